@@ -0,0 +1,699 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <lyra/lyra.hpp>
+#include <nlohmann/json.hpp>
+#include <nncase/compiler.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/bitcast.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/matmul.h>
+#include <nncase/ir/ops/reduce.h>
+#include <nncase/ir/ops/slice.h>
+#include <nncase/ir/ops/transpose.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/version.h>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+#ifdef WIN32
+#include <Windows.h>
+#include <psapi.h>
+#elif !defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+using namespace nncase;
+using namespace nncase::ir;
+namespace chrono = std::chrono;
+
+namespace
+{
+class graph_builder
+{
+public:
+    graph_builder(ir::graph &graph)
+        : graph_(graph), rng_(0)
+    {
+    }
+
+    output_connector &input(shape_t shape)
+    {
+        auto node = graph_.emplace<input_node>(dt_float32, shape);
+        node->name("input");
+        return node->output();
+    }
+
+    void output(output_connector &value, std::string name)
+    {
+        auto node = graph_.emplace<output_node>(value.type(), value.shape());
+        node->name(std::move(name));
+        node->input().connect(value);
+    }
+
+    output_connector &weights(shape_t shape)
+    {
+        std::uniform_real_distribution<float> dist(-0.1f, 0.1f);
+        std::vector<float> data(std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>()));
+        for (auto &value : data)
+            value = dist(rng_);
+        return graph_.emplace<constant>(dt_float32, shape, data)->output();
+    }
+
+    output_connector &zeros(shape_t shape)
+    {
+        std::vector<float> data(std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>()));
+        return graph_.emplace<constant>(dt_float32, shape, data)->output();
+    }
+
+    output_connector &scalar(float value)
+    {
+        return graph_.emplace<constant>(value)->output();
+    }
+
+    output_connector &conv2d(output_connector &input, size_t out_channels, int32_t kernel, int32_t stride = 1, bool relu = true)
+    {
+        auto &in_shape = input.shape();
+        shape_t w_shape { out_channels, in_shape[1], (size_t)kernel, (size_t)kernel };
+        padding pad { (kernel - 1) / 2, (kernel - 1) / 2 };
+        auto node = graph_.emplace<ir::conv2d>(in_shape, w_shape, 1, pad, pad, stride, stride, 1, 1,
+            relu ? value_range<float> { 0.f, std::numeric_limits<float>::infinity() } : value_range<float>::full());
+        node->input().connect(input);
+        node->weights().connect(weights(w_shape));
+        node->bias().connect(weights(shape_t { out_channels }));
+        return node->output();
+    }
+
+    // input [M, K] x weights [K, N] + bias
+    output_connector &dense(output_connector &input, size_t units)
+    {
+        shape_t w_shape { input.shape()[1], units };
+        auto node = graph_.emplace<ir::matmul>(input.shape(), w_shape, value_range<float>::full());
+        node->input_a().connect(input);
+        node->input_b().connect(weights(w_shape));
+        node->bias().connect(weights(shape_t { units }));
+        return node->output();
+    }
+
+    output_connector &matmul(output_connector &a, output_connector &b)
+    {
+        auto node = graph_.emplace<ir::matmul>(a.shape(), b.shape(), value_range<float>::full());
+        node->input_a().connect(a);
+        node->input_b().connect(b);
+        node->bias().connect(zeros(shape_t { b.shape()[1] }));
+        return node->output();
+    }
+
+    output_connector &binary(binary_op_t op, output_connector &a, output_connector &b)
+    {
+        auto node = graph_.emplace<ir::binary>(op, a.shape(), b.shape(), value_range<float>::full());
+        node->input_a().connect(a);
+        node->input_b().connect(b);
+        return node->output();
+    }
+
+    output_connector &unary(unary_op_t op, output_connector &input)
+    {
+        auto node = graph_.emplace<ir::unary>(op, input.shape());
+        node->input().connect(input);
+        return node->output();
+    }
+
+    output_connector &sigmoid(output_connector &input)
+    {
+        auto &exp = unary(unary_exp, unary(unary_neg, input));
+        return binary(binary_div, scalar(1.f), binary(binary_add, scalar(1.f), exp));
+    }
+
+    output_connector &reduce(reduce_op_t op, output_connector &input, int32_t axis)
+    {
+        auto init = op == reduce_max ? std::numeric_limits<float>::lowest() : 0.f;
+        auto node = graph_.emplace<ir::reduce>(op, input.shape(), axis_t { axis }, init, true);
+        node->input().connect(input);
+        return node->output();
+    }
+
+    output_connector &softmax(output_connector &input)
+    {
+        auto axis = (int32_t)input.shape().size() - 1;
+        auto &exp = unary(unary_exp, binary(binary_sub, input, reduce(reduce_max, input, axis)));
+        return binary(binary_div, exp, reduce(reduce_sum, exp, axis));
+    }
+
+    output_connector &layer_norm(output_connector &input)
+    {
+        auto axis = (int32_t)input.shape().size() - 1;
+        auto &centered = binary(binary_sub, input, reduce(reduce_mean, input, axis));
+        auto &var = reduce(reduce_mean, binary(binary_mul, centered, centered), axis);
+        auto &norm = binary(binary_mul, centered, unary(unary_rsqrt, binary(binary_add, var, scalar(1e-5f))));
+        shape_t param_shape { input.shape().back() };
+        return binary(binary_add, binary(binary_mul, norm, weights(param_shape)), weights(param_shape));
+    }
+
+    output_connector &slice(output_connector &input, axis_t begin, axis_t end)
+    {
+        auto node = graph_.emplace<ir::slice>(dt_float32, input.shape(), begin, end);
+        node->input().connect(input);
+        return node->output();
+    }
+
+    output_connector &transpose(output_connector &input, axis_t perm)
+    {
+        auto node = graph_.emplace<ir::transpose>(dt_float32, input.shape(), perm);
+        node->input().connect(input);
+        return node->output();
+    }
+
+    output_connector &reshape(output_connector &input, shape_t new_shape)
+    {
+        auto node = graph_.emplace<bitcast>(dt_float32, input.shape(), new_shape);
+        node->input().connect(input);
+        return node->output();
+    }
+
+    output_connector &concat(std::span<output_connector *const> inputs, int32_t axis)
+    {
+        std::vector<shape_t> shapes;
+        for (auto in : inputs)
+            shapes.emplace_back(in->shape());
+        auto node = graph_.emplace<ir::concat>(dt_float32, shapes, axis);
+        for (size_t i = 0; i < inputs.size(); i++)
+            node->input_at(i).connect(*inputs[i]);
+        return node->output();
+    }
+
+private:
+    ir::graph &graph_;
+    std::mt19937 rng_;
+};
+
+// A deep chain of residual conv blocks
+void build_conv_chain(graph_builder &b)
+{
+    auto *x = &b.input(shape_t { 1, 16, 56, 56 });
+    for (size_t i = 0; i < 500; i++)
+    {
+        auto &y = b.conv2d(b.conv2d(*x, 16, 3), 16, 3, 1, false);
+        x = &b.binary(binary_add, *x, y);
+    }
+    b.output(*x, "output");
+}
+
+// Many independent branches joined by a single concat
+void build_wide_branches(graph_builder &b)
+{
+    auto &x = b.input(shape_t { 1, 32, 28, 28 });
+    std::vector<output_connector *> branches;
+    for (size_t i = 0; i < 256; i++)
+        branches.emplace_back(&b.conv2d(b.conv2d(x, 8, 1), 8, 3));
+    b.output(b.concat(branches, 1), "output");
+}
+
+// An LSTM layer unrolled over the time steps
+void build_lstm_unrolled(graph_builder &b)
+{
+    const size_t steps = 64, input_size = 128, hidden = 256;
+    auto &x = b.input(shape_t { steps, input_size });
+    auto *h = &b.zeros(shape_t { 1, hidden });
+    auto *c = &b.zeros(shape_t { 1, hidden });
+    std::vector<output_connector *> outputs;
+    for (int32_t t = 0; t < (int32_t)steps; t++)
+    {
+        auto &x_t = b.slice(x, axis_t { t, 0 }, axis_t { t + 1, (int32_t)input_size });
+        auto &gates = b.binary(binary_add, b.dense(x_t, hidden * 4), b.dense(*h, hidden * 4));
+        auto gate = [&](int32_t i) -> output_connector & { return b.slice(gates, axis_t { 0, i * (int32_t)hidden }, axis_t { 1, (i + 1) * (int32_t)hidden }); };
+        auto &in_gate = b.sigmoid(gate(0));
+        auto &forget_gate = b.sigmoid(gate(1));
+        auto &cell_gate = b.unary(unary_tanh, gate(2));
+        auto &out_gate = b.sigmoid(gate(3));
+        c = &b.binary(binary_add, b.binary(binary_mul, forget_gate, *c), b.binary(binary_mul, in_gate, cell_gate));
+        h = &b.binary(binary_mul, out_gate, b.unary(unary_tanh, *c));
+        outputs.emplace_back(h);
+    }
+    b.output(b.concat(outputs, 0), "output");
+}
+
+// A strided backbone with class, box and objectness heads on three feature levels
+void build_detector(graph_builder &b)
+{
+    auto *x = &b.conv2d(b.input(shape_t { 1, 3, 320, 320 }), 16, 3, 2);
+    std::vector<output_connector *> features;
+    size_t channels = 16;
+    for (size_t stage = 0; stage < 5; stage++)
+    {
+        channels *= 2;
+        x = &b.conv2d(*x, channels, 3, 2);
+        for (size_t i = 0; i < 2; i++)
+            x = &b.binary(binary_add, *x, b.conv2d(b.conv2d(*x, channels / 2, 1), channels, 3));
+        if (stage >= 2)
+            features.emplace_back(x);
+    }
+
+    const size_t num_classes = 80, num_anchors = 3;
+    std::vector<output_connector *> cls, box, obj;
+    for (auto feature : features)
+    {
+        auto &shape = feature->shape();
+        auto head = [&](size_t out_channels) -> output_connector & {
+            auto &y = b.conv2d(b.conv2d(*feature, 64, 3), out_channels * num_anchors, 1, 1, false);
+            return b.reshape(y, shape_t { out_channels * num_anchors, shape[2] * shape[3] });
+        };
+        cls.emplace_back(&b.sigmoid(head(num_classes)));
+        box.emplace_back(&head(4));
+        obj.emplace_back(&b.sigmoid(head(1)));
+    }
+    b.output(b.concat(cls, 1), "cls");
+    b.output(b.concat(box, 1), "box");
+    b.output(b.concat(obj, 1), "obj");
+}
+
+// Pre-norm transformer encoder layers with multi-head self attention
+void build_transformer(graph_builder &b)
+{
+    const size_t seq = 128, dim = 256, heads = 8, head_dim = dim / heads, ffn = 1024;
+    auto *x = &b.input(shape_t { seq, dim });
+    for (size_t layer = 0; layer < 2; layer++)
+    {
+        auto &norm = b.layer_norm(*x);
+        auto &q = b.dense(norm, dim);
+        auto &k = b.dense(norm, dim);
+        auto &v = b.dense(norm, dim);
+        std::vector<output_connector *> attn_heads;
+        for (int32_t h = 0; h < (int32_t)heads; h++)
+        {
+            axis_t begin { 0, h * (int32_t)head_dim }, end { (int32_t)seq, (h + 1) * (int32_t)head_dim };
+            auto &k_t = b.transpose(b.slice(k, begin, end), axis_t { 1, 0 });
+            auto &scores = b.binary(binary_mul, b.matmul(b.slice(q, begin, end), k_t), b.scalar(1.f / std::sqrt((float)head_dim)));
+            attn_heads.emplace_back(&b.matmul(b.softmax(scores), b.slice(v, begin, end)));
+        }
+        x = &b.binary(binary_add, *x, b.dense(b.concat(attn_heads, 1), dim));
+
+        auto &hidden = b.dense(b.layer_norm(*x), ffn);
+        auto &gelu = b.binary(binary_mul, hidden, b.sigmoid(b.binary(binary_mul, hidden, b.scalar(1.702f))));
+        x = &b.binary(binary_add, *x, b.dense(gelu, dim));
+    }
+    b.output(*x, "output");
+}
+
+// Protobuf wire format, enough to serialize the ONNX messages below
+class proto_writer
+{
+public:
+    void varint(uint32_t field, uint64_t value)
+    {
+        key(field, 0);
+        raw_varint(value);
+    }
+
+    void bytes(uint32_t field, std::string_view value)
+    {
+        key(field, 2);
+        raw_varint(value.size());
+        data_.append(value);
+    }
+
+    void message(uint32_t field, const proto_writer &value)
+    {
+        bytes(field, value.data());
+    }
+
+    const std::string &data() const noexcept { return data_; }
+
+private:
+    void key(uint32_t field, uint32_t wire_type)
+    {
+        raw_varint((field << 3) | wire_type);
+    }
+
+    void raw_varint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            data_.push_back((char)(value | 0x80));
+            value >>= 7;
+        }
+        data_.push_back((char)value);
+    }
+
+    std::string data_;
+};
+
+// Builds an ONNX model, so the import phase parses a real serialized model
+class onnx_builder
+{
+public:
+    onnx_builder()
+        : rng_(0)
+    {
+    }
+
+    std::string input(const std::string &name, const shape_t &shape)
+    {
+        graph_.message(11, value_info(name, shape));
+        return name;
+    }
+
+    void output(const std::string &name, const shape_t &shape)
+    {
+        graph_.message(12, value_info(name, shape));
+    }
+
+    std::string conv2d(const std::string &input, size_t in_channels, size_t out_channels, int64_t kernel, bool relu = true)
+    {
+        auto pad = (kernel - 1) / 2;
+        proto_writer pads;
+        pads.bytes(1, "pads");
+        for (size_t i = 0; i < 4; i++)
+            pads.varint(8, (uint64_t)pad);
+        pads.varint(20, 7); // INTS
+
+        auto w = weights(shape_t { out_channels, in_channels, (size_t)kernel, (size_t)kernel });
+        auto b = weights(shape_t { out_channels });
+        auto conv = node("Conv", { input, w, b }, { pads });
+        return relu ? node("Relu", { conv }) : conv;
+    }
+
+    std::string add(const std::string &a, const std::string &b)
+    {
+        return node("Add", { a, b });
+    }
+
+    std::vector<uint8_t> serialize() const
+    {
+        proto_writer opset;
+        opset.varint(2, 11);
+
+        proto_writer model;
+        model.varint(1, 7); // ir_version
+        model.bytes(2, "benchncc");
+        model.message(7, graph_);
+        model.message(8, opset);
+        auto &data = model.data();
+        return { data.begin(), data.end() };
+    }
+
+private:
+    static proto_writer value_info(const std::string &name, const shape_t &shape)
+    {
+        proto_writer tensor_shape;
+        for (auto dim : shape)
+        {
+            proto_writer dimension;
+            dimension.varint(1, dim);
+            tensor_shape.message(1, dimension);
+        }
+
+        proto_writer tensor_type;
+        tensor_type.varint(1, 1); // FLOAT
+        tensor_type.message(2, tensor_shape);
+        proto_writer type;
+        type.message(1, tensor_type);
+
+        proto_writer info;
+        info.bytes(1, name);
+        info.message(2, type);
+        return info;
+    }
+
+    std::string weights(const shape_t &shape)
+    {
+        std::uniform_real_distribution<float> dist(-0.1f, 0.1f);
+        std::vector<float> data(std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>()));
+        for (auto &value : data)
+            value = dist(rng_);
+
+        auto name = "w" + std::to_string(weights_count_++);
+        proto_writer tensor;
+        for (auto dim : shape)
+            tensor.varint(1, dim);
+        tensor.varint(2, 1); // FLOAT
+        tensor.bytes(8, name);
+        tensor.bytes(9, { reinterpret_cast<const char *>(data.data()), data.size() * sizeof(float) });
+        graph_.message(5, tensor);
+        return name;
+    }
+
+    std::string node(const std::string &op_type, const std::vector<std::string> &inputs, const std::vector<proto_writer> &attributes = {})
+    {
+        auto output = op_type + std::to_string(node_count_++);
+        proto_writer node;
+        for (auto &in : inputs)
+            node.bytes(1, in);
+        node.bytes(2, output);
+        node.bytes(3, output);
+        node.bytes(4, op_type);
+        for (auto &attr : attributes)
+            node.message(5, attr);
+        graph_.message(1, node);
+        return output;
+    }
+
+    proto_writer graph_;
+    size_t weights_count_ = 0;
+    size_t node_count_ = 0;
+    std::mt19937 rng_;
+};
+
+// The conv chain again, imported from ONNX instead of built in memory
+std::vector<uint8_t> serialize_conv_chain()
+{
+    const shape_t shape { 1, 16, 56, 56 };
+    onnx_builder b;
+    auto x = b.input("input", shape);
+    for (size_t i = 0; i < 500; i++)
+    {
+        auto y = b.conv2d(b.conv2d(x, 16, 16, 3), 16, 16, 3, false);
+        x = b.add(x, y);
+    }
+    b.output(x, shape);
+    return b.serialize();
+}
+
+struct bench_model
+{
+    const char *name;
+    void (*build)(graph_builder &builder);
+    std::vector<uint8_t> (*serialize)() = nullptr;
+};
+
+const bench_model models[] = {
+    { "conv_chain", build_conv_chain },
+    { "wide_branches", build_wide_branches },
+    { "lstm_unrolled", build_lstm_unrolled },
+    { "detector", build_detector },
+    { "transformer", build_transformer },
+    { "conv_chain_onnx", nullptr, serialize_conv_chain },
+};
+
+class random_samples : public sample_source
+{
+public:
+    random_samples(size_t count)
+        : count_(count), rng_(0)
+    {
+    }
+
+    void reset() override { index_ = 0; }
+
+    bool next(std::span<uint8_t> dest) override
+    {
+        if (index_++ == count_)
+            return false;
+
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        auto values = reinterpret_cast<float *>(dest.data());
+        for (size_t i = 0; i < dest.size() / sizeof(float); i++)
+            values[i] = dist(rng_);
+        return true;
+    }
+
+private:
+    size_t count_;
+    size_t index_ = 0;
+    std::mt19937 rng_;
+};
+
+// Resets the peak so each model is measured on its own where the platform allows it
+void reset_peak_rss()
+{
+#ifdef __linux__
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+size_t peak_rss()
+{
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("VmHWM:", 0) == 0)
+            return std::stoull(line.substr(6)) * 1024;
+    }
+    return 0;
+#else
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+double elapsed_ms(chrono::steady_clock::time_point begin)
+{
+    return chrono::duration<double, std::milli>(chrono::steady_clock::now() - begin).count();
+}
+
+nlohmann::json run_model(const bench_model &model, const std::string &target, size_t samples)
+{
+    nlohmann::json result { { "name", model.name } };
+    // Serialized up front so that only the import is measured
+    std::vector<uint8_t> onnx;
+    if (model.serialize)
+    {
+        onnx = model.serialize();
+        result["onnx_size"] = onnx.size();
+    }
+
+    reset_peak_rss();
+    auto begin = chrono::steady_clock::now();
+
+    try
+    {
+        compile_options options {};
+        options.target = target;
+        auto compiler = compiler::create(options);
+
+        if (model.serialize)
+        {
+            compiler->import_onnx(onnx, import_options {});
+        }
+        else
+        {
+            // Graphs built in memory skip the import, their construction is reported on its own
+            auto build_begin = chrono::steady_clock::now();
+            graph_builder builder(compiler->graph(0));
+            model.build(builder);
+            result["build_ms"] = elapsed_ms(build_begin);
+        }
+        result["nodes"] = compiler->graph(0).nodes().size();
+
+        if (samples)
+        {
+            ptq_tensor_options ptq_options;
+            ptq_options.samples_count = samples;
+            ptq_options.samples = std::make_shared<random_samples>(samples);
+            compiler->use_ptq(ptq_options);
+        }
+
+        compiler->compile();
+        std::stringstream kmodel;
+        compiler->gencode(kmodel);
+
+        auto &stats = compiler->stats();
+        result["import_ms"] = stats.import_ms;
+        result["optimize_ms"] = stats.optimize_ms;
+        result["calibrate_ms"] = stats.calibrate_ms;
+        result["schedule_ms"] = stats.schedule_ms;
+        result["codegen_ms"] = stats.codegen_ms;
+        result["model_size"] = kmodel.str().size();
+    }
+    catch (std::exception &ex)
+    {
+        result["error"] = ex.what();
+    }
+
+    result["total_ms"] = elapsed_ms(begin);
+    result["peak_rss"] = peak_rss();
+    return result;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    // stdout only carries the json results, so they can be piped
+    std::cerr << "nncase Compile Benchmark Tools " NNCASE_VERSION NNCASE_VERSION_SUFFIX << std::endl
+              << "Copyright 2019-2021 Canaan Inc." << std::endl;
+
+    std::string target = "cpu";
+    std::string output;
+    std::string filter;
+    size_t samples = 2;
+    bool show_help = false;
+    auto cli = lyra::cli()
+        | lyra::help(show_help)
+        | lyra::opt(target, "target").name("-t").name("--target").help("target architecture, default is " + target)
+        | lyra::opt(output, "output file").name("-o").name("--output").help("write the results as json to this file instead of stdout")
+        | lyra::opt(filter, "model").name("--model").help("only run the models whose name contains this")
+        | lyra::opt(samples, "samples").name("--samples").help("calibration samples, 0 compiles without quantization, default is " + std::to_string(samples));
+
+    auto parsed = cli.parse({ argc, argv });
+    if (!parsed)
+    {
+        std::cerr << parsed.errorMessage() << std::endl;
+        return 1;
+    }
+    if (show_help)
+    {
+        std::cout << cli;
+        return 0;
+    }
+
+    nlohmann::json results { { "version", NNCASE_VERSION NNCASE_VERSION_SUFFIX }, { "target", target }, { "samples", samples } };
+    auto &model_results = results["models"] = nlohmann::json::array();
+
+    // The compiler logs its phases to stdout, send them to stderr with the other diagnostics
+    auto stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+    for (auto &model : models)
+    {
+        if (std::string_view(model.name).find(filter) == std::string_view::npos)
+            continue;
+
+        auto result = run_model(model, target, samples);
+        if (result.contains("error"))
+            fprintf(stderr, "Cannot compile %s: %s\n", model.name, result["error"].get<std::string>().c_str());
+        model_results.emplace_back(std::move(result));
+    }
+    std::cout.rdbuf(stdout_buf);
+
+    if (output.empty())
+    {
+        std::cout << results.dump(4) << std::endl;
+    }
+    else
+    {
+        std::ofstream(output) << results.dump(4) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <lyra/lyra.hpp>
+#include <nlohmann/json.hpp>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/schedule/buffer_allocator.h>
+#include <nncase/schedule/freelist.h>
+#include <nncase/schedule/liveness_analysis.h>
+#include <nncase/schedule/scheduler.h>
+#include <nncase/targets/neutral_target.h>
+#include <nncase/version.h>
+#include <random>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::schedule;
+namespace chrono = std::chrono;
+
+namespace
+{
+double elapsed_ms(chrono::steady_clock::time_point begin)
+{
+    return chrono::duration<double, std::milli>(chrono::steady_clock::now() - begin).count();
+}
+
+// An unrolled recurrent cell: every step reads the previous state and a skip connection
+// from a few steps back, which keeps a handful of buffers alive across many ages.
+void build_unrolled_graph(graph &g, size_t steps, size_t skip)
+{
+    shape_t shape { 1, 64 };
+    auto in = g.emplace<input_node>(dt_float32, shape);
+    std::vector<output_connector *> states { &in->output() };
+    for (size_t i = 0; i < steps; i++)
+    {
+        auto &prev = *states.back();
+        auto &skipped = *states[states.size() > skip ? states.size() - skip : 0];
+        auto u = g.emplace<unary>(unary_tanh, shape);
+        auto b = g.emplace<binary>(binary_add, shape, shape, value_range<float>::full());
+        u->input().connect(prev);
+        b->input_a().connect(u->output());
+        b->input_b().connect(skipped);
+        states.emplace_back(&b->output());
+    }
+
+    auto out = g.emplace<output_node>(dt_float32, shape);
+    out->input().connect(*states.back());
+}
+
+nlohmann::json bench_freelist(size_t allocations, size_t max_living)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> size_dist(1, 4096);
+    freelist list(std::nullopt);
+    std::vector<memory_span> living;
+
+    auto begin = chrono::steady_clock::now();
+    for (size_t i = 0; i < allocations; i++)
+    {
+        if (living.size() >= max_living)
+        {
+            auto idx = std::uniform_int_distribution<size_t>(0, living.size() - 1)(rng);
+            list.free(living[idx]);
+            living[idx] = living.back();
+            living.pop_back();
+        }
+
+        living.emplace_back(list.allocate(size_dist(rng) * 8));
+    }
+
+    return { { "name", "freelist" }, { "allocations", allocations }, { "max_living", max_living }, { "total_ms", elapsed_ms(begin) } };
+}
+
+// Liveness and allocation of one graph, the way function_schedule_context runs them
+nlohmann::json bench_allocation(size_t steps, size_t skip)
+{
+    graph g;
+    build_unrolled_graph(g, steps, skip);
+
+    auto begin = chrono::steady_clock::now();
+    std::list<logical_buffer> buffers;
+    std::unordered_map<const output_connector *, logical_buffer *> buffer_map;
+    lifetime_recorder lr(buffers, buffer_map);
+    auto alloc_visitor = make_relay_ir_visitor([&](node &node) {
+        for (auto out : node.outputs())
+            lr.allocate(*out, mem_data);
+        lr.grow_age();
+        for (auto in : node.inputs())
+            lr.release(*in->connection());
+    });
+    alloc_visitor.visit(g.outputs());
+    lr.finish();
+    auto liveness_ms = elapsed_ms(begin);
+
+    auto alloc_begin = chrono::steady_clock::now();
+    std::list<physical_buffer> physical_buffers;
+    std::vector<physical_buffer *> orders;
+    for (auto &b : buffers)
+        orders.emplace_back(&physical_buffers.emplace_back(orders.size(), b));
+    std::sort(orders.begin(), orders.end(), [](const physical_buffer *lhs, const physical_buffer *rhs) { return lhs->lifetime().birth < rhs->lifetime().birth; });
+
+    best_fit_allocator allocator;
+    for (auto b : orders)
+        allocator.mark(*b);
+    allocator.finish();
+    auto allocate_ms = elapsed_ms(alloc_begin);
+
+    return { { "name", "allocation" }, { "nodes", g.nodes().size() }, { "buffers", orders.size() }, { "max_usage", allocator.max_usage() },
+        { "liveness_ms", liveness_ms }, { "allocate_ms", allocate_ms }, { "total_ms", elapsed_ms(begin) } };
+}
+
+nlohmann::json bench_scheduler(size_t steps, size_t skip)
+{
+    graph g;
+    build_unrolled_graph(g, steps, skip);
+    targets::neutral_target target;
+
+    auto begin = chrono::steady_clock::now();
+    scheduler sch(target, g, g.outputs());
+    auto result = sch.schedule();
+    auto total_ms = elapsed_ms(begin);
+
+    return { { "name", "scheduler" }, { "nodes", g.nodes().size() }, { "modules", result.modules.size() }, { "total_ms", total_ms } };
+}
+}
+
+int main(int argc, char *argv[])
+{
+    // stdout only carries the json results, so they can be piped
+    std::cerr << "nncase Schedule Benchmark Tools " NNCASE_VERSION NNCASE_VERSION_SUFFIX << std::endl
+              << "Copyright 2019-2021 Canaan Inc." << std::endl;
+
+    std::string output;
+    size_t steps = 10000;
+    size_t skip = 8;
+    size_t allocations = 100000;
+    bool show_help = false;
+    auto cli = lyra::cli()
+        | lyra::help(show_help)
+        | lyra::opt(output, "output file").name("-o").name("--output").help("write the results as json to this file instead of stdout")
+        | lyra::opt(steps, "steps").name("--steps").help("steps of the unrolled graph, each adds two nodes, default is " + std::to_string(steps))
+        | lyra::opt(skip, "skip").name("--skip").help("distance of the skip connections, default is " + std::to_string(skip))
+        | lyra::opt(allocations, "allocations").name("--allocations").help("freelist allocations, default is " + std::to_string(allocations));
+
+    auto parsed = cli.parse({ argc, argv });
+    if (!parsed)
+    {
+        std::cerr << parsed.errorMessage() << std::endl;
+        return 1;
+    }
+    if (show_help)
+    {
+        std::cout << cli;
+        return 0;
+    }
+
+    nlohmann::json results { { "version", NNCASE_VERSION NNCASE_VERSION_SUFFIX } };
+    auto &bench_results = results["benchmarks"] = nlohmann::json::array();
+
+    // The scheduler logs to stdout, send it to stderr with the other diagnostics
+    auto stdout_buf = std::cout.rdbuf(std::cerr.rdbuf());
+    bench_results.emplace_back(bench_freelist(allocations, allocations / 20));
+    bench_results.emplace_back(bench_allocation(steps, skip));
+    bench_results.emplace_back(bench_scheduler(steps, skip));
+    std::cout.rdbuf(stdout_buf);
+
+    if (output.empty())
+    {
+        std::cout << results.dump(4) << std::endl;
+    }
+    else
+    {
+        std::ofstream(output) << results.dump(4) << std::endl;
+    }
+
+    return 0;
+}
@@ -32,6 +32,10 @@ public:
     void config_dump(const std::filesystem::path &dump_dir, bool dump_asm);
     build_model_result build(std::ostream &output);
 
+    /// Threads shared by all modules, 0 for hardware concurrency and 1 for a serial build.
+    size_t num_threads() const noexcept { return num_threads_; }
+    void num_threads(size_t value) noexcept { num_threads_ = value; }
+
     size_t max_usage(memory_location_t location) const;
 
 private:
@@ -39,5 +43,6 @@ private:
     const schedule::model_schedule_result &sched_;
     std::filesystem::path dump_dir_;
     bool dump_asm_;
+    size_t num_threads_;
 };
 }
@@ -80,6 +80,15 @@ public:
     void config_dump(const std::filesystem::path &dump_dir, bool dump_asm);
     void build(binary_writer &writer);
 
+    /// Threads used to decompile sections, 0 for hardware concurrency.
+    size_t num_threads() const noexcept { return num_threads_; }
+    void num_threads(size_t value) noexcept { num_threads_ = value; }
+
+    /// Compile and link the module into its own sections. Builders of different modules
+    /// don't share state, so they can generate concurrently before being written in order.
+    void generate();
+    void write(binary_writer &writer);
+
     const schedule::buffer_allocation &allocation(ir::output_connector &conn) const;
     const schedule::buffer_allocation &allocation(ir::input_connector &conn) const { return allocation(*conn.connection()); }
     size_t max_usage(memory_location_t location) const;
@@ -94,6 +103,7 @@ protected:
     function_call_id function_id(ir::graph *graph);
     void set_current_entry_point(std::streampos pos);
     void set_current_function_text_end(std::streampos pos);
+    const schedule::function_schedule_result &current_function() const noexcept { return *current_function_; }
 
     virtual void begin_emit_module();
     virtual void begin_emit_function(const schedule::function_schedule_result &function);
@@ -109,6 +119,8 @@ private:
     std::vector<nncase::ir::node *> generate_current_runtime_ops();
     void compile();
     void decompile(std::string_view stage, std::string_view section_name, std::span<const uint8_t> input, std::span<const symbol> symbols);
+    template <class TPredicate>
+    void decompile_sections(std::string_view stage, TPredicate &&predicate);
 
     void write_constants();
     void generate_merge_info();
@@ -120,6 +132,7 @@ private:
 
 private:
     uint32_t alignment_;
+    size_t num_threads_;
     std::string module_name_;
     const module_builder_params &params_;
     std::map<std::string, section, std::less<>> section_writer_;
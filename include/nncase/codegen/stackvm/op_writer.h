@@ -972,6 +972,9 @@ struct op_writer<nncase::runtime::stackvm::tensor_conv2d_op_t>
         writer.write(op.dilation_w);
         writer.write(op.fused_clamp_low);
         writer.write(op.fused_clamp_high);
+        writer.write(op.fused_lut);
+        writer.write(op.fused_lut_zero_point);
+        writer.write(op.fused_lut_scale);
     }
 };
 
@@ -1330,6 +1333,146 @@ struct op_writer<nncase::runtime::stackvm::tensor_transpose_op_t>
     }
 };
 
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_detection_postprocess_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_detection_postprocess_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_boxes);
+        writer.write(op.rstride_boxes);
+        writer.write(op.rshape_scores);
+        writer.write(op.rstride_scores);
+        writer.write(op.center_point_box);
+        writer.write(op.max_output_boxes_per_class);
+        writer.write(op.iou_threshold);
+        writer.write(op.score_threshold);
+    }
+};
+
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_topk_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_topk_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_src);
+        writer.write(op.rstride_src);
+        writer.write(op.rstride_values);
+        writer.write(op.rstride_indices);
+        writer.write(op.axis);
+        writer.write(op.k);
+        writer.write(op.largest);
+        writer.write(op.sorted);
+    }
+};
+
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_loop_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_loop_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(op.function_id);
+        writer.write(op.module_id);
+        writer.write(op.num_src);
+        writer.write(op.num_dst);
+        writer.write(op.num_states);
+        writer.write(op.num_scan_inputs);
+        writer.write(op.trip_count);
+    }
+};
+
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_image_preprocess_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_image_preprocess_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_src);
+        writer.write(op.rstride_src);
+        writer.write(op.rshape_dest);
+        writer.write(op.rstride_dest);
+        writer.write(op.zero_point);
+        writer.write(op.scale);
+        writer.write(op.input_nhwc);
+        writer.write(op.swap_rb);
+        writer.write(op.resize_h);
+        writer.write(op.resize_w);
+        writer.write(op.pad_top);
+        writer.write(op.pad_left);
+        writer.write(op.pad_value);
+        writer.write(op.output_nhwc);
+    }
+};
+
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_quantized_binary_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_quantized_binary_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(static_cast<uint8_t>(op.binary_op));
+        writer.write(op.rshape_src1);
+        writer.write(op.rstride_src1);
+        writer.write(op.rshape_src2);
+        writer.write(op.rstride_src2);
+        writer.write(op.rstride_dest);
+        writer.write(op.in_a_zero_point);
+        writer.write(op.in_a_scale);
+        writer.write(op.in_b_zero_point);
+        writer.write(op.in_b_scale);
+        writer.write(op.out_zero_point);
+        writer.write(op.out_scale);
+        writer.write(op.fused_clamp_low);
+        writer.write(op.fused_clamp_high);
+    }
+};
+
+template <>
+struct op_writer<nncase::runtime::stackvm::tensor_conv2d_pool_op_t>
+{
+    void operator()(const nncase::runtime::stackvm::tensor_conv2d_pool_op_t &op, binary_writer &writer) const
+    {
+        writer.write(static_cast<uint8_t>(op.opcode));
+        writer.write(static_cast<uint16_t>(op.funct));
+        writer.write(static_cast<uint8_t>(op.datatype));
+        writer.write(op.rshape_src);
+        writer.write(op.rstride_src);
+        writer.write(op.rshape_kernel);
+        writer.write(op.rstride_kernel);
+        writer.write(op.rstride_bias);
+        writer.write(op.rstride_dest);
+        writer.write(op.groups);
+        writer.write(op.stride_h);
+        writer.write(op.stride_w);
+        writer.write(op.dilation_h);
+        writer.write(op.dilation_w);
+        writer.write(op.fused_clamp_low);
+        writer.write(op.fused_clamp_high);
+        writer.write(op.fused_lut);
+        writer.write(op.fused_lut_zero_point);
+        writer.write(op.fused_lut_scale);
+        writer.write(static_cast<uint8_t>(op.pool_op));
+        writer.write(op.pool_init_value);
+        writer.write(op.pool_filter_h);
+        writer.write(op.pool_filter_w);
+        writer.write(op.pool_stride_h);
+        writer.write(op.pool_stride_w);
+        writer.write(op.pool_clamp_low);
+        writer.write(op.pool_clamp_high);
+    }
+};
+
 class NNCASE_API op_builder
 {
 public:
@@ -1435,7 +1578,7 @@ public:
     void tensor_broadcast_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_dest, uint8_t rstride_dest);
     void tensor_binary_(datatype_t datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rstride_dest, binary_op_t binary_op, float fused_clamp_low, float fused_clamp_high);
     void tensor_call_(uint32_t function_id, uint16_t module_id, uint8_t num_src, uint8_t num_dst);
-    void tensor_conv2d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high);
+    void tensor_conv2d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high, bool fused_lut, int32_t fused_lut_zero_point, float fused_lut_scale);
     void tensor_copy_(datatype_t datatype, uint8_t rshape, uint8_t rstride_src, uint8_t rstride_dest);
     void tensor_convert_(datatype_t in_datatype, datatype_t dst_datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest);
     void tensor_cumsum_(datatype_t datatype, uint8_t rshape_src, int32_t axis, bool exclusive, bool reverse);
@@ -1458,6 +1601,12 @@ public:
     void tensor_ternary_(datatype_t datatype, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rshape_src3, uint8_t rstride_src3, uint8_t rstride_dest);
     void tensor_unary_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, unary_op_t unary_op);
     void tensor_transpose_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_dest, uint8_t rshape_perm);
+    void tensor_detection_postprocess_(datatype_t datatype, uint8_t rshape_boxes, uint8_t rstride_boxes, uint8_t rshape_scores, uint8_t rstride_scores, bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold);
+    void tensor_topk_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_values, uint8_t rstride_indices, int32_t axis, int32_t k, bool largest, bool sorted);
+    void tensor_loop_(uint32_t function_id, uint16_t module_id, uint8_t num_src, uint8_t num_dst, uint8_t num_states, uint8_t num_scan_inputs, uint32_t trip_count);
+    void tensor_image_preprocess_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_dest, uint8_t rstride_dest, int32_t zero_point, float scale, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left, float pad_value, bool output_nhwc);
+    void tensor_quantized_binary_(datatype_t datatype, binary_op_t binary_op, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rstride_dest, int32_t in_a_zero_point, float in_a_scale, int32_t in_b_zero_point, float in_b_scale, int32_t out_zero_point, float out_scale, float fused_clamp_low, float fused_clamp_high);
+    void tensor_conv2d_pool_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high, bool fused_lut, int32_t fused_lut_zero_point, float fused_lut_scale, reduce_op_t pool_op, float pool_init_value, uint16_t pool_filter_h, uint16_t pool_filter_w, uint16_t pool_stride_h, uint16_t pool_stride_w, float pool_clamp_low, float pool_clamp_high);
 
 private:
     section_writer &writer_;
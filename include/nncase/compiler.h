@@ -58,6 +58,7 @@ struct compile_options
     std::string input_layout = "NCHW";
     std::string output_layout = "NCHW";
     uint32_t tcu_num = 0;
+    size_t codegen_threads = 0;
 };
 
 struct import_options
@@ -65,6 +66,18 @@ struct import_options
     std::span<const std::string> output_arrays;
 };
 
+// Calibration samples pulled one at a time, so the whole calibration set never has to be in memory.
+class NNCASE_API sample_source
+{
+public:
+    virtual ~sample_source() = default;
+
+    /// Start a new pass over the samples, calibrate methods other than no_clip take two passes.
+    virtual void reset() = 0;
+    /// Fill dest with the next sample, returns false at the end of the pass.
+    virtual bool next(std::span<uint8_t> dest) = 0;
+};
+
 struct ptq_options_base
 {
     std::string calibrate_method = "no_clip";
@@ -80,7 +93,9 @@ struct ptq_dataset_options : ptq_options_base
 struct ptq_tensor_options : ptq_options_base
 {
     std::vector<uint8_t> tensor_data;
-    size_t samples_count;
+    size_t samples_count = 0;
+    /// Used instead of tensor_data when set, samples_count is then only reported to progress.
+    std::shared_ptr<sample_source> samples;
 };
 
 struct dump_range_options_base
@@ -97,7 +112,18 @@ struct dump_range_dataset_options : dump_range_options_base
 struct dump_range_tensor_options : dump_range_options_base
 {
     std::vector<uint8_t> tensor_data;
-    size_t samples_count;
+    size_t samples_count = 0;
+    /// Used instead of tensor_data when set, samples_count is then only reported to progress.
+    std::shared_ptr<sample_source> samples;
+};
+
+struct compile_stats
+{
+    double import_ms = 0;
+    double optimize_ms = 0;
+    double calibrate_ms = 0;
+    double schedule_ms = 0;
+    double codegen_ms = 0;
 };
 
 class NNCASE_API compiler
@@ -117,5 +143,7 @@ public:
     virtual nncase::target &target() = 0;
     virtual void compile() = 0;
     virtual void gencode(std::ostream &output) = 0;
+    /// Wall time spent in each compile phase so far.
+    virtual const compile_stats &stats() const noexcept = 0;
 };
 }
@@ -153,7 +153,6 @@ NNCASE_API inline result<runtime::runtime_tensor> neg(runtime::runtime_tensor &i
 
 /**
  * @brief binary add
- *        temporary not support
  * @param input_a runtime_tensor
  * @param input_b runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -165,7 +164,6 @@ NNCASE_API inline result<runtime::runtime_tensor> add(runtime::runtime_tensor &i
 }
 /**
  * @brief binary sub
- *        temporary not support
  * @param input_a runtime_tensor
  * @param input_b runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -177,7 +175,6 @@ NNCASE_API inline result<runtime::runtime_tensor> sub(runtime::runtime_tensor &i
 }
 /**
  * @brief binary mul
- *        temporary not support
  * @param input_a runtime_tensor
  * @param input_b runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -189,7 +186,6 @@ NNCASE_API inline result<runtime::runtime_tensor> mul(runtime::runtime_tensor &i
 }
 /**
  * @brief binary div
- *        temporary not support
  * @param input_a runtime_tensor
  * @param input_b runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -201,7 +197,6 @@ NNCASE_API inline result<runtime::runtime_tensor> div(runtime::runtime_tensor &i
 }
 /**
  * @brief binary min
- *        temporary not support
  * @param input_a runtime_tensor
  * @param input_b runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -213,7 +208,6 @@ NNCASE_API inline result<runtime::runtime_tensor> min(runtime::runtime_tensor &i
 }
 /**
  * @brief binary max
- *        temporary not support
  * @param input_a runtime_tensor
  * @param input_b runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -225,7 +219,7 @@ NNCASE_API inline result<runtime::runtime_tensor> max(runtime::runtime_tensor &i
 }
 
 /**
- * @brief quantize float or bfloat tensor to uint8 or int8
+ * @brief quantize float tensor to uint8 or int8 with the quant param of the input tensor
  * 
  * @param input runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -236,7 +230,7 @@ NNCASE_API inline result<runtime::runtime_tensor> quantize(runtime::runtime_tens
     return impl::quantize(input, dtype);
 }
 /**
- * @brief dequantize uint8 or int8 tensor to float or bfloat
+ * @brief dequantize uint8 or int8 tensor to float with the quant param of the input tensor
  * 
  * @param input runtime_tensor
  * @param dtype datatype, output tensor datatype
@@ -249,9 +243,10 @@ NNCASE_API inline result<runtime::runtime_tensor> dequantize(runtime::runtime_te
 
 /**
  * @brief give bboxs, crop new tensor from current tensor.
+ *        output shape is [n * roi_amounts, c, out_h, out_w], rois are read in place without copies
  * 
- * @param input 
- * @param bbox runtime tensor, shape should be [1,1,roi_amounts,4], layout should be [y0, x0, y1, x1]
+ * @param input NCHW tensor
+ * @param bbox float runtime tensor, shape should be [1,1,roi_amounts,4], layout should be [y0, x0, y1, x1], y1 and x1 exclusive
  * @param out_h output tensor height
  * @param out_w output tensor width
  * @param resize_mode resize mode
@@ -278,7 +273,6 @@ NNCASE_API inline result<runtime::runtime_tensor> resize(runtime::runtime_tensor
 
 /**
  * @brief padding value on the input tensor
- *        temporary not support
  * @param input 
  * @param padding vector for padding param, from last to frist. eg. vector [ {2,3}, {1,3} ] mean pad {2,3} in last dim, pad {1,3} in last second dim
  * @param pad_mode 
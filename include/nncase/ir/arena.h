@@ -0,0 +1,76 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <nncase/runtime/compiler_defs.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace nncase::ir
+{
+/// Bump allocator owning the nodes, connectors and names of a graph and of the subgraphs
+/// split from it. Objects are destructed in place by their owners, which hand their storage
+/// back for reuse by later objects of the same size. Not thread safe, like the graph itself.
+class NNCASE_API ir_arena
+{
+public:
+    ir_arena() = default;
+    ir_arena(ir_arena &) = delete;
+    ir_arena &operator=(ir_arena &) = delete;
+
+    void *allocate(size_t bytes, size_t alignment);
+    void deallocate(void *ptr, size_t bytes) noexcept;
+
+    template <class T, class... TArgs>
+    T *construct(TArgs &&...args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+    }
+
+    /// Pooled copy of a name, it lives as long as the arena.
+    const std::string &intern(std::string_view name);
+
+    /// Node ids are unique among all graphs sharing the arena.
+    size_t next_node_id() noexcept { return next_node_id_++; }
+    size_t node_id_bound() const noexcept { return next_node_id_; }
+
+    /// Arena of the graph that is constructing a node on this thread, if any.
+    static ir_arena *current() noexcept;
+
+    class NNCASE_API scope
+    {
+    public:
+        scope(ir_arena &arena) noexcept;
+        scope(scope &) = delete;
+        ~scope();
+
+    private:
+        ir_arena *previous_;
+    };
+
+private:
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::byte *current_ = nullptr;
+    size_t available_ = 0;
+    std::unordered_map<size_t, std::vector<void *>> free_lists_;
+    std::unordered_set<std::string> names_;
+    size_t next_node_id_ = 0;
+};
+}
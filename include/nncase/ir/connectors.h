@@ -30,7 +30,7 @@ class NNCASE_API base_connector
 public:
     template <class TName, class TShape>
     base_connector(node &owner, TName &&name, datatype_t type, TShape &&shape)
-        : owner_(owner), name_(std::forward<TName>(name)), type_(type), shape_(std::forward<TShape>(shape))
+        : owner_(owner), name_(&intern_name(std::forward<TName>(name))), type_(type), shape_(std::forward<TShape>(shape))
     {
     }
 
@@ -38,7 +38,7 @@ public:
     base_connector(base_connector &&) = default;
 
     node &owner() const noexcept { return owner_; }
-    const std::string &name() const noexcept { return name_; }
+    const std::string &name() const noexcept { return *name_; }
     datatype_t type() const noexcept { return type_; }
     const shape_t &shape() const noexcept { return shape_; }
     connector_attributes attributes() const noexcept { return attributes_; }
@@ -46,7 +46,7 @@ public:
 
 private:
     node &owner_;
-    std::string name_;
+    const std::string *name_;
     datatype_t type_;
     shape_t shape_;
     connector_attributes attributes_ = cnctr_attr_none;
@@ -82,10 +82,14 @@ public:
     // void attributes(connector_attributes value) noexcept { attributes_ = value; }
     memory_location_t memory_location() const noexcept { return memory_location_; }
     void memory_location(memory_location_t value) noexcept { memory_location_ = value; }
+    // Range given by a pre-quantized model, takes precedence over calibration
+    const std::optional<value_range<float>> &quant_range() const noexcept { return quant_range_; }
+    void quant_range(std::optional<value_range<float>> value) noexcept { quant_range_ = value; }
 
 private:
     std::vector<input_connector *> connections_;
     // connector_attributes attributes_ = cnctr_attr_none;
     memory_location_t memory_location_;
+    std::optional<value_range<float>> quant_range_;
 };
 }
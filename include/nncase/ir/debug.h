@@ -43,6 +43,8 @@ inline std::string to_string(memory_location_t location)
         return "rdata";
     case mem_data:
         return "data";
+    case mem_shared_data:
+        return "shared_data";
     default:
         return "unknown";
     }
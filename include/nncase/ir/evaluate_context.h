@@ -59,12 +59,18 @@ public:
     }
 
     module_evaluate_context &module() const noexcept { return mod_eval_; }
+    eval_step step() const noexcept { return step_; }
+    size_t stage() const noexcept { return stage_; }
+    bool record_output_buffers() const noexcept { return record_output_buffers_; }
 
     void evaluate(eval_step step, size_t stage, bool record_output_buffers);
 
 private:
     const schedule::function_schedule_result &sched_;
     module_evaluate_context &mod_eval_;
+    eval_step step_ = eval_step::after_import;
+    size_t stage_ = 0;
+    bool record_output_buffers_ = false;
     std::unique_ptr<std::byte[]> input_pool_;
     std::unique_ptr<std::byte[]> output_pool_;
 
@@ -110,6 +116,7 @@ public:
 
     function_evaluate_context &entrypoint();
     module_evaluate_context &module(const module_type_t &module_type);
+    std::byte *shared_memory_pool() const noexcept { return shared_memory_pool_.get(); }
 
     evaluate_tensor memory_at(const output_connector &conn)
     {
@@ -140,6 +147,7 @@ public:
 
 private:
     const schedule::model_schedule_result &sched_;
+    std::unique_ptr<std::byte[]> shared_memory_pool_;
     std::unordered_map<module_type_t, module_evaluate_context> module_ctxs_;
 };
 }
@@ -30,12 +30,27 @@ struct split_graph_result
     std::unordered_map<output_node *, std::vector<input_connector *>> outputs;
 };
 
+struct node_deleter
+{
+    // Nodes live in the graph arena, which reuses their storage for later nodes
+    void operator()(node *n) const noexcept
+    {
+        auto arena = n->arena_;
+        auto bytes = n->arena_bytes_;
+        n->~node();
+        if (bytes)
+            arena->deallocate(n, bytes);
+    }
+};
+
+using node_ptr = std::unique_ptr<node, node_deleter>;
+
 class NNCASE_API graph
 {
 public:
     graph() noexcept;
     explicit graph(const module_type_t &module_type) noexcept
-        : module_type_(module_type) { }
+        : arena_(std::make_shared<ir_arena>()), module_type_(module_type) { }
 
     graph(graph &) = delete;
     graph(graph &&) = delete;
@@ -46,13 +61,19 @@ public:
     const module_type_t &module_type() const noexcept { return module_type_; }
     void set_module_type(module_type_t type) { this->module_type_ = type; }
 
-    std::span<std::unique_ptr<node>> nodes() noexcept { return nodes_; }
+    std::span<node_ptr> nodes() noexcept { return nodes_; }
     std::span<input_node *> inputs() noexcept { return inputs_; }
     std::span<output_node *> outputs() noexcept { return outputs_; }
     std::span<std::unique_ptr<graph>> subgraphs() noexcept { return subgraphs_; }
     std::vector<graph *> reachable_graphs() noexcept;
 
-    std::span<std::unique_ptr<node> const> nodes() const noexcept { return nodes_; }
+    std::span<node_ptr const> nodes() const noexcept { return nodes_; }
+
+    /// Loop bodies and call targets, their callers bind inputs by position so unused ones are kept.
+    bool is_subgraph() const noexcept { return is_subgraph_; }
+
+    /// Upper bound of the ids of this graph's nodes, for sizing id-indexed vectors.
+    size_t node_id_bound() const noexcept { return arena_->node_id_bound(); }
     std::span<input_node *const> inputs() const noexcept { return inputs_; }
     std::span<output_node *const> outputs() const noexcept { return outputs_; }
     std::span<std::unique_ptr<graph> const> subgraphs() const noexcept { return subgraphs_; }
@@ -60,7 +81,11 @@ public:
     template <class T, class... TArgs>
     T *emplace(TArgs &&...args)
     {
-        auto node = static_cast<T *>(nodes_.emplace_back(new T(std::forward<TArgs>(args)...)).get());
+        ir_arena::scope arena_scope(*arena_);
+        auto node = arena_->construct<T>(std::forward<TArgs>(args)...);
+        node->id_ = arena_->next_node_id();
+        node->arena_bytes_ = sizeof(T);
+        nodes_.emplace_back(node);
         if constexpr (std::is_same_v<T, input_node>)
             inputs_.emplace_back(node);
         else if constexpr (std::is_same_v<T, output_node>)
@@ -76,9 +101,12 @@ public:
     graph &add_subgraph(std::unique_ptr<graph> subgraph);
 
 private:
+    // Declared first so nodes are destroyed before their storage, and shared with split subgraphs
+    std::shared_ptr<ir_arena> arena_;
     std::string name_;
     module_type_t module_type_;
-    std::vector<std::unique_ptr<node>> nodes_;
+    bool is_subgraph_ = false;
+    std::vector<node_ptr> nodes_;
     std::vector<std::unique_ptr<graph>> subgraphs_;
     std::vector<input_node *> inputs_;
     std::vector<output_node *> outputs_;
@@ -15,6 +15,8 @@
 #pragma once
 #include <nncase/runtime/datatypes.h>
 #include <span>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <xtensor/xshape.hpp>
 
@@ -46,6 +48,11 @@ enum connector_attributes
 DEFINE_ENUM_BITMASK_OPERATORS(node_attributes)
 DEFINE_ENUM_BITMASK_OPERATORS(connector_attributes)
 
+/// Return the pooled copy of a node or connector name, so the returned reference can be stored
+/// instead of a string. Names are pooled in the arena of the graph constructing a node on this
+/// thread and live as long as it, names of nodes built outside of a graph live until exit.
+NNCASE_API const std::string &intern_name(std::string_view name);
+
 template <class T, class = std::enable_if_t<std::is_pointer_v<T>>>
 std::vector<std::decay_t<T>> dup(std::span<T> source)
 {
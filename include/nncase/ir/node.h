@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "arena.h"
 #include "connectors.h"
 #include "opcode.h"
 #include <list>
@@ -21,6 +22,8 @@
 
 namespace nncase::ir
 {
+struct node_deleter;
+
 #define DEFINE_NODE_OPCODE(value)                                    \
     static constexpr node_opcode opcode() noexcept { return value; } \
     const node_opcode &runtime_opcode() const noexcept override { return value; }
@@ -33,11 +36,20 @@ public:
     node &operator=(node &) = delete;
     virtual ~node();
 
-    const std::string &name() const noexcept { return name_; }
+    const std::string &name() const noexcept { return *name_; }
     template <class TArg, class... TArgs>
-    void name(TArg arg, TArgs... args) { name_.assign(std::forward<TArg>(arg), std::forward<TArgs>(args)...); }
+    void name(TArg &&arg, TArgs &&...args)
+    {
+        if constexpr (sizeof...(TArgs) == 0 && std::is_convertible_v<TArg, std::string_view>)
+            name_ = &intern(std::forward<TArg>(arg));
+        else
+            name_ = &intern(std::string(std::forward<TArg>(arg), std::forward<TArgs>(args)...));
+    }
     std::string escaped_name() const noexcept;
 
+    /// Dense id assigned by the owning graph, usable as an index into per-graph vectors.
+    size_t id() const noexcept { return id_; }
+
     const module_type_t &module_type() const noexcept { return module_type_; }
     void module_type(const module_type_t &type) noexcept { module_type_ = type; }
 
@@ -56,14 +68,14 @@ public:
     void record_output_connectors_quant_map(output_connector &oc_after_quant, output_connector &oc_before_quant) noexcept { output_connectors_quant_map_.emplace(&oc_after_quant, &oc_before_quant); }
     std::unordered_map<output_connector *, output_connector *> get_output_connectors_quant_map() const noexcept { return output_connectors_quant_map_; }
 
-    void record_node_name_before_quant(std::string name) noexcept { node_name_before_quant_.assign(name); }
-    std::string get_node_name_before_quant() const noexcept { return node_name_before_quant_; }
+    void record_node_name_before_quant(std::string_view name) { node_name_before_quant_ = &intern(name); }
+    const std::string &get_node_name_before_quant() const noexcept { return *node_name_before_quant_; }
 
 protected:
     template <class TName, class TShape>
     input_connector &add_input(TName &&name, datatype_t type, TShape &&shape)
     {
-        auto ptr = input_connectors_storage_.emplace_back(std::make_unique<input_connector>(*this, std::forward<TName>(name), type, std::forward<TShape>(shape))).get();
+        auto ptr = new_connector<input_connector>(*this, std::forward<TName>(name), type, std::forward<TShape>(shape));
         input_connectors_.emplace_back(ptr);
         return *ptr;
     }
@@ -71,7 +83,7 @@ protected:
     template <class TName, class TShape>
     output_connector &add_output(TName &&name, datatype_t type, TShape &&shape, memory_location_t memory_location = mem_data)
     {
-        auto ptr = output_connectors_storage_.emplace_back(std::make_unique<output_connector>(*this, std::forward<TName>(name), type, std::forward<TShape>(shape), memory_location)).get();
+        auto ptr = new_connector<output_connector>(*this, std::forward<TName>(name), type, std::forward<TShape>(shape), memory_location);
         output_connectors_.emplace_back(ptr);
         return *ptr;
     }
@@ -79,14 +91,35 @@ protected:
     virtual bool properties_equal(node &other) const = 0;
 
 private:
-    std::string name_;
+    // Renamed nodes keep pooling their names in the arena of their graph
+    const std::string &intern(std::string_view name)
+    {
+        return arena_ ? arena_->intern(name) : intern_name(name);
+    }
+
+    template <class T, class... TArgs>
+    T *new_connector(TArgs &&...args)
+    {
+        // Connectors share the arena of the graph constructing this node
+        if (arena_)
+            return arena_->construct<T>(std::forward<TArgs>(args)...);
+        return new T(std::forward<TArgs>(args)...);
+    }
+
+    friend class graph;
+    friend struct node_deleter;
+
+private:
+    size_t id_ = 0;
+    ir_arena *arena_;
+    // Size of the storage allocated by the graph for this node, 0 if it wasn't
+    size_t arena_bytes_ = 0;
+    const std::string *name_;
     module_type_t module_type_;
     node_attributes attributes_ = node_attributes::node_attr_action;
     std::vector<input_connector *> input_connectors_;
     std::vector<output_connector *> output_connectors_;
-    std::vector<std::unique_ptr<input_connector>> input_connectors_storage_;
-    std::vector<std::unique_ptr<output_connector>> output_connectors_storage_;
     std::unordered_map<output_connector *, output_connector *> output_connectors_quant_map_;
-    std::string node_name_before_quant_;
+    const std::string *node_name_before_quant_;
 };
 }
@@ -77,14 +77,19 @@ public:
     {
     }
 
+    /// Takes the data over instead of copying it
+    template <class TShape>
+    constant(datatype_t type, TShape &&shape, std::vector<std::byte> &&data)
+        : data_(std::move(data)), datatype_(type)
+    {
+        add_data_output(type, std::forward<TShape>(shape));
+    }
+
     template <class TShape, class... TDataArgs>
     constant(datatype_t type, TShape &&shape, TDataArgs... data_args)
         : data_(std::forward<TDataArgs>(data_args)...), datatype_(type)
     {
-        if (ir::get_bytes(type, shape) != data_.size())
-            throw std::invalid_argument("Shape and data size don't match");
-        add_output("output", type, std::forward<TShape>(shape), mem_rdata)
-            .attributes(cnctr_attr_no_layout_strides);
+        add_data_output(type, std::forward<TShape>(shape));
     }
 
     template <class TScalar>
@@ -133,6 +138,16 @@ public:
 protected:
     bool properties_equal(node &other) const override;
 
+private:
+    template <class TShape>
+    void add_data_output(datatype_t type, TShape &&shape)
+    {
+        if (ir::get_bytes(type, shape) != data_.size())
+            throw std::invalid_argument("Shape and data size don't match");
+        add_output("output", type, std::forward<TShape>(shape), mem_rdata)
+            .attributes(cnctr_attr_no_layout_strides);
+    }
+
 private:
     std::vector<std::byte> data_;
     datatype_t datatype_;
@@ -28,6 +28,7 @@ public:
     input_connector &input() { return input_at(0); }
     input_connector &weights() { return input_at(1); }
     input_connector &bias() { return input_at(2); }
+    input_connector &activation_table() { return input_at(3); }
     output_connector &output() { return output_at(0); }
 
     int32_t filter_h() const noexcept { return (int32_t)weights().shape()[2]; }
@@ -42,8 +43,12 @@ public:
     int32_t dilation_h() const noexcept { return dilation_h_; }
     int32_t dilation_w() const noexcept { return dilation_w_; }
     value_range<float> fused_activation() const noexcept { return fused_activation_; }
+    bool has_activation_table() const noexcept { return has_activation_table_; }
+    const quant_param_t &activation_param() const noexcept { return activation_param_; }
 
     conv2d(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation);
+    /// Adds a 256-entry float activation_table input, indexed by the clamped output quantized to uint8 with activation_param
+    conv2d(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, quant_param_t activation_param);
 
 protected:
     bool properties_equal(node &other) const override;
@@ -57,5 +62,7 @@ private:
     int32_t dilation_h_;
     int32_t dilation_w_;
     value_range<float> fused_activation_;
+    bool has_activation_table_;
+    quant_param_t activation_param_;
 };
 }
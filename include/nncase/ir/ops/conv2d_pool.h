@@ -0,0 +1,89 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../node.h"
+
+namespace nncase::ir
+{
+/// conv2d whose output is reduced by a 2D pooling window before it is stored
+class NNCASE_API conv2d_pool : public node
+{
+public:
+    DEFINE_NODE_OPCODE(op_conv2d_pool);
+
+    const input_connector &weights() const { return input_at(1); }
+
+    input_connector &input() { return input_at(0); }
+    input_connector &weights() { return input_at(1); }
+    input_connector &bias() { return input_at(2); }
+    input_connector &activation_table() { return input_at(3); }
+    output_connector &output() { return output_at(0); }
+
+    int32_t filter_h() const noexcept { return (int32_t)weights().shape()[2]; }
+    int32_t filter_w() const noexcept { return (int32_t)weights().shape()[3]; }
+    int32_t output_channels() const noexcept { return (int32_t)weights().shape()[0]; }
+    int32_t groups() const noexcept { return groups_; }
+    padding padding_h() const noexcept { return padding_h_; }
+    padding padding_w() const noexcept { return padding_w_; }
+    int32_t stride_h() const noexcept { return stride_h_; }
+    int32_t stride_w() const noexcept { return stride_w_; }
+    int32_t dilation_h() const noexcept { return dilation_h_; }
+    int32_t dilation_w() const noexcept { return dilation_w_; }
+    value_range<float> fused_activation() const noexcept { return fused_activation_; }
+    bool has_activation_table() const noexcept { return has_activation_table_; }
+    const quant_param_t &activation_param() const noexcept { return activation_param_; }
+    reduce_op_t pool_op() const noexcept { return pool_op_; }
+    float pool_init_value() const noexcept { return pool_init_value_; }
+    int32_t pool_filter_h() const noexcept { return pool_filter_h_; }
+    int32_t pool_filter_w() const noexcept { return pool_filter_w_; }
+    padding pool_padding_h() const noexcept { return pool_padding_h_; }
+    padding pool_padding_w() const noexcept { return pool_padding_w_; }
+    int32_t pool_stride_h() const noexcept { return pool_stride_h_; }
+    int32_t pool_stride_w() const noexcept { return pool_stride_w_; }
+    value_range<float> pool_activation() const noexcept { return pool_activation_; }
+
+    conv2d_pool(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w,
+        int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, reduce_op_t pool_op, float pool_init_value, int32_t pool_filter_h,
+        int32_t pool_filter_w, padding pool_padding_h, padding pool_padding_w, int32_t pool_stride_h, int32_t pool_stride_w, value_range<float> pool_activation);
+    /// Adds a 256-entry float activation_table input applied to the conv output before pooling, see conv2d
+    conv2d_pool(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w,
+        int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, quant_param_t activation_param, reduce_op_t pool_op, float pool_init_value,
+        int32_t pool_filter_h, int32_t pool_filter_w, padding pool_padding_h, padding pool_padding_w, int32_t pool_stride_h, int32_t pool_stride_w, value_range<float> pool_activation);
+
+protected:
+    bool properties_equal(node &other) const override;
+
+private:
+    int32_t groups_;
+    padding padding_h_;
+    padding padding_w_;
+    int32_t stride_h_;
+    int32_t stride_w_;
+    int32_t dilation_h_;
+    int32_t dilation_w_;
+    value_range<float> fused_activation_;
+    bool has_activation_table_;
+    quant_param_t activation_param_;
+    reduce_op_t pool_op_;
+    float pool_init_value_;
+    int32_t pool_filter_h_;
+    int32_t pool_filter_w_;
+    padding pool_padding_h_;
+    padding pool_padding_w_;
+    int32_t pool_stride_h_;
+    int32_t pool_stride_w_;
+    value_range<float> pool_activation_;
+};
+}
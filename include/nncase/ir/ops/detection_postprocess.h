@@ -0,0 +1,46 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../node.h"
+
+namespace nncase::ir
+{
+class NNCASE_API detection_postprocess : public node
+{
+public:
+    DEFINE_NODE_OPCODE(op_detection_postprocess);
+
+    input_connector &boxes() { return input_at(0); }
+    input_connector &scores() { return input_at(1); }
+    output_connector &output() { return output_at(0); }
+
+    bool center_point_box() const noexcept { return center_point_box_; }
+    int32_t max_output_boxes_per_class() const noexcept { return max_output_boxes_per_class_; }
+    float iou_threshold() const noexcept { return iou_threshold_; }
+    float score_threshold() const noexcept { return score_threshold_; }
+
+    detection_postprocess(datatype_t input_type, shape_t boxes_shape, shape_t scores_shape, bool center_point_box,
+        int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold);
+
+protected:
+    bool properties_equal(node &other) const override;
+
+private:
+    bool center_point_box_;
+    int32_t max_output_boxes_per_class_;
+    float iou_threshold_;
+    float score_threshold_;
+};
+}
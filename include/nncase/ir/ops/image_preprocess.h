@@ -0,0 +1,54 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../node.h"
+
+namespace nncase::ir
+{
+/// Dequantize, layout change, swapRB, letterbox (bilinear resize + pad) and normalization of a model input image in one pass
+class NNCASE_API image_preprocess : public node
+{
+public:
+    DEFINE_NODE_OPCODE(op_image_preprocess);
+
+    input_connector &input() { return input_at(0); }
+    input_connector &mean() { return input_at(1); }
+    input_connector &stddev() { return input_at(2); }
+    output_connector &output() { return output_at(0); }
+
+    const quant_param_t &input_param() const noexcept { return input_param_; }
+    bool input_nhwc() const noexcept { return input_nhwc_; }
+    bool swap_rb() const noexcept { return swap_rb_; }
+    const std::array<int32_t, 2> &resize_shape() const noexcept { return resize_shape_; }
+    const std::array<padding, 2> &paddings() const noexcept { return paddings_; }
+    float pad_value() const noexcept { return pad_value_; }
+    bool output_nhwc() const noexcept { return output_nhwc_; }
+
+    image_preprocess(datatype_t input_type, shape_t input_shape, quant_param_t input_param, bool input_nhwc, bool swap_rb,
+        std::array<int32_t, 2> resize_shape, std::array<padding, 2> paddings, float pad_value, bool output_nhwc);
+
+protected:
+    bool properties_equal(node &other) const override;
+
+private:
+    quant_param_t input_param_;
+    bool input_nhwc_;
+    bool swap_rb_;
+    std::array<int32_t, 2> resize_shape_;
+    std::array<padding, 2> paddings_;
+    float pad_value_;
+    bool output_nhwc_;
+};
+}
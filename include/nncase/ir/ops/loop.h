@@ -0,0 +1,57 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../graph.h"
+
+namespace nncase::ir
+{
+// Runs body trip_count times without unrolling it.
+// Inputs:  [initial states][scan inputs][invariants][carries]
+// Outputs: [final states][scan outputs]
+// Body inputs are [states][scan slices][invariants], body outputs are [next states][scan output slices].
+// Scans are iterated along axis 0. Carries are scratch buffers shaped like the states, they hold
+// one side of the ping-pong state buffers between iterations.
+class NNCASE_API loop : public node
+{
+public:
+    DEFINE_NODE_OPCODE(op_loop);
+
+    graph &body() const noexcept { return body_; }
+    size_t num_states() const noexcept { return num_states_; }
+    size_t num_scan_inputs() const noexcept { return num_scan_inputs_; }
+    size_t num_invariants() const noexcept { return num_invariants_; }
+    size_t num_scan_outputs() const noexcept { return outputs().size() - num_states_; }
+    size_t trip_count() const noexcept { return trip_count_; }
+
+    input_connector &initial_state(size_t index) { return input_at(index); }
+    input_connector &scan_input(size_t index) { return input_at(num_states_ + index); }
+    input_connector &invariant(size_t index) { return input_at(num_states_ + num_scan_inputs_ + index); }
+    input_connector &carry(size_t index) { return input_at(num_states_ + num_scan_inputs_ + num_invariants_ + index); }
+    output_connector &final_state(size_t index) { return output_at(index); }
+    output_connector &scan_output(size_t index) { return output_at(num_states_ + index); }
+
+    loop(graph &body, size_t num_states, size_t num_scan_inputs, size_t trip_count);
+
+protected:
+    bool properties_equal(node &other) const override;
+
+private:
+    graph &body_;
+    size_t num_states_;
+    size_t num_scan_inputs_;
+    size_t num_invariants_;
+    size_t trip_count_;
+};
+}
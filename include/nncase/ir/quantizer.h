@@ -120,6 +120,7 @@ public:
     void record(ir::output_connector &connector, value_range<float> range);
     void set(ir::output_connector &connector, value_range<float> range);
     bool has_record(ir::output_connector &connector) const;
+    bool has_range(ir::output_connector &connector) const;
     void record(ir::output_connector &connector, std::span<const float> data);
     void record(ir::output_connector &connector, std::span<const bfloat16> data);
     void record(ir::output_connector &connector, std::span<const half> data);
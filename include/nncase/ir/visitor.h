@@ -34,7 +34,8 @@ protected:
     virtual bool visit(node &node);
 
 private:
-    std::unordered_set<node *> visited_;
+    // Indexed by node id
+    std::vector<bool> visited_;
 };
 
 class NNCASE_API dfs_ir_pre_order_visitor : public ir_visitor
@@ -23,6 +23,15 @@ BEGIN_NS_NNCASE_KERNELS
 NNCASE_API result<void> conv2d(const float *input, const float *weights, const float *bias, float *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
-    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut, kernel_context &context = default_kernel_context()) noexcept;
+
+/// conv2d followed by a 2D pooling (dilation 1) over its output. The conv output is produced a band of rows
+/// at a time into a small scratch buffer and pooled from there, so it never goes through memory at full resolution.
+NNCASE_API result<void> conv2d_pool(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut,
+    reduce_op_t pool_op, float pool_init_value, int32_t pool_filter_h, int32_t pool_filter_w, const padding &pool_padding_h, const padding &pool_padding_w,
+    int32_t pool_stride_h, int32_t pool_stride_w, value_range<float> pool_activation, kernel_context &context = default_kernel_context()) noexcept;
 
 END_NS_NNCASE_KERNELS
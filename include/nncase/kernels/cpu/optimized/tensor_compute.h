@@ -37,7 +37,8 @@ NNCASE_API result<void> copy(datatype_t type, const gsl::byte *src, gsl::byte *d
 NNCASE_API result<void> conv2d(const float *input, const float *weights, const float *bias, float *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
-    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept;
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut,
+    kernel_context &context) noexcept;
 
 NNCASE_API result<void> dequantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
@@ -54,6 +55,11 @@ NNCASE_API result<void> gather_nd(datatype_t type, const gsl::byte *input, gsl::
 NNCASE_API result<void> onehot(datatype_t type, const int32_t *indices, gsl::byte *output, const runtime_shape_t &indices_shape, const runtime_shape_t &out_shape,
     const runtime_shape_t &out_strides, gsl::byte *depth, gsl::byte *off_value, gsl::byte *on_value, size_t axis, onehot_mode_t mode, kernel_context &context) noexcept;
 
+template <typename T>
+NNCASE_API result<void> quantized_binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_b_shape, quant_param_t in_a_param, quant_param_t in_b_param,
+    quant_param_t out_param, value_range<float> fused_activation, kernel_context &context) noexcept;
+
 NNCASE_API result<void> quantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept;
@@ -62,4 +68,27 @@ NNCASE_API result<void> slice(datatype_t type, const gsl::byte *input, gsl::byte
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const runtime_shape_t &begins, const runtime_axis_t &ends, const runtime_axis_t &strides,
     kernel_context &context = default_kernel_context()) noexcept;
 
+template <typename T>
+NNCASE_API result<void> topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, int64_t k, int32_t axis, bool largest, bool sorted,
+    kernel_context &context = default_kernel_context()) noexcept;
+
+template <typename T>
+NNCASE_API result<void> detection_postprocess(const T *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const T *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold,
+    kernel_context &context = default_kernel_context()) noexcept;
+
+template <typename T>
+NNCASE_API result<void> image_preprocess(const T *input, const float *mean, const float *stddev, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &out_shape,
+    quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left, float pad_value,
+    bool output_nhwc, kernel_context &context = default_kernel_context()) noexcept;
+
+template <typename T>
+NNCASE_API result<void> random_normal(T *output, const runtime_shape_t &out_shape, float mean, float std, float seed, kernel_context &context) noexcept;
+
+template <typename T>
+NNCASE_API result<void> random_uniform(T *output, const runtime_shape_t &out_shape, float low, float high, float seed, kernel_context &context) noexcept;
+
 END_NS_NNCASE_KERNELS_CPU_OPT
@@ -14,9 +14,11 @@
  */
 #pragma once
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <nncase/runtime/datatypes.h>
 #include <numeric>
 
@@ -249,6 +251,88 @@ constexpr T quantize(float value, const quant_param_t &param) noexcept
     return (T)clamp((int32_t)lrintf(value / param.scale + param.zero_point), (int32_t)std::numeric_limits<T>::lowest(), (int32_t)std::numeric_limits<T>::max());
 }
 
+template <class T>
+constexpr float dequantize(T value, const quant_param_t &param) noexcept
+{
+    return ((int32_t)value - param.zero_point) * param.scale;
+}
+
+inline float apply_activation(float value, value_range<float> activation, const activation_lut &lut) noexcept
+{
+    value = clamp(value, activation.min, activation.max);
+    return lut.empty() ? value : lut.table[quantize<uint8_t>(value, lut.param)];
+}
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+// Every 4-element block of a random tensor only depends on its index and the seed.
+using philox_block = std::array<uint32_t, 4>;
+using philox_key = std::array<uint32_t, 2>;
+
+inline philox_block philox4x32(philox_block counter, philox_key key) noexcept
+{
+    constexpr uint32_t m0 = 0xD2511F53, m1 = 0xCD9E8D57;
+    constexpr uint32_t w0 = 0x9E3779B9, w1 = 0xBB67AE85;
+    for (int32_t round = 0; round < 10; round++)
+    {
+        const auto p0 = (uint64_t)m0 * counter[0];
+        const auto p1 = (uint64_t)m1 * counter[2];
+        counter = { (uint32_t)(p1 >> 32) ^ counter[1] ^ key[0], (uint32_t)p1, (uint32_t)(p0 >> 32) ^ counter[3] ^ key[1], (uint32_t)p0 };
+        key[0] += w0;
+        key[1] += w1;
+    }
+
+    return counter;
+}
+
+inline philox_key get_philox_key(float seed) noexcept
+{
+    uint32_t bits;
+    std::memcpy(&bits, &seed, sizeof(bits));
+    return { bits, 0x2545F491 };
+}
+
+inline philox_block philox4x32(uint64_t block, philox_key key) noexcept
+{
+    return philox4x32(philox_block { (uint32_t)block, (uint32_t)(block >> 32), 0, 0 }, key);
+}
+
+// Top 24 bits mapped to [0, 1)
+inline float to_unit_float(uint32_t value) noexcept
+{
+    return (value >> 8) * (1.f / 16777216.f);
+}
+
+template <class T>
+void random_uniform_block(T *output, size_t count, const philox_block &bits, float low, float high) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+        output[i] = (T)(low + to_unit_float(bits[i]) * (high - low));
+}
+
+template <class T>
+void random_normal_block(T *output, size_t count, const philox_block &bits, float mean, float stddev) noexcept
+{
+    // Box-Muller on (0, 1] x [0, 1), two normals per pair of words
+    constexpr float two_pi = 6.283185307179586f;
+    for (size_t i = 0; i < count; i += 2)
+    {
+        const auto r = std::sqrt(-2.f * std::log(1.f - to_unit_float(bits[i])));
+        const auto theta = two_pi * to_unit_float(bits[i + 1]);
+        output[i] = (T)(mean + stddev * r * std::cos(theta));
+        if (i + 1 < count)
+            output[i + 1] = (T)(mean + stddev * r * std::sin(theta));
+    }
+}
+
+template <class T>
+inline T round_cast(float value) noexcept
+{
+    if constexpr (std::numeric_limits<T>::is_integer)
+        return (T)std::floor(value + .5f);
+    else
+        return (T)value;
+}
+
 inline std::pair<float, float> get_resize_scales(const runtime_shape_t &in_shape, int32_t out_h, int32_t out_w, bool align_corners)
 {
     auto height_scale = (float)in_shape[2] / out_h;
@@ -44,6 +44,12 @@ NNCASE_API result<void> binary(binary_op_t op, const float *input_a, const float
     const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
     const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
 
+template <typename T>
+NNCASE_API result<void> quantized_binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, quant_param_t in_a_param, quant_param_t in_b_param,
+    quant_param_t out_param, value_range<float> fused_activation, kernel_context &context = default_kernel_context()) noexcept;
+
 NNCASE_API result<void> dequantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context = default_kernel_context()) noexcept;
@@ -106,10 +112,30 @@ NNCASE_API result<void> hardmax(const T *input, const runtime_shape_t &in_shape,
     T *output, int32_t axis) noexcept;
 
 template <typename T>
-NNCASE_API result<void> random_normal(T *output, const runtime_shape_t &out_shape, float mean, float std, float seed) noexcept;
+NNCASE_API result<void> detection_postprocess(const T *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const T *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold,
+    kernel_context &context = default_kernel_context()) noexcept;
+
+template <typename T>
+NNCASE_API result<void> topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &output_values_strides, const runtime_shape_t &output_indices_strides,
+    int64_t k, int32_t axis, bool largest, bool sorted, kernel_context &context = default_kernel_context()) noexcept;
 
 template <typename T>
-NNCASE_API result<void> random_uniform(T *output, const runtime_shape_t &out_shape, float low, float high, float seed) noexcept;
+NNCASE_API result<void> image_preprocess(const T *input, const float *mean, const float *stddev, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left, float pad_value,
+    bool output_nhwc, kernel_context &context = default_kernel_context()) noexcept;
+
+template <typename T>
+NNCASE_API result<void> random_normal(T *output, const runtime_shape_t &out_shape, float mean, float std, float seed,
+    kernel_context &context = default_kernel_context()) noexcept;
+
+template <typename T>
+NNCASE_API result<void> random_uniform(T *output, const runtime_shape_t &out_shape, float low, float high, float seed,
+    kernel_context &context = default_kernel_context()) noexcept;
 
 template <typename T>
 NNCASE_API result<void> ternary(const float *input_a, const T *input_b, const T *input_c, T *output,
@@ -0,0 +1,64 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nncase
+{
+// Run func(0) ... func(count - 1) on up to num_threads threads (hardware concurrency by default),
+// the caller's thread being one of them. Indices are handed out in order as threads become free.
+// The first exception thrown is rethrown once all threads finished.
+template <class TFunc>
+void parallel_for(size_t count, TFunc &&func, size_t num_threads = 0)
+{
+    if (!num_threads)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = std::min(num_threads, count);
+
+    std::atomic<size_t> next = 0;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&] {
+        try
+        {
+            for (size_t i = next++; i < count; i = next++)
+                func(i);
+        }
+        catch (...)
+        {
+            std::lock_guard lock(error_mutex);
+            if (!error)
+                error = std::current_exception();
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < num_threads; i++)
+        workers.emplace_back(worker);
+    if (num_threads)
+        worker();
+    for (auto &thread : workers)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+}
@@ -358,6 +358,17 @@ struct fixed_mul
     int32_t rounded_mul() const noexcept { return (int32_t)lrintf(mul); }
 };
 
+// 256-entry table fused after an op's clamp, indexed by the result quantized to uint8 with param
+struct activation_lut
+{
+    const float *table;
+    quant_param_t param;
+
+    bool empty() const noexcept { return table == nullptr; }
+
+    static activation_lut none() noexcept { return { nullptr, { 0, 1.f } }; }
+};
+
 using memory_location_t = uint8_t;
 NNCASE_INLINE_VAR constexpr memory_location_t mem_input = 0;
 NNCASE_INLINE_VAR constexpr memory_location_t mem_output = 1;
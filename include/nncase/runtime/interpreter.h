@@ -68,14 +68,27 @@ public:
     result<void> output_tensor(size_t index, runtime_tensor tensor) noexcept;
 
     result<void> run() noexcept;
+    /** Only compute the given outputs, others are left unwritten. Models with more than 32 outputs compute all of them */
+    result<void> run(gsl::span<const size_t> outputs) noexcept;
 
     result<runtime_module *> find_module_by_id(size_t index) noexcept;
     options_dict &options() noexcept;
+    gsl::span<gsl::byte> shared_data() const noexcept;
+
+    /** Threads used by the kernels of this interpreter, 0 uses the process default */
+    uint32_t num_threads() const noexcept { return num_threads_; }
+    void num_threads(uint32_t value) noexcept { num_threads_ = value; }
+
+private:
+    result<void> initialize_shared_data() noexcept;
 
 private:
     std::vector<std::unique_ptr<runtime_module>> modules_;
+    std::unique_ptr<gsl::byte[]> shared_data_;
+    size_t shared_data_size_;
     runtime_function *entry_function_;
     options_dict options_;
+    uint32_t num_threads_;
 };
 
 END_NS_NNCASE_RUNTIME
@@ -107,6 +107,6 @@ struct shape_header
 };
 
 NNCASE_INLINE_VAR constexpr uint32_t MODEL_IDENTIFIER = 'KMDL';
-NNCASE_INLINE_VAR constexpr uint32_t MODEL_VERSION = 5;
+NNCASE_INLINE_VAR constexpr uint32_t MODEL_VERSION = 6;
 
 END_NS_NNCASE_RUNTIME
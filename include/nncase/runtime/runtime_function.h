@@ -65,6 +65,11 @@ public:
     result<void> output_tensor(size_t index, runtime_tensor tensor) noexcept;
 
     result<void> invoke() noexcept;
+    result<void> invoke(gsl::span<const runtime_tensor> inputs, gsl::span<const runtime_tensor> outputs) noexcept;
+
+    /** Bit i requests output i, outputs that are not requested may be left unwritten */
+    uint32_t output_mask() const noexcept { return output_mask_; }
+    void output_mask(uint32_t mask) noexcept { output_mask_ = mask; }
 
 protected:
     virtual result<void> initialize_core(runtime_function_init_context &context) noexcept = 0;
@@ -81,6 +86,7 @@ private:
     std::vector<inout_tensor_info> input_tensors_;
     std::vector<inout_tensor_info> output_tensors_;
     runtime_module &rt_module_;
+    uint32_t output_mask_ = ~uint32_t(0);
 };
 
 END_NS_NNCASE_RUNTIME
@@ -48,6 +48,8 @@ public:
     uint32_t mempools_size() const noexcept;
     const mempool_desc &mempool(size_t index) const noexcept;
     mempool_desc mempool(memory_location_t location) const noexcept;
+    mempool_desc shared_mempool(memory_location_t location) const noexcept;
+    gsl::span<gsl::byte> shared_data() const noexcept;
 
     result<runtime_function *> find_function_by_id(size_t index) noexcept;
 
@@ -1171,6 +1171,9 @@ struct op_reader<tensor_conv2d_op_t>
         op.dilation_w = reader.read_unaligned<uint16_t>();
         op.fused_clamp_low = reader.read_unaligned<float>();
         op.fused_clamp_high = reader.read_unaligned<float>();
+        op.fused_lut = reader.read_unaligned<bool>();
+        op.fused_lut_zero_point = reader.read_unaligned<int32_t>();
+        op.fused_lut_scale = reader.read_unaligned<float>();
         return op;
     }
 };
@@ -1574,6 +1577,158 @@ struct op_reader<tensor_transpose_op_t>
     }
 };
 
+template <>
+struct op_reader<tensor_detection_postprocess_op_t>
+{
+    tensor_detection_postprocess_op_t operator()(span_reader &reader) const
+    {
+        tensor_detection_postprocess_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_boxes = reader.read_unaligned<uint8_t>();
+        op.rstride_boxes = reader.read_unaligned<uint8_t>();
+        op.rshape_scores = reader.read_unaligned<uint8_t>();
+        op.rstride_scores = reader.read_unaligned<uint8_t>();
+        op.center_point_box = reader.read_unaligned<bool>();
+        op.max_output_boxes_per_class = reader.read_unaligned<int32_t>();
+        op.iou_threshold = reader.read_unaligned<float>();
+        op.score_threshold = reader.read_unaligned<float>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_topk_op_t>
+{
+    tensor_topk_op_t operator()(span_reader &reader) const
+    {
+        tensor_topk_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src = reader.read_unaligned<uint8_t>();
+        op.rstride_src = reader.read_unaligned<uint8_t>();
+        op.rstride_values = reader.read_unaligned<uint8_t>();
+        op.rstride_indices = reader.read_unaligned<uint8_t>();
+        op.axis = reader.read_unaligned<int32_t>();
+        op.k = reader.read_unaligned<int32_t>();
+        op.largest = reader.read_unaligned<bool>();
+        op.sorted = reader.read_unaligned<bool>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_loop_op_t>
+{
+    tensor_loop_op_t operator()(span_reader &reader) const
+    {
+        tensor_loop_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.function_id = reader.read_unaligned<uint32_t>();
+        op.module_id = reader.read_unaligned<uint16_t>();
+        op.num_src = reader.read_unaligned<uint8_t>();
+        op.num_dst = reader.read_unaligned<uint8_t>();
+        op.num_states = reader.read_unaligned<uint8_t>();
+        op.num_scan_inputs = reader.read_unaligned<uint8_t>();
+        op.trip_count = reader.read_unaligned<uint32_t>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_image_preprocess_op_t>
+{
+    tensor_image_preprocess_op_t operator()(span_reader &reader) const
+    {
+        tensor_image_preprocess_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src = reader.read_unaligned<uint8_t>();
+        op.rstride_src = reader.read_unaligned<uint8_t>();
+        op.rshape_dest = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.zero_point = reader.read_unaligned<int32_t>();
+        op.scale = reader.read_unaligned<float>();
+        op.input_nhwc = reader.read_unaligned<bool>();
+        op.swap_rb = reader.read_unaligned<bool>();
+        op.resize_h = reader.read_unaligned<int32_t>();
+        op.resize_w = reader.read_unaligned<int32_t>();
+        op.pad_top = reader.read_unaligned<int32_t>();
+        op.pad_left = reader.read_unaligned<int32_t>();
+        op.pad_value = reader.read_unaligned<float>();
+        op.output_nhwc = reader.read_unaligned<bool>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_quantized_binary_op_t>
+{
+    tensor_quantized_binary_op_t operator()(span_reader &reader) const
+    {
+        tensor_quantized_binary_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.binary_op = static_cast<binary_op_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src1 = reader.read_unaligned<uint8_t>();
+        op.rstride_src1 = reader.read_unaligned<uint8_t>();
+        op.rshape_src2 = reader.read_unaligned<uint8_t>();
+        op.rstride_src2 = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.in_a_zero_point = reader.read_unaligned<int32_t>();
+        op.in_a_scale = reader.read_unaligned<float>();
+        op.in_b_zero_point = reader.read_unaligned<int32_t>();
+        op.in_b_scale = reader.read_unaligned<float>();
+        op.out_zero_point = reader.read_unaligned<int32_t>();
+        op.out_scale = reader.read_unaligned<float>();
+        op.fused_clamp_low = reader.read_unaligned<float>();
+        op.fused_clamp_high = reader.read_unaligned<float>();
+        return op;
+    }
+};
+
+template <>
+struct op_reader<tensor_conv2d_pool_op_t>
+{
+    tensor_conv2d_pool_op_t operator()(span_reader &reader) const
+    {
+        tensor_conv2d_pool_op_t op(default_init);
+        op.opcode = static_cast<opcode_t>(reader.read_unaligned<uint8_t>());
+        op.funct = static_cast<tensor_function_t>(reader.read_unaligned<uint16_t>());
+        op.datatype = static_cast<datatype_t>(reader.read_unaligned<uint8_t>());
+        op.rshape_src = reader.read_unaligned<uint8_t>();
+        op.rstride_src = reader.read_unaligned<uint8_t>();
+        op.rshape_kernel = reader.read_unaligned<uint8_t>();
+        op.rstride_kernel = reader.read_unaligned<uint8_t>();
+        op.rstride_bias = reader.read_unaligned<uint8_t>();
+        op.rstride_dest = reader.read_unaligned<uint8_t>();
+        op.groups = reader.read_unaligned<uint16_t>();
+        op.stride_h = reader.read_unaligned<uint16_t>();
+        op.stride_w = reader.read_unaligned<uint16_t>();
+        op.dilation_h = reader.read_unaligned<uint16_t>();
+        op.dilation_w = reader.read_unaligned<uint16_t>();
+        op.fused_clamp_low = reader.read_unaligned<float>();
+        op.fused_clamp_high = reader.read_unaligned<float>();
+        op.fused_lut = reader.read_unaligned<bool>();
+        op.fused_lut_zero_point = reader.read_unaligned<int32_t>();
+        op.fused_lut_scale = reader.read_unaligned<float>();
+        op.pool_op = static_cast<reduce_op_t>(reader.read_unaligned<uint8_t>());
+        op.pool_init_value = reader.read_unaligned<float>();
+        op.pool_filter_h = reader.read_unaligned<uint16_t>();
+        op.pool_filter_w = reader.read_unaligned<uint16_t>();
+        op.pool_stride_h = reader.read_unaligned<uint16_t>();
+        op.pool_stride_w = reader.read_unaligned<uint16_t>();
+        op.pool_clamp_low = reader.read_unaligned<float>();
+        op.pool_clamp_high = reader.read_unaligned<float>();
+        return op;
+    }
+};
+
 class NNCASE_API op_visitor
 {
 public:
@@ -1707,6 +1862,12 @@ public:
     virtual result<void> visit(NNCASE_UNUSED const tensor_ternary_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_unary_op_t &op) noexcept { return ok(); }
     virtual result<void> visit(NNCASE_UNUSED const tensor_transpose_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_detection_postprocess_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_topk_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_loop_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_image_preprocess_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_quantized_binary_op_t &op) noexcept { return ok(); }
+    virtual result<void> visit(NNCASE_UNUSED const tensor_conv2d_pool_op_t &op) noexcept { return ok(); }
 
 protected:
     bool interrupted_;
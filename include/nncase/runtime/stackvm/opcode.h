@@ -156,6 +156,12 @@ enum class tensor_function_t
     TERNARY = 0x001F,
     TRANSPOSE = 0x0020,
     UNARY = 0x0021,
+    DETECTION_POSTPROCESS = 0x0022,
+    TOPK = 0x0023,
+    LOOP = 0x0024,
+    IMAGE_PREPROCESS = 0x0025,
+    QUANTIZED_BINARY = 0x0026,
+    CONV2D_POOL = 0x0027,
 };
 
 // Instructions
@@ -1302,10 +1308,13 @@ struct tensor_conv2d_op_t
     uint16_t dilation_w;
     float fused_clamp_low;
     float fused_clamp_high;
+    bool fused_lut;
+    int32_t fused_lut_zero_point;
+    float fused_lut_scale;
 
     tensor_conv2d_op_t(default_init_t) noexcept { }
-    explicit tensor_conv2d_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high) noexcept
-        : opcode(opcode_t::TENSOR), funct(tensor_function_t::CONV2D), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rshape_kernel(rshape_kernel), rstride_kernel(rstride_kernel), rstride_bias(rstride_bias), rstride_dest(rstride_dest), groups(groups), stride_h(stride_h), stride_w(stride_w), dilation_h(dilation_h), dilation_w(dilation_w), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
+    explicit tensor_conv2d_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high, bool fused_lut, int32_t fused_lut_zero_point, float fused_lut_scale) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::CONV2D), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rshape_kernel(rshape_kernel), rstride_kernel(rstride_kernel), rstride_bias(rstride_bias), rstride_dest(rstride_dest), groups(groups), stride_h(stride_h), stride_w(stride_w), dilation_h(dilation_h), dilation_w(dilation_w), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high), fused_lut(fused_lut), fused_lut_zero_point(fused_lut_zero_point), fused_lut_scale(fused_lut_scale)
     {
     }
 };
@@ -1709,4 +1718,156 @@ struct tensor_transpose_op_t
     }
 };
 
+struct tensor_detection_postprocess_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_boxes;
+    uint8_t rstride_boxes;
+    uint8_t rshape_scores;
+    uint8_t rstride_scores;
+    bool center_point_box;
+    int32_t max_output_boxes_per_class;
+    float iou_threshold;
+    float score_threshold;
+
+    tensor_detection_postprocess_op_t(default_init_t) noexcept { }
+    explicit tensor_detection_postprocess_op_t(datatype_t datatype, uint8_t rshape_boxes, uint8_t rstride_boxes, uint8_t rshape_scores, uint8_t rstride_scores, bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::DETECTION_POSTPROCESS), datatype(datatype), rshape_boxes(rshape_boxes), rstride_boxes(rstride_boxes), rshape_scores(rshape_scores), rstride_scores(rstride_scores), center_point_box(center_point_box), max_output_boxes_per_class(max_output_boxes_per_class), iou_threshold(iou_threshold), score_threshold(score_threshold)
+    {
+    }
+};
+
+struct tensor_topk_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_src;
+    uint8_t rstride_src;
+    uint8_t rstride_values;
+    uint8_t rstride_indices;
+    int32_t axis;
+    int32_t k;
+    bool largest;
+    bool sorted;
+
+    tensor_topk_op_t(default_init_t) noexcept { }
+    explicit tensor_topk_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_values, uint8_t rstride_indices, int32_t axis, int32_t k, bool largest, bool sorted) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::TOPK), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rstride_values(rstride_values), rstride_indices(rstride_indices), axis(axis), k(k), largest(largest), sorted(sorted)
+    {
+    }
+};
+
+struct tensor_loop_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    uint32_t function_id;
+    uint16_t module_id;
+    uint8_t num_src;
+    uint8_t num_dst;
+    uint8_t num_states;
+    uint8_t num_scan_inputs;
+    uint32_t trip_count;
+
+    tensor_loop_op_t(default_init_t) noexcept { }
+    explicit tensor_loop_op_t(uint32_t function_id, uint16_t module_id, uint8_t num_src, uint8_t num_dst, uint8_t num_states, uint8_t num_scan_inputs, uint32_t trip_count) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::LOOP), function_id(function_id), module_id(module_id), num_src(num_src), num_dst(num_dst), num_states(num_states), num_scan_inputs(num_scan_inputs), trip_count(trip_count)
+    {
+    }
+};
+
+struct tensor_image_preprocess_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_src;
+    uint8_t rstride_src;
+    uint8_t rshape_dest;
+    uint8_t rstride_dest;
+    int32_t zero_point;
+    float scale;
+    bool input_nhwc;
+    bool swap_rb;
+    int32_t resize_h;
+    int32_t resize_w;
+    int32_t pad_top;
+    int32_t pad_left;
+    float pad_value;
+    bool output_nhwc;
+
+    tensor_image_preprocess_op_t(default_init_t) noexcept { }
+    explicit tensor_image_preprocess_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_dest, uint8_t rstride_dest, int32_t zero_point, float scale, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left, float pad_value, bool output_nhwc) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::IMAGE_PREPROCESS), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rshape_dest(rshape_dest), rstride_dest(rstride_dest), zero_point(zero_point), scale(scale), input_nhwc(input_nhwc), swap_rb(swap_rb), resize_h(resize_h), resize_w(resize_w), pad_top(pad_top), pad_left(pad_left), pad_value(pad_value), output_nhwc(output_nhwc)
+    {
+    }
+};
+
+struct tensor_quantized_binary_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    binary_op_t binary_op;
+    uint8_t rshape_src1;
+    uint8_t rstride_src1;
+    uint8_t rshape_src2;
+    uint8_t rstride_src2;
+    uint8_t rstride_dest;
+    int32_t in_a_zero_point;
+    float in_a_scale;
+    int32_t in_b_zero_point;
+    float in_b_scale;
+    int32_t out_zero_point;
+    float out_scale;
+    float fused_clamp_low;
+    float fused_clamp_high;
+
+    tensor_quantized_binary_op_t(default_init_t) noexcept { }
+    explicit tensor_quantized_binary_op_t(datatype_t datatype, binary_op_t binary_op, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rstride_dest, int32_t in_a_zero_point, float in_a_scale, int32_t in_b_zero_point, float in_b_scale, int32_t out_zero_point, float out_scale, float fused_clamp_low, float fused_clamp_high) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::QUANTIZED_BINARY), datatype(datatype), binary_op(binary_op), rshape_src1(rshape_src1), rstride_src1(rstride_src1), rshape_src2(rshape_src2), rstride_src2(rstride_src2), rstride_dest(rstride_dest), in_a_zero_point(in_a_zero_point), in_a_scale(in_a_scale), in_b_zero_point(in_b_zero_point), in_b_scale(in_b_scale), out_zero_point(out_zero_point), out_scale(out_scale), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high)
+    {
+    }
+};
+
+struct tensor_conv2d_pool_op_t
+{
+    opcode_t opcode;
+    tensor_function_t funct;
+    datatype_t datatype;
+    uint8_t rshape_src;
+    uint8_t rstride_src;
+    uint8_t rshape_kernel;
+    uint8_t rstride_kernel;
+    uint8_t rstride_bias;
+    uint8_t rstride_dest;
+    uint16_t groups;
+    uint16_t stride_h;
+    uint16_t stride_w;
+    uint16_t dilation_h;
+    uint16_t dilation_w;
+    float fused_clamp_low;
+    float fused_clamp_high;
+    bool fused_lut;
+    int32_t fused_lut_zero_point;
+    float fused_lut_scale;
+    reduce_op_t pool_op;
+    float pool_init_value;
+    uint16_t pool_filter_h;
+    uint16_t pool_filter_w;
+    uint16_t pool_stride_h;
+    uint16_t pool_stride_w;
+    float pool_clamp_low;
+    float pool_clamp_high;
+
+    tensor_conv2d_pool_op_t(default_init_t) noexcept { }
+    explicit tensor_conv2d_pool_op_t(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high, bool fused_lut, int32_t fused_lut_zero_point, float fused_lut_scale, reduce_op_t pool_op, float pool_init_value, uint16_t pool_filter_h, uint16_t pool_filter_w, uint16_t pool_stride_h, uint16_t pool_stride_w, float pool_clamp_low, float pool_clamp_high) noexcept
+        : opcode(opcode_t::TENSOR), funct(tensor_function_t::CONV2D_POOL), datatype(datatype), rshape_src(rshape_src), rstride_src(rstride_src), rshape_kernel(rshape_kernel), rstride_kernel(rstride_kernel), rstride_bias(rstride_bias), rstride_dest(rstride_dest), groups(groups), stride_h(stride_h), stride_w(stride_w), dilation_h(dilation_h), dilation_w(dilation_w), fused_clamp_low(fused_clamp_low), fused_clamp_high(fused_clamp_high), fused_lut(fused_lut), fused_lut_zero_point(fused_lut_zero_point), fused_lut_scale(fused_lut_scale), pool_op(pool_op), pool_init_value(pool_init_value), pool_filter_h(pool_filter_h), pool_filter_w(pool_filter_w), pool_stride_h(pool_stride_h), pool_stride_w(pool_stride_w), pool_clamp_low(pool_clamp_low), pool_clamp_high(pool_clamp_high)
+    {
+    }
+};
+
 END_NS_NNCASE_RT_MODULE
@@ -15,10 +15,12 @@
 #pragma once
 #include "buffers.h"
 #include "freelist.h"
+#include <functional>
 #include <list>
 #include <nncase/ir/ir_types.h>
 #include <nncase/runtime/datatypes.h>
 #include <optional>
+#include <queue>
 #include <unordered_map>
 
 namespace nncase::schedule
@@ -58,20 +60,27 @@ public:
     void finish() override;
 };
 
-class NNCASE_API first_fit_allocator : public buffer_allocator
+/// Places each buffer in the smallest free span that fits it, see freelist
+class NNCASE_API best_fit_allocator : public buffer_allocator
 {
 public:
-    first_fit_allocator(std::optional<size_t> fixed_size = std::nullopt);
+    best_fit_allocator(std::optional<size_t> fixed_size = std::nullopt);
 
     void base_offset(size_t value) override;
     void mark(const physical_buffer &buffer) override;
     void finish() override;
 
 private:
+    using living_buffer_t = std::pair<size_t, const physical_buffer *>;
+
     freelist list_;
-    std::vector<const physical_buffer *> living_buffers_;
+    // Ordered by lifetime end, so dead buffers are popped without scanning the living ones
+    std::priority_queue<living_buffer_t, std::vector<living_buffer_t>, std::greater<living_buffer_t>> living_buffers_;
 };
 
+/// Former name, kept for targets that register it
+using first_fit_allocator = best_fit_allocator;
+
 using allocator_map_t = std::unordered_map<memory_location_t, buffer_allocator *>;
 using shared_allocator_map_t = std::unordered_map<module_type_t, buffer_allocator *>;
 }
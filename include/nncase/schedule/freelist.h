@@ -18,13 +18,17 @@
 #include <map>
 #include <nncase/runtime/datatypes.h>
 #include <optional>
+#include <set>
 #include <stdint.h>
 
 namespace nncase::schedule
 {
+/// Free spans are indexed both by address, for coalescing on free, and by size, so
+/// allocation picks the smallest fitting span in logarithmic time.
 class NNCASE_API freelist
 {
     using free_nodes_t = std::map<size_t, memory_span>;
+    using size_index_t = std::set<std::pair<size_t, size_t>>;
 
 public:
     freelist(std::optional<size_t> fixed_size);
@@ -37,11 +41,13 @@ public:
 
 private:
     free_nodes_t::iterator reserve(size_t size);
-    void merge(free_nodes_t::iterator offset);
+    free_nodes_t::iterator add_node(const memory_span &node);
+    void remove_node(free_nodes_t::iterator it);
 
 private:
     bool is_fixed_;
     free_nodes_t free_nodes_;
+    size_index_t size_index_;
     size_t heap_end_ = 0;
 };
 }
@@ -14,10 +14,13 @@
  */
 #pragma once
 #include "schedule_types.h"
+#include <unordered_set>
 
 namespace nncase::schedule
 {
-class lifetime_recorder
+/// Records buffer lifetimes as birth/death events. Ages are only written when a buffer
+/// dies, so advancing the age is O(1) regardless of how many buffers are alive.
+class NNCASE_API lifetime_recorder
 {
 public:
     lifetime_recorder(std::list<logical_buffer> &buffers, std::unordered_map<const ir::output_connector *, logical_buffer *> &buffer_map);
@@ -29,10 +32,17 @@ public:
     void release(ir::output_connector &conn);
     void grow_age();
 
+    /// Close the lifetimes of buffers that are still alive at the current age.
+    void finish();
+
+private:
+    void kill(logical_buffer &buffer);
+
 private:
     size_t next_buffer_id_ = 0;
     size_t cnt_age_ = 0;
     std::list<logical_buffer> &buffers_;
     std::unordered_map<const ir::output_connector *, logical_buffer *> &buffer_map_;
+    std::unordered_set<logical_buffer *> alive_buffers_;
 };
 }
@@ -16,6 +16,7 @@
 #include "buffer_allocator.h"
 #include "liveness_analysis.h"
 #include "schedule_types.h"
+#include <deque>
 #include <filesystem>
 
 namespace nncase
@@ -52,8 +53,10 @@ public:
     void end_schedule();
 
 private:
+    buffer_allocator &allocator(const logical_buffer &buffer);
     void create_allocators();
     void generate_compute_sequence();
+    void analyze_output_masks();
     void make_logical_buffers(caller_context &caller_ctx);
     void analyze_buffer_alias();
     void update_offset();
@@ -87,6 +90,7 @@ public:
     model_schedule_context &model_sched() const noexcept { return model_sched_; }
     allocator_map_t &allocators() noexcept { return allocators_; }
     buffer_allocator &shared_allocator(const module_type_t &type);
+    bool is_data_shared() const noexcept { return shared_allocators_.contains(type_); }
 
     void visit_function(ir::graph &graph, caller_context &caller_ctx);
     void end_schedule();
@@ -98,7 +102,8 @@ private:
     allocator_map_t allocators_;
     std::vector<std::shared_ptr<buffer_allocator>> allocator_holder_;
     shared_allocator_map_t shared_allocators_;
-    std::vector<function_schedule_context> functions_;
+    // Visiting a function may visit its callees in this module, so contexts must not move
+    std::deque<function_schedule_context> functions_;
     std::filesystem::path dump_dir_;
 };
 
@@ -107,7 +112,8 @@ class model_schedule_context
 public:
     model_schedule_context(model_schedule_result &result, nncase::target &target, bool skip_buffer_alias);
     model_schedule_context(const model_schedule_context &) = delete;
-    model_schedule_context(model_schedule_context &&) = default;
+    // Module contexts keep pointers to this context and its shared allocator
+    model_schedule_context(model_schedule_context &&) = delete;
 
     model_schedule_context &operator=(const model_schedule_context &) = delete;
 
@@ -116,11 +122,15 @@ public:
     void config_dump(std::filesystem::path dump_dir);
     const std::filesystem::path &dump_dir() const noexcept { return dump_dir_; }
     model_schedule_result &model_result() const noexcept { return result_; }
+    buffer_allocator &shared_allocator() noexcept { return shared_allocator_; }
+    ir::graph *entry_function() const noexcept { return entry_function_; }
 
     void schedule(ir::graph &entry_function);
     void visit_function(ir::graph &graph, caller_context &caller_ctx);
+    void mark_shared(const physical_buffer &buffer);
 
 private:
+    void allocate_shared_buffers();
     void end_schedule();
 
 private:
@@ -131,5 +141,7 @@ private:
     module_schedule_context *entry_module_;
     ir::graph *entry_function_;
     std::unordered_map<module_type_t, module_schedule_context> module_contexts_;
+    best_fit_allocator shared_allocator_;
+    std::vector<const physical_buffer *> shared_buffers_;
 };
 }
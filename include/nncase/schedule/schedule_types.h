@@ -55,6 +55,14 @@ struct function_schedule_result
     std::vector<ir::node *> compute_sequence;
     size_t input_pool_size;
     size_t output_pool_size;
+    /** Bit i set means the node contributes to output i, empty if the graph has more than 32 outputs */
+    std::unordered_map<const ir::node *, uint32_t> output_masks;
+
+    uint32_t full_output_mask() const noexcept
+    {
+        auto outputs = graph->outputs().size();
+        return outputs >= 32 ? ~uint32_t(0) : (uint32_t(1) << outputs) - 1;
+    }
 };
 
 struct module_schedule_result
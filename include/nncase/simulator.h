@@ -33,6 +33,9 @@ struct simulate_options
     std::string input_layout = "NCHW";
     float input_mean = 0.f;
     float input_std = 1.f;
+
+    // Number of interpreters running in parallel, 0 means hardware concurrency.
+    size_t num_threads = 0;
 };
 
 class NNCASE_API simulator
@@ -0,0 +1,39 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../transform.h"
+
+namespace nncase::ir::transforms
+{
+/// Split a chain of row local ops (conv2d, reduce_window2d and elementwise ops) whose
+/// intermediate feature maps don't fit in cache into tiles of output rows. Each tile
+/// reads its input rows including the halo, runs the whole chain and is concatenated
+/// back, so the intermediates of a tile stay small while the next op reads them.
+class NNCASE_API depth_first_tiling_transform : public transform
+{
+public:
+    depth_first_tiling_transform(size_t cache_size = 512 * 1024) noexcept
+        : cache_size_(cache_size) { }
+
+    void process(transform_context &context) override;
+
+protected:
+    bool skip_self_contained_check() const noexcept override { return true; }
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    size_t cache_size_;
+};
+}
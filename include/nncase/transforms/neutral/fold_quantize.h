@@ -22,6 +22,16 @@ class NNCASE_API fold_quantize_transform : public transform
 public:
     void process(transform_context &context) override;
 
+protected:
+    bool skip_self_contained_check() const noexcept override { return true; }
+    bool on_try_match(ir::node &node, transform_context &context) override;
+};
+
+class NNCASE_API fold_requantize_transform : public transform
+{
+public:
+    void process(transform_context &context) override;
+
 protected:
     bool skip_self_contained_check() const noexcept override { return true; }
     bool on_try_match(ir::node &node, transform_context &context) override;
@@ -0,0 +1,79 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../transform.h"
+
+namespace nncase::ir::transforms
+{
+class NNCASE_API quantized_binary_transform : public transform
+{
+public:
+    quantized_binary_transform(datatype_t quant_type) noexcept
+        : quant_type_(quant_type) { }
+    void process(transform_context &context) override;
+
+protected:
+    bool skip_self_contained_check() const noexcept override { return true; }
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    datatype_t quant_type_;
+};
+
+class NNCASE_API quantized_reduce_window2d_transform : public transform
+{
+public:
+    quantized_reduce_window2d_transform(datatype_t quant_type) noexcept
+        : quant_type_(quant_type) { }
+    void process(transform_context &context) override;
+
+protected:
+    bool skip_self_contained_check() const noexcept override { return true; }
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    datatype_t quant_type_;
+};
+
+class NNCASE_API quantized_resize_image_transform : public transform
+{
+public:
+    quantized_resize_image_transform(datatype_t quant_type) noexcept
+        : quant_type_(quant_type) { }
+    void process(transform_context &context) override;
+
+protected:
+    bool skip_self_contained_check() const noexcept override { return true; }
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    datatype_t quant_type_;
+};
+
+class NNCASE_API quantized_concat_transform : public transform
+{
+public:
+    quantized_concat_transform(datatype_t quant_type) noexcept
+        : quant_type_(quant_type) { }
+    void process(transform_context &context) override;
+
+protected:
+    bool skip_self_contained_check() const noexcept override { return true; }
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    datatype_t quant_type_;
+};
+}
@@ -0,0 +1,40 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nncase/runtime/k210/compiler_defs.h>
+#include <nncase/runtime/k210/runtime_types.h>
+#include <nncase/transforms/transform.h>
+
+namespace nncase::ir::transforms::k210
+{
+/// Split a fake kpu conv2d whose input and output don't fit in KPU RAM together into
+/// row tiles. Each tile is uploaded, convolved and downloaded on its own, so the
+/// mem_kpu allocator can reuse the same region for every tile.
+class NNCASE_MODULES_K210_API kpu_conv2d_tiling_transform : public transform
+{
+public:
+    kpu_conv2d_tiling_transform(size_t kpu_ram_size = runtime::k210::KPU_RAM_SIZE) noexcept
+        : kpu_ram_size_(kpu_ram_size) { }
+
+    void process(transform_context &context) override;
+
+protected:
+    bool skip_self_contained_check() const noexcept override { return true; }
+    bool on_try_match(ir::node &node, transform_context &context) override;
+
+private:
+    size_t kpu_ram_size_;
+};
+}
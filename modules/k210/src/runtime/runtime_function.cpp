@@ -134,6 +134,9 @@ result<gsl::span<gsl::byte>> k210_runtime_function::memory_at(const memory_range
     case mem_data:
         base = module().data().data();
         break;
+    case mem_shared_data:
+        base = module().shared_data().data();
+        break;
     case mem_kpu:
         base = module().kpu_ram().data();
         break;
@@ -0,0 +1,168 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/k210/fake_kpu_conv2d.h>
+#include <nncase/ir/ops/slice.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/runtime/k210/runtime_op_utility.h>
+#include <nncase/transforms/k210/kpu_conv2d_tiling.h>
+#include <nncase/transforms/k210/kpu_utils.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::k210;
+using namespace nncase::runtime::k210;
+using namespace nncase::ir::transforms;
+using namespace nncase::ir::transforms::k210;
+
+namespace
+{
+struct kpu_tile
+{
+    // Input rows fed to the tile, including the halo rows needed by the filter
+    int32_t in_begin;
+    int32_t in_end;
+    // Rows of the tile output that belong to the original output
+    int32_t out_begin;
+    int32_t out_end;
+};
+
+size_t get_tile_kpu_bytes(fake_kpu_conv2d &conv, const shape_t &in_shape)
+{
+    auto out_shape = in_shape;
+    out_shape[1] = conv.output_channels();
+    out_shape[2] = get_kpu_pool_output_size((int32_t)in_shape[2], conv.pool_type());
+    out_shape[3] = get_kpu_pool_output_size((int32_t)in_shape[3], conv.pool_type());
+    return (size_t)get_kpu_bytes(in_shape) + (size_t)get_kpu_bytes(out_shape);
+}
+
+std::vector<kpu_tile> split_rows(int32_t in_h, int32_t pad, int32_t stride, int32_t tiles)
+{
+    // Halo before a tile is rounded up to the pool stride so pool windows stay aligned
+    auto halo = (pad + stride - 1) / stride * stride;
+    auto out_h = in_h / stride;
+    auto base = out_h / tiles;
+    auto rem = out_h % tiles;
+
+    std::vector<kpu_tile> result;
+    int32_t out_begin = 0;
+    for (int32_t i = 0; i < tiles; i++)
+    {
+        auto rows = base + (i < rem ? 1 : 0);
+        auto begin = out_begin * stride;
+        auto end = (out_begin + rows) * stride;
+
+        kpu_tile tile;
+        tile.in_begin = begin == 0 ? 0 : begin - halo;
+        tile.in_end = i == tiles - 1 ? in_h : std::min(end + pad, in_h);
+        tile.out_begin = (begin - tile.in_begin) / stride;
+        tile.out_end = tile.out_begin + rows;
+        result.emplace_back(tile);
+        out_begin += rows;
+    }
+
+    return result;
+}
+
+std::vector<kpu_tile> get_tiles(fake_kpu_conv2d &conv, size_t kpu_ram_size)
+{
+    auto in_shape = conv.input().shape();
+    auto in_h = (int32_t)in_shape[2];
+    auto pad = get_kpu_padding(conv.filter_type());
+    auto stride = get_kpu_filter_stride(conv.pool_type());
+    auto out_h = in_h / stride;
+
+    for (int32_t tiles = 2; tiles <= out_h; tiles++)
+    {
+        auto result = split_rows(in_h, pad, stride, tiles);
+        auto fits = std::all_of(result.begin(), result.end(), [&](const kpu_tile &tile) {
+            auto tile_shape = in_shape;
+            tile_shape[2] = tile.in_end - tile.in_begin;
+            return is_supported_in_shape(tile_shape)
+                && get_tile_kpu_bytes(conv, tile_shape) <= kpu_ram_size;
+        });
+        if (fits)
+            return result;
+    }
+
+    return {};
+}
+}
+
+bool kpu_conv2d_tiling_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto conv = node_cast<fake_kpu_conv2d>(node))
+    {
+        // Overlapping pools would need halo rows after the conv as well
+        if (get_kpu_filter_size(conv->pool_type()) == get_kpu_filter_stride(conv->pool_type())
+            && get_tile_kpu_bytes(*conv, conv->input().shape()) > kpu_ram_size_
+            && !get_tiles(*conv, kpu_ram_size_).empty())
+        {
+            context.inputs.emplace_back(&conv->input());
+            context.inputs.emplace_back(&conv->weights());
+            context.inputs.emplace_back(&conv->bias());
+            context.outputs.emplace_back(&conv->output());
+
+            context.matched_nodes.emplace_back(conv);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void kpu_conv2d_tiling_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &weights = *context.inputs[1]->connection();
+    auto &bias = *context.inputs[2]->connection();
+    auto inputs = context.outputs[0]->connections();
+    auto &old_conv = static_cast<fake_kpu_conv2d &>(*context.matched_nodes[0]);
+
+    auto &in_shape = output.shape();
+    auto tiles = get_tiles(old_conv, kpu_ram_size_);
+    std::vector<output_connector *> tile_outputs;
+    std::vector<shape_t> tile_shapes;
+
+    for (size_t i = 0; i < tiles.size(); i++)
+    {
+        auto &tile = tiles[i];
+        auto in_slc = context.graph.emplace<slice>(dt_float32, in_shape, axis_t { 0, 0, tile.in_begin, 0 },
+            axis_t { (int32_t)in_shape[0], (int32_t)in_shape[1], tile.in_end, (int32_t)in_shape[3] });
+        auto conv = context.graph.emplace<fake_kpu_conv2d>(in_slc->output().shape(), old_conv.is_depthwise(), weights.shape(),
+            old_conv.filter_type(), old_conv.pool_type(), old_conv.fused_activation());
+        conv->name(old_conv.name() + "/tile_" + std::to_string(i));
+        auto &out_shape = conv->output().shape();
+        auto out_slc = context.graph.emplace<slice>(dt_float32, out_shape, axis_t { 0, 0, tile.out_begin, 0 },
+            axis_t { (int32_t)out_shape[0], (int32_t)out_shape[1], tile.out_end, (int32_t)out_shape[3] });
+
+        in_slc->input().connect(output);
+        conv->input().connect(in_slc->output());
+        conv->weights().connect(weights);
+        conv->bias().connect(bias);
+        out_slc->input().connect(conv->output());
+        tile_outputs.emplace_back(&out_slc->output());
+        tile_shapes.emplace_back(out_slc->output().shape());
+    }
+
+    auto c = context.graph.emplace<concat>(dt_float32, tile_shapes, 2);
+    c->name(old_conv.name());
+    for (size_t i = 0; i < tile_outputs.size(); i++)
+        c->input_at(i).connect(*tile_outputs[i]);
+
+    for (auto &in : dup(inputs))
+        in->connect(c->output());
+}
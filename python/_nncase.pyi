@@ -1,4 +1,4 @@
-from typing import Any, List, BinaryIO
+from typing import Any, List, BinaryIO, Iterable
 
 import numpy
 
@@ -25,6 +25,7 @@ class CompileOptions:
     output_layout: str
     letterbox_value: float
     tcu_num: int
+    codegen_threads: int
     def __init__(self) -> None: ...
 
 
@@ -68,6 +69,7 @@ class PTQTensorOptions:
     samples_count: int
     def __init__(self) -> None: ...
     def set_tensor_data(self, bytes: bytes) -> None: ...
+    def set_tensor_data_iter(self, samples: Iterable[numpy.ndarray], prefetch: int = 2) -> None: ...
 
 
 class Path:
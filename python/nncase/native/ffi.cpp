@@ -16,6 +16,8 @@
 #include "pytype_utils.h"
 #include "type_casters.20.h"
 #include "type_casters.h"
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <nncase/compiler.h>
 #include <nncase/ir/debug.h>
@@ -31,6 +33,7 @@
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 #include <sstream>
+#include <thread>
 
 namespace py = pybind11;
 using namespace nncase;
@@ -120,6 +123,195 @@ private:
     schedule::model_schedule_result schedule_result_;
     ir::evaluator evaluator_;
 };
+
+// Pulls calibration samples lazily from a Python iterable of arrays, each pass iterates it again.
+// With prefetch, a background thread keeps up to `prefetch` samples ready while calibration runs.
+class py_sample_source : public sample_source
+{
+public:
+    py_sample_source(py::object iterable, size_t prefetch)
+        : iterable_(std::move(iterable)), prefetch_(prefetch)
+    {
+    }
+
+    ~py_sample_source()
+    {
+        stop();
+        py::gil_scoped_acquire gil;
+        iterator_ = {};
+        iterable_ = {};
+    }
+
+    void reset() override
+    {
+        stop();
+        py::gil_scoped_acquire gil;
+        iterator_ = py::iter(iterable_);
+        if (prefetch_)
+            worker_ = std::thread([this] { produce(); });
+    }
+
+    bool next(std::span<uint8_t> dest) override
+    {
+        py::object sample;
+        if (prefetch_)
+        {
+            std::exception_ptr error;
+            {
+                std::unique_lock lock(mutex_);
+                cond_.wait(lock, [this] { return !queue_.empty() || done_; });
+                if (!queue_.empty())
+                {
+                    sample = std::move(queue_.front());
+                    queue_.pop_front();
+                    cond_.notify_all();
+                }
+                else
+                {
+                    error = error_;
+                }
+            }
+
+            if (!sample)
+            {
+                finish();
+                if (error)
+                    std::rethrow_exception(error);
+                return false;
+            }
+        }
+        else
+        {
+            bool pulled;
+            {
+                py::gil_scoped_acquire gil;
+                pulled = pull(sample);
+            }
+
+            if (!pulled)
+            {
+                finish();
+                return false;
+            }
+        }
+
+        py::gil_scoped_acquire gil;
+        copy_sample(std::move(sample), dest);
+        return true;
+    }
+
+private:
+    static void copy_sample(py::object sample, std::span<uint8_t> dest)
+    {
+        // Contiguous arrays are read in place
+        auto array = py::array::ensure(sample, py::array::c_style);
+        if (!array)
+            throw std::invalid_argument("Calibration sample must be an array");
+        if ((size_t)array.nbytes() != dest.size())
+            throw std::invalid_argument("Calibration sample has " + std::to_string(array.nbytes()) + " bytes, model input needs " + std::to_string(dest.size()));
+
+        py::gil_scoped_release nogil;
+        std::memcpy(dest.data(), array.data(), dest.size());
+    }
+
+    bool pull(py::object &sample)
+    {
+        auto item = PyIter_Next(iterator_.ptr());
+        if (!item)
+        {
+            if (PyErr_Occurred())
+                throw py::error_already_set();
+            return false;
+        }
+
+        sample = py::reinterpret_steal<py::object>(item);
+        return true;
+    }
+
+    void produce()
+    {
+        try
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock lock(mutex_);
+                    cond_.wait(lock, [this] { return queue_.size() < prefetch_ || stopping_; });
+                    if (stopping_)
+                        break;
+                }
+
+                py::object sample;
+                {
+                    py::gil_scoped_acquire gil;
+                    if (!pull(sample))
+                        break;
+                }
+
+                std::lock_guard lock(mutex_);
+                queue_.emplace_back(std::move(sample));
+                cond_.notify_all();
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(mutex_);
+            error_ = std::current_exception();
+        }
+
+        std::lock_guard lock(mutex_);
+        done_ = true;
+        cond_.notify_all();
+    }
+
+    // The pass is over, don't keep the worker and the iterator alive until the next one
+    void finish()
+    {
+        stop();
+        py::gil_scoped_acquire gil;
+        iterator_ = {};
+    }
+
+    void stop()
+    {
+        if (worker_.joinable())
+        {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+                cond_.notify_all();
+            }
+
+            // The worker may be waiting for the GIL
+            if (PyGILState_Check())
+            {
+                py::gil_scoped_release nogil;
+                worker_.join();
+            }
+            else
+            {
+                worker_.join();
+            }
+        }
+
+        py::gil_scoped_acquire gil;
+        queue_.clear();
+        error_ = nullptr;
+        stopping_ = false;
+        done_ = false;
+    }
+
+    py::object iterable_;
+    py::object iterator_;
+    size_t prefetch_;
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<py::object> queue_;
+    std::exception_ptr error_;
+    bool stopping_ = false;
+    bool done_ = false;
+};
 }
 
 PYBIND11_MODULE(_nncase, m)
@@ -150,6 +342,7 @@ PYBIND11_MODULE(_nncase, m)
         .def_readwrite("input_layout", &compile_options::input_layout)
         .def_readwrite("output_layout", &compile_options::output_layout)
         .def_readwrite("tcu_num", &compile_options::tcu_num)
+        .def_readwrite("codegen_threads", &compile_options::codegen_threads)
         .def_readwrite("is_fpga", &compile_options::is_fpga)
         .def_readwrite("dump_ir", &compile_options::dump_ir)
         .def_readwrite("dump_asm", &compile_options::dump_asm)
@@ -172,7 +365,13 @@ PYBIND11_MODULE(_nncase, m)
             if (PyBytes_AsStringAndSize(bytes.ptr(), reinterpret_cast<char **>(&buffer), &length))
                 throw std::invalid_argument("Invalid bytes");
             o.tensor_data.assign(buffer, buffer + length);
-        });
+        })
+        .def(
+            "set_tensor_data_iter", [](ptq_tensor_options &o, py::object samples, size_t prefetch) {
+                o.tensor_data.clear();
+                o.samples = std::make_shared<py_sample_source>(std::move(samples), prefetch);
+            },
+            py::arg("samples"), py::arg("prefetch") = 2);
 
     py::class_<dump_range_tensor_options>(m, "DumpRangeTensorOptions")
         .def(py::init())
@@ -184,7 +383,13 @@ PYBIND11_MODULE(_nncase, m)
             if (PyBytes_AsStringAndSize(bytes.ptr(), reinterpret_cast<char **>(&buffer), &length))
                 throw std::invalid_argument("Invalid bytes");
             o.tensor_data.assign(buffer, buffer + length);
-        });
+        })
+        .def(
+            "set_tensor_data_iter", [](dump_range_tensor_options &o, py::object samples, size_t prefetch) {
+                o.tensor_data.clear();
+                o.samples = std::make_shared<py_sample_source>(std::move(samples), prefetch);
+            },
+            py::arg("samples"), py::arg("prefetch") = 2);
 
     py::class_<graph_evaluator>(m, "GraphEvaluator")
         .def_property_readonly("outputs_size", &graph_evaluator::outputs_size)
@@ -197,7 +402,7 @@ PYBIND11_MODULE(_nncase, m)
         .def("import_tflite", &compiler::import_tflite)
         .def("import_onnx", &compiler::import_onnx)
         .def("import_caffe", &compiler::import_caffe)
-        .def("compile", &compiler::compile)
+        .def("compile", &compiler::compile, py::call_guard<py::gil_scoped_release>())
         .def("use_ptq", py::overload_cast<ptq_tensor_options>(&compiler::use_ptq))
         .def("dump_range_options", py::overload_cast<dump_range_tensor_options>(&compiler::dump_range_options))
         .def("gencode", [](compiler &c, std::ostream &stream) { c.gencode(stream); })
@@ -224,7 +429,8 @@ PYBIND11_MODULE(_nncase, m)
         .def("set_input_tensor", [](interpreter &interp, size_t index, runtime_tensor tensor) { return interp.input_tensor(index, tensor).unwrap_or_throw(); })
         .def("get_output_tensor", [](interpreter &interp, size_t index) { return interp.output_tensor(index).unwrap_or_throw(); })
         .def("set_output_tensor", [](interpreter &interp, size_t index, runtime_tensor tensor) { return interp.output_tensor(index, tensor).unwrap_or_throw(); })
-        .def("run", [](interpreter &interp) { interp.run().unwrap_or_throw(); });
+        .def("run", [](interpreter &interp) { interp.run().unwrap_or_throw(); })
+        .def("run", [](interpreter &interp, std::vector<size_t> outputs) { interp.run(outputs).unwrap_or_throw(); });
 
     m.def("test_target", [](std::string name) {
         try
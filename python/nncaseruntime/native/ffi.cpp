@@ -91,5 +91,6 @@ PYBIND11_MODULE(_nncaseruntime, m)
         .def("set_input_tensor", [](interpreter &interp, size_t index, runtime_tensor tensor) { return interp.input_tensor(index, tensor).unwrap_or_throw(); })
         .def("get_output_tensor", [](interpreter &interp, size_t index) { return interp.output_tensor(index).unwrap_or_throw(); })
         .def("set_output_tensor", [](interpreter &interp, size_t index, runtime_tensor tensor) { return interp.output_tensor(index, tensor).unwrap_or_throw(); })
-        .def("run", [](interpreter &interp) { interp.run().unwrap_or_throw(); });
+        .def("run", [](interpreter &interp) { interp.run().unwrap_or_throw(); })
+        .def("run", [](interpreter &interp, std::vector<size_t> outputs) { interp.run(outputs).unwrap_or_throw(); });
 }
@@ -27,7 +27,8 @@ inference_command::inference_command(lyra::cli &cli)
                          .add_argument(lyra::arg(output_path_, "output path").required().help("output path"))
                          .add_argument(lyra::opt(dataset_, "dataset path").name("--dataset").required().help("dataset path"))
                          .add_argument(lyra::opt(dataset_format_, "dataset format").name("--dataset-format").optional().help("dataset format, e.g. image|raw, default is " + dataset_format_))
-                         .add_argument(lyra::opt(input_layout_, "input layout").name("--input-layout").optional().help("input layout, e.g NCHW|NHWC, default is " + input_layout_)));
+                         .add_argument(lyra::opt(input_layout_, "input layout").name("--input-layout").optional().help("input layout, e.g NCHW|NHWC, default is " + input_layout_))
+                         .add_argument(lyra::opt(num_threads_, "threads").name("--threads").optional().help("number of parallel inference threads, 0 means hardware concurrency, default is " + std::to_string(num_threads_))));
 }
 
 void inference_command::run()
@@ -37,6 +38,7 @@ void inference_command::run()
     options.dataset_format = dataset_format_;
     options.output_path = output_path_;
     options.input_layout = input_layout_;
+    options.num_threads = num_threads_;
 
     auto sim = simulator::create(read_file(model_filename_), options);
     sim->run();
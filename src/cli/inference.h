@@ -32,5 +32,6 @@ private:
     std::string dataset_;
     std::string dataset_format_ = "image";
     std::string input_layout_ = "NCHW";
+    uint32_t num_threads_ = 0;
 };
 }
@@ -14,6 +14,7 @@
  */
 #include <nncase/codegen/model_builder.h>
 #include <nncase/ir/op_utils.h>
+#include <nncase/parallel.h>
 #include <nncase/runtime/model.h>
 #include <nncase/targets/target.h>
 
@@ -24,7 +25,7 @@ using namespace nncase::schedule;
 using namespace nncase::runtime;
 
 model_builder::model_builder(target &target, const schedule::model_schedule_result &sched)
-    : target_(target), sched_(sched), dump_asm_(false)
+    : target_(target), sched_(sched), dump_asm_(false), num_threads_(0)
 {
 }
 
@@ -51,12 +52,31 @@ build_model_result model_builder::build(std::ostream &output)
     auto header_pos = writer.position();
     writer.skip(sizeof(header));
 
+    // Modules are generated concurrently into their own sections and written in schedule order,
+    // so the model is the same as a serial build
+    std::vector<module_builder_params> params;
+    std::vector<std::unique_ptr<module_builder>> builders;
+    params.reserve(sched_.modules.size());
     for (auto &mod_sched : sched_.modules)
     {
-        module_builder_params params { sched_, mod_sched };
-        auto builder = target_.create_module_builder(mod_sched.type, mod_sched.type.data(), params);
+        auto &param = params.emplace_back(module_builder_params { sched_, mod_sched });
+        auto &builder = builders.emplace_back(target_.create_module_builder(mod_sched.type, mod_sched.type.data(), param));
         builder->config_dump(dump_dir_ / mod_sched.type.data(), dump_asm_);
-        builder->build(writer);
+    }
+
+    // Split the threads between modules so the sections each module decompiles in parallel
+    // don't oversubscribe the cores
+    auto num_threads = num_threads_ ? num_threads_ : std::max(1u, std::thread::hardware_concurrency());
+    auto module_threads = std::max(size_t(1), std::min(num_threads, builders.size()));
+    for (auto &builder : builders)
+        builder->num_threads(std::max(size_t(1), num_threads / module_threads));
+
+    parallel_for(
+        builders.size(), [&](size_t i) { builders[i]->generate(); }, module_threads);
+
+    for (auto &builder : builders)
+    {
+        builder->write(writer);
         header.alignment = std::max(header.alignment, builder->alignment());
     }
 
@@ -116,10 +136,11 @@ size_t model_builder::max_usage(memory_location_t location) const
     }
     else
     {
+        // All modules share the same pool
         for (auto &mod : sched_.modules)
         {
             for (auto &shared : mod.shared_max_usages)
-                usage += shared.second;
+                usage = std::max(usage, shared.second);
         }
     }
 
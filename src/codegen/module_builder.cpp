@@ -20,6 +20,7 @@
 #include <nncase/ir/ops/constant.h>
 #include <nncase/ir/runtime_type_utils.h>
 #include <nncase/ir/visitor.h>
+#include <nncase/parallel.h>
 #include <nncase/runtime/bitio.h>
 #include <nncase/runtime/model.h>
 #include <string>
@@ -38,7 +39,7 @@ std::unordered_set<node_opcode> non_runtime_opcodes { op_input_node, op_output_n
 }
 
 module_builder::module_builder(uint32_t alignment, std::string_view module_name, const module_builder_params &params)
-    : dump_asm_(false), alignment_(alignment), module_name_(module_name), params_(params)
+    : dump_asm_(false), alignment_(alignment), num_threads_(0), module_name_(module_name), params_(params)
 {
 }
 
@@ -152,8 +153,7 @@ void module_builder::compile()
         for (auto &section : section_writer_)
             section.second.body = read_stream(section.second.stream);
 
-        for (auto &section : section_writer_)
-            decompile("compile", section.first, section.second.body, section.second.writer.symbols());
+        decompile_sections("compile", [](const std::string &) { return true; });
     }
 }
 
@@ -208,6 +208,25 @@ void module_builder::decompile(std::string_view stage, std::string_view section_
     }
 }
 
+template <class TPredicate>
+void module_builder::decompile_sections(std::string_view stage, TPredicate &&predicate)
+{
+    // Each section is decompiled into its own file, so they don't depend on each other
+    std::vector<std::pair<const std::string, section> *> sections;
+    for (auto &section : section_writer_)
+    {
+        if (predicate(section.first))
+            sections.emplace_back(&section);
+    }
+
+    parallel_for(
+        sections.size(), [&](size_t i) {
+            auto &section = *sections[i];
+            decompile(stage, section.first, section.second.body, section.second.writer.symbols());
+        },
+        num_threads_);
+}
+
 void module_builder::generate_merge_info()
 {
     if (!rdata_section_merges_.empty())
@@ -296,13 +315,7 @@ void module_builder::link()
     write_symbol_refs();
 
     if (dump_asm_)
-    {
-        for (auto &section : section_writer_)
-        {
-            if (rdata_section_merges_.contains(section.first))
-                decompile("link", section.first, section.second.body, section.second.writer.symbols());
-        }
-    }
+        decompile_sections("link", [&](const std::string &name) { return rdata_section_merges_.contains(name); });
 }
 
 void module_builder::write_binary(binary_writer &writer)
@@ -320,6 +333,15 @@ void module_builder::write_binary(binary_writer &writer)
         writer.write(desc);
     }
 
+    // shared mempools
+    for (auto &mem : params_.module_sched.shared_max_usages)
+    {
+        mempool_desc desc {};
+        desc.location = mem_shared_data;
+        desc.size = (uint32_t)mem.second;
+        writer.write(desc);
+    }
+
     // functions
     for (auto &func_sched : params_.module_sched.functions)
         write_function_binary(writer, func_sched);
@@ -446,9 +468,19 @@ void module_builder::write_function_binary(binary_writer &writer, const schedule
 }
 
 void module_builder::build(binary_writer &writer)
+{
+    generate();
+    write(writer);
+}
+
+void module_builder::generate()
 {
     compile();
     link();
+}
+
+void module_builder::write(binary_writer &writer)
+{
     write_binary(writer);
 }
 
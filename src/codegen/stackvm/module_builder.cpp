@@ -56,10 +56,37 @@ void stackvm_module_builder::begin_emit_function([[maybe_unused]] const schedule
 
 void stackvm_module_builder::end_emit_function([[maybe_unused]] const schedule::function_schedule_result &function)
 {
+    // Branches skipping the last ops land on this ret instead of past the end of the text
+    op_writer<ret_op_t>()(ret_op_t(), text_writer());
     set_current_function_text_end(text_writer().position());
 }
 
 void stackvm_module_builder::emit(ir::node &node)
+{
+    auto &function = current_function();
+    auto it = function.output_masks.find(&node);
+    if (it == function.output_masks.end() || it->second == function.full_output_mask())
+        return emit_op(node);
+
+    // Skip the node if none of the outputs it feeds is requested (arg 0 holds the requested output mask)
+    auto &writer = text_writer();
+    {
+        stackvm_op_builder builder(node, writer);
+        builder.ldarg_0_();
+        builder.ldc_i4_((int32_t)it->second);
+        builder.and_();
+        builder.br_false_(0);
+    }
+
+    auto body_begin = writer.position();
+    emit_op(node);
+    auto body_end = writer.position();
+    writer.position(body_begin - std::streamoff(sizeof(int32_t)));
+    writer.write((int32_t)(body_end - body_begin));
+    writer.position(body_end);
+}
+
+void stackvm_module_builder::emit_op(ir::node &node)
 {
     stackvm_op_builder builder(node, text_writer());
 #define DEFINE_OP(op)                          \
@@ -20,16 +20,21 @@
 #include <nncase/ir/ops/broadcast.h>
 #include <nncase/ir/ops/call.h>
 #include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_pool.h>
 #include <nncase/ir/ops/convert.h>
 #include <nncase/ir/ops/copy.h>
 #include <nncase/ir/ops/cumsum.h>
 #include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/detection_postprocess.h>
 #include <nncase/ir/ops/gather.h>
 #include <nncase/ir/ops/gather_nd.h>
 #include <nncase/ir/ops/hardmax.h>
+#include <nncase/ir/ops/image_preprocess.h>
+#include <nncase/ir/ops/loop.h>
 #include <nncase/ir/ops/onehot.h>
 #include <nncase/ir/ops/pad.h>
 #include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/ops/quantized_binary.h>
 #include <nncase/ir/ops/random_normal.h>
 #include <nncase/ir/ops/random_uniform.h>
 #include <nncase/ir/ops/reduce.h>
@@ -40,6 +45,7 @@
 #include <nncase/ir/ops/slice.h>
 #include <nncase/ir/ops/table_lookup.h>
 #include <nncase/ir/ops/ternary.h>
+#include <nncase/ir/ops/topk.h>
 #include <nncase/ir/ops/transpose.h>
 #include <nncase/ir/ops/unary.h>
 #include <nncase/ir/placeholders.h>
@@ -76,6 +82,8 @@ protected:
     void emit(ir::node &node) override;
 
 private:
+    void emit_op(ir::node &node);
+
 #define DEFINE_OP(op_) void emit(ir::op_ &op, stackvm_op_builder &builder);
 #include "ops.def"
 #undef DEFINE_OP
@@ -518,9 +518,9 @@ void op_builder::tensor_call_(uint32_t function_id, uint16_t module_id, uint8_t
     op_writer<tensor_call_op_t>()(tensor_call_op_t(function_id, module_id, num_src, num_dst), writer_);
 }
 
-void op_builder::tensor_conv2d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high)
+void op_builder::tensor_conv2d_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high, bool fused_lut, int32_t fused_lut_zero_point, float fused_lut_scale)
 {
-    op_writer<tensor_conv2d_op_t>()(tensor_conv2d_op_t(datatype, rshape_src, rstride_src, rshape_kernel, rstride_kernel, rstride_bias, rstride_dest, groups, stride_h, stride_w, dilation_h, dilation_w, fused_clamp_low, fused_clamp_high), writer_);
+    op_writer<tensor_conv2d_op_t>()(tensor_conv2d_op_t(datatype, rshape_src, rstride_src, rshape_kernel, rstride_kernel, rstride_bias, rstride_dest, groups, stride_h, stride_w, dilation_h, dilation_w, fused_clamp_low, fused_clamp_high, fused_lut, fused_lut_zero_point, fused_lut_scale), writer_);
 }
 
 void op_builder::tensor_copy_(datatype_t datatype, uint8_t rshape, uint8_t rstride_src, uint8_t rstride_dest)
@@ -632,3 +632,33 @@ void op_builder::tensor_transpose_(datatype_t datatype, uint8_t rshape_src, uint
 {
     op_writer<tensor_transpose_op_t>()(tensor_transpose_op_t(datatype, rshape_src, rstride_src, rstride_dest, rshape_perm), writer_);
 }
+
+void op_builder::tensor_detection_postprocess_(datatype_t datatype, uint8_t rshape_boxes, uint8_t rstride_boxes, uint8_t rshape_scores, uint8_t rstride_scores, bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold)
+{
+    op_writer<tensor_detection_postprocess_op_t>()(tensor_detection_postprocess_op_t(datatype, rshape_boxes, rstride_boxes, rshape_scores, rstride_scores, center_point_box, max_output_boxes_per_class, iou_threshold, score_threshold), writer_);
+}
+
+void op_builder::tensor_topk_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rstride_values, uint8_t rstride_indices, int32_t axis, int32_t k, bool largest, bool sorted)
+{
+    op_writer<tensor_topk_op_t>()(tensor_topk_op_t(datatype, rshape_src, rstride_src, rstride_values, rstride_indices, axis, k, largest, sorted), writer_);
+}
+
+void op_builder::tensor_loop_(uint32_t function_id, uint16_t module_id, uint8_t num_src, uint8_t num_dst, uint8_t num_states, uint8_t num_scan_inputs, uint32_t trip_count)
+{
+    op_writer<tensor_loop_op_t>()(tensor_loop_op_t(function_id, module_id, num_src, num_dst, num_states, num_scan_inputs, trip_count), writer_);
+}
+
+void op_builder::tensor_image_preprocess_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_dest, uint8_t rstride_dest, int32_t zero_point, float scale, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left, float pad_value, bool output_nhwc)
+{
+    op_writer<tensor_image_preprocess_op_t>()(tensor_image_preprocess_op_t(datatype, rshape_src, rstride_src, rshape_dest, rstride_dest, zero_point, scale, input_nhwc, swap_rb, resize_h, resize_w, pad_top, pad_left, pad_value, output_nhwc), writer_);
+}
+
+void op_builder::tensor_quantized_binary_(datatype_t datatype, binary_op_t binary_op, uint8_t rshape_src1, uint8_t rstride_src1, uint8_t rshape_src2, uint8_t rstride_src2, uint8_t rstride_dest, int32_t in_a_zero_point, float in_a_scale, int32_t in_b_zero_point, float in_b_scale, int32_t out_zero_point, float out_scale, float fused_clamp_low, float fused_clamp_high)
+{
+    op_writer<tensor_quantized_binary_op_t>()(tensor_quantized_binary_op_t(datatype, binary_op, rshape_src1, rstride_src1, rshape_src2, rstride_src2, rstride_dest, in_a_zero_point, in_a_scale, in_b_zero_point, in_b_scale, out_zero_point, out_scale, fused_clamp_low, fused_clamp_high), writer_);
+}
+
+void op_builder::tensor_conv2d_pool_(datatype_t datatype, uint8_t rshape_src, uint8_t rstride_src, uint8_t rshape_kernel, uint8_t rstride_kernel, uint8_t rstride_bias, uint8_t rstride_dest, uint16_t groups, uint16_t stride_h, uint16_t stride_w, uint16_t dilation_h, uint16_t dilation_w, float fused_clamp_low, float fused_clamp_high, bool fused_lut, int32_t fused_lut_zero_point, float fused_lut_scale, reduce_op_t pool_op, float pool_init_value, uint16_t pool_filter_h, uint16_t pool_filter_w, uint16_t pool_stride_h, uint16_t pool_stride_w, float pool_clamp_low, float pool_clamp_high)
+{
+    op_writer<tensor_conv2d_pool_op_t>()(tensor_conv2d_pool_op_t(datatype, rshape_src, rstride_src, rshape_kernel, rstride_kernel, rstride_bias, rstride_dest, groups, stride_h, stride_w, dilation_h, dilation_w, fused_clamp_low, fused_clamp_high, fused_lut, fused_lut_zero_point, fused_lut_scale, pool_op, pool_init_value, pool_filter_h, pool_filter_w, pool_stride_h, pool_stride_w, pool_clamp_low, pool_clamp_high), writer_);
+}
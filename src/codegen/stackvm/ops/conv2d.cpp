@@ -29,6 +29,8 @@ void stackvm_module_builder::emit(conv2d &node, stackvm_op_builder &builder)
     builder.lea_buffer(weights);
     builder.lea_buffer(bias);
     builder.lea_buffer(output);
+    if (node.has_activation_table())
+        builder.lea_buffer(allocation(node.activation_table()));
     builder.ldpadding(node.padding_h());
     builder.ldpadding(node.padding_w());
 
@@ -39,5 +41,6 @@ void stackvm_module_builder::emit(conv2d &node, stackvm_op_builder &builder)
     builder.stshape(4, bias.strides);
     builder.stshape(5, output.strides);
     builder.tensor_conv2d_(node.input().type(), 0, 1, 2, 3, 4, 5, (uint16_t)node.groups(), (uint16_t)node.stride_h(), (uint16_t)node.stride_w(),
-        (uint16_t)node.dilation_h(), (uint16_t)node.dilation_w(), node.fused_activation().min, node.fused_activation().max);
+        (uint16_t)node.dilation_h(), (uint16_t)node.dilation_w(), node.fused_activation().min, node.fused_activation().max,
+        node.has_activation_table(), node.activation_param().zero_point, node.activation_param().scale);
 }
@@ -0,0 +1,36 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../module_builder.h"
+
+using namespace nncase;
+using namespace nncase::codegen;
+using namespace nncase::codegen::stackvm;
+using namespace nncase::ir;
+
+void stackvm_module_builder::emit(detection_postprocess &node, stackvm_op_builder &builder)
+{
+    auto &boxes = allocation(node.boxes());
+    auto &scores = allocation(node.scores());
+    auto &output = allocation(node.output());
+    builder.lea_buffer(boxes);
+    builder.lea_buffer(scores);
+    builder.lea_buffer(output);
+    builder.stshape(0, boxes.shape);
+    builder.stshape(1, boxes.strides);
+    builder.stshape(2, scores.shape);
+    builder.stshape(3, scores.strides);
+    builder.tensor_detection_postprocess_(node.boxes().type(), 0, 1, 2, 3, node.center_point_box(), node.max_output_boxes_per_class(),
+        node.iou_threshold(), node.score_threshold());
+}
@@ -0,0 +1,41 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../module_builder.h"
+
+using namespace nncase;
+using namespace nncase::codegen;
+using namespace nncase::codegen::stackvm;
+using namespace nncase::ir;
+
+void stackvm_module_builder::emit(image_preprocess &node, stackvm_op_builder &builder)
+{
+    auto &input = allocation(node.input());
+    auto &mean = allocation(node.mean());
+    auto &stddev = allocation(node.stddev());
+    auto &output = allocation(node.output());
+    auto &param = node.input_param();
+    auto &resize_shape = node.resize_shape();
+    auto &paddings = node.paddings();
+    builder.lea_buffer(input);
+    builder.lea_buffer(mean);
+    builder.lea_buffer(stddev);
+    builder.lea_buffer(output);
+    builder.stshape(0, input.shape);
+    builder.stshape(1, input.strides);
+    builder.stshape(2, output.shape);
+    builder.stshape(3, output.strides);
+    builder.tensor_image_preprocess_(node.input().type(), 0, 1, 2, 3, param.zero_point, param.scale, node.input_nhwc(), node.swap_rb(),
+        resize_shape[0], resize_shape[1], paddings[0].before, paddings[1].before, node.pad_value(), node.output_nhwc());
+}
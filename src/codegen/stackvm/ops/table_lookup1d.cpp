@@ -27,8 +27,16 @@ void stackvm_module_builder::emit(table_lookup1d &node, stackvm_op_builder &buil
     builder.lea_buffer(input);
     builder.lea_buffer(table);
     builder.lea_buffer(output);
-    builder.ldscalar((uint8_t)0);
-    builder.ldscalar((uint8_t)255);
+    if (node.input().type() == dt_int8)
+    {
+        builder.ldscalar(std::numeric_limits<int8_t>::lowest());
+        builder.ldscalar(std::numeric_limits<int8_t>::max());
+    }
+    else
+    {
+        builder.ldscalar((uint8_t)0);
+        builder.ldscalar((uint8_t)255);
+    }
 
     builder.stshape(0, input.shape);
     builder.stshape(1, input.strides);
@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <fstream>
 #include <nncase/data/dataset.h>
 #include <opencv2/core.hpp>
@@ -39,6 +40,9 @@ dataset::dataset(const std::filesystem::path &path, std::function<bool(const std
             filenames_.emplace_back(path);
     }
 
+    // Keep a stable order across platforms, samples of multi inputs are paired by order
+    std::sort(filenames_.begin(), filenames_.end());
+
     size_t samples = (filenames_.size() / batch_size()) * batch_size();
     filenames_.resize(samples);
 
@@ -124,6 +124,9 @@ void function_evaluate_context::evaluate(eval_step step = nncase::ir::eval_step:
     using clock = chrono::high_resolution_clock;
     chrono::nanoseconds total_duration = {};
     auto quantizer = module().quantizer();
+    step_ = step;
+    stage_ = stage;
+    record_output_buffers_ = record_output_buffers;
 
     for (auto &&node : sched_.compute_sequence)
     {
@@ -174,6 +177,8 @@ module_evaluate_context::module_evaluate_context(const module_schedule_result &s
 
 std::byte *module_evaluate_context::memory_pool(memory_location_t location) const
 {
+    if (location == mem_shared_data)
+        return model_eval_.shared_memory_pool();
     return memory_pools_.at(location).get();
 }
 
@@ -208,6 +213,14 @@ void module_evaluate_context::end_collect_distribution(const std::function<void(
 model_evaluate_context::model_evaluate_context(const schedule::model_schedule_result &sched)
     : sched_(sched)
 {
+    size_t shared_usage = 0;
+    for (auto &module : sched.modules)
+    {
+        for (auto &usage : module.shared_max_usages)
+            shared_usage = std::max(shared_usage, usage.second);
+    }
+
+    shared_memory_pool_ = std::make_unique<std::byte[]>(shared_usage);
     for (auto &module : sched.modules)
         module_ctxs_.emplace(std::piecewise_construct, std::forward_as_tuple(module.type), std::forward_as_tuple(module, *this));
 }
@@ -22,18 +22,23 @@
 #include <nncase/ir/ops/clamp.h>
 #include <nncase/ir/ops/concat.h>
 #include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_pool.h>
 #include <nncase/ir/ops/conv2d_transpose.h>
 #include <nncase/ir/ops/convert.h>
 #include <nncase/ir/ops/cumsum.h>
 #include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/detection_postprocess.h>
 #include <nncase/ir/ops/fused_unary.h>
 #include <nncase/ir/ops/gather.h>
 #include <nncase/ir/ops/gather_nd.h>
 #include <nncase/ir/ops/hardmax.h>
+#include <nncase/ir/ops/image_preprocess.h>
+#include <nncase/ir/ops/loop.h>
 #include <nncase/ir/ops/matmul.h>
 #include <nncase/ir/ops/onehot.h>
 #include <nncase/ir/ops/pad.h>
 #include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/ops/quantized_binary.h>
 #include <nncase/ir/ops/random_normal.h>
 #include <nncase/ir/ops/random_uniform.h>
 #include <nncase/ir/ops/reduce.h>
@@ -44,6 +49,7 @@
 #include <nncase/ir/ops/slice.h>
 #include <nncase/ir/ops/table_lookup.h>
 #include <nncase/ir/ops/ternary.h>
+#include <nncase/ir/ops/topk.h>
 #include <nncase/ir/ops/transpose.h>
 #include <nncase/ir/ops/unary.h>
 #include <nncase/ir/runtime_type_utils.h>
@@ -81,6 +87,22 @@ namespace
 void nop_evaluator(ir::node &, function_evaluate_context &)
 {
 }
+
+void copy_tensor(const evaluate_tensor &src, const evaluate_tensor &dest)
+{
+    kernels::copy(src.datatype(), src.buffer().data(), dest.buffer().data(), src.shape(), src.strides(), dest.strides())
+        .unwrap_or_throw();
+}
+
+// View of the index-th sub-tensor along axis 0
+evaluate_tensor scan_slice(const evaluate_tensor &tensor, size_t index)
+{
+    runtime_shape_t shape(tensor.shape().begin() + 1, tensor.shape().end());
+    runtime_shape_t strides(tensor.strides().begin() + 1, tensor.strides().end());
+    auto offset = index * tensor.strides()[0] * runtime::get_bytes(tensor.datatype());
+    auto size = tensor.buffer().size() - offset;
+    return evaluate_tensor(tensor.datatype(), shape, strides, tensor.buffer().subspan(offset, size));
+}
 }
 
 namespace nncase::ir
@@ -91,6 +113,7 @@ void register_neutral_evaluators()
     register_evaluator(op_output_node, nop_evaluator);
     register_evaluator(op_ignore_node, nop_evaluator);
     register_evaluator(op_constant, nop_evaluator);
+    register_evaluator(op_uninitialized, nop_evaluator);
 
     register_evaluator(op_batch_to_space, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<batch_to_space &>(node);
@@ -120,6 +143,34 @@ void register_neutral_evaluators()
             .unwrap_or_throw();
     });
 
+    register_evaluator(op_quantized_binary, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<quantized_binary &>(node);
+
+        auto datatype = rnode.input_a().type();
+        auto input_a = context.memory_at(rnode.input_a());
+        auto input_b = context.memory_at(rnode.input_b());
+        auto output = context.memory_at(rnode.output());
+
+        auto binary = [&](auto *input_a_ptr, auto *input_b_ptr, auto *output_ptr) {
+            kernels::quantized_binary(rnode.binary_op(), input_a_ptr, input_b_ptr, output_ptr, input_a.shape(), input_a.strides(),
+                input_b.shape(), input_b.strides(), output.strides(), rnode.input_a_param(), rnode.input_b_param(), rnode.output_param(),
+                rnode.fused_activation())
+                .unwrap_or_throw();
+        };
+
+        switch (datatype)
+        {
+        case dt_uint8:
+            binary(input_a.buffer().as_span<uint8_t>().data(), input_b.buffer().as_span<uint8_t>().data(), output.buffer().as_span<uint8_t>().data());
+            break;
+        case dt_int8:
+            binary(input_a.buffer().as_span<int8_t>().data(), input_b.buffer().as_span<int8_t>().data(), output.buffer().as_span<int8_t>().data());
+            break;
+        default:
+            throw std::runtime_error("unsupported dtype for quantized_binary: " + std::string(datatype_names(datatype)));
+        }
+    });
+
     register_evaluator(op_broadcast, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<broadcast &>(node);
 
@@ -162,10 +213,34 @@ void register_neutral_evaluators()
         auto weights_mem = weights.buffer().as_span<float>();
         auto bias_mem = bias.buffer().as_span<float>();
         auto output_mem = output.buffer().as_span<float>();
+        auto fused_lut = activation_lut::none();
+        if (rnode.has_activation_table())
+            fused_lut = { context.memory_at(rnode.activation_table()).buffer().as_span<float>().data(), rnode.activation_param() };
 
         kernels::conv2d(input_mem.data(), weights_mem.data(), bias_mem.data(), output_mem.data(), input.shape(), input.strides(),
             weights.shape(), weights.strides(), bias.strides(), output.strides(), rnode.padding_h(), rnode.padding_w(),
-            rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
+            rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation(), fused_lut)
+            .unwrap_or_throw();
+    });
+
+    register_evaluator(op_conv2d_pool, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<conv2d_pool &>(node);
+
+        assert(rnode.input().type() == dt_float32);
+
+        auto input = context.memory_at(rnode.input());
+        auto weights = context.memory_at(rnode.weights());
+        auto bias = context.memory_at(rnode.bias());
+        auto output = context.memory_at(rnode.output());
+        auto fused_lut = activation_lut::none();
+        if (rnode.has_activation_table())
+            fused_lut = { context.memory_at(rnode.activation_table()).buffer().as_span<float>().data(), rnode.activation_param() };
+
+        kernels::conv2d_pool(input.buffer().as_span<float>().data(), weights.buffer().as_span<float>().data(), bias.buffer().as_span<float>().data(),
+            output.buffer().as_span<float>().data(), input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), output.strides(),
+            rnode.padding_h(), rnode.padding_w(), rnode.groups(), rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(),
+            rnode.fused_activation(), fused_lut, rnode.pool_op(), rnode.pool_init_value(), rnode.pool_filter_h(), rnode.pool_filter_w(),
+            rnode.pool_padding_h(), rnode.pool_padding_w(), rnode.pool_stride_h(), rnode.pool_stride_w(), rnode.pool_activation())
             .unwrap_or_throw();
     });
 
@@ -332,16 +407,31 @@ void register_neutral_evaluators()
     register_evaluator(op_reduce_window2d, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<reduce_window2d &>(node);
 
-        assert(rnode.input().type() == dt_float32);
+        auto datatype = rnode.input().type();
         auto input = context.memory_at(rnode.input());
         auto output = context.memory_at(rnode.output());
-        auto input_mem = input.buffer().as_span<float>();
-        auto output_mem = output.buffer().as_span<float>();
 
-        kernels::reduce_window2d(rnode.reduce_op(), input_mem.data(), rnode.init_value(), output_mem.data(),
-            input.shape(), input.strides(), output.strides(), rnode.padding_h(), rnode.padding_w(), rnode.filter_h(), rnode.filter_w(),
-            rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
-            .unwrap_or_throw();
+        auto reduce_window = [&](auto *input_ptr, auto *output_ptr) {
+            kernels::reduce_window2d(rnode.reduce_op(), input_ptr, rnode.init_value(), output_ptr,
+                input.shape(), input.strides(), output.strides(), rnode.padding_h(), rnode.padding_w(), rnode.filter_h(), rnode.filter_w(),
+                rnode.stride_h(), rnode.stride_w(), rnode.dilation_h(), rnode.dilation_w(), rnode.fused_activation())
+                .unwrap_or_throw();
+        };
+
+        switch (datatype)
+        {
+        case dt_float32:
+            reduce_window(input.buffer().as_span<float>().data(), output.buffer().as_span<float>().data());
+            break;
+        case dt_uint8:
+            reduce_window(input.buffer().as_span<uint8_t>().data(), output.buffer().as_span<uint8_t>().data());
+            break;
+        case dt_int8:
+            reduce_window(input.buffer().as_span<int8_t>().data(), output.buffer().as_span<int8_t>().data());
+            break;
+        default:
+            throw std::runtime_error("unsupported dtype for reduce_window2d: " + std::string(datatype_names(datatype)));
+        }
     });
 
     register_evaluator(op_bitcast, [](ir::node &node, function_evaluate_context &context) {
@@ -510,12 +600,13 @@ void register_neutral_evaluators()
     register_evaluator(op_table_lookup1d, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<table_lookup1d &>(node);
 
-        assert(rnode.input().type() == dt_uint8);
-        auto input = context.memory_at(rnode.input()).buffer().as_span<uint8_t>();
-        auto table = context.memory_at(rnode.table()).buffer().as_span<uint8_t>();
-        auto output = context.memory_at(rnode.output()).buffer().as_span<uint8_t>();
+        auto input = context.memory_at(rnode.input());
+        auto table = context.memory_at(rnode.table());
+        auto output = context.memory_at(rnode.output());
 
-        kernels::neutral::table_lookup1d(input.data(), output.data(), input.size(), table.data());
+        kernels::lut1d(input.datatype(), input.buffer().data(), table.buffer().data(), output.buffer().data(), input.shape(),
+            input.strides(), output.strides(), {}, {})
+            .unwrap_or_throw();
     });
 
     register_evaluator(op_clamp, [](ir::node &node, function_evaluate_context &context) {
@@ -632,6 +723,122 @@ void register_neutral_evaluators()
         }
     });
 
+    register_evaluator(op_detection_postprocess, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<detection_postprocess &>(node);
+        auto datatype = rnode.boxes().type();
+        auto boxes = context.memory_at(rnode.boxes());
+        auto scores = context.memory_at(rnode.scores());
+        auto output = context.memory_at(rnode.output());
+
+        switch (datatype)
+        {
+        case dt_float32:
+            kernels::detection_postprocess(boxes.buffer().as_span<float>().data(), boxes.shape(), boxes.strides(),
+                scores.buffer().as_span<float>().data(), scores.shape(), scores.strides(), output.buffer().as_span<int64_t>().data(),
+                rnode.center_point_box(), rnode.max_output_boxes_per_class(), rnode.iou_threshold(), rnode.score_threshold())
+                .unwrap_or_throw();
+            break;
+        default:
+            throw std::runtime_error("unsupported dtype for detection_postprocess: " + std::string(datatype_names(datatype)));
+        }
+    });
+
+    register_evaluator(op_topk, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<topk &>(node);
+        auto datatype = rnode.input().type();
+        auto input = context.memory_at(rnode.input());
+        auto values = context.memory_at(rnode.values());
+        auto indices = context.memory_at(rnode.indices());
+
+        switch (datatype)
+        {
+        case dt_float32:
+            kernels::topk(input.buffer().as_span<float>().data(), values.buffer().as_span<float>().data(), indices.buffer().as_span<int64_t>().data(),
+                input.shape(), input.strides(), values.strides(), indices.strides(), rnode.k(), rnode.axis(), rnode.largest(), rnode.sorted())
+                .unwrap_or_throw();
+            break;
+        default:
+            throw std::runtime_error("unsupported dtype for topk: " + std::string(datatype_names(datatype)));
+        }
+    });
+
+    register_evaluator(op_image_preprocess, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<image_preprocess &>(node);
+        auto datatype = rnode.input().type();
+        auto input = context.memory_at(rnode.input());
+        auto mean = context.memory_at(rnode.mean()).buffer().as_span<float>();
+        auto stddev = context.memory_at(rnode.stddev()).buffer().as_span<float>();
+        auto output = context.memory_at(rnode.output());
+        auto &resize_shape = rnode.resize_shape();
+        auto &paddings = rnode.paddings();
+
+        auto preprocess = [&](auto *input_ptr) {
+            kernels::image_preprocess(input_ptr, mean.data(), stddev.data(), output.buffer().as_span<float>().data(), input.shape(), input.strides(),
+                output.shape(), output.strides(), rnode.input_param(), rnode.input_nhwc(), rnode.swap_rb(), resize_shape[0], resize_shape[1],
+                paddings[0].before, paddings[1].before, rnode.pad_value(), rnode.output_nhwc())
+                .unwrap_or_throw();
+        };
+
+        switch (datatype)
+        {
+        case dt_uint8:
+            preprocess(input.buffer().as_span<uint8_t>().data());
+            break;
+        case dt_int8:
+            preprocess(input.buffer().as_span<int8_t>().data());
+            break;
+        case dt_float32:
+            preprocess(input.buffer().as_span<float>().data());
+            break;
+        default:
+            throw std::runtime_error("unsupported dtype for image_preprocess: " + std::string(datatype_names(datatype)));
+        }
+    });
+
+    register_evaluator(op_loop, [](ir::node &node, function_evaluate_context &context) {
+        auto &rnode = static_cast<loop &>(node);
+        auto &body = rnode.body();
+        auto &body_ctx = context.module().model().module(body.module_type()).function(body);
+        auto num_states = rnode.num_states();
+        auto num_scan_inputs = rnode.num_scan_inputs();
+
+        for (size_t i = 0; i < num_states; i++)
+            copy_tensor(context.memory_at(rnode.initial_state(i)), body_ctx.input_at(i));
+        for (size_t i = 0; i < rnode.num_invariants(); i++)
+            copy_tensor(context.memory_at(rnode.invariant(i)), body_ctx.input_at(num_states + num_scan_inputs + i));
+
+        // Next states may alias the current ones, stage them before feeding back
+        std::vector<std::vector<gsl::byte>> next_states(num_states);
+        for (size_t t = 0; t < rnode.trip_count(); t++)
+        {
+            for (size_t i = 0; i < num_scan_inputs; i++)
+                copy_tensor(scan_slice(context.memory_at(rnode.scan_input(i)), t), body_ctx.input_at(num_states + i));
+
+            body_ctx.evaluate(context.step(), context.stage(), context.record_output_buffers());
+
+            for (size_t i = 0; i < num_states; i++)
+            {
+                auto out = body_ctx.output_at(i);
+                next_states[i].resize(out.buffer().size());
+                std::copy(out.buffer().begin(), out.buffer().end(), next_states[i].begin());
+            }
+
+            for (size_t i = 0; i < num_states; i++)
+            {
+                auto in = body_ctx.input_at(i);
+                auto out = body_ctx.output_at(i);
+                evaluate_tensor staged(out.datatype(), out.shape(), out.strides(), next_states[i]);
+                copy_tensor(staged, in);
+            }
+
+            for (size_t i = 0; i < rnode.num_scan_outputs(); i++)
+                copy_tensor(body_ctx.output_at(num_states + i), scan_slice(context.memory_at(rnode.scan_output(i)), t));
+        }
+
+        for (size_t i = 0; i < num_states; i++)
+            copy_tensor(body_ctx.input_at(i), context.memory_at(rnode.final_state(i)));
+    });
+
     register_evaluator(op_random_normal, [](ir::node &node, function_evaluate_context &context) {
         auto &rnode = static_cast<random_normal &>(node);
         auto datatype = rnode.output().type();
@@ -162,6 +162,11 @@ bool quantizer::has_record(ir::output_connector &connector) const
     return has_record_.contains(&connector) && has_record_.at(&connector);
 }
 
+bool quantizer::has_range(ir::output_connector &connector) const
+{
+    return quant_ranges_.contains(&connector);
+}
+
 void quantizer::record(output_connector &connector, std::span<const float> data)
 {
     switch (stage_)
@@ -15,43 +15,191 @@
  * limitations under the License.
  * 
  */
+#include <algorithm>
+#include <cmath>
 #include <nncase/functional/ops.platform.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/dbg.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase::runtime;
+
+namespace
+{
+// Host tensors are mapped in place, no staging copies are made
+#define MAP_HOST(name, tensor, access)                            \
+    CHECK_WITH_ERR((tensor).is_host(), std::errc::invalid_argument); \
+    try_var(name, hrt::map(tensor, access))
+
+template <class T>
+const T *cdata(const hrt::mapped_buffer &map) noexcept
+{
+    return reinterpret_cast<const T *>(map.buffer().data());
+}
+
+template <class T>
+T *data(const hrt::mapped_buffer &map) noexcept
+{
+    return reinterpret_cast<T *>(map.buffer().data());
+}
+
+nncase::result<nncase::scalar> to_scalar(nncase::datatype_t type, float value) noexcept
+{
+    switch (type)
+    {
+    case nncase::dt_float32:
+        return nncase::ok(nncase::scalar(value));
+    case nncase::dt_uint8:
+        return nncase::ok(nncase::scalar((uint8_t)value));
+    case nncase::dt_int8:
+        return nncase::ok(nncase::scalar((int8_t)value));
+    case nncase::dt_int32:
+        return nncase::ok(nncase::scalar((int32_t)value));
+    default:
+        return nncase::err(std::errc::not_supported);
+    }
+}
+
+nncase::result<void> resize_image(nncase::image_resize_mode_t resize_mode, nncase::datatype_t type, const gsl::byte *input, gsl::byte *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, size_t out_h, size_t out_w,
+    bool align_corners, bool half_pixel_centers) noexcept
+{
+    switch (resize_mode)
+    {
+    case nncase::image_resize_bilinear:
+        return nncase::kernels::resize_bilinear(type, input, output, in_shape, in_strides, out_strides, (int32_t)out_h, (int32_t)out_w, align_corners, half_pixel_centers);
+    case nncase::image_resize_nearest_neighbor:
+        return nncase::kernels::resize_nearest_neighbor(type, input, output, in_shape, in_strides, out_strides, (int32_t)out_h, (int32_t)out_w, align_corners, half_pixel_centers);
+    default:
+        return nncase::err(std::errc::not_supported);
+    }
+}
+}
 
 namespace nncase::F::impl
 {
 
-result<runtime::runtime_tensor> unary(NNCASE_UNUSED runtime::runtime_tensor &input, NNCASE_UNUSED datatype_t dtype, NNCASE_UNUSED unary_op_t op_type) noexcept
+result<runtime::runtime_tensor> unary(runtime::runtime_tensor &input, datatype_t dtype, unary_op_t op_type) noexcept
 {
-    return err(std::errc::not_supported);
+    CHECK_WITH_ERR(input.datatype() == dt_float32 && dtype == dt_float32, std::errc::not_supported);
+    try_var(output, hrt::create(dtype, input.shape()));
+    MAP_HOST(in_map, input, hrt::map_read);
+    try_var(out_map, hrt::map(output, hrt::map_write));
+    try_(kernels::unary(op_type, cdata<float>(in_map), data<float>(out_map), input.shape(), input.strides(), output.strides()));
+    return ok(output);
 }
 
-result<runtime::runtime_tensor> binary(NNCASE_UNUSED runtime::runtime_tensor &input_a, NNCASE_UNUSED runtime::runtime_tensor &input_b, NNCASE_UNUSED datatype_t dtype, NNCASE_UNUSED binary_op_t op_type) noexcept
+result<runtime::runtime_tensor> binary(runtime::runtime_tensor &input_a, runtime::runtime_tensor &input_b, datatype_t dtype, binary_op_t op_type) noexcept
 {
-    return err(std::errc::not_supported);
+    CHECK_WITH_ERR(input_a.datatype() == dt_float32 && input_b.datatype() == dt_float32 && dtype == dt_float32, std::errc::not_supported);
+    try_var(output, hrt::create(dtype, kernels::detail::get_binary_output_shape(input_a.shape(), input_b.shape())));
+    MAP_HOST(a_map, input_a, hrt::map_read);
+    MAP_HOST(b_map, input_b, hrt::map_read);
+    try_var(out_map, hrt::map(output, hrt::map_write));
+    try_(kernels::binary(op_type, cdata<float>(a_map), cdata<float>(b_map), data<float>(out_map), input_a.shape(), input_a.strides(),
+        input_b.shape(), input_b.strides(), output.strides(), value_range<float>::full()));
+    return ok(output);
 }
 
-result<runtime::runtime_tensor> quantize(NNCASE_UNUSED runtime::runtime_tensor &input, NNCASE_UNUSED datatype_t dtype) noexcept
+result<runtime::runtime_tensor> quantize(runtime::runtime_tensor &input, datatype_t dtype) noexcept
 {
-    return err(std::errc::not_supported);
+    CHECK_WITH_ERR(input.datatype() == dt_float32 && (dtype == dt_uint8 || dtype == dt_int8), std::errc::not_supported);
+    // Quantized with the parameter carried by the input tensor
+    auto param = input.quant_param();
+    try_var(output, hrt::create(dtype, input.shape()));
+    output.quant_param(param);
+    MAP_HOST(in_map, input, hrt::map_read);
+    try_var(out_map, hrt::map(output, hrt::map_write));
+    try_(kernels::quantize(dt_float32, dtype, in_map.buffer().data(), out_map.buffer().data(), input.shape(), input.strides(), output.strides(),
+        1.f / param.scale, (float)param.zero_point));
+    return ok(output);
 }
 
-result<runtime::runtime_tensor> dequantize(NNCASE_UNUSED runtime::runtime_tensor &input, NNCASE_UNUSED datatype_t dtype) noexcept
+result<runtime::runtime_tensor> dequantize(runtime::runtime_tensor &input, datatype_t dtype) noexcept
 {
-    return err(std::errc::not_supported);
+    CHECK_WITH_ERR((input.datatype() == dt_uint8 || input.datatype() == dt_int8) && dtype == dt_float32, std::errc::not_supported);
+    auto param = input.quant_param();
+    try_var(output, hrt::create(dtype, input.shape()));
+    MAP_HOST(in_map, input, hrt::map_read);
+    try_var(out_map, hrt::map(output, hrt::map_write));
+    try_(kernels::dequantize(input.datatype(), dtype, in_map.buffer().data(), out_map.buffer().data(), input.shape(), input.strides(), output.strides(),
+        param.scale, -param.zero_point * param.scale));
+    return ok(output);
 }
 
-result<runtime::runtime_tensor> crop(NNCASE_UNUSED runtime::runtime_tensor &input, NNCASE_UNUSED runtime::runtime_tensor &bbox, NNCASE_UNUSED size_t out_h, NNCASE_UNUSED size_t out_w, NNCASE_UNUSED image_resize_mode_t resize_mode) noexcept
+result<runtime::runtime_tensor> crop(runtime::runtime_tensor &input, runtime::runtime_tensor &bbox, size_t out_h, size_t out_w, image_resize_mode_t resize_mode, bool align_corners, bool half_pixel_centers) noexcept
 {
-    return err(std::errc::not_supported);
+    auto &in_shape = input.shape();
+    auto &in_strides = input.strides();
+    CHECK_WITH_ERR(in_shape.size() == 4, std::errc::invalid_argument);
+    CHECK_WITH_ERR(bbox.datatype() == dt_float32 && bbox.shape().size() == 4 && bbox.shape()[3] == 4, std::errc::invalid_argument);
+
+    // One output image per (batch, roi), batch major
+    auto rois = bbox.shape()[2];
+    try_var(output, hrt::create(input.datatype(), runtime_shape_t { in_shape[0] * rois, in_shape[1], out_h, out_w }));
+    MAP_HOST(in_map, input, hrt::map_read);
+    MAP_HOST(bbox_map, bbox, hrt::map_read);
+    try_var(out_map, hrt::map(output, hrt::map_write));
+
+    auto unit = get_bytes(input.datatype());
+    auto &out_strides = output.strides();
+    auto boxes = cdata<float>(bbox_map);
+    for (size_t n = 0; n < in_shape[0]; n++)
+    {
+        for (size_t r = 0; r < rois; r++)
+        {
+            auto box = [&](size_t i) { return boxes[offset(bbox.strides(), runtime_shape_t { 0, 0, r, i })]; };
+            // [y0, x0, y1, x1) in pixels, clamped to the image
+            auto y0 = (size_t)std::clamp(std::floor(box(0)), 0.f, (float)in_shape[2]);
+            auto x0 = (size_t)std::clamp(std::floor(box(1)), 0.f, (float)in_shape[3]);
+            auto y1 = (size_t)std::clamp(std::ceil(box(2)), 0.f, (float)in_shape[2]);
+            auto x1 = (size_t)std::clamp(std::ceil(box(3)), 0.f, (float)in_shape[3]);
+            CHECK_WITH_ERR(y1 > y0 && x1 > x0, std::errc::invalid_argument);
+
+            // The roi is read as a strided view of the input
+            runtime_shape_t roi_shape { 1, in_shape[1], y1 - y0, x1 - x0 };
+            auto roi = in_map.buffer().data() + (n * in_strides[0] + y0 * in_strides[2] + x0 * in_strides[3]) * unit;
+            auto dest = out_map.buffer().data() + (n * rois + r) * out_strides[0] * unit;
+            try_(resize_image(resize_mode, input.datatype(), roi, dest, roi_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers));
+        }
+    }
+
+    return ok(output);
 }
 
-result<runtime::runtime_tensor> resize(NNCASE_UNUSED runtime::runtime_tensor &input, NNCASE_UNUSED size_t out_h, NNCASE_UNUSED size_t out_w, NNCASE_UNUSED image_resize_mode_t resize_mode) noexcept
+result<runtime::runtime_tensor> resize(runtime::runtime_tensor &input, size_t out_h, size_t out_w, image_resize_mode_t resize_mode, bool align_corners, bool half_pixel_centers) noexcept
 {
-    return err(std::errc::not_supported);
+    auto &in_shape = input.shape();
+    CHECK_WITH_ERR(in_shape.size() == 4, std::errc::invalid_argument);
+    try_var(output, hrt::create(input.datatype(), runtime_shape_t { in_shape[0], in_shape[1], out_h, out_w }));
+    MAP_HOST(in_map, input, hrt::map_read);
+    try_var(out_map, hrt::map(output, hrt::map_write));
+    try_(resize_image(resize_mode, input.datatype(), in_map.buffer().data(), out_map.buffer().data(), in_shape, input.strides(), output.strides(),
+        out_h, out_w, align_corners, half_pixel_centers));
+    return ok(output);
 }
 
-result<runtime::runtime_tensor> pad(NNCASE_UNUSED runtime::runtime_tensor &input, NNCASE_UNUSED std::vector<padding> &padding, NNCASE_UNUSED pad_mode_t pad_mode, NNCASE_UNUSED float fill_v) noexcept
+result<runtime::runtime_tensor> pad(runtime::runtime_tensor &input, runtime_paddings_t &paddings, pad_mode_t pad_mode, float fill_v) noexcept
 {
-    return err(std::errc::not_supported);
+    auto &in_shape = input.shape();
+    CHECK_WITH_ERR(paddings.size() <= in_shape.size(), std::errc::invalid_argument);
+
+    // paddings are given from the last dim
+    runtime_paddings_t full_paddings(in_shape.size(), padding::zero());
+    for (size_t i = 0; i < paddings.size(); i++)
+        full_paddings[in_shape.size() - 1 - i] = paddings[i];
+
+    try_var(pad_value, to_scalar(input.datatype(), fill_v));
+    auto out_shape = in_shape;
+    for (size_t i = 0; i < out_shape.size(); i++)
+        out_shape[i] = (size_t)((int32_t)in_shape[i] + full_paddings[i].sum() + ((int32_t)in_shape[i] - 1) * full_paddings[i].interior);
+
+    try_var(output, hrt::create(input.datatype(), out_shape));
+    MAP_HOST(in_map, input, hrt::map_read);
+    try_var(out_map, hrt::map(output, hrt::map_write));
+    try_(kernels::pad(input.datatype(), in_map.buffer().data(), out_map.buffer().data(), in_shape, input.strides(), output.strides(),
+        full_paddings, pad_mode, pad_value));
+    return ok(output);
+}
 }
-}
\ No newline at end of file
@@ -99,7 +99,7 @@ void caffe_importer::import(std::string &real_inlayout, std::string &real_outlay
     }
 }
 
-void caffe_importer::convert_op(const LayerParameter &op, caffe::NetParameter caffemodel)
+void caffe_importer::convert_op(const LayerParameter &op, const caffe::NetParameter &caffemodel)
 {
     auto type = op.type();
 
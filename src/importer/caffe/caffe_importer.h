@@ -35,9 +35,9 @@ namespace importer
         void import(std::string &real_inlayout, std::string &real_outlayout);
 
     private:
-        void convert_op(const caffe::LayerParameter &op, caffe::NetParameter caffemodel);
+        void convert_op(const caffe::LayerParameter &op, const caffe::NetParameter &caffemodel);
 
-#define DEFINE_OPCODE(opcode) void convert_op_##opcode(const caffe::LayerParameter &op, caffe::NetParameter caffemodel);
+#define DEFINE_OPCODE(opcode) void convert_op_##opcode(const caffe::LayerParameter &op, const caffe::NetParameter &caffemodel);
 #include "opcode.def"
 #undef DEFINE_OPCODE
 
@@ -74,7 +74,7 @@ namespace importer
             return default_val;
         }
 
-        caffe::LayerParameter get_op_data(caffe::LayerParameter op, caffe::NetParameter caffemodel)
+        const caffe::LayerParameter &get_op_data(const caffe::LayerParameter &op, const caffe::NetParameter &caffemodel)
         {
             for (int32_t i = 0; i < caffemodel.layer_size(); i++)
             {
@@ -129,4 +129,4 @@ namespace importer
 }
 
 #define DEFINE_CAFFE_LOWER(opcode) \
-    void nncase::importer::caffe_importer::convert_op_##opcode([[maybe_unused]] const caffe::LayerParameter &op, [[maybe_unused]] caffe::NetParameter caffemodel)
+    void nncase::importer::caffe_importer::convert_op_##opcode([[maybe_unused]] const caffe::LayerParameter &op, [[maybe_unused]] const caffe::NetParameter &caffemodel)
@@ -32,7 +32,7 @@ DEFINE_CAFFE_LOWER(BatchNorm)
     if (param.has_use_global_stats() && !param.use_global_stats())
         throw std::runtime_error("use_global_stats should be true at inference step");
 
-    auto op_data = get_op_data(op, caffemodel);
+    auto &op_data = get_op_data(op, caffemodel);
 
     auto means = load_tensor<1>(op_data.blobs(0));
     auto variants = load_tensor<1>(op_data.blobs(1));
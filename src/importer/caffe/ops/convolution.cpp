@@ -33,7 +33,7 @@ DEFINE_CAFFE_LOWER(Convolution)
 
     auto &input = *output_tensors_.at(input_name);
 
-    auto op_data = get_op_data(op, caffemodel);
+    auto &op_data = get_op_data(op, caffemodel);
 
     auto &param = op.convolution_param();
     auto pad_h = (int32_t)get_or_default(std::bind(arr_func_t(&ConvolutionParameter::pad), &param, _1), param.pad_size(), 0, param.pad_h());
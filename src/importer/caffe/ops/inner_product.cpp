@@ -31,7 +31,7 @@ DEFINE_CAFFE_LOWER(InnerProduct)
     auto &input = *output_tensors_.at(input_name);
     auto &param = op.inner_product_param();
 
-    auto op_data = get_op_data(op, caffemodel);
+    auto &op_data = get_op_data(op, caffemodel);
 
     auto input_b = load_tensor<2>(op_data.blobs(0));
     std::vector<float> input_b_vec(input_b.begin(), input_b.end());
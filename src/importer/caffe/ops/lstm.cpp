@@ -37,7 +37,7 @@ DEFINE_CAFFE_LOWER(LSTM)
     if (param.expose_hidden())
         throw std::runtime_error("expose hidden for lstm is not supported yet");
 
-    auto op_data = get_op_data(op, caffemodel);
+    auto &op_data = get_op_data(op, caffemodel);
 
     std::vector<float> blob_w_static_vec;
 
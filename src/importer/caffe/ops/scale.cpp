@@ -30,7 +30,7 @@ DEFINE_CAFFE_LOWER(Scale)
         auto &input = *output_tensors_.at(input_name);
         auto &param = op.scale_param();
 
-        auto op_data = get_op_data(op, caffemodel);
+        auto &op_data = get_op_data(op, caffemodel);
 
         auto gamma = load_tensor<1>(op_data.blobs(0));
 
@@ -15,12 +15,14 @@
 
 #include "onnx_importer.h"
 #include <algorithm>
+#include <set>
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/message.h>
 #include <nncase/importer/importer.h>
 #include <nncase/importer/util.h>
 #include <nncase/ir/graph.h>
+#include <nncase/parallel.h>
 
 using namespace std;
 using namespace nncase;
@@ -113,6 +115,12 @@ onnx_importer::onnx_importer(std::span<const uint8_t> model, ir::graph &graph)
         throw std::runtime_error("Invalid ONNX model");
 }
 
+onnx_importer::onnx_importer(const onnx_importer &parent, const onnx::GraphProto &body, ir::graph &graph)
+    : graph_(graph), opset_map_(parent.opset_map_), parent_(&parent)
+{
+    *model_.mutable_graph() = body;
+}
+
 void onnx_importer::import(const struct import_options &options, std::string &real_inlayout, std::string &real_outlayout)
 {
     for (auto &opset : model_.opset_import())
@@ -173,7 +181,11 @@ void onnx_importer::import(const struct import_options &options, std::string &re
         // TODO: specify output
     }
 
-    // connect tensors
+    connect_tensors();
+}
+
+void onnx_importer::connect_tensors()
+{
     decltype(input_tensors_) dangling_inputs;
     for (auto &&in : input_tensors_)
     {
@@ -188,15 +200,85 @@ void onnx_importer::import(const struct import_options &options, std::string &re
     }
 
     // try to find and create initializers for not yet connected inputs
+    std::vector<const TensorProto *> initializers;
+    std::unordered_map<std::string, size_t> initializer_ids;
     for (auto &&in : dangling_inputs)
     {
-        auto init_node = emplace_constant(get_initializer(in.second));
+        if (initializer_ids.contains(in.second))
+            continue;
 
-        if (init_node)
-            in.first->connect(init_node->output());
-        else
+        auto initializer = find_initializer(in.second);
+        if (!initializer)
             throw std::runtime_error("Cannot find associated output node, graph input or initializer for input " + in.second);
+        initializer_ids.emplace(in.second, initializers.size());
+        initializers.emplace_back(initializer);
     }
+
+    // initializers hold most of the weights, decode them concurrently and only create the nodes serially
+    std::vector<constant_data> decoded(initializers.size());
+    parallel_for(initializers.size(), [&](size_t i) { decoded[i] = decode_constant(*initializers[i]); });
+
+    std::vector<constant *> init_nodes(initializers.size());
+    for (size_t i = 0; i < decoded.size(); i++)
+    {
+        // Each constant takes its decoded data over, so the weights are never held twice
+        init_nodes[i] = graph_.emplace<constant>(decoded[i].type, decoded[i].shape, std::move(decoded[i].data));
+    }
+
+    for (auto &&in : dangling_inputs)
+        in.first->connect(init_nodes[initializer_ids.at(in.second)]->output());
+}
+
+void onnx_importer::add_body_input(const std::string &name, datatype_t type, const shape_t &shape)
+{
+    auto node = graph_.emplace<input_node>(type, shape);
+    node->name(name);
+    output_tensors_.emplace(name, &node->output());
+}
+
+// Converts a control flow body whose declared inputs are already added.
+// Values captured from enclosing scopes become trailing graph inputs, their names are returned.
+std::vector<std::string> onnx_importer::import_body()
+{
+    const auto &body = model_.graph();
+    for (const auto &node : body.node())
+        convert_op(node);
+
+    for (const auto &output_info : body.output())
+    {
+        const auto &output_name = output_info.name();
+        auto pt_it = passthrough_connections_.find(output_name);
+        const auto &peer_name = pt_it != passthrough_connections_.end() ? pt_it->second : output_name;
+        auto out_it = output_tensors_.find(peer_name);
+        const auto output_dt = get_datatype(peer_name);
+        if (!output_dt)
+            throw std::runtime_error("Data type of output \"" + output_name + "\" is not supported");
+
+        auto node = graph_.emplace<output_node>(output_dt.value(), out_it != output_tensors_.end() ? out_it->second->shape() : get_shape(peer_name));
+        node->name(output_name);
+        input_tensors_.emplace(&node->input(), output_name);
+    }
+
+    std::set<std::string> captures;
+    for (auto &&in : input_tensors_)
+    {
+        auto pt_it = passthrough_connections_.find(in.second);
+        const auto &peer_name = pt_it != passthrough_connections_.end() ? pt_it->second : in.second;
+        if (!output_tensors_.contains(peer_name) && !get_initializer(peer_name))
+            captures.emplace(peer_name);
+    }
+
+    std::vector<std::string> invariants(captures.begin(), captures.end());
+    for (auto &name : invariants)
+    {
+        const auto type = parent_->get_datatype(name);
+        if (!type)
+            throw std::runtime_error("Cannot find captured value " + name + " in enclosing graph");
+        add_body_input(name, type.value(), parent_->get_shape(name));
+    }
+
+    connect_tensors();
+    return invariants;
 }
 
 void onnx_importer::convert_op(const NodeProto &node)
@@ -231,9 +313,14 @@ int64_t onnx_importer::get_opset_version(std::string domain) const
 
 optional<ValueInfoProto> onnx_importer::find_value_info(const string &value) const
 {
-    auto value_info = extract(model_.graph().input(), value);
-    if (value_info)
-        return value_info;
+    // Body inputs are bound with shapes derived from the outer op
+    optional<ValueInfoProto> value_info;
+    if (!parent_)
+    {
+        value_info = extract(model_.graph().input(), value);
+        if (value_info)
+            return value_info;
+    }
 
     value_info = extract(model_.graph().value_info(), value);
     if (value_info)
@@ -261,6 +348,9 @@ shape_t onnx_importer::get_shape(const string &value) const
         auto result_shape = oit->second->shape();
         return result_shape;
     }
+
+    if (parent_)
+        return parent_->get_shape(value);
     throw std::runtime_error("Can't find value info for " + value + " to parse its shape");
 }
 
@@ -325,6 +415,8 @@ optional<datatype_t> onnx_importer::get_datatype(const string &value) const
     if (initializer)
         return get_datatype(initializer.value());
 
+    if (parent_)
+        return parent_->get_datatype(value);
     return optional<datatype_t> {};
 }
 
@@ -574,6 +666,17 @@ optional<TensorProto> onnx_importer::get_attribute<TensorProto>(const onnx::Node
     return attr.value().t();
 }
 
+template <>
+optional<GraphProto> onnx_importer::get_attribute<GraphProto>(const onnx::NodeProto &node, const string &value)
+{
+    typedef GraphProto target_type;
+    const auto &attr = extract(node.attribute(), value);
+    if (!attr)
+        return optional<target_type> {};
+
+    return attr.value().g();
+}
+
 template <>
 optional<vector<float>> onnx_importer::get_attribute<vector<float>>(const onnx::NodeProto &node, const string &value)
 {
@@ -639,10 +742,20 @@ optional<axis_t> onnx_importer::get_attribute<axis_t>(const onnx::NodeProto &nod
 
 optional<TensorProto> onnx_importer::get_initializer(const string &value) const
 {
-    const auto &graph = model_.graph();
-    const auto &initializer = extract(graph.initializer(), value);
+    if (auto initializer = find_initializer(value))
+        return *initializer;
+    return {};
+}
+
+const TensorProto *onnx_importer::find_initializer(const string &value) const
+{
+    for (const auto &initializer : model_.graph().initializer())
+    {
+        if (initializer.name() == value)
+            return &initializer;
+    }
 
-    return initializer;
+    return parent_ ? parent_->find_initializer(value) : nullptr;
 }
 
 template <typename T, typename S>
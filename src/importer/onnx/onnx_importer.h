@@ -33,6 +33,7 @@ class onnx_importer
 {
 public:
     onnx_importer(std::span<const std::uint8_t> model, ir::graph &graph);
+    onnx_importer(const onnx_importer &parent, const onnx::GraphProto &body, ir::graph &graph);
 
     void import(const struct import_options &options, std::string &real_inlayout, std::string &real_outlayout);
 
@@ -44,6 +45,11 @@ private:
         attribute_value_type;
 
     void convert_op(const onnx::NodeProto &node);
+    void connect_tensors();
+    void add_body_input(const std::string &name, datatype_t type, const ir::shape_t &shape);
+    std::vector<std::string> import_body();
+    void emplace_loop(const onnx::NodeProto &node, ir::graph &body, size_t num_states, size_t num_scan_inputs, size_t trip_count,
+        std::span<const std::string> inputs, std::span<const std::string> outputs);
 #define DEFINE_OPCODE(opcode) void convert_op_##opcode(const onnx::NodeProto &node);
 #include "opcode.def"
 #undef DEFINE_OPCODE
@@ -76,6 +82,7 @@ private:
     template <typename T>
     static std::optional<T> get_attribute(const onnx::NodeProto &node, const std::string &name);
     std::optional<onnx::TensorProto> get_initializer(const std::string &name) const;
+    const onnx::TensorProto *find_initializer(const std::string &name) const;
     template <typename T, typename S = T>
     static std::vector<T> raw_to_vector(const onnx::TensorProto &tensor);
     template <typename T, typename S>
@@ -123,6 +130,16 @@ private:
     template <typename T>
     ir::constant *emplace_constant(const std::optional<T> &v);
 
+    struct constant_data
+    {
+        datatype_t type;
+        ir::shape_t shape;
+        std::vector<std::byte> data;
+    };
+
+    // Doesn't touch the graph, so initializers can be decoded concurrently
+    static constant_data decode_constant(const onnx::TensorProto &value);
+
     template <class Cont>
     static xtl::span<const std::uint8_t> span_from(const Cont &data);
 
@@ -136,6 +153,7 @@ private:
     std::unordered_map<ir::input_connector *, std::string> input_tensors_;
     std::unordered_map<std::string, ir::output_connector *> output_tensors_;
     std::unordered_map<std::string, std::string> passthrough_connections_;
+    const onnx_importer *parent_ = nullptr;
 };
 
 template <>
@@ -257,6 +275,8 @@ std::optional<std::string> onnx_importer::get_attribute<std::string>(const onnx:
 template <>
 std::optional<onnx::TensorProto> onnx_importer::get_attribute<onnx::TensorProto>(const onnx::NodeProto &node, const std::string &name);
 template <>
+std::optional<onnx::GraphProto> onnx_importer::get_attribute<onnx::GraphProto>(const onnx::NodeProto &node, const std::string &name);
+template <>
 std::optional<std::vector<float>> onnx_importer::get_attribute<std::vector<float>>(const onnx::NodeProto &node, const std::string &name);
 template <>
 std::optional<std::vector<std::int64_t>> onnx_importer::get_attribute<std::vector<std::int64_t>>(const onnx::NodeProto &node, const std::string &name);
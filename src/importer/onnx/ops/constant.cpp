@@ -17,66 +17,59 @@
 #include <cassert>
 #include <nncase/ir/graph.h>
 #include <nncase/ir/ops/constant.h>
+#include <span>
 
 using namespace nncase;
 using namespace nncase::importer;
 using namespace nncase::ir;
 using namespace onnx;
 
-template <>
-constant *onnx_importer::emplace_constant<TensorProto>(const std::optional<TensorProto> &value)
+namespace
 {
-    if (!value)
-        return nullptr;
+template <class TArray>
+std::vector<std::byte> to_bytes(const TArray &data)
+{
+    auto bytes = std::as_bytes(std::span(data.data(), data.size()));
+    return { bytes.begin(), bytes.end() };
+}
+}
 
-    const auto &v = value.value();
-    shape_t shape = get_shape(v);
-    const auto value_dt = get_datatype(v);
+onnx_importer::constant_data onnx_importer::decode_constant(const TensorProto &value)
+{
+    shape_t shape = get_shape(value);
+    const auto value_dt = get_datatype(value);
 
-    TensorProto_DataType tensor_element_type { v.data_type() };
+    TensorProto_DataType tensor_element_type { value.data_type() };
 
     switch (tensor_element_type)
     {
     case TensorProto_DataType_UINT8:
     case TensorProto_DataType_BOOL:
-    {
-        const auto &data = to<xt::xarray<uint8_t>>(v);
-        std::vector<uint8_t> vec { data.begin(), data.end() };
-        return graph_.emplace<constant>(value_dt.value(), shape, vec);
-    }
-
+        return { value_dt.value(), shape, to_bytes(to<xt::xarray<uint8_t>>(value)) };
     case TensorProto_DataType_FLOAT:
-    {
-        const auto &data = to<xt::xarray<float>>(v);
-        std::vector<float> vec { data.begin(), data.end() };
-        return graph_.emplace<constant>(value_dt.value(), shape, vec);
-    }
-
+        return { value_dt.value(), shape, to_bytes(to<xt::xarray<float>>(value)) };
     case TensorProto_DataType_INT32:
-    {
-        const auto &data = to<xt::xarray<int32_t>>(v);
-        std::vector<int32_t> vec { data.begin(), data.end() };
-        return graph_.emplace<constant>(value_dt.value(), shape, vec);
-    }
+        return { value_dt.value(), shape, to_bytes(to<xt::xarray<int32_t>>(value)) };
     case TensorProto_DataType_INT64:
-    {
-        const auto &data = to<xt::xarray<int64_t>>(v);
-        std::vector<int64_t> vec { data.begin(), data.end() };
-        return graph_.emplace<constant>(value_dt.value(), shape, vec);
-    }
+        return { value_dt.value(), shape, to_bytes(to<xt::xarray<int64_t>>(value)) };
     case TensorProto_DataType_UINT16:
     case TensorProto_DataType_INT16:
-    {
-        const auto &data = convert_to<xt::xarray<float>>(v);
-        std::vector<float> vec { data.begin(), data.end() };
-        return graph_.emplace<constant>(dt_float32, shape, vec);
-    }
-
+        return { dt_float32, shape, to_bytes(convert_to<xt::xarray<float>>(value)) };
     default:
         throw std::runtime_error("Data type \"" + to_string(tensor_element_type) + "\" not supported");
     }
 }
 
+template <>
+constant *onnx_importer::emplace_constant<TensorProto>(const std::optional<TensorProto> &value)
+{
+    if (!value)
+        return nullptr;
+
+    auto data = decode_constant(value.value());
+    return graph_.emplace<constant>(data.type, data.shape, std::move(data.data));
+}
+
 void onnx_importer::convert_op_Constant(const NodeProto &node)
 {
     assert(node.input().size() == 0);
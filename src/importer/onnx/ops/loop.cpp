@@ -0,0 +1,193 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../onnx_importer.h"
+#include <cassert>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/loop.h>
+#include <nncase/ir/placeholders.h>
+#include <numeric>
+
+using namespace nncase;
+using namespace nncase::importer;
+using namespace nncase::ir;
+using namespace onnx;
+
+namespace
+{
+void check_zeros(const std::optional<std::vector<int64_t>> &values, const std::string &op_type, const std::string &attr)
+{
+    if (values && std::any_of(values->begin(), values->end(), [](int64_t v) { return v != 0; }))
+        throw std::runtime_error(op_type + " only supports forward scans along axis 0, got non-zero " + attr);
+}
+
+// The loop condition must stay true, i.e. it is forwarded from cond_in or a constant
+bool is_constant_condition(const GraphProto &body, std::string name)
+{
+    const auto &cond_in = body.input()[1].name();
+    while (true)
+    {
+        if (name == cond_in)
+            return true;
+        if (std::any_of(body.initializer().begin(), body.initializer().end(), [&](const TensorProto &t) { return t.name() == name; }))
+            return true;
+
+        auto it = std::find_if(body.node().begin(), body.node().end(), [&](const NodeProto &n) {
+            return std::find(n.output().begin(), n.output().end(), name) != n.output().end();
+        });
+        if (it == body.node().end())
+            return false;
+        if (it->op_type() == "Constant")
+            return true;
+        if (it->op_type() != "Identity")
+            return false;
+        name = it->input()[0];
+    }
+}
+}
+
+void onnx_importer::emplace_loop(const NodeProto &node, ir::graph &body, size_t num_states, size_t num_scan_inputs, size_t trip_count,
+    std::span<const std::string> inputs, std::span<const std::string> outputs)
+{
+    const auto &op_name { generate_name(node) };
+    body.name(op_name + "_body");
+
+    auto op = graph_.emplace<loop>(body, num_states, num_scan_inputs, trip_count);
+    op->name(op_name);
+
+    assert(inputs.size() == num_states + num_scan_inputs + op->num_invariants());
+    for (size_t i = 0; i < inputs.size(); i++)
+        input_tensors_.emplace(&op->input_at(i), inputs[i]);
+
+    // Carries only need a lifetime spanning the loop
+    for (size_t i = 0; i < num_states; i++)
+    {
+        auto &carry = op->carry(i);
+        auto buffer = graph_.emplace<uninitialized>(carry.type(), carry.shape());
+        buffer->name(op_name + "/carry" + std::to_string(i));
+        carry.connect(buffer->output());
+    }
+
+    for (size_t i = 0; i < outputs.size(); i++)
+        output_tensors_.emplace(outputs[i], &op->output_at(i));
+}
+
+void onnx_importer::convert_op_Scan(const NodeProto &node)
+{
+    if (get_opset_version() < 9)
+        throw std::runtime_error("Scan before opset 9 is not supported");
+
+    const auto body_proto = get_attribute<GraphProto>(node, "body").value();
+    const auto num_scan_inputs = (size_t)get_attribute<int64_t>(node, "num_scan_inputs").value();
+    check_zeros(get_attribute<std::vector<int64_t>>(node, "scan_input_axes"), "Scan", "scan_input_axes");
+    check_zeros(get_attribute<std::vector<int64_t>>(node, "scan_input_directions"), "Scan", "scan_input_directions");
+    check_zeros(get_attribute<std::vector<int64_t>>(node, "scan_output_axes"), "Scan", "scan_output_axes");
+    check_zeros(get_attribute<std::vector<int64_t>>(node, "scan_output_directions"), "Scan", "scan_output_directions");
+
+    const auto num_states = (size_t)node.input().size() - num_scan_inputs;
+    if (num_scan_inputs == 0)
+        throw std::runtime_error("Scan requires at least one scan input");
+    const auto trip_count = get_shape(node.input()[num_states])[0];
+
+    auto &body = graph_.add_subgraph(std::make_unique<ir::graph>(graph_.module_type()));
+    onnx_importer body_importer(*this, body_proto, body);
+    std::vector<std::string> inputs;
+    for (int i = 0; i < node.input().size(); i++)
+    {
+        const auto &input = node.input()[i];
+        auto shape = get_shape(input);
+        if ((size_t)i >= num_states)
+        {
+            shape.erase(shape.begin());
+            if (shape.empty())
+                shape.push_back(1);
+        }
+
+        body_importer.add_body_input(body_proto.input()[i].name(), get_datatype(input).value(), shape);
+        inputs.emplace_back(input);
+    }
+
+    auto invariants = body_importer.import_body();
+    inputs.insert(inputs.end(), invariants.begin(), invariants.end());
+
+    std::vector<std::string> outputs(node.output().begin(), node.output().end());
+    emplace_loop(node, body, num_states, num_scan_inputs, trip_count, inputs, outputs);
+}
+
+void onnx_importer::convert_op_Loop(const NodeProto &node)
+{
+    auto body_proto = get_attribute<GraphProto>(node, "body").value();
+    if (node.input()[0].empty())
+        throw std::runtime_error("Loop without a trip count is not supported");
+    const auto trip_count = (size_t)get_constant_value<int64_t>(node.input()[0])[0];
+
+    // The outer condition gates the first iteration, the loop node always runs trip_count times
+    if (node.input().size() > 1 && !node.input()[1].empty())
+    {
+        const auto &cond_name = node.input()[1];
+        auto cond = get_constant_input_data<uint8_t>(cond_name);
+        if (!cond)
+        {
+            if (auto initializer = find_initializer(cond_name))
+            {
+                auto data = decode_constant(*initializer).data;
+                cond = std::vector<uint8_t>(reinterpret_cast<const uint8_t *>(data.data()), reinterpret_cast<const uint8_t *>(data.data() + data.size()));
+            }
+        }
+
+        if (!cond || cond->empty() || !cond->front())
+            throw std::runtime_error("Loop with a non constant or false initial condition is not supported");
+    }
+
+    const auto cond_out = body_proto.output()[0].name();
+    if (!is_constant_condition(body_proto, cond_out))
+        throw std::runtime_error("Loop with a data dependent condition is not supported");
+
+    // Body inputs are (iter_num, cond_in, states...), outputs are (cond_out, states..., scan outputs...)
+    const auto num_states = (size_t)node.input().size() - 2;
+    const auto iter_num = body_proto.input()[0].name();
+    const auto cond_in = body_proto.input()[1].name();
+    body_proto.mutable_output()->DeleteSubrange(0, 1);
+
+    auto &body = graph_.add_subgraph(std::make_unique<ir::graph>(graph_.module_type()));
+    onnx_importer body_importer(*this, body_proto, body);
+    std::vector<std::string> inputs;
+    for (size_t i = 0; i < num_states; i++)
+    {
+        const auto &input = node.input()[i + 2];
+        body_importer.add_body_input(body_proto.input()[i + 2].name(), get_datatype(input).value(), get_shape(input));
+        inputs.emplace_back(input);
+    }
+
+    // iter_num is scanned from a constant range
+    const auto &op_name { generate_name(node) };
+    std::vector<int64_t> iterations(trip_count);
+    std::iota(iterations.begin(), iterations.end(), 0);
+    auto iter_range = graph_.emplace<constant>(dt_int64, shape_t { trip_count, 1 }, iterations);
+    iter_range->name(op_name + "/iter_num");
+    output_tensors_.emplace(iter_range->name(), &iter_range->output());
+    body_importer.add_body_input(iter_num, dt_int64, shape_t { 1 });
+    inputs.emplace_back(iter_range->name());
+
+    auto cond = body.emplace<constant>(uint8_t(1));
+    cond->name(cond_in);
+    body_importer.output_tensors_.emplace(cond_in, &cond->output());
+
+    auto invariants = body_importer.import_body();
+    inputs.insert(inputs.end(), invariants.begin(), invariants.end());
+
+    std::vector<std::string> outputs(node.output().begin(), node.output().end());
+    emplace_loop(node, body, num_states, 1, trip_count, inputs, outputs);
+}
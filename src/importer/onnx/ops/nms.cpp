@@ -0,0 +1,57 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../onnx_importer.h"
+#include <cassert>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/detection_postprocess.h>
+
+using namespace nncase;
+using namespace nncase::importer;
+using namespace nncase::ir;
+using namespace onnx;
+
+void onnx_importer::convert_op_NonMaxSuppression(const NodeProto &node)
+{
+    assert(node.input().size() >= 2 && node.input().size() <= 5);
+
+    const auto &boxes = node.input()[0];
+    const auto &scores = node.input()[1];
+    const auto &output = node.output()[0];
+    const auto input_type = get_datatype(boxes).value();
+    auto boxes_shape = get_shape(boxes);
+    auto scores_shape = get_shape(scores);
+
+    auto center_point_box_attr = get_attribute<int>(node, "center_point_box");
+    bool center_point_box = center_point_box_attr ? center_point_box_attr.value() != 0 : false;
+
+    // max_output_boxes_per_class, iou_threshold and score_threshold are optional constant inputs
+    auto has_input = [&](int index) { return node.input().size() > index && !node.input()[index].empty(); };
+    int64_t max_output_boxes_per_class = has_input(2) ? get_constant_value<int64_t>(node.input()[2])[0] : 0;
+    float iou_threshold = has_input(3) ? get_constant_value<float>(node.input()[3])[0] : 0.f;
+    float score_threshold = has_input(4) ? get_constant_value<float>(node.input()[4])[0] : std::numeric_limits<float>::lowest();
+
+    // selected_indices is dynamic in onnx, nncase pads it to the per-class maximum
+    if (max_output_boxes_per_class <= 0)
+        throw std::runtime_error("NonMaxSuppression requires a positive constant max_output_boxes_per_class");
+    max_output_boxes_per_class = std::min(max_output_boxes_per_class, (int64_t)boxes_shape[1]);
+
+    auto op = graph_.emplace<detection_postprocess>(input_type, boxes_shape, scores_shape, center_point_box,
+        (int32_t)max_output_boxes_per_class, iou_threshold, score_threshold);
+    op->name(generate_name(node));
+
+    input_tensors_.emplace(&op->boxes(), boxes);
+    input_tensors_.emplace(&op->scores(), scores);
+    output_tensors_.emplace(output, &op->output());
+}
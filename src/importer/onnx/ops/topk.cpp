@@ -0,0 +1,65 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../onnx_importer.h"
+#include <cassert>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/topk.h>
+
+using namespace nncase;
+using namespace nncase::importer;
+using namespace nncase::ir;
+using namespace onnx;
+
+void onnx_importer::convert_op_TopK(const NodeProto &node)
+{
+    const auto &input = node.input()[0];
+    const auto input_type = get_datatype(input).value();
+    auto input_shape = get_shape(input);
+    const auto &values = node.output()[0];
+    const auto &indices = node.output()[1];
+
+    // k is an attribute before opset 10 and a constant input since
+    int64_t k;
+    if (node.input().size() > 1)
+    {
+        k = get_constant_value<int64_t>(node.input()[1])[0];
+    }
+    else
+    {
+        auto k_attr = get_attribute<int>(node, "k");
+        if (!k_attr)
+            throw std::runtime_error("TopK requires k");
+        k = k_attr.value();
+    }
+
+    // axis
+    auto axis_attr = get_attribute<int>(node, "axis");
+    int32_t axis = axis_attr ? axis_attr.value() : -1;
+
+    // largest
+    auto largest_attr = get_attribute<int>(node, "largest");
+    bool largest = largest_attr ? largest_attr.value() != 0 : true;
+
+    // sorted
+    auto sorted_attr = get_attribute<int>(node, "sorted");
+    bool sorted = sorted_attr ? sorted_attr.value() != 0 : true;
+
+    auto op = graph_.emplace<topk>(input_type, input_shape, k, axis, largest, sorted);
+    op->name(generate_name(node));
+
+    input_tensors_.emplace(&op->input(), input);
+    output_tensors_.emplace(values, &op->values());
+    output_tensors_.emplace(indices, &op->indices());
+}
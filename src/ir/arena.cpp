@@ -0,0 +1,119 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <mutex>
+#include <nncase/ir/arena.h>
+#include <nncase/ir/ir_types.h>
+#include <string>
+#include <unordered_set>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+namespace
+{
+constexpr size_t block_size = 64 * 1024;
+
+thread_local ir_arena *current_arena = nullptr;
+
+// Names of nodes built outside of any graph
+struct name_pool
+{
+    std::mutex lock;
+    std::unordered_set<std::string> names;
+};
+
+name_pool &get_name_pool()
+{
+    static name_pool pool;
+    return pool;
+}
+}
+
+void *ir_arena::allocate(size_t bytes, size_t alignment)
+{
+    // Reuse the storage of a destructed object of the same size
+    auto it = free_lists_.find(bytes);
+    if (it != free_lists_.end() && !it->second.empty() && reinterpret_cast<uintptr_t>(it->second.back()) % alignment == 0)
+    {
+        auto ptr = it->second.back();
+        it->second.pop_back();
+        return ptr;
+    }
+
+    auto padding = (alignment - reinterpret_cast<uintptr_t>(current_) % alignment) % alignment;
+    if (padding + bytes > available_)
+    {
+        // Large objects get a block of their own so the current block isn't wasted
+        if (bytes + alignment > block_size / 4)
+        {
+            auto &block = blocks_.emplace_back(std::make_unique<std::byte[]>(bytes + alignment));
+            auto addr = reinterpret_cast<uintptr_t>(block.get());
+            return block.get() + (alignment - addr % alignment) % alignment;
+        }
+
+        current_ = blocks_.emplace_back(std::make_unique<std::byte[]>(block_size)).get();
+        available_ = block_size;
+        padding = (alignment - reinterpret_cast<uintptr_t>(current_) % alignment) % alignment;
+    }
+
+    auto ptr = current_ + padding;
+    current_ = ptr + bytes;
+    available_ -= padding + bytes;
+    return ptr;
+}
+
+void ir_arena::deallocate(void *ptr, size_t bytes) noexcept
+{
+    try
+    {
+        free_lists_[bytes].emplace_back(ptr);
+    }
+    catch (...)
+    {
+        // Not reusing the storage is harmless, it is still freed with the arena
+    }
+}
+
+const std::string &ir_arena::intern(std::string_view name)
+{
+    return *names_.emplace(name).first;
+}
+
+ir_arena *ir_arena::current() noexcept
+{
+    return current_arena;
+}
+
+ir_arena::scope::scope(ir_arena &arena) noexcept
+    : previous_(current_arena)
+{
+    current_arena = &arena;
+}
+
+ir_arena::scope::~scope()
+{
+    current_arena = previous_;
+}
+
+const std::string &nncase::ir::intern_name(std::string_view name)
+{
+    if (auto arena = ir_arena::current())
+        return arena->intern(name);
+
+    auto &pool = get_name_pool();
+    std::lock_guard<std::mutex> guard(pool.lock);
+    return *pool.names.emplace(name).first;
+}
@@ -14,8 +14,10 @@
  */
 #include <nncase/ir/graph.h>
 #include <nncase/ir/ops/call.h>
+#include <nncase/ir/ops/loop.h>
 #include <nncase/ir/visitor.h>
 #include <nncase/runtime/stackvm/runtime_module.h>
+#include <algorithm>
 #include <unordered_set>
 
 using namespace nncase;
@@ -33,6 +35,8 @@ void add_reachable_graphs(graph &root, std::vector<graph *> &graphs)
     auto visitor = make_relay_ir_visitor([&](node &node) {
         if (auto c = node_cast<call>(node))
             subgraphs.emplace(&c->target());
+        else if (auto l = node_cast<loop>(node))
+            subgraphs.emplace(&l->body());
     });
     visitor.visit(root);
     for (auto &g : subgraphs)
@@ -95,13 +99,13 @@ void graph::assign_names()
 
 void graph::dce()
 {
-    std::unordered_set<node *> used_nodes;
+    std::vector<bool> used_nodes(node_id_bound());
 
     for (auto it = outputs_.begin(); it != outputs_.end();)
     {
         if (!(*it)->input().connection())
         {
-            nodes_.erase(std::find_if(nodes_.begin(), nodes_.end(), [it](std::unique_ptr<node> &node) { return node.get() == *it; }));
+            nodes_.erase(std::find_if(nodes_.begin(), nodes_.end(), [it](node_ptr &node) { return node.get() == *it; }));
             it = outputs_.erase(it);
         }
         else
@@ -110,11 +114,12 @@ void graph::dce()
         }
     }
 
-    auto visitor = make_relay_ir_visitor([&](node &node) { used_nodes.emplace(&node); });
+    auto visitor = make_relay_ir_visitor([&](node &node) { used_nodes[node.id()] = true; });
     visitor.visit(*this);
 
+    // Subgraph inputs are kept even if unused, callers bind arguments by position
     auto end = std::remove_if(std::begin(nodes_), std::end(nodes_), [&](auto &node) {
-        if (used_nodes.find(node.get()) == used_nodes.end())
+        if (!used_nodes[node->id()] && (!is_subgraph_ || node->runtime_opcode() != op_input_node))
         {
             for (auto in : node->inputs())
                 in->clear_connection();
@@ -134,20 +139,27 @@ split_graph_result graph::split_subgraph(std::span<node *const> nodes)
 {
     split_graph_result result;
     result.subgraph = std::make_unique<graph>(nodes.front()->module_type());
+    // Moved nodes keep their storage and ids, so the subgraph shares this graph's arena, which
+    // also numbers the nodes either graph creates afterwards without collisions
+    result.subgraph->arena_ = arena_;
 
     // 1. Erase nodes
-    std::unordered_set<node *> subgraph_nodes;
-    for (auto it = nodes.begin(); it != nodes.end(); ++it)
+    std::vector<bool> subgraph_nodes(node_id_bound());
+    std::vector<size_t> subgraph_order(node_id_bound());
+    for (size_t i = 0; i < nodes.size(); i++)
     {
-        auto find_it = std::find_if(nodes_.begin(), nodes_.end(), [&](auto &p) { return p.get() == *it; });
-        if (find_it != nodes_.end())
-        {
-            subgraph_nodes.emplace(find_it->get());
-            result.subgraph->nodes_.emplace_back(std::move(*find_it));
-            nodes_.erase(find_it);
-        }
+        subgraph_nodes[nodes[i]->id()] = true;
+        subgraph_order[nodes[i]->id()] = i;
     }
 
+    auto end = std::stable_partition(nodes_.begin(), nodes_.end(), [&](node_ptr &p) { return !subgraph_nodes[p->id()]; });
+    std::sort(end, nodes_.end(), [&](node_ptr &lhs, node_ptr &rhs) { return subgraph_order[lhs->id()] < subgraph_order[rhs->id()]; });
+    for (auto it = end; it != nodes_.end(); ++it)
+        result.subgraph->nodes_.emplace_back(std::move(*it));
+    nodes_.erase(end, nodes_.end());
+
+    auto in_subgraph = [&](node &n) { return n.id() < subgraph_nodes.size() && subgraph_nodes[n.id()]; };
+
     // 2. Find in/out connectors
     std::unordered_set<output_connector *> outputs;
     std::unordered_map<output_connector *, input_node *> inputs;
@@ -155,7 +167,7 @@ split_graph_result graph::split_subgraph(std::span<node *const> nodes)
     {
         for (auto in : node->inputs())
         {
-            if (!subgraph_nodes.contains(&in->connection()->owner()))
+            if (!in_subgraph(in->connection()->owner()))
             {
                 if (outputs.emplace(in->connection()).second)
                 {
@@ -176,7 +188,7 @@ split_graph_result graph::split_subgraph(std::span<node *const> nodes)
         for (auto out : node->outputs())
         {
             auto conns = out->connections();
-            if (std::any_of(conns.begin(), conns.end(), [&](input_connector *in) { return !subgraph_nodes.contains(&in->owner()); }))
+            if (std::any_of(conns.begin(), conns.end(), [&](input_connector *in) { return !in_subgraph(in->owner()); }))
             {
                 auto onode = result.subgraph->emplace<output_node>(out->type(), out->shape());
                 onode->name(out->owner().name());
@@ -184,7 +196,7 @@ split_graph_result graph::split_subgraph(std::span<node *const> nodes)
 
                 for (auto in : dup(conns))
                 {
-                    if (!subgraph_nodes.contains(&in->owner()))
+                    if (!in_subgraph(in->owner()))
                     {
                         result.outputs[onode].emplace_back(in);
                         in->clear_connection();
@@ -201,25 +213,28 @@ split_graph_result graph::split_subgraph(std::span<node *const> nodes)
 
 graph &graph::add_subgraph(std::unique_ptr<graph> subgraph)
 {
+    subgraph->is_subgraph_ = true;
     return *subgraphs_.emplace_back(std::move(subgraph));
 }
 
 void graph::cse()
 {
-    std::unordered_set<node *> csed_nodes;
+    std::vector<bool> csed_nodes(node_id_bound());
+    bool csed;
 
     while (true)
     {
+        csed = false;
         for (size_t i = 0; i < nodes_.size() - 1; i++)
         {
             auto &inode = nodes_[i];
-            if (csed_nodes.contains(inode.get()))
+            if (csed_nodes[inode->id()])
                 continue;
 
             for (size_t j = i + 1; j < nodes_.size(); j++)
             {
                 auto &jnode = nodes_[j];
-                if (csed_nodes.contains(jnode.get()))
+                if (csed_nodes[jnode->id()])
                     continue;
 
                 if (!dontcse_ops.contains(inode->runtime_opcode())
@@ -234,15 +249,16 @@ void graph::cse()
                             in->connect(output);
                     }
 
-                    csed_nodes.emplace(jnode.get());
+                    csed_nodes[jnode->id()] = true;
+                    csed = true;
                 }
             }
         }
 
-        if (!csed_nodes.empty())
+        if (csed)
         {
             dce();
-            csed_nodes.clear();
+            csed_nodes.assign(node_id_bound(), false);
         }
         else
         {
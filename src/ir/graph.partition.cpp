@@ -17,6 +17,10 @@
 #include <nncase/ir/ops/constant.h>
 #include <nncase/ir/visitor.h>
 #include <nncase/runtime/stackvm/runtime_module.h>
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <map>
 #include <unordered_set>
 
 using namespace nncase;
@@ -44,15 +48,16 @@ struct region
         {
             nodes.emplace_back(&n);
             for (auto in : n.inputs())
-                region_inputs.emplace(in);
+            {
+                if (!outputs.contains(in->connection()))
+                    region_inputs.emplace(in);
+            }
+
             for (auto out : n.outputs())
-                outputs.emplace(out);
-            for (auto it = region_inputs.begin(); it != region_inputs.end();)
             {
-                if (outputs.contains((*it)->connection()))
-                    it = region_inputs.erase(it);
-                else
-                    ++it;
+                outputs.emplace(out);
+                for (auto in : out->connections())
+                    region_inputs.erase(in);
             }
 
             if (is_all_noaction && n.attributes() & node_attr_action)
@@ -103,9 +108,13 @@ struct region
 
 class graph_merger
 {
+    static constexpr size_t no_region = std::numeric_limits<size_t>::max();
+
+    using input_key_t = std::pair<module_type_t, std::vector<output_connector *>>;
+
 public:
     graph_merger(graph &g)
-        : g_(g)
+        : g_(g), node_to_region_(g.node_id_bound(), no_region)
     {
     }
 
@@ -116,7 +125,17 @@ public:
         merge_regions();
     }
 
-    const std::list<region> &regions() const noexcept { return regions_; }
+    std::vector<const region *> regions() const
+    {
+        std::vector<const region *> result;
+        for (size_t i = 0; i < regions_.size(); i++)
+        {
+            if (parents_[i] == i)
+                result.emplace_back(&regions_[i]);
+        }
+
+        return result;
+    }
 
 private:
     void create_regions()
@@ -129,37 +148,37 @@ private:
                 return;
 
             // 2. Find last region
-            region *last_region = nullptr;
+            size_t last_region = no_region;
             for (auto in : node.inputs())
             {
-                auto &conn = in->connection()->owner();
-                auto it = node_to_region_.find(&conn);
-                if (it != node_to_region_.end())
+                auto conn_region = node_to_region_[in->connection()->owner().id()];
+                if (conn_region != no_region)
                 {
                     // 2.1. Last region not set, set it
-                    if (!last_region)
+                    if (last_region == no_region)
                     {
-                        last_region = it->second;
+                        last_region = conn_region;
                     }
                     // 2.2. Last region set but different, create new region
-                    else if (last_region != it->second)
+                    else if (last_region != conn_region)
                     {
-                        last_region = nullptr;
+                        last_region = no_region;
                         break;
                     }
                 }
             }
 
             // 3. Last region not set or different module type, create new region
-            if (!last_region || last_region->module_type != node.module_type())
+            if (last_region == no_region || regions_[last_region].module_type != node.module_type())
             {
-                auto &region = regions_.emplace_back(node.module_type());
-                add_node_to_region(region, node);
+                regions_.emplace_back(node.module_type());
+                parents_.emplace_back(parents_.size());
+                add_node_to_region(regions_.size() - 1, node);
             }
             // 4. Add to last region
             else
             {
-                add_node_to_region(*last_region, node);
+                add_node_to_region(last_region, node);
             }
         });
         creator.visit(g_);
@@ -172,156 +191,214 @@ private:
         g_.dce();
     }
 
+    // Regions are created in topological order and merged through a worklist. After a
+    // merge only the merged region and its neighbours can match a rule again, so each
+    // region is revisited a bounded number of times instead of rescanning all pairs.
+    // None of the rules can close a cycle between regions: a merged region only reads
+    // from producers that one of its halves already read from, so a path leaving it
+    // and coming back would have been a cycle before the merge.
     void merge_regions()
     {
-        bool changed;
-        do
+        std::deque<size_t> worklist;
+        std::vector<bool> queued(regions_.size(), true);
+        for (size_t i = 0; i < regions_.size(); i++)
+            worklist.emplace_back(i);
+
+        auto enqueue = [&](size_t id) {
+            if (!queued[id])
+            {
+                queued[id] = true;
+                worklist.emplace_back(id);
+            }
+        };
+
+        std::map<input_key_t, size_t> same_input_regions;
+        while (!worklist.empty())
         {
-            changed = false;
-            changed |= merge_child_region();
-            changed |= merge_parent_region();
-            changed |= merge_same_input_region();
-        } while (changed);
+            auto id = worklist.front();
+            worklist.pop_front();
+            queued[id] = false;
+            if (find(id) != id)
+                continue;
+
+            auto merged_to = merge_child_region(id);
+            if (merged_to == no_region)
+                merged_to = merge_parent_region(id);
+            if (merged_to == no_region)
+                merged_to = merge_same_input_region(id, same_input_regions);
+
+            if (merged_to != no_region)
+            {
+                enqueue(merged_to);
+                for (auto neighbour : producers(merged_to))
+                    enqueue(neighbour);
+                for (auto neighbour : consumers(merged_to))
+                    enqueue(neighbour);
+            }
+        }
     }
 
-    bool merge_child_region()
+    // Merge region b into its only producer if all of its inputs connect to that region's outputs
+    size_t merge_child_region(size_t b)
     {
-        bool ever_changed = false;
-        bool changed;
-        do
+        auto &rb = regions_[b];
+        if (rb.region_inputs.empty())
+            return no_region;
+
+        auto a = no_region;
+        for (auto in : rb.region_inputs)
         {
-            changed = false;
-            for (auto ita = regions_.begin(); ita != regions_.end(); ++ita)
-            {
-                std::vector<std::list<region>::iterator> to_be_merge;
-                for (auto itb = regions_.begin(); itb != regions_.end(); ++itb)
-                {
-                    // don't merge stackvm region
-                    if (ita == itb
-                        || (ita->module_type == runtime::stackvm::stackvm_module_type
-                            && itb->module_type == runtime::stackvm::stackvm_module_type))
-                        continue;
-
-                    // itb's inputs all connect to ita's output
-                    if ((ita->module_type == itb->module_type || itb->is_all_noaction)
-                        && std::all_of(itb->region_inputs.begin(), itb->region_inputs.end(), [&](input_connector *in) { return ita->outputs.contains(in->connection()); }))
-                        to_be_merge.emplace_back(itb);
-                }
+            auto producer = region_of(in->connection()->owner());
+            if (producer == no_region || (a != no_region && a != producer))
+                return no_region;
+            a = producer;
+        }
 
-                if (!to_be_merge.empty())
-                {
-                    for (auto region : to_be_merge)
-                    {
-                        ita->merge(*region);
-                        regions_.erase(region);
-                    }
+        auto &ra = regions_[a];
+        if (!can_merge(ra, rb) || (ra.module_type != rb.module_type && !rb.is_all_noaction))
+            return no_region;
+        return merge(a, b);
+    }
 
-                    changed = ever_changed = true;
-                    break;
-                }
+    // Merge no-action region b into its only consumer if all of its outputs connect to that region's inputs
+    size_t merge_parent_region(size_t b)
+    {
+        auto &rb = regions_[b];
+        if (!rb.is_all_noaction)
+            return no_region;
+
+        auto a = no_region;
+        for (auto out : rb.outputs)
+        {
+            for (auto in : out->connections())
+            {
+                auto consumer = region_of(in->owner());
+                if (consumer == no_region || consumer == b || (a != no_region && a != consumer))
+                    return no_region;
+                a = consumer;
             }
-        } while (changed);
-        return ever_changed;
+        }
+
+        if (a == no_region || !can_merge(regions_[a], rb))
+            return no_region;
+        return merge(a, b);
     }
 
-    bool merge_parent_region()
+    // Merge regions of the same module type reading exactly the same outputs
+    size_t merge_same_input_region(size_t b, std::map<input_key_t, size_t> &same_input_regions)
     {
-        bool ever_changed = false;
-        bool changed;
-        do
+        auto key = input_key(b);
+        auto it = same_input_regions.find(key);
+        if (it != same_input_regions.end())
         {
-            changed = false;
-            for (auto ita = regions_.begin(); ita != regions_.end(); ++ita)
+            auto a = it->second;
+            if (a != b
+                && find(a) == a
+                && can_merge(regions_[a], regions_[b])
+                && input_key(a) == key)
             {
-                std::vector<std::list<region>::iterator> to_be_merge;
-                for (auto itb = regions_.begin(); itb != regions_.end(); ++itb)
-                {
-                    // don't merge stackvm region
-                    if (ita == itb
-                        || (ita->module_type == runtime::stackvm::stackvm_module_type
-                            && itb->module_type == runtime::stackvm::stackvm_module_type))
-                        continue;
-
-                    // itb's outputs all connect to ita's input
-                    if (itb->is_all_noaction
-                        && std::all_of(itb->outputs.begin(), itb->outputs.end(), [&](output_connector *out) { return std::all_of(out->connections().begin(), out->connections().end(), [&](input_connector *in) { return ita->region_inputs.contains(in); }); }))
-                        to_be_merge.emplace_back(itb);
-                }
+                // Keep the earlier region as the merge target, like a front-to-back scan would
+                auto target = merge(std::min(a, b), std::max(a, b));
+                it->second = target;
+                return target;
+            }
+        }
 
-                if (!to_be_merge.empty())
-                {
-                    for (auto region : to_be_merge)
-                    {
-                        ita->merge(*region);
-                        regions_.erase(region);
-                    }
+        same_input_regions.insert_or_assign(std::move(key), b);
+        return no_region;
+    }
 
-                    changed = ever_changed = true;
-                    break;
-                }
-            }
-        } while (changed);
-        return ever_changed;
+    bool can_merge(const region &a, const region &b) const noexcept
+    {
+        // don't merge stackvm region
+        return !(a.module_type == runtime::stackvm::stackvm_module_type
+            && b.module_type == runtime::stackvm::stackvm_module_type);
+    }
+
+    size_t merge(size_t a, size_t b)
+    {
+        regions_[a].merge(regions_[b]);
+        regions_[b] = region(regions_[b].module_type);
+        parents_[b] = a;
+        return a;
     }
 
-    bool merge_same_input_region()
+    input_key_t input_key(size_t id) const
     {
-        bool ever_changed = false;
-        bool changed;
-        do
+        auto &r = regions_[id];
+        std::vector<output_connector *> outputs;
+        outputs.reserve(r.region_inputs.size());
+        for (auto in : r.region_inputs)
+            outputs.emplace_back(in->connection());
+        std::sort(outputs.begin(), outputs.end());
+        outputs.erase(std::unique(outputs.begin(), outputs.end()), outputs.end());
+        return { r.module_type, std::move(outputs) };
+    }
+
+    std::vector<size_t> producers(size_t id)
+    {
+        std::vector<size_t> result;
+        for (auto in : regions_[id].region_inputs)
         {
-            changed = false;
-            for (auto ita = regions_.begin(); ita != regions_.end(); ++ita)
-            {
-                std::vector<std::list<region>::iterator> to_be_merge;
-                for (auto itb = regions_.begin(); itb != regions_.end(); ++itb)
-                {
-                    // don't merge stackvm region
-                    if (ita == itb
-                        || (ita->module_type == runtime::stackvm::stackvm_module_type
-                            && itb->module_type == runtime::stackvm::stackvm_module_type))
-                        continue;
-
-                    // itb has the same input with ita
-                    if (ita->module_type == itb->module_type)
-                    {
-                        std::unordered_set<output_connector *> outputs_a, outputs_b;
-                        for (auto in : ita->region_inputs)
-                            outputs_a.emplace(in->connection());
-                        for (auto in : itb->region_inputs)
-                            outputs_b.emplace(in->connection());
-                        if (std::all_of(outputs_a.begin(), outputs_a.end(), [&](output_connector *out) { return outputs_b.contains(out); })
-                            && std::all_of(outputs_b.begin(), outputs_b.end(), [&](output_connector *out) { return outputs_a.contains(out); }))
-                            to_be_merge.emplace_back(itb);
-                    }
-                }
+            auto producer = region_of(in->connection()->owner());
+            if (producer != no_region && producer != id)
+                result.emplace_back(producer);
+        }
 
-                if (!to_be_merge.empty())
-                {
-                    for (auto region : to_be_merge)
-                    {
-                        ita->merge(*region);
-                        regions_.erase(region);
-                    }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
 
-                    changed = ever_changed = true;
-                    break;
-                }
+    std::vector<size_t> consumers(size_t id)
+    {
+        std::vector<size_t> result;
+        for (auto out : regions_[id].outputs)
+        {
+            for (auto in : out->connections())
+            {
+                auto consumer = region_of(in->owner());
+                if (consumer != no_region && consumer != id)
+                    result.emplace_back(consumer);
             }
-        } while (changed);
-        return ever_changed;
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    size_t find(size_t id)
+    {
+        while (parents_[id] != id)
+        {
+            parents_[id] = parents_[parents_[id]];
+            id = parents_[id];
+        }
+
+        return id;
+    }
+
+    size_t region_of(node &n)
+    {
+        // Constants embedded after the regions were created have no entry
+        if (n.id() >= node_to_region_.size() || node_to_region_[n.id()] == no_region)
+            return no_region;
+        return find(node_to_region_[n.id()]);
     }
 
-    void add_node_to_region(region &region, node &node)
+    void add_node_to_region(size_t id, node &node)
     {
-        region.add_node(node);
-        node_to_region_.emplace(&node, &region);
+        regions_[id].add_node(node);
+        node_to_region_[node.id()] = id;
     }
 
 private:
     graph &g_;
-    std::list<region> regions_;
-    std::unordered_map<node *, region *> node_to_region_;
+    std::vector<region> regions_;
+    std::vector<size_t> parents_;
+    // Indexed by node id
+    std::vector<size_t> node_to_region_;
 };
 }
 
@@ -331,16 +408,16 @@ void graph::merge_module_regions()
     merger.merge();
 
     std::unordered_map<std::string, size_t> subids;
-    for (auto &region : merger.regions())
+    for (auto region : merger.regions())
     {
         // Don't create subgraph for stackvm
-        if (region.module_type == runtime::stackvm::stackvm_module_type)
+        if (region->module_type == runtime::stackvm::stackvm_module_type)
             continue;
 
-        auto split = split_subgraph(region.nodes);
+        auto split = split_subgraph(region->nodes);
         auto &subg = add_subgraph(std::move(split.subgraph));
         auto c = emplace<call>(subg);
-        c->name(std::string(region.module_type.data()) + "_" + std::to_string(subids[region.module_type.data()]++));
+        c->name(std::string(region->module_type.data()) + "_" + std::to_string(subids[region->module_type.data()]++));
         subg.name(c->name());
 
         for (auto &inp : split.inputs)
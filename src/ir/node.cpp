@@ -19,12 +19,33 @@ using namespace nncase;
 using namespace nncase::ir;
 
 node::node(std::string name)
-    : name_(std::move(name)), module_type_(runtime::stackvm::stackvm_module_type)
+    : arena_(ir_arena::current()), name_(&intern_name(name)), module_type_(runtime::stackvm::stackvm_module_type), node_name_before_quant_(&intern_name(""))
 {
 }
 
 node::~node()
 {
+    for (auto in : input_connectors_)
+    {
+        if (arena_)
+        {
+            in->~input_connector();
+            arena_->deallocate(in, sizeof(input_connector));
+        }
+        else
+            delete in;
+    }
+
+    for (auto out : output_connectors_)
+    {
+        if (arena_)
+        {
+            out->~output_connector();
+            arena_->deallocate(out, sizeof(output_connector));
+        }
+        else
+            delete out;
+    }
 }
 
 bool node::equals(node &other) const
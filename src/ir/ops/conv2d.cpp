@@ -19,7 +19,7 @@ using namespace nncase;
 using namespace nncase::ir;
 
 conv2d::conv2d(shape_t input_shape, shape_t weighs_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation)
-    : groups_(groups), padding_h_(padding_h), padding_w_(padding_w), stride_h_(stride_h), stride_w_(stride_w), dilation_h_(dilation_h), dilation_w_(dilation_w), fused_activation_(fused_activation)
+    : groups_(groups), padding_h_(padding_h), padding_w_(padding_w), stride_h_(stride_h), stride_w_(stride_w), dilation_h_(dilation_h), dilation_w_(dilation_w), fused_activation_(fused_activation), has_activation_table_(false), activation_param_ { 0, 1.f }
 {
     add_input("input", dt_float32, input_shape);
     add_input("weights", dt_float32, weighs_shape);
@@ -32,10 +32,19 @@ conv2d::conv2d(shape_t input_shape, shape_t weighs_shape, int32_t groups, paddin
             get_windowed_output_size((int32_t)input_shape[3] + padding_w_.sum(), filter_w(), stride_w_, dilation_w_, false) });
 }
 
+conv2d::conv2d(shape_t input_shape, shape_t weighs_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, quant_param_t activation_param)
+    : conv2d(std::move(input_shape), std::move(weighs_shape), groups, padding_h, padding_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation)
+{
+    has_activation_table_ = true;
+    activation_param_ = activation_param;
+    add_input("activation_table", dt_float32, shape_t { 256 });
+}
+
 bool conv2d::properties_equal(node &other) const
 {
     auto &r = static_cast<conv2d &>(other);
     return groups() == r.groups() && padding_h() == r.padding_h() && padding_w() == r.padding_w()
         && stride_h() == r.stride_h() && stride_w() == r.stride_w() && dilation_h() == r.dilation_h()
-        && dilation_w() == r.dilation_w() && fused_activation() == r.fused_activation();
+        && dilation_w() == r.dilation_w() && fused_activation() == r.fused_activation()
+        && has_activation_table() == r.has_activation_table() && activation_param() == r.activation_param();
 }
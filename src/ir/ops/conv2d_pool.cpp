@@ -0,0 +1,61 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/conv2d_pool.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+conv2d_pool::conv2d_pool(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w,
+    int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, reduce_op_t pool_op, float pool_init_value, int32_t pool_filter_h,
+    int32_t pool_filter_w, padding pool_padding_h, padding pool_padding_w, int32_t pool_stride_h, int32_t pool_stride_w, value_range<float> pool_activation)
+    : groups_(groups), padding_h_(padding_h), padding_w_(padding_w), stride_h_(stride_h), stride_w_(stride_w), dilation_h_(dilation_h), dilation_w_(dilation_w), fused_activation_(fused_activation), has_activation_table_(false), activation_param_ { 0, 1.f }, pool_op_(pool_op), pool_init_value_(pool_init_value), pool_filter_h_(pool_filter_h), pool_filter_w_(pool_filter_w), pool_padding_h_(pool_padding_h), pool_padding_w_(pool_padding_w), pool_stride_h_(pool_stride_h), pool_stride_w_(pool_stride_w), pool_activation_(pool_activation)
+{
+    add_input("input", dt_float32, input_shape);
+    add_input("weights", dt_float32, weights_shape);
+    add_input("bias", dt_float32, shape_t { (size_t)output_channels() });
+
+    auto conv_h = get_windowed_output_size((int32_t)input_shape[2] + padding_h_.sum(), filter_h(), stride_h_, dilation_h_, false);
+    auto conv_w = get_windowed_output_size((int32_t)input_shape[3] + padding_w_.sum(), filter_w(), stride_w_, dilation_w_, false);
+    add_output("output", dt_float32,
+        shape_t {
+            input_shape[0],
+            (size_t)output_channels(),
+            get_windowed_output_size((int32_t)conv_h + pool_padding_h_.sum(), pool_filter_h_, pool_stride_h_, 1, false),
+            get_windowed_output_size((int32_t)conv_w + pool_padding_w_.sum(), pool_filter_w_, pool_stride_w_, 1, false) });
+}
+
+conv2d_pool::conv2d_pool(shape_t input_shape, shape_t weights_shape, int32_t groups, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w,
+    int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, quant_param_t activation_param, reduce_op_t pool_op, float pool_init_value,
+    int32_t pool_filter_h, int32_t pool_filter_w, padding pool_padding_h, padding pool_padding_w, int32_t pool_stride_h, int32_t pool_stride_w, value_range<float> pool_activation)
+    : conv2d_pool(std::move(input_shape), std::move(weights_shape), groups, padding_h, padding_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation,
+        pool_op, pool_init_value, pool_filter_h, pool_filter_w, pool_padding_h, pool_padding_w, pool_stride_h, pool_stride_w, pool_activation)
+{
+    has_activation_table_ = true;
+    activation_param_ = activation_param;
+    add_input("activation_table", dt_float32, shape_t { 256 });
+}
+
+bool conv2d_pool::properties_equal(node &other) const
+{
+    auto &r = static_cast<conv2d_pool &>(other);
+    return groups() == r.groups() && padding_h() == r.padding_h() && padding_w() == r.padding_w()
+        && stride_h() == r.stride_h() && stride_w() == r.stride_w() && dilation_h() == r.dilation_h()
+        && dilation_w() == r.dilation_w() && fused_activation() == r.fused_activation()
+        && has_activation_table() == r.has_activation_table() && activation_param() == r.activation_param()
+        && pool_op() == r.pool_op() && pool_init_value() == r.pool_init_value() && pool_filter_h() == r.pool_filter_h()
+        && pool_filter_w() == r.pool_filter_w() && pool_padding_h() == r.pool_padding_h() && pool_padding_w() == r.pool_padding_w()
+        && pool_stride_h() == r.pool_stride_h() && pool_stride_w() == r.pool_stride_w() && pool_activation() == r.pool_activation();
+}
@@ -0,0 +1,43 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/detection_postprocess.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+detection_postprocess::detection_postprocess(datatype_t input_type, shape_t boxes_shape, shape_t scores_shape, bool center_point_box,
+    int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold)
+    : center_point_box_(center_point_box), max_output_boxes_per_class_(max_output_boxes_per_class), iou_threshold_(iou_threshold), score_threshold_(score_threshold)
+{
+    if (boxes_shape.size() != 3 || boxes_shape[2] != 4)
+        throw std::invalid_argument("Boxes of detection_postprocess must be [batch, spatial, 4]");
+    if (scores_shape.size() != 3 || scores_shape[0] != boxes_shape[0] || scores_shape[2] != boxes_shape[1])
+        throw std::invalid_argument("Scores of detection_postprocess must be [batch, classes, spatial]");
+    if (max_output_boxes_per_class <= 0)
+        throw std::invalid_argument("max_output_boxes_per_class of detection_postprocess must be positive");
+
+    add_input("boxes", input_type, boxes_shape);
+    add_input("scores", input_type, scores_shape);
+    // Static-shaped selected_indices, unused rows are filled with -1
+    add_output("output", dt_int64, shape_t { scores_shape[0] * scores_shape[1] * (size_t)max_output_boxes_per_class, 3 });
+}
+
+bool detection_postprocess::properties_equal(node &other) const
+{
+    auto &r = static_cast<detection_postprocess &>(other);
+    return center_point_box() == r.center_point_box() && max_output_boxes_per_class() == r.max_output_boxes_per_class()
+        && iou_threshold() == r.iou_threshold() && score_threshold() == r.score_threshold();
+}
@@ -0,0 +1,47 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/image_preprocess.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+image_preprocess::image_preprocess(datatype_t input_type, shape_t input_shape, quant_param_t input_param, bool input_nhwc, bool swap_rb,
+    std::array<int32_t, 2> resize_shape, std::array<padding, 2> paddings, float pad_value, bool output_nhwc)
+    : input_param_(input_param), input_nhwc_(input_nhwc), swap_rb_(swap_rb), resize_shape_(resize_shape), paddings_(paddings), pad_value_(pad_value), output_nhwc_(output_nhwc)
+{
+    if (input_shape.size() != 4)
+        throw std::invalid_argument("Image preprocess input must be 4D");
+
+    auto channels = input_nhwc ? input_shape[3] : input_shape[1];
+    if (swap_rb && channels != 3)
+        throw std::invalid_argument("SwapRB requires 3 channels");
+
+    auto out_h = (size_t)(resize_shape[0] + paddings[0].sum());
+    auto out_w = (size_t)(resize_shape[1] + paddings[1].sum());
+    auto out_shape = output_nhwc ? shape_t { input_shape[0], out_h, out_w, channels } : shape_t { input_shape[0], channels, out_h, out_w };
+
+    add_input("input", input_type, input_shape);
+    add_input("mean", dt_float32, shape_t { channels });
+    add_input("stddev", dt_float32, shape_t { channels });
+    add_output("output", dt_float32, out_shape);
+}
+
+bool image_preprocess::properties_equal(node &other) const
+{
+    auto &r = static_cast<image_preprocess &>(other);
+    return input_param() == r.input_param() && input_nhwc() == r.input_nhwc() && swap_rb() == r.swap_rb()
+        && resize_shape() == r.resize_shape() && paddings() == r.paddings() && pad_value() == r.pad_value() && output_nhwc() == r.output_nhwc();
+}
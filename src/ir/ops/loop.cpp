@@ -0,0 +1,77 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/loop.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+namespace
+{
+shape_t scan_shape(size_t trip_count, const shape_t &slice_shape)
+{
+    shape_t shape { trip_count };
+    shape.insert(shape.end(), slice_shape.begin(), slice_shape.end());
+    return shape;
+}
+}
+
+loop::loop(graph &body, size_t num_states, size_t num_scan_inputs, size_t trip_count)
+    : body_(body), num_states_(num_states), num_scan_inputs_(num_scan_inputs), trip_count_(trip_count)
+{
+    auto body_inputs = body_.inputs();
+    auto body_outputs = body_.outputs();
+    if (body_inputs.size() < num_states + num_scan_inputs || body_outputs.size() < num_states)
+        throw std::invalid_argument("Loop body doesn't have enough inputs or outputs");
+    num_invariants_ = body_inputs.size() - num_states - num_scan_inputs;
+
+    for (size_t i = 0; i < num_states; i++)
+    {
+        auto &in = body_inputs[i]->output();
+        auto &out = body_outputs[i]->input();
+        if (in.type() != out.type() || in.shape() != out.shape())
+            throw std::invalid_argument("Loop state " + body_inputs[i]->name() + " changes its type or shape across iterations");
+    }
+
+    for (size_t i = 0; i < body_inputs.size(); i++)
+    {
+        auto &in = body_inputs[i]->output();
+        if (i >= num_states && i < num_states + num_scan_inputs)
+            add_input(body_inputs[i]->name(), in.type(), scan_shape(trip_count, in.shape()));
+        else
+            add_input(body_inputs[i]->name(), in.type(), in.shape());
+    }
+
+    for (size_t i = 0; i < num_states; i++)
+    {
+        auto &in = body_inputs[i]->output();
+        add_input(body_inputs[i]->name() + "_carry", in.type(), in.shape());
+    }
+
+    for (size_t i = 0; i < body_outputs.size(); i++)
+    {
+        auto &out = body_outputs[i]->input();
+        if (i < num_states)
+            add_output(body_outputs[i]->name(), out.type(), out.shape());
+        else
+            add_output(body_outputs[i]->name(), out.type(), scan_shape(trip_count, out.shape()));
+    }
+}
+
+bool loop::properties_equal(node &other) const
+{
+    auto &r = static_cast<loop &>(other);
+    return &body() == &r.body() && num_states() == r.num_states() && num_scan_inputs() == r.num_scan_inputs() && trip_count() == r.trip_count();
+}
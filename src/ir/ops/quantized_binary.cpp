@@ -0,0 +1,38 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/quantized_binary.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+quantized_binary::quantized_binary(binary_op_t binary_op, datatype_t type, shape_t input_a_shape, shape_t input_b_shape, quant_param_t input_a_param,
+    quant_param_t input_b_param, quant_param_t output_param, value_range<float> fused_activation)
+    : binary_op_(binary_op), input_a_param_(input_a_param), input_b_param_(input_b_param), output_param_(output_param), fused_activation_(fused_activation)
+{
+    if (type != dt_uint8 && type != dt_int8)
+        throw std::invalid_argument("Quantized binary only supports uint8 and int8");
+
+    add_input("input_a", type, input_a_shape);
+    add_input("input_b", type, input_b_shape);
+    add_output("output", type, get_binary_output_shape(input_a_shape, input_b_shape));
+}
+
+bool quantized_binary::properties_equal(node &other) const
+{
+    auto &r = static_cast<quantized_binary &>(other);
+    return binary_op() == r.binary_op() && input_a_param() == r.input_a_param() && input_b_param() == r.input_b_param()
+        && output_param() == r.output_param() && fused_activation() == r.fused_activation();
+}
@@ -19,9 +19,14 @@ using namespace nncase;
 using namespace nncase::ir;
 
 reduce_window2d::reduce_window2d(reduce_op_t reduce_op, shape_t input_shape, float init_value, int32_t filter_h, int32_t filter_w, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, bool ceil_mode, bool count_include_pad, std::vector<int32_t> padding_h_w_after, bool strict_inside_input)
+    : reduce_window2d(dt_float32, reduce_op, std::move(input_shape), init_value, filter_h, filter_w, padding_h, padding_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation, ceil_mode, count_include_pad, std::move(padding_h_w_after), strict_inside_input)
+{
+}
+
+reduce_window2d::reduce_window2d(datatype_t type, reduce_op_t reduce_op, shape_t input_shape, float init_value, int32_t filter_h, int32_t filter_w, padding padding_h, padding padding_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, bool ceil_mode, bool count_include_pad, std::vector<int32_t> padding_h_w_after, bool strict_inside_input)
     : reduce_op_(reduce_op), init_value_(init_value), filter_h_(filter_h), filter_w_(filter_w), padding_h_(padding_h), padding_w_(padding_w), stride_h_(stride_h), stride_w_(stride_w), dilation_h_(dilation_h), dilation_w_(dilation_w), fused_activation_(fused_activation), ceil_mode_(ceil_mode), count_include_pad_(count_include_pad), padding_h_w_after_(padding_h_w_after), strict_inside_input_(strict_inside_input)
 {
-    add_input("input", dt_float32, input_shape);
+    add_input("input", type, input_shape);
     auto output_size_h = get_windowed_output_size((int32_t)input_shape[2] + padding_h_.sum(), filter_h_, stride_h_, dilation_h_, false, ceil_mode);
     auto output_size_w = get_windowed_output_size((int32_t)input_shape[3] + padding_w_.sum(), filter_w_, stride_w_, dilation_w_, false, ceil_mode);
 
@@ -33,7 +38,7 @@ reduce_window2d::reduce_window2d(reduce_op_t reduce_op, shape_t input_shape, flo
             output_size_w -= 1;
     }
 
-    add_output("output", dt_float32,
+    add_output("output", type,
         shape_t {
             input_shape[0],
             input_shape[1],
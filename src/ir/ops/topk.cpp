@@ -0,0 +1,38 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/topk.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+topk::topk(datatype_t input_type, shape_t input_shape, int64_t k, int32_t axis, bool largest, bool sorted)
+    : axis_(normalize_axis(input_shape, axis)), k_(k), largest_(largest), sorted_(sorted)
+{
+    if (k <= 0 || (size_t)k > input_shape[axis_])
+        throw std::invalid_argument("K of topk must be in (0, input_shape[axis]]");
+
+    auto out_shape = input_shape;
+    out_shape[axis_] = (size_t)k;
+    add_input("input", input_type, input_shape);
+    add_output("values", input_type, out_shape);
+    add_output("indices", dt_int64, out_shape);
+}
+
+bool topk::properties_equal(node &other) const
+{
+    auto &r = static_cast<topk &>(other);
+    return axis() == r.axis() && k() == r.k() && largest() == r.largest() && sorted() == r.sorted();
+}
@@ -36,12 +36,14 @@ void ir_visitor::visit(std::span<output_node *> outputs)
 
 bool ir_visitor::visited(node &node) const noexcept
 {
-    return visited_.find(&node) != visited_.end();
+    return node.id() < visited_.size() && visited_[node.id()];
 }
 
 void ir_visitor::mark_visit(node &node)
 {
-    visited_.emplace(&node);
+    if (node.id() >= visited_.size())
+        visited_.resize(node.id() + 1);
+    visited_[node.id()] = true;
 }
 
 bool ir_visitor::visit([[maybe_unused]] node &node)
@@ -96,9 +98,9 @@ bool dfs_ir_post_order_visitor::visit_strategy(node &node)
 bool bfs_ir_pre_order_visitor::visit_strategy(node &node)
 {
     std::queue<nncase::ir::node *> nodes;
-    std::unordered_set<nncase::ir::node *> nodes_set;
+    std::vector<bool> nodes_set(node.id() + 1);
     nodes.push(&node);
-    nodes_set.emplace(&node);
+    nodes_set[node.id()] = true;
 
     while (!nodes.empty())
     {
@@ -112,8 +114,13 @@ bool bfs_ir_pre_order_visitor::visit_strategy(node &node)
             if (in->connection())
             {
                 auto &in_node = in->connection()->owner();
-                if (nodes_set.emplace(&in_node).second)
+                if (in_node.id() >= nodes_set.size())
+                    nodes_set.resize(in_node.id() + 1);
+                if (!nodes_set[in_node.id()])
+                {
+                    nodes_set[in_node.id()] = true;
                     nodes.push(&in_node);
+                }
             }
         }
     }
@@ -15,15 +15,23 @@
 #include <nncase/kernels/convolution.h>
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/kernels/reduce_window.h>
 #include <nncase/runtime/runtime_op_utility.h>
 using namespace nncase;
 using namespace nncase::runtime;
 using namespace nncase::kernels;
 
+namespace
+{
+// Budget of the conv rows kept in scratch for one band of pooled rows
+constexpr size_t conv2d_pool_band_bytes = 256 * 1024;
+}
+
 result<void> kernels::conv2d(const float *input, const float *weights, const float *bias, float *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
-    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, kernel_context &context) noexcept
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut, kernel_context &context) noexcept
 {
     if (dilation_h == 1 && dilation_w == 1)
     {
@@ -31,7 +39,7 @@ result<void> kernels::conv2d(const float *input, const float *weights, const flo
                 in_shape, in_strides, w_shape,
                 w_strides, bias_strides, out_strides,
                 padding_h, padding_w, groups, stride_h,
-                stride_w, dilation_h, dilation_w, fused_activation, context)
+                stride_w, dilation_h, dilation_w, fused_activation, fused_lut, context)
                 .is_ok())
         {
             return ok();
@@ -42,5 +50,56 @@ result<void> kernels::conv2d(const float *input, const float *weights, const flo
         in_shape, in_strides, w_shape,
         w_strides, bias_strides, out_strides,
         padding_h, padding_w, groups, stride_h,
-        stride_w, dilation_h, dilation_w, fused_activation, context);
+        stride_w, dilation_h, dilation_w, fused_activation, fused_lut, context);
+}
+
+result<void> kernels::conv2d_pool(const float *input, const float *weights, const float *bias, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
+    const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut,
+    reduce_op_t pool_op, float pool_init_value, int32_t pool_filter_h, int32_t pool_filter_w, const padding &pool_padding_h, const padding &pool_padding_w,
+    int32_t pool_stride_h, int32_t pool_stride_w, value_range<float> pool_activation, kernel_context &context) noexcept
+{
+    const auto in_h = (int32_t)in_shape[2];
+    const auto filter_h = (int32_t)w_shape[2];
+    const auto conv_h = (int32_t)kernels::detail::get_windowed_output_size(in_shape[2], filter_h, stride_h, dilation_h, padding_h);
+    const auto conv_w = kernels::detail::get_windowed_output_size(in_shape[3], (int32_t)w_shape[3], stride_w, dilation_w, padding_w);
+    const auto out_h = (int32_t)kernels::detail::get_windowed_output_size((size_t)conv_h, pool_filter_h, pool_stride_h, 1, pool_padding_h);
+    const auto conv_extent = (filter_h - 1) * dilation_h + 1;
+
+    // Pooled rows per band, so that the conv rows they read fit the scratch budget
+    const auto conv_row_bytes = in_shape[0] * w_shape[0] * conv_w * sizeof(float);
+    const auto max_conv_rows = std::max(conv2d_pool_band_bytes / conv_row_bytes, (size_t)pool_filter_h);
+    const auto band_rows = std::clamp(((int32_t)max_conv_rows - pool_filter_h) / pool_stride_h + 1, 1, out_h);
+    const auto max_band_conv_rows = std::min((band_rows - 1) * pool_stride_h + pool_filter_h, conv_h);
+
+    std::vector<float> band(in_shape[0] * w_shape[0] * max_band_conv_rows * conv_w);
+    for (int32_t oy = 0; oy < out_h; oy += band_rows)
+    {
+        const auto oy_end = std::min(oy + band_rows, out_h);
+
+        // Conv rows read by the pooled rows [oy, oy_end), the clipped part is the pooling padding
+        const auto pool_begin = oy * pool_stride_h - pool_padding_h.before;
+        const auto pool_end = (oy_end - 1) * pool_stride_h - pool_padding_h.before + pool_filter_h;
+        const auto conv_begin = std::max(pool_begin, 0);
+        const auto conv_end = std::min(pool_end, conv_h);
+
+        // Input rows read by the conv rows [conv_begin, conv_end), the clipped part is the conv padding
+        const auto in_begin = conv_begin * stride_h - padding_h.before;
+        const auto in_end = (conv_end - 1) * stride_h - padding_h.before + conv_extent;
+        const auto in_begin_clip = std::max(in_begin, 0);
+        const auto in_end_clip = std::min(in_end, in_h);
+
+        runtime_shape_t band_in_shape { in_shape[0], in_shape[1], (size_t)(in_end_clip - in_begin_clip), in_shape[3] };
+        runtime_shape_t band_shape { in_shape[0], w_shape[0], (size_t)(conv_end - conv_begin), conv_w };
+        auto band_strides = get_default_strides(band_shape);
+        try_(kernels::conv2d(input + in_begin_clip * in_strides[2], weights, bias, band.data(), band_in_shape, in_strides, w_shape, w_strides,
+            bias_strides, band_strides, { in_begin_clip - in_begin, in_end - in_end_clip }, padding_w, groups, stride_h, stride_w,
+            dilation_h, dilation_w, fused_activation, fused_lut, context));
+        try_(kernels::reduce_window2d(pool_op, band.data(), pool_init_value, output + oy * out_strides[2], band_shape, band_strides, out_strides,
+            { conv_begin - pool_begin, pool_end - conv_end }, pool_padding_w, pool_filter_h, pool_filter_w, pool_stride_h, pool_stride_w, 1, 1,
+            pool_activation, context));
+    }
+
+    return ok();
 }
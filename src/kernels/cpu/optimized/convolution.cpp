@@ -29,7 +29,7 @@
                   in_shape, in_strides, w_shape,          \
                   w_strides, bias_strides, out_strides,   \
                   padding_h, padding_w, groups, stride_h, \
-                  stride_w, dilation_h, dilation_w, fused_activation, context
+                  stride_w, dilation_h, dilation_w, fused_activation, fused_lut, context
 
 #define CONV2D_NXM_S1_S2(n, m)                           \
     if (filter_h == n && filter_w == m)                  \
@@ -63,12 +63,33 @@ using namespace nncase::kernels;
 using namespace nncase::kernels::cpu;
 using namespace nncase::kernels::cpu::optimized;
 
+namespace
+{
+// Size 1 dims may carry a 0 stride
+size_t get_row_step(const runtime_shape_t &shape, const runtime_shape_t &strides) noexcept
+{
+    return shape[2] == 1 ? shape[3] : strides[2];
+}
+
+// Rows are dense along W, the outer dims may have any strides
+bool has_dense_rows(const runtime_shape_t &shape, const runtime_shape_t &strides) noexcept
+{
+    return shape[3] == 1 || strides[3] == 1;
+}
+
+// Each H x W plane is dense, so it can be walked as a single row
+bool has_dense_planes(const runtime_shape_t &shape, const runtime_shape_t &strides) noexcept
+{
+    return has_dense_rows(shape, strides) && get_row_step(shape, strides) == shape[3];
+}
+}
+
 result<void> conv2d_1x1_s1(const float *input, const float *weights, const float *bias, float *output,
     const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides, NNCASE_UNUSED const runtime_shape_t &w_shape,
     NNCASE_UNUSED const runtime_shape_t &w_strides, NNCASE_UNUSED const runtime_shape_t &bias_strides, NNCASE_UNUSED const runtime_shape_t &out_strides,
     NNCASE_UNUSED const padding &padding_h, NNCASE_UNUSED const padding &padding_w,
     NNCASE_UNUSED int32_t groups, NNCASE_UNUSED int32_t stride_h, NNCASE_UNUSED int32_t stride_w,
-    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, NNCASE_UNUSED kernels::kernel_context &context) noexcept
+    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut, NNCASE_UNUSED kernels::kernel_context &context) noexcept
 {
     const auto widths = in_shape[2] * in_shape[3];
     // if oc's type is size_t, openmp will throw error in visual studio
@@ -141,7 +162,7 @@ result<void> conv2d_1x1_s1(const float *input, const float *weights, const float
 
             for (size_t i = 0; i < widths; i++)
             {
-                *(now_output_channel_start + i) = kernels::detail::apply_activation(*(now_output_channel_start + i), fused_activation);
+                *(now_output_channel_start + i) = kernels::detail::apply_activation(*(now_output_channel_start + i), fused_activation, fused_lut);
             }
         }
     }
@@ -153,7 +174,7 @@ result<void> conv2d_1x1_s2(const float *input, const float *weights, const float
     NNCASE_UNUSED const runtime_shape_t &w_strides, NNCASE_UNUSED const runtime_shape_t &bias_strides, NNCASE_UNUSED const runtime_shape_t &out_strides,
     NNCASE_UNUSED const padding &padding_h, NNCASE_UNUSED const padding &padding_w,
     NNCASE_UNUSED int32_t groups, NNCASE_UNUSED int32_t stride_h, NNCASE_UNUSED int32_t stride_w,
-    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, NNCASE_UNUSED kernels::kernel_context &context) noexcept
+    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut, NNCASE_UNUSED kernels::kernel_context &context) noexcept
 {
     const auto batch = in_shape[0], in_channels = in_shape[1], in_h = in_shape[2], in_w = in_shape[3], out_channels = w_shape[0];
     const auto filter_h = (int32_t)w_shape[2];
@@ -235,7 +256,7 @@ result<void> conv2d_1x1_s2(const float *input, const float *weights, const float
                 float *r_out = out + h * out_strides[2];
                 for (size_t w = 0; w < out_w; w++)
                 {
-                    *(r_out + w) = kernels::detail::apply_activation(*(r_out + w), fused_activation);
+                    *(r_out + w) = kernels::detail::apply_activation(*(r_out + w), fused_activation, fused_lut);
                 }
             }
         }
@@ -367,7 +388,7 @@ void conv2d_channel_dispatch(size_t &i, size_t out_h, size_t out_w, std::array<T
         }
         increase_n<compute_rsize<LocalParallel, Stride_h, Filter_h>()>(r,
             (Stride_h * LocalParallel - 1) * in_w_step + tail_step);
-        increase_n<LocalParallel>(outptr, out_w_step * (LocalParallel - 1));
+        increase_n<LocalParallel>(outptr, out_w_step * LocalParallel - out_w);
     }
     conv2d_channel_dispatch<LocalParallel / 2, Filter_h, Filter_w, Stride_h, Stride_w>(i, out_h, out_w, sum,
         r, k, outptr, in_w_step, out_w_step, tail_step, std::integral_constant<bool, std::greater<size_t>()(LocalParallel, 1)> {});
@@ -387,12 +408,14 @@ result<void> conv2d_nxm(const float *input, const float *weights, const float *b
     NNCASE_UNUSED const runtime_shape_t &w_strides, NNCASE_UNUSED const runtime_shape_t &bias_strides, NNCASE_UNUSED const runtime_shape_t &out_strides,
     NNCASE_UNUSED const padding &padding_h, NNCASE_UNUSED const padding &padding_w,
     NNCASE_UNUSED int32_t groups, NNCASE_UNUSED int32_t stride_h, NNCASE_UNUSED int32_t stride_w,
-    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, NNCASE_UNUSED kernels::kernel_context &context) noexcept
+    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut, NNCASE_UNUSED kernels::kernel_context &context) noexcept
 {
     const auto batch = in_shape[0], out_channels = w_shape[0], in_channels = w_shape[1], in_h = in_shape[2], in_w = in_shape[3];
     const auto out_h = kernels::detail::get_windowed_output_size(in_h, Filter_h, Stride_h, dilation_h, padding::zero());
     const auto out_w = kernels::detail::get_windowed_output_size(in_w, Filter_w, Stride_w, dilation_w, padding::zero());
-    const size_t tail_step = in_strides[2] - (out_w * Stride_w);
+    const auto in_row_step = get_row_step(in_shape, in_strides);
+    const auto out_row_step = get_row_step({ batch, out_channels, out_h, out_w }, out_strides);
+    const size_t tail_step = in_row_step - (out_w * Stride_w);
     for (size_t b = 0; b < batch; b++) // batch
     {
 #ifdef NNCASE_OPENMP
@@ -406,21 +429,22 @@ result<void> conv2d_nxm(const float *input, const float *weights, const float *b
             std::array<float, Parallel> sum;
 
             float *out = output + out_strides[0] * b + out_strides[1] * oc;
-            std::fill_n(out, out_strides[2] ? out_h * out_strides[2] : (out_strides[3] ? out_w * out_strides[3] : 1), bias[oc]); // avoid shape == 1, stride == 0
+            for (size_t h = 0; h < out_h; h++)
+                std::fill_n(out + h * out_row_step, out_w, bias[oc]);
 
             for (size_t ic = 0; ic < in_channels; ic++) // in channel
             {
-                binding_ptr<Parallel>(outptr, out, out_strides[2]);
-                binding_ptr<Parallel, Stride_h, Filter_h>(r, input + in_strides[0] * b + in_strides[1] * ic, in_strides[2]);
+                binding_ptr<Parallel>(outptr, out, out_row_step);
+                binding_ptr<Parallel, Stride_h, Filter_h>(r, input + in_strides[0] * b + in_strides[1] * ic, in_row_step);
                 binding_ptr<Filter_h>(k, weights + w_strides[0] * oc + w_strides[1] * ic, w_strides[2]);
-                conv2d_channel<Parallel, Filter_h, Filter_w, Stride_h, Stride_w>(out_h, out_w, sum, r, k, outptr, in_strides[2], out_strides[2], tail_step);
+                conv2d_channel<Parallel, Filter_h, Filter_w, Stride_h, Stride_w>(out_h, out_w, sum, r, k, outptr, in_row_step, out_row_step, tail_step);
             }
             for (size_t h = 0; h < out_h; h++)
             {
                 float *r_out = out + h * out_strides[2];
                 for (size_t w = 0; w < out_w; w++)
                 {
-                    *(r_out + w) = kernels::detail::apply_activation(*(r_out + w), fused_activation);
+                    *(r_out + w) = kernels::detail::apply_activation(*(r_out + w), fused_activation, fused_lut);
                 }
             }
         }
@@ -434,13 +458,15 @@ result<void> conv2d_depthwise_nxm(const float *input, const float *weights, cons
     NNCASE_UNUSED const runtime_shape_t &w_strides, NNCASE_UNUSED const runtime_shape_t &bias_strides, NNCASE_UNUSED const runtime_shape_t &out_strides,
     NNCASE_UNUSED const padding &padding_h, NNCASE_UNUSED const padding &padding_w,
     NNCASE_UNUSED int32_t groups, NNCASE_UNUSED int32_t stride_h, NNCASE_UNUSED int32_t stride_w,
-    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, NNCASE_UNUSED kernels::kernel_context &context) noexcept
+    NNCASE_UNUSED int32_t dilation_h, NNCASE_UNUSED int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut, NNCASE_UNUSED kernels::kernel_context &context) noexcept
 {
     const auto batch = in_shape[0], channels = w_shape[0], in_h = in_shape[2], in_w = in_shape[3];
     const auto out_h = kernels::detail::get_windowed_output_size(in_h, Filter_h, Stride_h, dilation_h, padding::zero());
     const auto out_w = kernels::detail::get_windowed_output_size(in_w, Filter_w, Stride_w, dilation_w, padding::zero());
 
-    const size_t tail_step = in_strides[2] - (out_w * Stride_w);
+    const auto in_row_step = get_row_step(in_shape, in_strides);
+    const auto out_row_step = get_row_step({ batch, channels, out_h, out_w }, out_strides);
+    const size_t tail_step = in_row_step - (out_w * Stride_w);
     for (size_t b = 0; b < batch; b++) // batch
     {
 
@@ -455,18 +481,19 @@ result<void> conv2d_depthwise_nxm(const float *input, const float *weights, cons
             std::array<float, Parallel> sum;
 
             float *out = output + out_strides[0] * b + out_strides[1] * c;
-            std::fill_n(out, out_strides[2] ? out_h * out_strides[2] : (out_strides[3] ? out_w * out_strides[3] : 1), bias[c]);
+            for (size_t h = 0; h < out_h; h++)
+                std::fill_n(out + h * out_row_step, out_w, bias[c]);
 
-            binding_ptr<Parallel>(outptr, out, out_strides[2]);
-            binding_ptr<Parallel, Stride_h, Filter_h>(r, input + in_strides[0] * b + in_strides[1] * c, in_strides[2]);
+            binding_ptr<Parallel>(outptr, out, out_row_step);
+            binding_ptr<Parallel, Stride_h, Filter_h>(r, input + in_strides[0] * b + in_strides[1] * c, in_row_step);
             binding_ptr<Filter_h>(k, weights + w_strides[0] * c, w_strides[2]);
-            conv2d_channel<Parallel, Filter_h, Filter_w, Stride_h, Stride_w>(out_h, out_w, sum, r, k, outptr, in_strides[2], out_strides[2], tail_step);
+            conv2d_channel<Parallel, Filter_h, Filter_w, Stride_h, Stride_w>(out_h, out_w, sum, r, k, outptr, in_row_step, out_row_step, tail_step);
             for (size_t h = 0; h < out_h; h++)
             {
                 float *r_out = out + h * out_strides[2];
                 for (size_t w = 0; w < out_w; w++)
                 {
-                    *(r_out + w) = kernels::detail::apply_activation(*(r_out + w), fused_activation);
+                    *(r_out + w) = kernels::detail::apply_activation(*(r_out + w), fused_activation, fused_lut);
                 }
             }
         }
@@ -475,46 +502,61 @@ result<void> conv2d_depthwise_nxm(const float *input, const float *weights, cons
 }
 
 #ifdef NNCASE_HALIDE
-#define HALIDE_CONV2D_NXM_S1_S2(KH, KW)                                                                                               \
-    if (filter_h == (KH) && filter_w == (KW))                                                                                         \
-    {                                                                                                                                 \
-        const auto out_h = detail::get_windowed_output_size(in_shape[2], filter_h, stride_h, dilation_h, padding_h);                  \
-        const auto out_w = detail::get_windowed_output_size(in_shape[3], filter_w, stride_w, dilation_w, padding_w);                  \
-        Halide::Runtime::Buffer<float> _input_buffer(const_cast<float *>(input), in_shape[3], in_shape[2], in_shape[1], in_shape[0]); \
-        Halide::Runtime::Buffer<float> _weights_buffer(const_cast<float *>(weights), w_shape[3], w_shape[2], w_shape[1], w_shape[0]); \
-        Halide::Runtime::Buffer<float> _bias_buffer(const_cast<float *>(bias), w_shape[0]);                                           \
-        float v_range[2] = { fused_activation.min, fused_activation.max };                                                            \
-        Halide::Runtime::Buffer<float> _value_range_buffer(v_range, 2);                                                               \
-        Halide::Runtime::Buffer<float> _Clamped_buffer(output, out_w, out_h, w_shape[0], in_shape[0]);                                \
-        if (stride_h == stride_w && (stride_h == 1 || stride_h == 2))                                                                 \
-        {                                                                                                                             \
-            halide_conv2d_##KH##x##KW(_input_buffer, _weights_buffer, _bias_buffer, _value_range_buffer,                              \
-                padding_h.before, padding_h.after, padding_w.before, padding_w.after,                                                 \
-                stride_h, stride_w, _Clamped_buffer);                                                                                 \
-            return ok();                                                                                                              \
-        }                                                                                                                             \
+namespace
+{
+// Halide buffers take explicit strides, dims are listed innermost first
+Halide::Runtime::Buffer<float> make_halide_buffer(const float *data, const runtime_shape_t &shape, const runtime_shape_t &strides)
+{
+    std::array<halide_dimension_t, 4> dims;
+    for (size_t i = 0; i < dims.size(); i++)
+    {
+        auto axis = shape.size() - 1 - i;
+        // Pipelines require a unit innermost stride even when that dim has a single element
+        dims[i] = { 0, (int32_t)shape[axis], i == 0 ? 1 : (int32_t)strides[axis], 0 };
     }
 
-#define HALIDE_CONV2D_DEPTHWISE_NXM_S1_S2(KH, KW)                                                                                     \
-    if (filter_h == (KH) && filter_w == (KW))                                                                                         \
-    {                                                                                                                                 \
-        const auto out_h = detail::get_windowed_output_size(in_shape[2], filter_h, stride_h, dilation_h, padding_h);                  \
-        const auto out_w = detail::get_windowed_output_size(in_shape[3], filter_w, stride_w, dilation_w, padding_w);                  \
-        Halide::Runtime::Buffer<float> _input_buffer(const_cast<float *>(input), in_shape[3], in_shape[2], in_shape[1], in_shape[0]); \
-        Halide::Runtime::Buffer<float> _weights_buffer(const_cast<float *>(weights), w_shape[3], w_shape[2], w_shape[1], w_shape[0]); \
-        Halide::Runtime::Buffer<float> _bias_buffer(const_cast<float *>(bias), w_shape[0]);                                           \
-        float v_range[2] = { fused_activation.min, fused_activation.max };                                                            \
-        Halide::Runtime::Buffer<float> _value_range_buffer(v_range, 2);                                                               \
-        Halide::Runtime::Buffer<float> _Clamped_buffer(output, out_w, out_h, w_shape[0], in_shape[0]);                                \
-        if (stride_h == stride_w && (stride_h == 1 || stride_h == 2))                                                                 \
-        {                                                                                                                             \
-            halide_conv2d_depthwise_##KH##x##KW(_input_buffer, _weights_buffer, _bias_buffer, _value_range_buffer,                    \
-                padding_h.before, padding_h.after, padding_w.before, padding_w.after,                                                 \
-                stride_h, stride_w, _Clamped_buffer);                                                                                 \
-            return ok();                                                                                                              \
-        }                                                                                                                             \
+    return Halide::Runtime::Buffer<float>(const_cast<float *>(data), (int)shape.size(), dims.data());
+}
+
+// Halide kernels only fuse the clamp, the lut is applied on the output rows afterwards
+void apply_fused_lut(float *output, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    value_range<float> fused_activation, const activation_lut &fused_lut, kernels::kernel_context &context) noexcept
+{
+    if (fused_lut.empty())
+        return;
+
+    const auto row_step = get_row_step(out_shape, out_strides);
+    const auto planes = (int32_t)(out_shape[0] * out_shape[1]);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int32_t p = 0; p < planes; p++)
+    {
+        auto out_plane = output + (p / out_shape[1]) * out_strides[0] + (p % out_shape[1]) * out_strides[1];
+        for (size_t h = 0; h < out_shape[2]; h++)
+        {
+            auto out_row = out_plane + h * row_step;
+            for (size_t w = 0; w < out_shape[3]; w++)
+                out_row[w] = kernels::detail::apply_activation(out_row[w], fused_activation, fused_lut);
+        }
     }
+}
+}
 
+#define HALIDE_CONV2D_IMPL(FUNC, KH, KW)                                                                                       \
+    if (filter_h == (KH) && filter_w == (KW) && stride_h == stride_w && (stride_h == 1 || stride_h == 2))                      \
+    {                                                                                                                          \
+        float v_range[2] = { fused_activation.min, fused_activation.max };                                                     \
+        Halide::Runtime::Buffer<float> _value_range_buffer(v_range, 2);                                                        \
+        Halide::Runtime::Buffer<float> _bias_buffer(const_cast<float *>(bias), w_shape[0]);                                    \
+        auto _input_buffer = make_halide_buffer(input, in_shape, in_strides);                                                  \
+        auto _weights_buffer = make_halide_buffer(weights, w_shape, w_strides);                                                \
+        auto _output_buffer = make_halide_buffer(output, out_shape, out_strides);                                              \
+        FUNC##_##KH##x##KW(_input_buffer, _weights_buffer, _bias_buffer, _value_range_buffer,                                  \
+            padding_h.before, padding_h.after, padding_w.before, padding_w.after, stride_h, stride_w, _output_buffer);          \
+        apply_fused_lut(output, out_shape, out_strides, fused_activation, fused_lut, context);                                 \
+        return ok();                                                                                                           \
+    }
 #endif
 
 result<void> optimized::conv2d(const float *input, const float *weights, const float *bias, float *output,
@@ -523,36 +565,44 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
     NNCASE_UNUSED const runtime_shape_t &bias_strides, NNCASE_UNUSED const runtime_shape_t &out_strides,
     const padding &padding_h, const padding &padding_w, int32_t groups,
     int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w,
-    value_range<float> fused_activation, NNCASE_UNUSED kernels::kernel_context &context) noexcept
+    value_range<float> fused_activation, activation_lut fused_lut, NNCASE_UNUSED kernels::kernel_context &context) noexcept
 {
     const auto filter_h = w_shape[2];
     const auto filter_w = w_shape[3];
+    const runtime_shape_t out_shape { in_shape[0], w_shape[0],
+        kernels::detail::get_windowed_output_size(in_shape[2], (int32_t)filter_h, stride_h, dilation_h, padding_h),
+        kernels::detail::get_windowed_output_size(in_shape[3], (int32_t)filter_w, stride_w, dilation_w, padding_w) };
+
+    // All kernels below walk rows with unit W stride, the other dims follow the given strides
+    if (!has_dense_rows(in_shape, in_strides) || !has_dense_rows(out_shape, out_strides) || !has_dense_rows(w_shape, w_strides))
+        return err(std::errc::not_supported);
 
 #ifdef NNCASE_HALIDE
-    if (groups == 1 && runtime::is_contiguous(in_shape, in_strides))
+    if (groups == 1)
     {
         // clang-format off
-        HALIDE_CONV2D_NXM_S1_S2(1, 1)
-        else HALIDE_CONV2D_NXM_S1_S2(3, 3)
-        else HALIDE_CONV2D_NXM_S1_S2(5, 5)
-        else HALIDE_CONV2D_NXM_S1_S2(7, 7)
+        HALIDE_CONV2D_IMPL(halide_conv2d, 1, 1)
+        else HALIDE_CONV2D_IMPL(halide_conv2d, 3, 3)
+        else HALIDE_CONV2D_IMPL(halide_conv2d, 5, 5)
+        else HALIDE_CONV2D_IMPL(halide_conv2d, 7, 7)
         // clang-format on
     }
 
-    if ((size_t)groups == in_shape[1] && (size_t)groups == w_shape[0] && runtime::is_contiguous(in_shape, in_strides))
+    if ((size_t)groups == in_shape[1] && (size_t)groups == w_shape[0])
     {
         // clang-format off
-        HALIDE_CONV2D_DEPTHWISE_NXM_S1_S2(1, 1)
-        else HALIDE_CONV2D_DEPTHWISE_NXM_S1_S2(3, 3)
-        else HALIDE_CONV2D_DEPTHWISE_NXM_S1_S2(5, 5)
-        else HALIDE_CONV2D_DEPTHWISE_NXM_S1_S2(7, 7)
+        HALIDE_CONV2D_IMPL(halide_conv2d_depthwise, 1, 1)
+        else HALIDE_CONV2D_IMPL(halide_conv2d_depthwise, 3, 3)
+        else HALIDE_CONV2D_IMPL(halide_conv2d_depthwise, 5, 5)
+        else HALIDE_CONV2D_IMPL(halide_conv2d_depthwise, 7, 7)
         // clang-format on
     }
 
 #else
     if (groups == 1 && padding_h.before == 0 && padding_h.after == 0 && padding_w.before == 0 && padding_w.after == 0)
     {
-        if (filter_h == 1 && filter_w == 1)
+        // The 1x1 kernels walk whole H x W planes at once
+        if (filter_h == 1 && filter_w == 1 && has_dense_planes(in_shape, in_strides) && has_dense_planes(out_shape, out_strides))
         {
             if (stride_h == 1 && stride_w == 1)
             {
@@ -564,6 +614,7 @@ result<void> optimized::conv2d(const float *input, const float *weights, const f
             }
         }
         // clang-format off
+        else CONV2D_NXM_S1_S2(1, 1)
         else CONV2D_NXM_S1_S2(1, 3)
         else CONV2D_NXM_S1_S2(3, 1) 
         else CONV2D_NXM_S1_S2(3, 3) 
@@ -0,0 +1,171 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+struct decoded_box
+{
+    float x1, y1, x2, y2, area;
+};
+
+template <class T>
+decoded_box decode_box(const T *box, size_t coord_stride, bool center_point_box) noexcept
+{
+    float a = (float)box[0], b = (float)box[coord_stride], c = (float)box[2 * coord_stride], d = (float)box[3 * coord_stride];
+    decoded_box result;
+    if (center_point_box)
+    {
+        // [x_center, y_center, width, height]
+        result.x1 = a - c * 0.5f;
+        result.x2 = a + c * 0.5f;
+        result.y1 = b - d * 0.5f;
+        result.y2 = b + d * 0.5f;
+    }
+    else
+    {
+        // [y1, x1, y2, x2], any diagonal pair of corners
+        result.y1 = std::min(a, c);
+        result.y2 = std::max(a, c);
+        result.x1 = std::min(b, d);
+        result.x2 = std::max(b, d);
+    }
+
+    result.area = (result.x2 - result.x1) * (result.y2 - result.y1);
+    return result;
+}
+
+bool overlaps(const decoded_box &lhs, const decoded_box &rhs, float iou_threshold) noexcept
+{
+    auto w = std::max(0.f, std::min(lhs.x2, rhs.x2) - std::max(lhs.x1, rhs.x1));
+    auto h = std::max(0.f, std::min(lhs.y2, rhs.y2) - std::max(lhs.y1, rhs.y1));
+    auto inter = w * h;
+    auto uni = lhs.area + rhs.area - inter;
+    auto iou = uni > 0.f ? inter / uni : 0.f;
+    return iou > iou_threshold;
+}
+
+using candidate_t = std::pair<float, size_t>;
+
+// Heap order, the best candidate has the highest score and the lowest index
+struct worse_than
+{
+    bool operator()(const candidate_t &lhs, const candidate_t &rhs) const noexcept
+    {
+        return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second > rhs.second);
+    }
+};
+}
+
+template result<void> optimized::detection_postprocess<float>(const float *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const float *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold, kernel_context &context) noexcept;
+
+template <typename T>
+result<void> optimized::detection_postprocess(const T *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const T *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const auto batches = boxes_shape[0];
+    const auto spatial = boxes_shape[1];
+    const auto classes = scores_shape[1];
+    const auto max_per_class = (size_t)max_output_boxes_per_class;
+    const auto tasks = (int64_t)(batches * classes);
+
+    // 1. Decode the boxes of all batches once, they are shared by every class
+    std::vector<decoded_box> decoded(batches * spatial);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int64_t i = 0; i < (int64_t)decoded.size(); i++)
+    {
+        auto box = boxes + (size_t)i / spatial * boxes_strides[0] + (size_t)i % spatial * boxes_strides[1];
+        decoded[i] = decode_box(box, boxes_strides[2], center_point_box);
+    }
+
+    // 2. Greedy NMS of each batch and class, selections are compacted in order afterwards
+    std::vector<size_t> selected(tasks * max_per_class);
+    std::vector<size_t> selected_counts(tasks);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel num_threads(context.num_threads)
+#endif
+    {
+        std::vector<candidate_t> heap;
+        heap.reserve(spatial);
+
+#ifdef NNCASE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int64_t task = 0; task < tasks; task++)
+        {
+            const auto b = (size_t)task / classes;
+            const auto c = (size_t)task % classes;
+            auto class_scores = scores + b * scores_strides[0] + c * scores_strides[1];
+            auto class_boxes = decoded.data() + b * spatial;
+
+            heap.clear();
+            for (size_t i = 0; i < spatial; i++)
+            {
+                auto score = (float)class_scores[i * scores_strides[2]];
+                if (score > score_threshold)
+                    heap.emplace_back(score, i);
+            }
+
+            // Candidates are only ordered as far as they are visited, a candidate survives
+            // unless a box selected before it overlaps it, so it is enough to check those
+            std::make_heap(heap.begin(), heap.end(), worse_than {});
+            auto task_selected = selected.data() + task * max_per_class;
+            size_t count = 0;
+            while (!heap.empty() && count < max_per_class)
+            {
+                std::pop_heap(heap.begin(), heap.end(), worse_than {});
+                auto idx = heap.back().second;
+                heap.pop_back();
+
+                auto &box = class_boxes[idx];
+                if (std::none_of(task_selected, task_selected + count, [&](size_t s) { return overlaps(class_boxes[s], box, iou_threshold); }))
+                    task_selected[count++] = idx;
+            }
+
+            selected_counts[task] = count;
+        }
+    }
+
+    size_t rows = 0;
+    for (size_t task = 0; task < (size_t)tasks; task++)
+    {
+        for (size_t i = 0; i < selected_counts[task]; i++)
+        {
+            auto row = output + rows * 3;
+            row[0] = (int64_t)(task / classes);
+            row[1] = (int64_t)(task % classes);
+            row[2] = (int64_t)selected[task * max_per_class + i];
+            rows++;
+        }
+    }
+
+    std::fill(output + rows * 3, output + tasks * max_per_class * 3, int64_t(-1));
+    return ok();
+}
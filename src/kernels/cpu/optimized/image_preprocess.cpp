@@ -0,0 +1,166 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+// Integer pixels are dequantized through a 256 entry table
+template <class T>
+class pixel_loader
+{
+public:
+    pixel_loader(quant_param_t param)
+    {
+        for (size_t i = 0; i < table_.size(); i++)
+            table_[i] = (static_cast<T>(i) - param.zero_point) * param.scale;
+    }
+
+    float operator()(T value) const noexcept { return table_[static_cast<uint8_t>(value)]; }
+
+private:
+    std::array<float, 256> table_;
+};
+
+template <>
+class pixel_loader<float>
+{
+public:
+    pixel_loader(NNCASE_UNUSED quant_param_t param) { }
+
+    float operator()(float value) const noexcept { return value; }
+};
+}
+
+#define IMAGE_PREPROCESS_IMPL(type)                                                                                                   \
+    template result<void> optimized::image_preprocess<type>(const type *input, const float *mean, const float *stddev, float *output, \
+        const runtime_shape_t &in_shape, const runtime_shape_t &out_shape,                                                            \
+        quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left, \
+        float pad_value, bool output_nhwc, kernel_context &context) noexcept;
+
+IMAGE_PREPROCESS_IMPL(uint8_t)
+IMAGE_PREPROCESS_IMPL(int8_t)
+IMAGE_PREPROCESS_IMPL(float)
+
+template <typename T>
+result<void> optimized::image_preprocess(const T *input, const float *mean, const float *stddev, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &out_shape,
+    quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left,
+    float pad_value, bool output_nhwc, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const auto channels = input_nhwc ? in_shape[3] : in_shape[1];
+    const auto in_h = input_nhwc ? in_shape[1] : in_shape[2];
+    const auto in_w = input_nhwc ? in_shape[2] : in_shape[3];
+    const auto out_h = output_nhwc ? out_shape[1] : out_shape[2];
+    const auto out_w = output_nhwc ? out_shape[2] : out_shape[3];
+    const auto height_scale = (float)in_h / resize_h;
+    const auto width_scale = (float)in_w / resize_w;
+
+    // Element strides of a row and a channel, so both layouts share the row loop
+    const auto in_x_stride = input_nhwc ? channels : 1;
+    const auto in_y_stride = in_w * in_x_stride;
+    const auto in_c_stride = input_nhwc ? 1 : in_h * in_w;
+    const auto out_x_stride = output_nhwc ? channels : 1;
+    const auto out_y_stride = out_w * out_x_stride;
+    const auto out_c_stride = output_nhwc ? 1 : out_h * out_w;
+    const auto in_image_size = in_h * in_w * channels;
+    const auto out_image_size = out_h * out_w * channels;
+
+    pixel_loader<T> load(in_param);
+    std::vector<float> inv_stddev(channels), pad_norm(channels);
+    for (size_t c = 0; c < channels; c++)
+    {
+        inv_stddev[c] = 1.f / stddev[c];
+        pad_norm[c] = (pad_value - mean[c]) * inv_stddev[c];
+    }
+
+    // Horizontal taps are the same for every row
+    std::vector<size_t> x0_offsets(resize_w), x1_offsets(resize_w);
+    std::vector<float> x_fractions(resize_w);
+    for (int32_t x = 0; x < resize_w; x++)
+    {
+        float in_x;
+        int32_t in_x0, in_x1;
+        kernels::detail::set_resize_bilinear(x, width_scale, true, in_w, in_x, in_x0, in_x1);
+        x0_offsets[x] = in_x0 * in_x_stride;
+        x1_offsets[x] = in_x1 * in_x_stride;
+        x_fractions[x] = in_x - in_x0;
+    }
+
+    const auto rows = (int64_t)(out_shape[0] * out_h);
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int64_t row = 0; row < rows; row++)
+    {
+        const auto n = (size_t)row / out_h;
+        const auto oy = (size_t)row % out_h;
+        const auto y = (int32_t)oy - pad_top;
+        const auto in_image = input + n * in_image_size;
+        auto out_row = output + n * out_image_size + oy * out_y_stride;
+
+        float in_y = 0;
+        int32_t in_y0 = 0, in_y1 = 0;
+        const auto inside = y >= 0 && y < resize_h;
+        if (inside)
+            kernels::detail::set_resize_bilinear(y, height_scale, true, in_h, in_y, in_y0, in_y1);
+        const auto fy = in_y - in_y0;
+
+        for (size_t c = 0; c < channels; c++)
+        {
+            auto out = out_row + c * out_c_stride;
+            if (!inside)
+            {
+                for (size_t ox = 0; ox < out_w; ox++)
+                    out[ox * out_x_stride] = pad_norm[c];
+                continue;
+            }
+
+            for (int32_t ox = 0; ox < pad_left; ox++)
+                out[ox * out_x_stride] = pad_norm[c];
+            for (size_t ox = pad_left + resize_w; ox < out_w; ox++)
+                out[ox * out_x_stride] = pad_norm[c];
+
+            const auto src_c = swap_rb ? channels - 1 - c : c;
+            const auto row0 = in_image + src_c * in_c_stride + in_y0 * in_y_stride;
+            const auto row1 = in_image + src_c * in_c_stride + in_y1 * in_y_stride;
+            const auto m = mean[c];
+            const auto s = inv_stddev[c];
+            out += pad_left * out_x_stride;
+            for (int32_t x = 0; x < resize_w; x++)
+            {
+                const auto fx = x_fractions[x];
+                const auto a0 = (1 - fy) * (1 - fx);
+                const auto a1 = fy * (1 - fx);
+                const auto a2 = (1 - fy) * fx;
+                const auto a3 = fy * fx;
+                const auto value = load(row0[x0_offsets[x]]) * a0 + load(row1[x0_offsets[x]]) * a1
+                    + load(row0[x1_offsets[x]]) * a2 + load(row1[x1_offsets[x]]) * a3;
+                out[x * out_x_stride] = (value - m) * s;
+            }
+        }
+    }
+
+    return ok();
+}
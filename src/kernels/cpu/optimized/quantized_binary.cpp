@@ -0,0 +1,95 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+template <class T, class TOp>
+void quantized_binary_impl(const T *CXX_RESTRICT input_a, const T *CXX_RESTRICT input_b, T *CXX_RESTRICT output, size_t count,
+    size_t a_step, size_t b_step, float low, float high, NNCASE_UNUSED kernel_context &context, TOp &&op) noexcept
+{
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int32_t i = 0; i < (int32_t)count; i++)
+    {
+        auto value = op((int32_t)input_a[i * a_step], (int32_t)input_b[i * b_step]);
+        output[i] = (T)lrintf(kernels::detail::clamp(value, low, high));
+    }
+}
+}
+
+#define QUANTIZED_BINARY_INSTANCE(type)                                                                                         \
+    template result<void> optimized::quantized_binary<type>(binary_op_t op, const type *input_a, const type *input_b, type *output, \
+        const runtime_shape_t &in_a_shape, const runtime_shape_t &in_b_shape, quant_param_t in_a_param, quant_param_t in_b_param,  \
+        quant_param_t out_param, value_range<float> fused_activation, kernel_context &context) noexcept;
+
+QUANTIZED_BINARY_INSTANCE(uint8_t)
+QUANTIZED_BINARY_INSTANCE(int8_t)
+
+template <typename T>
+result<void> optimized::quantized_binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_b_shape, quant_param_t in_a_param, quant_param_t in_b_param,
+    quant_param_t out_param, value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    const auto a_size = compute_size(in_a_shape);
+    const auto b_size = compute_size(in_b_shape);
+    const auto count = std::max(a_size, b_size);
+    if ((a_size != count && a_size != 1) || (b_size != count && b_size != 1))
+        return err(std::errc::not_supported);
+
+    // Dequantize, activation and requantize collapse into one affine expression on the raw integers,
+    // the activation becomes a clamp in the output quantized domain.
+    const auto a_step = a_size == 1 ? 0 : 1;
+    const auto b_step = b_size == 1 ? 0 : 1;
+    const auto out_zp = (float)out_param.zero_point;
+    const auto low = std::max(fused_activation.min / out_param.scale + out_zp, (float)std::numeric_limits<T>::lowest());
+    const auto high = std::min(fused_activation.max / out_param.scale + out_zp, (float)std::numeric_limits<T>::max());
+
+    switch (op)
+    {
+    case binary_add:
+    case binary_sub:
+    {
+        const auto ka = in_a_param.scale / out_param.scale;
+        const auto kb = (op == binary_add ? 1.f : -1.f) * in_b_param.scale / out_param.scale;
+        const auto bias = out_zp - in_a_param.zero_point * ka - in_b_param.zero_point * kb;
+        quantized_binary_impl(input_a, input_b, output, count, a_step, b_step, low, high, context, [=](int32_t a, int32_t b) {
+            return a * ka + b * kb + bias;
+        });
+        return ok();
+    }
+    case binary_mul:
+    {
+        const auto k = in_a_param.scale * in_b_param.scale / out_param.scale;
+        const auto za = in_a_param.zero_point;
+        const auto zb = in_b_param.zero_point;
+        quantized_binary_impl(input_a, input_b, output, count, a_step, b_step, low, high, context, [=](int32_t a, int32_t b) {
+            return (float)((a - za) * (b - zb)) * k + out_zp;
+        });
+        return ok();
+    }
+    default:
+        return err(std::errc::not_supported);
+    }
+}
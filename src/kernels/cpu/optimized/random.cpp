@@ -0,0 +1,112 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+constexpr size_t lanes = 16;
+
+// Philox4x32-10 over `lanes` consecutive blocks in struct-of-arrays form so the rounds vectorize
+void philox4x32_lanes(uint64_t first_block, kernels::detail::philox_key key, std::array<kernels::detail::philox_block, lanes> &blocks) noexcept
+{
+    constexpr uint32_t m0 = 0xD2511F53, m1 = 0xCD9E8D57;
+    constexpr uint32_t w0 = 0x9E3779B9, w1 = 0xBB67AE85;
+    uint32_t c0[lanes], c1[lanes], c2[lanes], c3[lanes];
+    for (size_t l = 0; l < lanes; l++)
+    {
+        c0[l] = (uint32_t)(first_block + l);
+        c1[l] = (uint32_t)((first_block + l) >> 32);
+        c2[l] = c3[l] = 0;
+    }
+
+    for (int32_t round = 0; round < 10; round++)
+    {
+        for (size_t l = 0; l < lanes; l++)
+        {
+            const auto p0 = (uint64_t)m0 * c0[l];
+            const auto p1 = (uint64_t)m1 * c2[l];
+            const auto n0 = (uint32_t)(p1 >> 32) ^ c1[l] ^ key[0];
+            const auto n2 = (uint32_t)(p0 >> 32) ^ c3[l] ^ key[1];
+            c0[l] = n0;
+            c1[l] = (uint32_t)p1;
+            c2[l] = n2;
+            c3[l] = (uint32_t)p0;
+        }
+
+        key[0] += w0;
+        key[1] += w1;
+    }
+
+    for (size_t l = 0; l < lanes; l++)
+        blocks[l] = { c0[l], c1[l], c2[l], c3[l] };
+}
+
+// Chunks only depend on their index, so the result doesn't change with the thread count
+template <class T, class TBlockOp>
+void random_impl(T *output, size_t size, float seed, NNCASE_UNUSED kernel_context &context, TBlockOp &&block_op) noexcept
+{
+    const auto key = kernels::detail::get_philox_key(seed);
+    const auto chunk_size = lanes * 4;
+    const auto chunks = (size + chunk_size - 1) / chunk_size;
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel for num_threads(context.num_threads)
+#endif
+    for (int64_t chunk = 0; chunk < (int64_t)chunks; chunk++)
+    {
+        std::array<kernels::detail::philox_block, lanes> blocks;
+        philox4x32_lanes((uint64_t)chunk * lanes, key, blocks);
+        for (size_t l = 0; l < lanes; l++)
+        {
+            const auto begin = (size_t)chunk * chunk_size + l * 4;
+            if (begin >= size)
+                break;
+            block_op(output + begin, std::min(size - begin, (size_t)4), blocks[l]);
+        }
+    }
+}
+}
+
+template result<void> optimized::random_normal<float>(float *output, const runtime_shape_t &out_shape, float mean, float std, float seed,
+    kernel_context &context) noexcept;
+
+template <typename T>
+result<void> optimized::random_normal(T *output, const runtime_shape_t &out_shape, float mean, float stddev, float seed, kernel_context &context) noexcept
+{
+    random_impl(output, compute_size(out_shape), seed, context, [=](T *out, size_t count, const kernels::detail::philox_block &bits) {
+        kernels::detail::random_normal_block(out, count, bits, mean, stddev);
+    });
+    return ok();
+}
+
+template result<void> optimized::random_uniform<float>(float *output, const runtime_shape_t &out_shape, float low, float high, float seed,
+    kernel_context &context) noexcept;
+
+template <typename T>
+result<void> optimized::random_uniform(T *output, const runtime_shape_t &out_shape, float low, float high, float seed, kernel_context &context) noexcept
+{
+    random_impl(output, compute_size(out_shape), seed, context, [=](T *out, size_t count, const kernels::detail::philox_block &bits) {
+        kernels::detail::random_uniform_block(out, count, bits, low, high);
+    });
+    return ok();
+}
@@ -25,28 +25,26 @@ namespace
 {
 
 template <class T>
-result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
+result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, NNCASE_UNUSED bool half_pixel_centers, NNCASE_UNUSED kernel_context &context) noexcept
 {
     auto scales = kernels::detail::get_resize_scales(in_shape, out_h, out_w, align_corners);
     auto height_scale = scales.first;
     auto width_scale = scales.second;
-    const float rounding_offset = std::numeric_limits<T>::is_integer ? .5f : .0f;
     runtime_shape_t in_index(4), out_index(4);
 
-    const auto in_img_size = in_shape[2] * in_shape[3];
     const auto out_img_size = out_w * out_h;
 
     for (size_t batch = 0; batch < in_shape[0]; batch++)
     {
-        auto in_batch = input + (size_t)batch * in_shape[1] * in_img_size;
+        auto in_batch = input + batch * in_strides[0];
         auto *begin_output_ptr = output + batch * in_shape[1] * out_w * out_h;
 #ifdef NNCASE_OPENMP
 #pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
 #endif
         for (size_t oc = 0; oc < in_shape[1]; oc++)
         {
-            auto in_c = in_batch + (size_t)oc * in_img_size;
+            auto in_c = in_batch + oc * in_strides[1];
             auto *output_ptr = begin_output_ptr + oc * out_img_size;
             for (int oy = 0; oy < out_h; oy++)
             {
@@ -60,17 +58,17 @@ result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape
                     int32_t in_x0, in_x1;
                     kernels::detail::set_resize_bilinear(ox, width_scale, half_pixel_centers, in_shape[3], in_x, in_x0, in_x1);
 
-                    auto v0 = in_c[in_y0 * in_shape[3] + in_x0];
-                    auto v1 = in_c[in_y1 * in_shape[3] + in_x0];
-                    auto v2 = in_c[in_y0 * in_shape[3] + in_x1];
-                    auto v3 = in_c[in_y1 * in_shape[3] + in_x1];
+                    auto v0 = in_c[in_y0 * in_strides[2] + in_x0];
+                    auto v1 = in_c[in_y1 * in_strides[2] + in_x0];
+                    auto v2 = in_c[in_y0 * in_strides[2] + in_x1];
+                    auto v3 = in_c[in_y1 * in_strides[2] + in_x1];
 
                     auto a0 = (1 - (in_y - in_y0)) * (1 - (in_x - in_x0));
                     auto a1 = (in_y - in_y0) * (1 - (in_x - in_x0));
                     auto a2 = (1 - (in_y - in_y0)) * (in_x - in_x0);
                     auto a3 = (in_y - in_y0) * (in_x - in_x0);
 
-                    *output_ptr++ = T(v0 * a0 + v1 * a1 + v2 * a2 + v3 * a3 + rounding_offset);
+                    *output_ptr++ = kernels::detail::round_cast<T>(v0 * a0 + v1 * a1 + v2 * a2 + v3 * a3);
                 }
             }
         }
@@ -79,31 +77,30 @@ result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape
 }
 
 template <class T>
-result<void> resize_nearest_neighbor_impl(const T *input, T *output, const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
+result<void> resize_nearest_neighbor_impl(const T *input, T *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, bool align_corners, bool half_pixel_centers, NNCASE_UNUSED kernel_context &context) noexcept
 {
     auto scales = kernels::detail::get_resize_scales(in_shape, out_h, out_w, align_corners);
     auto height_scale = scales.first;
     auto width_scale = scales.second;
 
-    const auto in_image_size = in_shape[2] * in_shape[3];
     const auto out_image_size = out_h * out_w;
     for (size_t batch = 0; batch < in_shape[0]; batch++)
     {
-        auto *begin_input_ptr = input + batch * in_shape[1] * in_image_size;
+        auto *begin_input_ptr = input + batch * in_strides[0];
         auto *begin_output_ptr = output + batch * in_shape[1] * out_image_size;
 #ifdef NNCASE_OPENMP
 #pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
 #endif
         for (size_t oc = 0; oc < in_shape[1]; oc++)
         {
-            auto *input_ptr = begin_input_ptr + oc * in_image_size;
+            auto *input_ptr = begin_input_ptr + oc * in_strides[1];
             auto *output_ptr = begin_output_ptr + oc * out_image_size;
 
             for (int oy = 0; oy < out_h; oy++)
             {
                 auto in_y = kernels::detail::get_nearest_neighbor(oy, in_shape[2], height_scale, align_corners, half_pixel_centers);
-                auto *in_row = input_ptr + in_y * in_shape[3];
+                auto *in_row = input_ptr + in_y * in_strides[2];
 
                 for (int ox = 0; ox < out_w; ox++)
                 {
@@ -117,7 +114,7 @@ result<void> resize_nearest_neighbor_impl(const T *input, T *output, const runti
 }
 
 inline result<void> gnne_resize_nearest_neighbor(const bfloat16 *input, bfloat16 *output,
-    const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     NNCASE_UNUSED const runtime_shape_t &out_strides, int32_t out_h, int32_t out_w, NNCASE_UNUSED bool align_corners, NNCASE_UNUSED bool half_pixel_centers, NNCASE_UNUSED kernel_context &context)
 {
     if (align_corners || half_pixel_centers)
@@ -128,24 +125,23 @@ inline result<void> gnne_resize_nearest_neighbor(const bfloat16 *input, bfloat16
     auto height_scale = (float)in_shape[2] / out_h;
     auto width_scale = (float)in_shape[3] / out_w;
 
-    const auto in_image_size = in_shape[2] * in_shape[3];
     const auto out_image_size = out_h * out_w;
     for (size_t batch = 0; batch < in_shape[0]; batch++)
     {
-        auto *begin_input_ptr = input + batch * in_shape[1] * in_image_size;
+        auto *begin_input_ptr = input + batch * in_strides[0];
         auto *begin_output_ptr = output + batch * in_shape[1] * out_image_size;
 #ifdef NNCASE_OPENMP
 #pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
 #endif
         for (size_t oc = 0; oc < in_shape[1]; oc++)
         {
-            auto *input_ptr = begin_input_ptr + oc * in_image_size;
+            auto *input_ptr = begin_input_ptr + oc * in_strides[1];
             auto *output_ptr = begin_output_ptr + oc * out_image_size;
 
             for (int oy = 0; oy < out_h; oy++)
             {
                 auto in_y = std::min((int32_t)floorf(oy * height_scale), (int32_t)in_shape[2] - 1);
-                auto *in_row = input_ptr + in_y * in_shape[3];
+                auto *in_row = input_ptr + in_y * in_strides[2];
 
                 for (int ox = 0; ox < out_w; ox++)
                 {
@@ -158,7 +154,7 @@ inline result<void> gnne_resize_nearest_neighbor(const bfloat16 *input, bfloat16
     return ok();
 }
 
-inline result<void> resize_bilinear_impl(const bfloat16 *input, bfloat16 *output, const runtime_shape_t &in_shape, NNCASE_UNUSED const runtime_shape_t &in_strides,
+inline result<void> resize_bilinear_impl(const bfloat16 *input, bfloat16 *output, const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
     NNCASE_UNUSED const runtime_shape_t &out_strides,
     int32_t out_h, int32_t out_w, bool align_corners,
     NNCASE_UNUSED bool half_pixel_centers,
@@ -176,19 +172,18 @@ inline result<void> resize_bilinear_impl(const bfloat16 *input, bfloat16 *output
     if (align_corners && out_w > 1)
         width_scale = (float)(in_shape[3] - 1) / (out_w - 1);
 
-    const auto in_img_size = in_shape[2] * in_shape[3];
     const auto out_img_size = out_w * out_h;
 
     for (size_t batch = 0; batch < in_shape[0]; batch++)
     {
-        auto in_batch = input + (size_t)batch * in_shape[1] * in_img_size;
+        auto in_batch = input + batch * in_strides[0];
         auto *begin_output_ptr = output + batch * in_shape[1] * out_w * out_h;
 #ifdef NNCASE_OPENMP
 #pragma omp parallel for num_threads(kernels::default_kernel_context().num_threads)
 #endif
         for (size_t oc = 0; oc < in_shape[1]; oc++)
         {
-            auto in_c = in_batch + (size_t)oc * in_img_size;
+            auto in_c = in_batch + oc * in_strides[1];
             auto *output_ptr = begin_output_ptr + oc * out_img_size;
             for (int oy = 0; oy < out_h; oy++)
             {
@@ -202,10 +197,10 @@ inline result<void> resize_bilinear_impl(const bfloat16 *input, bfloat16 *output
                     auto in_x0 = (int)floorf(in_x);
                     auto in_x1 = std::min(in_x0 + 1, (int32_t)in_shape[3] - 1);
 
-                    auto v0 = in_c[in_y0 * in_shape[3] + in_x0];
-                    auto v1 = in_c[in_y1 * in_shape[3] + in_x0];
-                    auto v2 = in_c[in_y0 * in_shape[3] + in_x1];
-                    auto v3 = in_c[in_y1 * in_shape[3] + in_x1];
+                    auto v0 = in_c[in_y0 * in_strides[2] + in_x0];
+                    auto v1 = in_c[in_y1 * in_strides[2] + in_x0];
+                    auto v2 = in_c[in_y0 * in_strides[2] + in_x1];
+                    auto v3 = in_c[in_y1 * in_strides[2] + in_x1];
 
                     auto a0 = (1 - (in_y - in_y0)) * (1 - (in_x - in_x0));
                     auto a1 = (in_y - in_y0) * (1 - (in_x - in_x0));
@@ -0,0 +1,176 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <numeric>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::optimized;
+
+namespace
+{
+constexpr size_t prefilter_block = 64;
+
+template <class T>
+using element_t = std::pair<T, int64_t>;
+
+template <class T>
+struct better_than
+{
+    bool largest;
+
+    bool operator()(const element_t<T> &a, const element_t<T> &b) const noexcept
+    {
+        if (a.first != b.first)
+            return largest ? a.first > b.first : a.first < b.first;
+        return a.second < b.second;
+    }
+};
+
+template <class T>
+size_t count_hits(const T *src, size_t count, T threshold, bool largest) noexcept
+{
+    // Branch-free so the compiler can vectorize the compare
+    size_t hits = 0;
+    if (largest)
+    {
+        for (size_t i = 0; i < count; i++)
+            hits += src[i] > threshold;
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+            hits += src[i] < threshold;
+    }
+    return hits;
+}
+
+// Small k: keep a heap of the best k with the worst on top, and only look at the
+// elements of a block once the vectorized prefilter finds one beating the threshold
+template <class T>
+void select_heap(const T *src, size_t n, size_t k, better_than<T> better, std::vector<element_t<T>> &heap) noexcept
+{
+    heap.resize(k);
+    for (size_t i = 0; i < k; i++)
+        heap[i] = { src[i], (int64_t)i };
+    std::make_heap(heap.begin(), heap.end(), better);
+
+    auto threshold = heap.front().first;
+    for (size_t begin = k; begin < n; begin += prefilter_block)
+    {
+        auto end = std::min(begin + prefilter_block, n);
+        if (!count_hits(src + begin, end - begin, threshold, better.largest))
+            continue;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            // Equal values have larger indices so never replace the top
+            auto v = src[i];
+            if (better.largest ? v > threshold : v < threshold)
+            {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = { v, (int64_t)i };
+                std::push_heap(heap.begin(), heap.end(), better);
+                threshold = heap.front().first;
+            }
+        }
+    }
+}
+
+// Large k: quickselect the k-th element
+template <class T>
+void select_partition(const T *src, size_t n, size_t k, better_than<T> better, std::vector<element_t<T>> &elements) noexcept
+{
+    elements.resize(n);
+    for (size_t i = 0; i < n; i++)
+        elements[i] = { src[i], (int64_t)i };
+    if (k < n)
+        std::nth_element(elements.begin(), elements.begin() + (k - 1), elements.end(), better);
+    elements.resize(k);
+}
+
+template <class T>
+result<void> topk_impl(const T *input, T *output_values, int64_t *output_indices, const runtime_shape_t &in_shape,
+    size_t k, size_t axis, bool largest, bool sorted, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    const auto n = in_shape[axis];
+    const auto outer = std::accumulate(in_shape.begin(), in_shape.begin() + axis, size_t(1), std::multiplies<size_t> {});
+    const auto inner = std::accumulate(in_shape.begin() + axis + 1, in_shape.end(), size_t(1), std::multiplies<size_t> {});
+    const auto slices = (int64_t)(outer * inner);
+    const better_than<T> better { largest };
+    const bool use_heap = k * 8 <= n;
+
+#ifdef NNCASE_OPENMP
+#pragma omp parallel num_threads(context.num_threads)
+#endif
+    {
+        std::vector<T> column(inner == 1 ? 0 : n);
+        std::vector<element_t<T>> selected;
+
+#ifdef NNCASE_OPENMP
+#pragma omp for
+#endif
+        for (int64_t s = 0; s < slices; s++)
+        {
+            const auto o = (size_t)s / inner;
+            const auto in = (size_t)s % inner;
+            const T *src = input + o * n * inner + in;
+            if (inner != 1)
+            {
+                for (size_t i = 0; i < n; i++)
+                    column[i] = src[i * inner];
+                src = column.data();
+            }
+
+            if (use_heap)
+                select_heap(src, n, k, better, selected);
+            else
+                select_partition(src, n, k, better, selected);
+
+            // Unsorted results keep the input order
+            if (sorted)
+                std::sort(selected.begin(), selected.end(), better);
+            else
+                std::sort(selected.begin(), selected.end(), [](auto &a, auto &b) { return a.second < b.second; });
+
+            auto values = output_values + o * k * inner + in;
+            auto indices = output_indices + o * k * inner + in;
+            for (size_t i = 0; i < k; i++)
+            {
+                values[i * inner] = selected[i].first;
+                indices[i * inner] = selected[i].second;
+            }
+        }
+    }
+
+    return ok();
+}
+}
+
+template result<void> optimized::topk<float>(const float *input, float *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, int64_t k, int32_t axis, bool largest, bool sorted, kernel_context &context) noexcept;
+
+template <typename T>
+result<void> optimized::topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, int64_t k, int32_t axis, bool largest, bool sorted, kernel_context &context) noexcept
+{
+    return topk_impl(input, output_values, output_indices, in_shape, (size_t)k, (size_t)axis, largest, sorted, context);
+}
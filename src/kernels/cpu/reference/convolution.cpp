@@ -24,7 +24,7 @@ using namespace nncase::kernels::cpu::reference;
 result<void> reference::conv2d(const float *input, const float *weights, const float *bias, float *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &w_shape, const runtime_shape_t &w_strides,
     const runtime_shape_t &bias_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
-    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
+    int32_t groups, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation, activation_lut fused_lut,
     NNCASE_UNUSED kernel_context &context) noexcept
 {
     const auto filter_h = (int32_t)w_shape[2];
@@ -82,7 +82,7 @@ result<void> reference::conv2d(const float *input, const float *weights, const f
                             }
                         }
 
-                        output[offset(out_strides, out_index)] = kernels::detail::apply_activation(value, fused_activation);
+                        output[offset(out_strides, out_index)] = kernels::detail::apply_activation(value, fused_activation, fused_lut);
                     }
                 }
             }
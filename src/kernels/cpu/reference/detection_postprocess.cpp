@@ -0,0 +1,158 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <numeric>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::reference;
+
+namespace
+{
+// Decoded boxes as separate arrays so the IoU loop over candidates vectorizes
+struct decoded_boxes
+{
+    std::vector<float> x1, y1, x2, y2, area;
+
+    explicit decoded_boxes(size_t count)
+        : x1(count), y1(count), x2(count), y2(count), area(count)
+    {
+    }
+};
+
+template <class T>
+void decode_boxes(const T *boxes, const runtime_shape_t &boxes_strides, size_t batch, size_t count, bool center_point_box, decoded_boxes &decoded) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        auto box = boxes + batch * boxes_strides[0] + i * boxes_strides[1];
+        float a = (float)box[0], b = (float)box[boxes_strides[2]], c = (float)box[2 * boxes_strides[2]], d = (float)box[3 * boxes_strides[2]];
+        float x1, y1, x2, y2;
+        if (center_point_box)
+        {
+            // [x_center, y_center, width, height]
+            x1 = a - c * 0.5f;
+            x2 = a + c * 0.5f;
+            y1 = b - d * 0.5f;
+            y2 = b + d * 0.5f;
+        }
+        else
+        {
+            // [y1, x1, y2, x2], any diagonal pair of corners
+            y1 = std::min(a, c);
+            y2 = std::max(a, c);
+            x1 = std::min(b, d);
+            x2 = std::max(b, d);
+        }
+
+        decoded.x1[i] = x1;
+        decoded.y1[i] = y1;
+        decoded.x2[i] = x2;
+        decoded.y2[i] = y2;
+        decoded.area[i] = (x2 - x1) * (y2 - y1);
+    }
+}
+
+// Mark every remaining candidate whose IoU with the selected box exceeds the threshold
+void suppress(const decoded_boxes &decoded, size_t selected, const size_t *candidates, uint8_t *suppressed, size_t count, float iou_threshold) noexcept
+{
+    auto sx1 = decoded.x1[selected], sy1 = decoded.y1[selected], sx2 = decoded.x2[selected], sy2 = decoded.y2[selected];
+    auto sarea = decoded.area[selected];
+    for (size_t i = 0; i < count; i++)
+    {
+        auto idx = candidates[i];
+        auto w = std::max(0.f, std::min(sx2, decoded.x2[idx]) - std::max(sx1, decoded.x1[idx]));
+        auto h = std::max(0.f, std::min(sy2, decoded.y2[idx]) - std::max(sy1, decoded.y1[idx]));
+        auto inter = w * h;
+        auto uni = sarea + decoded.area[idx] - inter;
+        auto iou = uni > 0.f ? inter / uni : 0.f;
+        suppressed[i] |= (uint8_t)(iou > iou_threshold);
+    }
+}
+}
+
+template result<void> reference::detection_postprocess<float>(const float *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const float *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold) noexcept;
+
+template <typename T>
+result<void> reference::detection_postprocess(const T *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const T *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold) noexcept
+{
+    const auto batches = boxes_shape[0];
+    const auto spatial = boxes_shape[1];
+    const auto classes = scores_shape[1];
+    const auto max_per_class = (size_t)max_output_boxes_per_class;
+    const auto total_rows = batches * classes * max_per_class;
+
+    decoded_boxes decoded(spatial);
+    std::vector<size_t> candidates(spatial);
+    std::vector<float> candidate_scores(spatial);
+    std::vector<uint8_t> suppressed(spatial);
+    size_t rows = 0;
+
+    for (size_t b = 0; b < batches; b++)
+    {
+        decode_boxes(boxes, boxes_strides, b, spatial, center_point_box, decoded);
+
+        for (size_t c = 0; c < classes; c++)
+        {
+            auto class_scores = scores + b * scores_strides[0] + c * scores_strides[1];
+
+            // 1. Score threshold
+            size_t count = 0;
+            for (size_t i = 0; i < spatial; i++)
+            {
+                auto score = (float)class_scores[i * scores_strides[2]];
+                candidate_scores[i] = score;
+                if (score > score_threshold)
+                    candidates[count++] = i;
+            }
+
+            // 2. Sort by score
+            std::sort(candidates.begin(), candidates.begin() + count, [&](size_t lhs, size_t rhs) {
+                return candidate_scores[lhs] > candidate_scores[rhs] || (candidate_scores[lhs] == candidate_scores[rhs] && lhs < rhs);
+            });
+
+            // 3. Greedy NMS
+            std::fill_n(suppressed.begin(), count, 0);
+            size_t selected = 0;
+            for (size_t i = 0; i < count && selected < max_per_class; i++)
+            {
+                if (suppressed[i])
+                    continue;
+
+                auto idx = candidates[i];
+                auto row = output + rows * 3;
+                row[0] = (int64_t)b;
+                row[1] = (int64_t)c;
+                row[2] = (int64_t)idx;
+                rows++;
+                selected++;
+                suppress(decoded, idx, candidates.data() + i + 1, suppressed.data() + i + 1, count - i - 1, iou_threshold);
+            }
+        }
+    }
+
+    std::fill(output + rows * 3, output + total_rows * 3, int64_t(-1));
+    return ok();
+}
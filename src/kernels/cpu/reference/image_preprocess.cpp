@@ -0,0 +1,92 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::reference;
+
+#define IMAGE_PREPROCESS_IMPL(type)                                                                                                              \
+    template result<void> reference::image_preprocess<type>(const type *input, const float *mean, const float *stddev, float *output,             \
+        const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, \
+        quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left,            \
+        float pad_value, bool output_nhwc) noexcept;
+
+IMAGE_PREPROCESS_IMPL(uint8_t)
+IMAGE_PREPROCESS_IMPL(int8_t)
+IMAGE_PREPROCESS_IMPL(float)
+
+template <typename T>
+result<void> reference::image_preprocess(const T *input, const float *mean, const float *stddev, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left,
+    float pad_value, bool output_nhwc) noexcept
+{
+    const auto channels = input_nhwc ? in_shape[3] : in_shape[1];
+    const auto in_h = input_nhwc ? in_shape[1] : in_shape[2];
+    const auto in_w = input_nhwc ? in_shape[2] : in_shape[3];
+    const auto out_h = output_nhwc ? out_shape[1] : out_shape[2];
+    const auto out_w = output_nhwc ? out_shape[2] : out_shape[3];
+    const auto height_scale = (float)in_h / resize_h;
+    const auto width_scale = (float)in_w / resize_w;
+
+    auto load = [&](size_t n, size_t c, size_t y, size_t x) -> float {
+        auto value = input[offset(in_strides, input_nhwc ? runtime_shape_t { n, y, x, c } : runtime_shape_t { n, c, y, x })];
+        if constexpr (std::is_same_v<T, float>)
+            return value;
+        else
+            return (value - in_param.zero_point) * in_param.scale;
+    };
+
+    for (size_t n = 0; n < out_shape[0]; n++)
+    {
+        for (size_t c = 0; c < channels; c++)
+        {
+            auto src_c = swap_rb ? channels - 1 - c : c;
+            for (size_t oy = 0; oy < out_h; oy++)
+            {
+                auto y = (int32_t)oy - pad_top;
+                for (size_t ox = 0; ox < out_w; ox++)
+                {
+                    auto x = (int32_t)ox - pad_left;
+                    auto value = pad_value;
+                    if (y >= 0 && y < resize_h && x >= 0 && x < resize_w)
+                    {
+                        float in_y, in_x;
+                        int32_t in_y0, in_y1, in_x0, in_x1;
+                        kernels::detail::set_resize_bilinear(y, height_scale, true, in_h, in_y, in_y0, in_y1);
+                        kernels::detail::set_resize_bilinear(x, width_scale, true, in_w, in_x, in_x0, in_x1);
+
+                        auto a0 = (1 - (in_y - in_y0)) * (1 - (in_x - in_x0));
+                        auto a1 = (in_y - in_y0) * (1 - (in_x - in_x0));
+                        auto a2 = (1 - (in_y - in_y0)) * (in_x - in_x0);
+                        auto a3 = (in_y - in_y0) * (in_x - in_x0);
+                        value = load(n, src_c, in_y0, in_x0) * a0 + load(n, src_c, in_y1, in_x0) * a1
+                            + load(n, src_c, in_y0, in_x1) * a2 + load(n, src_c, in_y1, in_x1) * a3;
+                    }
+
+                    auto out_index = output_nhwc ? runtime_shape_t { n, oy, ox, c } : runtime_shape_t { n, c, oy, ox };
+                    output[offset(out_strides, out_index)] = (value - mean[c]) / stddev[c];
+                }
+            }
+        }
+    }
+
+    return ok();
+}
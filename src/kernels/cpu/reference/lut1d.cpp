@@ -24,22 +24,32 @@ using namespace nncase::kernels::cpu::reference;
 
 namespace
 {
-result<void> lut1d_impl(const uint8_t *input, const uint8_t *table, uint8_t *output, const runtime_shape_t &shape,
+// Tables are indexed from the lowest value of the type, so int8 tables start at -128
+template <class T>
+result<void> lut1d_impl(const T *input, const T *table, T *output, const runtime_shape_t &shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides) noexcept
 {
     return apply(shape, [&](const runtime_shape_t &index) -> result<void> {
-        const auto v = input[offset(in_strides, index)];
+        const auto v = (int32_t)input[offset(in_strides, index)] - (int32_t)std::numeric_limits<T>::lowest();
         output[offset(out_strides, index)] = table[v];
         return ok();
     });
 }
 }
 
+#define LUT1D_IMPL(type) \
+    return lut1d_impl(reinterpret_cast<const type *>(input), reinterpret_cast<const type *>(table), reinterpret_cast<type *>(output), shape, in_strides, out_strides)
+
 result<void> reference::lut1d(datatype_t type, const gsl::byte *input, const gsl::byte *table, gsl::byte *output, const runtime_shape_t &shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, NNCASE_UNUSED const scalar &min, NNCASE_UNUSED const scalar &max) noexcept
 {
-    if (type != dt_uint8)
+    switch (type)
+    {
+    case dt_uint8:
+        LUT1D_IMPL(uint8_t);
+    case dt_int8:
+        LUT1D_IMPL(int8_t);
+    default:
         return err(std::errc::not_supported);
-    return lut1d_impl(reinterpret_cast<const uint8_t *>(input), reinterpret_cast<const uint8_t *>(table),
-        reinterpret_cast<uint8_t *>(output), shape, in_strides, out_strides);
+    }
 }
@@ -0,0 +1,74 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::reference;
+
+namespace
+{
+template <class T, class TOp>
+result<void> quantized_binary_impl(TOp &&op, const T *input_a, const T *input_b, T *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, quant_param_t in_a_param, quant_param_t in_b_param,
+    quant_param_t out_param, value_range<float> fused_activation) noexcept
+{
+    const auto out_shape = kernels::detail::get_binary_output_shape(in_a_shape, in_b_shape);
+    return apply(out_shape, [&](const runtime_shape_t &index) -> result<void> {
+        const auto in_a_index = kernels::detail::get_reduced_offset(index, in_a_shape);
+        const auto in_b_index = kernels::detail::get_reduced_offset(index, in_b_shape);
+        const auto a = kernels::detail::dequantize(input_a[offset(in_a_strides, in_a_index)], in_a_param);
+        const auto b = kernels::detail::dequantize(input_b[offset(in_b_strides, in_b_index)], in_b_param);
+        output[offset(out_strides, index)] = kernels::detail::quantize<T>(kernels::detail::apply_activation(op(a, b), fused_activation), out_param);
+        return ok();
+    });
+}
+}
+
+#define QUANTIZED_BINARY_INSTANCE(type)                                                                                         \
+    template result<void> reference::quantized_binary<type>(binary_op_t op, const type *input_a, const type *input_b, type *output, \
+        const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,              \
+        const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, quant_param_t in_a_param, quant_param_t in_b_param, \
+        quant_param_t out_param, value_range<float> fused_activation, kernel_context &context) noexcept;
+
+QUANTIZED_BINARY_INSTANCE(uint8_t)
+QUANTIZED_BINARY_INSTANCE(int8_t)
+
+#define QUANTIZED_BINARY_IMPL(op, funct) \
+    case op:                             \
+        return quantized_binary_impl(funct, input_a, input_b, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides, out_strides, in_a_param, in_b_param, out_param, fused_activation)
+
+template <typename T>
+result<void> reference::quantized_binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, quant_param_t in_a_param, quant_param_t in_b_param,
+    quant_param_t out_param, value_range<float> fused_activation, NNCASE_UNUSED kernel_context &context) noexcept
+{
+    switch (op)
+    {
+        QUANTIZED_BINARY_IMPL(binary_add, std::plus<float>());
+        QUANTIZED_BINARY_IMPL(binary_sub, std::minus<float>());
+        QUANTIZED_BINARY_IMPL(binary_mul, std::multiplies<float>());
+        QUANTIZED_BINARY_IMPL(binary_min, [](float a, float b) { return std::min(a, b); });
+        QUANTIZED_BINARY_IMPL(binary_max, [](float a, float b) { return std::max(a, b); });
+    default:
+        return err(std::errc::not_supported);
+    }
+}
@@ -12,11 +12,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-// #include <iostream>
 #include <nncase/kernels/cpu/reference/tensor_compute.h>
 #include <nncase/kernels/kernel_utils.h>
 #include <nncase/runtime/runtime_op_utility.h>
-#include <random>
 
 using namespace nncase;
 using namespace nncase::runtime;
@@ -27,11 +25,12 @@ using namespace nncase::kernels::cpu::reference;
 template result<void> reference::random_normal<float>(float *output, const runtime_shape_t &out_shape, float mean, float std, float seed) noexcept;
 
 template <typename T>
-result<void> reference::random_normal(T *output, const runtime_shape_t &out_shape, float mean, float std, float seed) noexcept
+result<void> reference::random_normal(T *output, const runtime_shape_t &out_shape, float mean, float stddev, float seed) noexcept
 {
-    std::default_random_engine engine(seed);
-    std::normal_distribution<T> dis(mean, std);
-    std::generate_n(output, compute_size(out_shape), [&] { return dis(engine); });
+    const auto key = kernels::detail::get_philox_key(seed);
+    const auto size = compute_size(out_shape);
+    for (size_t i = 0; i < size; i += 4)
+        kernels::detail::random_normal_block(output + i, std::min(size - i, (size_t)4), kernels::detail::philox4x32(i / 4, key), mean, stddev);
 
     return ok();
 }
@@ -41,9 +40,10 @@ template result<void> reference::random_uniform<float>(float *output, const runt
 template <typename T>
 result<void> reference::random_uniform(T *output, const runtime_shape_t &out_shape, float low, float high, float seed) noexcept
 {
-    std::default_random_engine engine(seed);
-    std::uniform_real_distribution<T> dis(low, high);
-    std::generate_n(output, compute_size(out_shape), [&] { return dis(engine); });
+    const auto key = kernels::detail::get_philox_key(seed);
+    const auto size = compute_size(out_shape);
+    for (size_t i = 0; i < size; i += 4)
+        kernels::detail::random_uniform_block(output + i, std::min(size - i, (size_t)4), kernels::detail::philox4x32(i / 4, key), low, high);
 
     return ok();
 }
@@ -24,22 +24,51 @@ using namespace nncase::kernels::cpu::reference;
 
 namespace
 {
+// Quantized inputs share one quant param with the output, so windows are reduced on
+// the raw integers and the activation is already in the quantized domain.
+template <class T>
+using accumulator_t = std::conditional_t<std::is_floating_point_v<T>, float, int32_t>;
+
+template <class T>
 struct identity_window
 {
-    float operator()(float src, NNCASE_UNUSED int32_t window) const noexcept
+    accumulator_t<T> operator()(accumulator_t<T> src, NNCASE_UNUSED int32_t window) const noexcept
     {
         return src;
     }
 };
 
-template <class TBinaryOp, class TWindowOp>
-result<void> reduce_window2d_impl(const float *input, float init_value, float *output, const runtime_shape_t &in_shape,
+template <class T>
+struct mean_window
+{
+    accumulator_t<T> operator()(accumulator_t<T> src, int32_t window) const noexcept
+    {
+        if constexpr (std::is_floating_point_v<T>)
+            return src / (float)window;
+        else
+            return (int32_t)lrintf((float)src / window);
+    }
+};
+
+template <class T>
+T saturate(float value) noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return value;
+    else
+        return (T)kernels::detail::clamp(value, (float)std::numeric_limits<T>::lowest(), (float)std::numeric_limits<T>::max());
+}
+
+template <class T, class TBinaryOp, class TWindowOp>
+result<void> reduce_window2d_impl(const T *input, float init_value, T *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w,
     value_range<float> fused_activation, TBinaryOp &&binary_op, TWindowOp &&window_op, NNCASE_UNUSED kernel_context &context) noexcept
 {
+    using acc_t = accumulator_t<T>;
     const auto out_h = kernels::detail::get_windowed_output_size(in_shape[2], filter_h, stride_h, dilation_h, padding_h);
     const auto out_w = kernels::detail::get_windowed_output_size(in_shape[3], filter_w, stride_w, dilation_w, padding_w);
+    const auto init = (acc_t)saturate<T>(init_value);
     runtime_shape_t out_shape { in_shape[0], in_shape[1], out_h, out_w };
 
     for (size_t batch = 0; batch < in_shape[0]; batch++)
@@ -56,7 +85,7 @@ result<void> reduce_window2d_impl(const float *input, float init_value, float *o
                     const size_t filter_y_end = (size_t)std::min(filter_h, ((int32_t)in_shape[2] - in_y_origin + dilation_h - 1) / dilation_h);
                     const size_t filter_x_start = (size_t)std::max(0, (-in_x_origin + dilation_w - 1) / dilation_w);
                     const size_t filter_x_end = (size_t)std::min(filter_w, ((int32_t)in_shape[3] - in_x_origin + dilation_w - 1) / dilation_w);
-                    float value = init_value;
+                    acc_t value = init;
                     int32_t kernel_count = 0;
 
                     for (size_t ky = filter_y_start; ky < filter_y_end; ky++)
@@ -66,14 +95,15 @@ result<void> reduce_window2d_impl(const float *input, float init_value, float *o
                             const size_t in_y = in_y_origin + dilation_h * ky;
                             const size_t in_x = in_x_origin + dilation_w * kx;
 
-                            const float in_v = input[offset(in_strides, { batch, oc, in_y, in_x })];
+                            const acc_t in_v = input[offset(in_strides, { batch, oc, in_y, in_x })];
 
                             value = binary_op(value, in_v);
                             kernel_count++;
                         }
                     }
 
-                    output[offset(out_strides, { batch, oc, oy, ox })] = kernels::detail::apply_activation(window_op(value, kernel_count), fused_activation);
+                    auto result = kernels::detail::apply_activation((float)window_op(value, kernel_count), fused_activation);
+                    output[offset(out_strides, { batch, oc, oy, ox })] = saturate<T>(result);
                 }
             }
         }
@@ -87,21 +117,29 @@ result<void> reduce_window2d_impl(const float *input, float init_value, float *o
     case op:                                            \
         return reduce_window2d_impl(input, init_value, output, in_shape, in_strides, out_strides, padding_h, padding_w, filter_h, filter_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation, reducer, post_process, context)
 
-#define REDUCE_WINDOW2D_IMPL_NO_POST(op, reducer) \
-    case op:                                      \
-        return reduce_window2d_impl(input, init_value, output, in_shape, in_strides, out_strides, padding_h, padding_w, filter_h, filter_w, stride_h, stride_w, dilation_h, dilation_w, fused_activation, reducer, identity_window(), context)
+#define REDUCE_WINDOW2D_INSTANCE(type)                                                                                                          \
+    template result<void> reference::reduce_window2d<type>(reduce_op_t op, const type *input, float init_value, type *output,                     \
+        const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h,          \
+        const padding &padding_w, int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, \
+        value_range<float> fused_activation, kernel_context &context) noexcept;
+
+REDUCE_WINDOW2D_INSTANCE(float)
+REDUCE_WINDOW2D_INSTANCE(uint8_t)
+REDUCE_WINDOW2D_INSTANCE(int8_t)
 
-result<void> reference::reduce_window2d(reduce_op_t op, const float *input, float init_value, float *output, const runtime_shape_t &in_shape,
+template <typename T>
+result<void> reference::reduce_window2d(reduce_op_t op, const T *input, float init_value, T *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
     kernel_context &context) noexcept
 {
+    using acc_t = accumulator_t<T>;
     switch (op)
     {
-        REDUCE_WINDOW2D_IMPL(reduce_mean, std::plus<float>(), [](float v, int32_t block_size) { return v / (float)block_size; });
-        REDUCE_WINDOW2D_IMPL_NO_POST(reduce_min, [](float a, float b) { return std::min(a, b); });
-        REDUCE_WINDOW2D_IMPL_NO_POST(reduce_max, [](float a, float b) { return std::max(a, b); });
-        REDUCE_WINDOW2D_IMPL_NO_POST(reduce_sum, std::plus<float>());
+        REDUCE_WINDOW2D_IMPL(reduce_mean, std::plus<acc_t>(), mean_window<T>());
+        REDUCE_WINDOW2D_IMPL(reduce_min, [](acc_t a, acc_t b) { return std::min(a, b); }, identity_window<T>());
+        REDUCE_WINDOW2D_IMPL(reduce_max, [](acc_t a, acc_t b) { return std::max(a, b); }, identity_window<T>());
+        REDUCE_WINDOW2D_IMPL(reduce_sum, std::plus<acc_t>(), identity_window<T>());
     default:
         return err(std::errc::not_supported);
     }
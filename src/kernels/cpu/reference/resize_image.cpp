@@ -31,7 +31,6 @@ result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape
     auto height_scale = scales.first;
     auto width_scale = scales.second;
 
-    const float rounding_offset = std::numeric_limits<T>::is_integer ? .5f : .0f;
     runtime_shape_t in_index(4), out_index(4);
 
     auto get_input = [&](int32_t in_y, int32_t in_x) {
@@ -71,7 +70,7 @@ result<void> resize_bilinear_impl(const T *input, T *output, const runtime_shape
                     auto a1 = (in_y - in_y0) * (1 - (in_x - in_x0));
                     auto a2 = (1 - (in_y - in_y0)) * (in_x - in_x0);
                     auto a3 = (in_y - in_y0) * (in_x - in_x0);
-                    output[offset(out_strides, out_index)] = T(v0 * a0 + v1 * a1 + v2 * a2 + v3 * a3 + rounding_offset);
+                    output[offset(out_strides, out_index)] = kernels::detail::round_cast<T>(v0 * a0 + v1 * a1 + v2 * a2 + v3 * a3);
                 }
             }
         }
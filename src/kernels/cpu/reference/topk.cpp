@@ -0,0 +1,70 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <vector>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::kernels;
+using namespace nncase::kernels::cpu;
+using namespace nncase::kernels::cpu::reference;
+
+template result<void> reference::topk<float>(const float *input, float *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &output_values_strides, const runtime_shape_t &output_indices_strides,
+    int64_t k, int32_t axis, bool largest, bool sorted) noexcept;
+
+template <typename T>
+result<void> reference::topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &output_values_strides, const runtime_shape_t &output_indices_strides,
+    int64_t k, int32_t axis, bool largest, bool sorted) noexcept
+{
+    // Ties are broken by the smaller index, so the selected set is unique
+    auto better = [largest](const std::pair<T, int64_t> &a, const std::pair<T, int64_t> &b) {
+        if (a.first != b.first)
+            return largest ? a.first > b.first : a.first < b.first;
+        return a.second < b.second;
+    };
+
+    auto slice_shape = in_shape;
+    slice_shape[axis] = 1;
+    std::vector<std::pair<T, int64_t>> elements(in_shape[axis]);
+    return apply(slice_shape, [&](const runtime_shape_t &index) -> result<void> {
+        auto in_index = index;
+        for (size_t i = 0; i < in_shape[axis]; i++)
+        {
+            in_index[axis] = i;
+            elements[i] = { input[offset(in_strides, in_index)], (int64_t)i };
+        }
+
+        std::partial_sort(elements.begin(), elements.begin() + k, elements.end(), better);
+        // Unsorted results keep the input order
+        if (!sorted)
+            std::sort(elements.begin(), elements.begin() + k, [](auto &a, auto &b) { return a.second < b.second; });
+
+        auto out_index = index;
+        for (int64_t i = 0; i < k; i++)
+        {
+            out_index[axis] = (size_t)i;
+            output_values[offset(output_values_strides, out_index)] = elements[i].first;
+            output_indices[offset(output_indices_strides, out_index)] = elements[i].second;
+        }
+        return ok();
+    });
+}
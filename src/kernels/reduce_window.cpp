@@ -20,7 +20,18 @@ using namespace nncase;
 using namespace nncase::runtime;
 using namespace nncase::kernels;
 
-result<void> kernels::reduce_window2d(reduce_op_t op, const float *input, float init_value, float *output, const runtime_shape_t &in_shape,
+#define REDUCE_WINDOW2D_INSTANCE(type)                                                                                                          \
+    template result<void> kernels::reduce_window2d<type>(reduce_op_t op, const type *input, float init_value, type *output,                       \
+        const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h,          \
+        const padding &padding_w, int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, \
+        value_range<float> fused_activation, kernel_context &context) noexcept;
+
+REDUCE_WINDOW2D_INSTANCE(float)
+REDUCE_WINDOW2D_INSTANCE(uint8_t)
+REDUCE_WINDOW2D_INSTANCE(int8_t)
+
+template <typename T>
+result<void> kernels::reduce_window2d(reduce_op_t op, const T *input, float init_value, T *output, const runtime_shape_t &in_shape,
     const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, const padding &padding_h, const padding &padding_w,
     int32_t filter_h, int32_t filter_w, int32_t stride_h, int32_t stride_w, int32_t dilation_h, int32_t dilation_w, value_range<float> fused_activation,
     kernel_context &context) noexcept
@@ -14,6 +14,7 @@
  */
 #include <nncase/kernels/cpu/optimized/tensor_compute.h>
 #include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
 #include <nncase/kernels/tensor_compute.h>
 #include <nncase/runtime/runtime_op_utility.h>
 
@@ -90,6 +91,34 @@ result<void> kernels::copy(datatype_t type, const gsl::byte *src, gsl::byte *des
     }
 }
 
+#define QUANTIZED_BINARY_INSTANCE(type)                                                                                            \
+    template result<void> kernels::quantized_binary<type>(binary_op_t op, const type *input_a, const type *input_b, type *output,   \
+        const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,                 \
+        const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, quant_param_t in_a_param, quant_param_t in_b_param, \
+        quant_param_t out_param, value_range<float> fused_activation, kernel_context &context) noexcept;
+
+QUANTIZED_BINARY_INSTANCE(uint8_t)
+QUANTIZED_BINARY_INSTANCE(int8_t)
+
+template <typename T>
+result<void> kernels::quantized_binary(binary_op_t op, const T *input_a, const T *input_b, T *output,
+    const runtime_shape_t &in_a_shape, const runtime_shape_t &in_a_strides, const runtime_shape_t &in_b_shape,
+    const runtime_shape_t &in_b_strides, const runtime_shape_t &out_strides, quant_param_t in_a_param, quant_param_t in_b_param,
+    quant_param_t out_param, value_range<float> fused_activation, kernel_context &context) noexcept
+{
+    const auto out_shape = kernels::detail::get_binary_output_shape(in_a_shape, in_b_shape);
+    if ((op == binary_add || op == binary_sub || op == binary_mul)
+        && is_contiguous(in_a_shape, in_a_strides) && is_contiguous(in_b_shape, in_b_strides) && is_contiguous(out_shape, out_strides)
+        && (in_a_shape == in_b_shape || compute_size(in_a_shape) == 1 || compute_size(in_b_shape) == 1))
+    {
+        return cpu::optimized::quantized_binary(op, input_a, input_b, output, in_a_shape, in_b_shape, in_a_param, in_b_param, out_param,
+            fused_activation, context);
+    }
+
+    return cpu::reference::quantized_binary(op, input_a, input_b, output, in_a_shape, in_a_strides, in_b_shape, in_b_strides, out_strides,
+        in_a_param, in_b_param, out_param, fused_activation, context);
+}
+
 result<void> kernels::dequantize(datatype_t in_type, datatype_t out_type, const gsl::byte *input, gsl::byte *output,
     const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_strides, float scale, float bias,
     kernel_context &context) noexcept
@@ -193,9 +222,10 @@ result<void> kernels::reduce_prod(const T *input, T *output, const runtime_shape
     return cpu::reference::reduce_prod(input, output, in_shape, in_strides, out_strides, axes, keep_dims);
 }
 
+// Optimized resize kernels accept any batch, channel and row strides as long as rows are dense
 #define DISPATCH_RESIZE(resize_fun)                                                                                                                          \
     runtime_shape_t out_shape { in_shape[0], in_shape[1], static_cast<size_t>(out_h), static_cast<size_t>(out_w) };                                          \
-    if (is_contiguous(in_shape, in_strides) && is_contiguous(out_shape, out_strides))                                                                        \
+    if ((in_shape[3] == 1 || in_strides[3] == 1) && is_contiguous(out_shape, out_strides))                                                                   \
     {                                                                                                                                                        \
         return cpu::optimized::resize_fun(type, input, output, in_shape, in_strides, out_strides, out_h, out_w, align_corners, half_pixel_centers, context); \
     }                                                                                                                                                        \
@@ -285,20 +315,87 @@ result<void> kernels::hardmax(const T *input, const runtime_shape_t &in_shape, c
     return cpu::reference::hardmax(input, in_shape, in_strides, output, axis);
 }
 
-template result<void> kernels::random_normal<float>(float *output, const runtime_shape_t &out_shape, float mean, float std, float seed) noexcept;
+template result<void> kernels::detection_postprocess<float>(const float *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const float *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold, kernel_context &context) noexcept;
+
+template <typename T>
+result<void> kernels::detection_postprocess(const T *boxes, const runtime_shape_t &boxes_shape, const runtime_shape_t &boxes_strides,
+    const T *scores, const runtime_shape_t &scores_shape, const runtime_shape_t &scores_strides, int64_t *output,
+    bool center_point_box, int32_t max_output_boxes_per_class, float iou_threshold, float score_threshold, kernel_context &context) noexcept
+{
+    return cpu::optimized::detection_postprocess(boxes, boxes_shape, boxes_strides, scores, scores_shape, scores_strides, output,
+        center_point_box, max_output_boxes_per_class, iou_threshold, score_threshold, context);
+}
+
+template result<void> kernels::topk<float>(const float *input, float *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &output_values_strides, const runtime_shape_t &output_indices_strides,
+    int64_t k, int32_t axis, bool largest, bool sorted, kernel_context &context) noexcept;
+
+template <typename T>
+result<void> kernels::topk(const T *input, T *output_values, int64_t *output_indices,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides,
+    const runtime_shape_t &output_values_strides, const runtime_shape_t &output_indices_strides,
+    int64_t k, int32_t axis, bool largest, bool sorted, kernel_context &context) noexcept
+{
+    auto out_shape = in_shape;
+    out_shape[axis] = (size_t)k;
+    if (is_contiguous(in_shape, in_strides) && is_contiguous(out_shape, output_values_strides) && is_contiguous(out_shape, output_indices_strides))
+    {
+        return cpu::optimized::topk(input, output_values, output_indices, in_shape, k, axis, largest, sorted, context);
+    }
+    else
+    {
+        return cpu::reference::topk(input, output_values, output_indices, in_shape, in_strides, output_values_strides, output_indices_strides,
+            k, axis, largest, sorted);
+    }
+}
+
+#define IMAGE_PREPROCESS_IMPL(type)                                                                                                              \
+    template result<void> kernels::image_preprocess<type>(const type *input, const float *mean, const float *stddev, float *output,               \
+        const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides, \
+        quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left,            \
+        float pad_value, bool output_nhwc, kernel_context &context) noexcept;
+
+IMAGE_PREPROCESS_IMPL(uint8_t)
+IMAGE_PREPROCESS_IMPL(int8_t)
+IMAGE_PREPROCESS_IMPL(float)
+
+template <typename T>
+result<void> kernels::image_preprocess(const T *input, const float *mean, const float *stddev, float *output,
+    const runtime_shape_t &in_shape, const runtime_shape_t &in_strides, const runtime_shape_t &out_shape, const runtime_shape_t &out_strides,
+    quant_param_t in_param, bool input_nhwc, bool swap_rb, int32_t resize_h, int32_t resize_w, int32_t pad_top, int32_t pad_left,
+    float pad_value, bool output_nhwc, kernel_context &context) noexcept
+{
+    if (is_contiguous(in_shape, in_strides) && is_contiguous(out_shape, out_strides))
+    {
+        return cpu::optimized::image_preprocess(input, mean, stddev, output, in_shape, out_shape, in_param, input_nhwc, swap_rb,
+            resize_h, resize_w, pad_top, pad_left, pad_value, output_nhwc, context);
+    }
+    else
+    {
+        return cpu::reference::image_preprocess(input, mean, stddev, output, in_shape, in_strides, out_shape, out_strides, in_param, input_nhwc, swap_rb,
+            resize_h, resize_w, pad_top, pad_left, pad_value, output_nhwc);
+    }
+}
+
+template result<void> kernels::random_normal<float>(float *output, const runtime_shape_t &out_shape, float mean, float std, float seed,
+    kernel_context &context) noexcept;
 
 template <typename T>
-result<void> kernels::random_normal(T *output, const runtime_shape_t &out_shape, float mean, float std, float seed) noexcept
+result<void> kernels::random_normal(T *output, const runtime_shape_t &out_shape, float mean, float std, float seed, kernel_context &context) noexcept
 {
-    return cpu::reference::random_normal(output, out_shape, mean, std, seed);
+    return cpu::optimized::random_normal(output, out_shape, mean, std, seed, context);
 }
 
-template result<void> kernels::random_uniform<float>(float *output, const runtime_shape_t &out_shape, float low, float high, float seed) noexcept;
+template result<void> kernels::random_uniform<float>(float *output, const runtime_shape_t &out_shape, float low, float high, float seed,
+    kernel_context &context) noexcept;
 
 template <typename T>
-result<void> kernels::random_uniform(T *output, const runtime_shape_t &out_shape, float low, float high, float seed) noexcept
+result<void> kernels::random_uniform(T *output, const runtime_shape_t &out_shape, float low, float high, float seed, kernel_context &context) noexcept
 {
-    return cpu::reference::random_uniform(output, out_shape, low, high, seed);
+    return cpu::optimized::random_uniform(output, out_shape, low, high, seed, context);
 }
 
 template result<void> kernels::ternary<float>(const float *input_a, const float *input_b, const float *input_c, float *output,
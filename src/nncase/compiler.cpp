@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "nncase/ir/quantizer.h"
+#include <chrono>
 #include <fstream>
 #include <magic_enum.hpp>
 #include <nncase/codegen/model_builder.h>
@@ -21,6 +22,8 @@
 #include <nncase/importer/importer.h>
 #include <nncase/ir/debug.h>
 #include <nncase/ir/evaluator.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/visitor.h>
 #include <nncase/kernels/neutral/neutral_kernels.h>
 #include <nncase/runtime/datatypes.h>
 #include <nncase/runtime/debug.h>
@@ -30,6 +33,7 @@
 #include <nncase/transforms/neutral/post_process_transform.h>
 #include <nncase/transforms/neutral/pre_process_setting.h>
 #include <nncase/transforms/pass.h>
+#include <unordered_set>
 #include <variant>
 
 using namespace nncase;
@@ -120,6 +124,51 @@ std::string format_size(size_t size)
     return ss.str();
 }
 
+class phase_timer
+{
+public:
+    phase_timer(double &elapsed_ms)
+        : elapsed_ms_(elapsed_ms), begin_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~phase_timer()
+    {
+        elapsed_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin_).count();
+    }
+
+private:
+    double &elapsed_ms_;
+    std::chrono::steady_clock::time_point begin_;
+};
+
+class tensor_data_source : public sample_source
+{
+public:
+    tensor_data_source(std::span<const uint8_t> data, size_t samples_count)
+        : data_(data), samples_count_(samples_count)
+    {
+    }
+
+    void reset() override { index_ = 0; }
+
+    bool next(std::span<uint8_t> dest) override
+    {
+        if (index_ == samples_count_)
+            return false;
+        if ((index_ + 1) * dest.size() > data_.size())
+            throw std::runtime_error("Calibration tensor data is smaller than samples_count samples");
+
+        std::memcpy(dest.data(), data_.data() + index_++ * dest.size(), dest.size());
+        return true;
+    }
+
+private:
+    std::span<const uint8_t> data_;
+    size_t samples_count_;
+    size_t index_ = 0;
+};
+
 class compiler_impl : public compiler
 {
 public:
@@ -136,6 +185,7 @@ public:
 
 #define BEGIN_IMPORT()                              \
     std::cout << "1. Import graph..." << std::endl; \
+    phase_timer import_timer(stats_.import_ms);     \
                                                     \
     importer::import_options imp_options;           \
     imp_options.output_arrays = options.output_arrays;
@@ -165,6 +215,7 @@ public:
     void import_caffe(std::span<const uint8_t> model, std::span<const uint8_t> prototxt) override
     {
         std::cout << "1. Import graph..." << std::endl;
+        phase_timer import_timer(stats_.import_ms);
         importer::import_caffe(graph_, model, prototxt, real_inlayout_, real_outlayout_);
         END_IMPORT()
     }
@@ -193,6 +244,11 @@ public:
 
     void compile() override
     {
+        // Calibration runs inside this phase but is accounted separately,
+        // only the calibration time spent in this call is subtracted
+        phase_timer optimize_timer(stats_.optimize_ms);
+        stats_.optimize_ms += stats_.calibrate_ms;
+
         if (use_ptq_)
         {
             if (compile_options_.input_type == "default")
@@ -232,10 +288,13 @@ public:
         std::cout << "2. Optimize target independent..." << std::endl;
         optimize_target_independent(graph_);
 
+        // Pre-quantized models carry their own ranges and need no calibration dataset
+        auto use_quant = use_ptq_ || has_model_quant_ranges(graph_);
+
         std::cout << "3. Optimize target dependent..." << std::endl;
-        optimize_target_dependent(graph_, use_ptq_);
+        optimize_target_dependent(graph_, use_quant);
 
-        if (use_ptq_)
+        if (use_quant)
         {
             std::cout << "4.1. Add quantize annotation..." << std::endl;
             add_quantize_annotation(graph_);
@@ -247,7 +306,7 @@ public:
             std::cout << "4.3. Quantize graph..." << std::endl;
             quantize_graph(graph_, evaluator);
 
-            if (compile_options_.dump_quant_error)
+            if (use_ptq_ && compile_options_.dump_quant_error)
             {
                 std::cout << "4.4. Evaluate quantized graph..." << std::endl;
                 char target_name[MAX_MODULE_TYPE_LENGTH];
@@ -301,6 +360,8 @@ public:
 
         if (compile_options_.benchmark_only)
             optimize_benchmark(graph_);
+
+        stats_.optimize_ms -= stats_.calibrate_ms;
     }
 
     ir::graph &graph(uint32_t stage) override
@@ -313,10 +374,12 @@ public:
 
         if (stage > 2)
         {
+            auto use_quant = use_ptq_ || has_model_quant_ranges(graph_);
+
             std::cout << "3. Optimize target dependent..." << std::endl;
-            optimize_target_dependent(graph_, use_ptq_);
+            optimize_target_dependent(graph_, use_quant);
 
-            if (use_ptq_)
+            if (use_quant)
             {
                 std::cout << "4.1. Add quantize annotation..." << std::endl;
                 add_quantize_annotation(graph_);
@@ -340,14 +403,24 @@ public:
             sch.config_dump(dump_path);
         }
 
-        auto schr = sch.schedule();
+        auto schr = [&] {
+            phase_timer schedule_timer(stats_.schedule_ms);
+            return sch.schedule();
+        }();
+
         model_builder builder(*target_, schr);
         builder.config_dump(compile_options_.dump_dir, compile_options_.dump_asm);
-        auto result = builder.build(output);
+        builder.num_threads(compile_options_.codegen_threads);
+        auto result = [&] {
+            phase_timer codegen_timer(stats_.codegen_ms);
+            return builder.build(output);
+        }();
 
         dump_summary(graph_, builder, result);
     }
 
+    const compile_stats &stats() const noexcept override { return stats_; }
+
 private:
     void set_target(std::string_view type)
     {
@@ -411,6 +484,7 @@ private:
             pmgr.add_pass<add_copy_to_concat_pass>();
             pmgr.add_pass<add_copy_to_slice_pass>();
             pmgr.add_pass<add_copy_to_output_pass>();
+            pmgr.add_pass<make_slice_view_pass>();
 
             transform_pass pass("optimize_copy");
             pass.emplace<remove_exclusive_copy_to_output_transform>();
@@ -445,6 +519,43 @@ private:
         run_passes("quantize_annotation", graph, [&](const module_type_t &module_type, ir::transforms::pass_manager &pmgr) { target_->register_quantize_annotation_passes(module_type, pmgr); });
     }
 
+    bool has_model_quant_ranges(ir::graph &graph)
+    {
+        for (auto g : graph.reachable_graphs())
+        {
+            for (auto &n : g->nodes())
+            {
+                for (auto out : n->outputs())
+                {
+                    if (out->quant_range())
+                        return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void seed_model_quant_ranges(ir::graph &graph, ir::quantizer &quant, const std::unordered_set<node_opcode> &opcodes)
+    {
+        auto visitor = make_relay_ir_visitor([&](node &node) {
+            for (auto out : node.outputs())
+            {
+                if (out->quant_range())
+                    quant.set(*out, *out->quant_range());
+                else if (!use_ptq_ && node.inputs().size() == 1 && opcodes.contains(node.runtime_opcode())
+                    && quant.has_range(*node.input_at(0).connection()))
+                    quant.set(*out, quant.get(*node.input_at(0).connection()));
+                else if (auto c = node_cast<constant>(node); c && !use_ptq_ && out->type() == dt_float32 && !quant.has_range(*out))
+                    quant.record(*out, std::span<const float>(reinterpret_cast<const float *>(c->data().data()), c->data().size() / sizeof(float)));
+
+                if (!use_ptq_ && (out->attributes() & cnctr_attr_need_quantize) && !quant.has_range(*out))
+                    throw std::runtime_error("No quantization range for " + node.name() + " in pre-quantized model, a calibration dataset is required");
+            }
+        });
+        visitor.visit(graph);
+    }
+
     void quantize_graph(ir::graph &graph, ir::evaluator &evaluator)
     {
         auto graph_runner = [&](ir::graph &graph) {
@@ -454,6 +565,7 @@ private:
             // broadcast quant ranges
             std::unordered_set<node_opcode> opcodes;
             target_->add_quantization_broadcast(opcodes);
+            seed_model_quant_ranges(graph, *quant, opcodes);
             quant->broadcast_output(graph, opcodes);
 
             ir::transforms::transform_pass p("process i&o node");
@@ -477,6 +589,7 @@ private:
 
     ir::evaluator run_calibration(ir::graph &graph, eval_step step)
     {
+        phase_timer calibrate_timer(stats_.calibrate_ms);
         schedule::scheduler sched(*target_, graph, graph.outputs());
         if (compile_options_.dump_ir)
         {
@@ -499,6 +612,9 @@ private:
             evaluator.enable_ptq(*target_, calib_method);
         }
 
+        if (step == eval_step::after_calib && !use_ptq_)
+            return evaluator;
+
         if (graph.inputs().size() != 1)
             throw std::invalid_argument("Collect ranges only support models that have single 1 input");
 
@@ -624,6 +740,9 @@ private:
     {
         std::string step_str = step == nncase::ir::eval_step::after_import ? "1" : (step == nncase::ir::eval_step::after_calib ? "4.2" : "4.4");
         const size_t max_stages = options.calibrate_method == "no_clip" ? 1 : 2;
+        tensor_data_source tensor_source(options.tensor_data, options.samples_count);
+        sample_source &source = options.samples ? *options.samples : tensor_source;
+
         for (size_t stage = 0; stage < max_stages; stage++)
         {
             if (stage == 0)
@@ -636,17 +755,24 @@ private:
                 evaluator.begin_collect_distribution();
             }
 
-            for (size_t i = 0; i < options.samples_count; i++)
+            source.reset();
+            size_t i = 0;
+            while (true)
             {
                 auto input_buffer = evaluator.input_at(0).buffer();
-                std::memcpy(input_buffer.data(), options.tensor_data.data() + i * input_buffer.size_bytes(), input_buffer.size_bytes());
+                if (!source.next({ reinterpret_cast<uint8_t *>(input_buffer.data()), input_buffer.size_bytes() }))
+                    break;
 
                 evaluator.evaluate(step, stage, compile_options_.dump_quant_error);
                 evaluator.end_sample();
                 if (options.progress)
-                    options.progress(i++, options.samples_count);
+                    options.progress(i, options.samples_count);
+                i++;
             }
 
+            if (!i)
+                throw std::runtime_error("Calibration got no samples, samples used for more than one pass must be re-iterable");
+
             if (stage == 1)
             {
                 std::cout << step_str + ".3. Find optimal quantization ranges..." << std::endl;
@@ -667,8 +793,21 @@ private:
             dump_graph(graph, name);
         };
 
-        for (auto graph : root_graph.reachable_graphs())
-            graph_runner(*graph);
+        // Passes may create new subgraphs (e.g. loop bodies), run until no new graph appears
+        std::unordered_set<ir::graph *> visited;
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (auto graph : root_graph.reachable_graphs())
+            {
+                if (visited.emplace(graph).second)
+                {
+                    graph_runner(*graph);
+                    changed = true;
+                }
+            }
+        }
     }
 
     void dump_graph(ir::graph &graph, std::string_view prefix)
@@ -703,6 +842,7 @@ private:
         total_usage += dump_memory_usage(mod_builder, mem_input, ".input");
         total_usage += dump_memory_usage(mod_builder, mem_output, ".output");
         total_usage += dump_memory_usage(mod_builder, mem_data, ".data");
+        total_usage += dump_memory_usage(mod_builder, mem_shared_data, ".shared_data");
         std::cout << "MODEL"
                   << "\t" << format_size(build_result.model_size) << std::endl;
         total_usage += build_result.model_size;
@@ -713,6 +853,7 @@ private:
         file << "input: " << format_size(mod_builder.max_usage(mem_input)) << std::endl;
         file << "output: " << format_size(mod_builder.max_usage(mem_output)) << std::endl;
         file << "data: " << format_size(mod_builder.max_usage(mem_data)) << std::endl;
+        file << "shared_data: " << format_size(mod_builder.max_usage(mem_shared_data)) << std::endl;
         file << "MODEL: " << format_size(build_result.model_size) << std::endl;
         file << "TOTAL: " << format_size(total_usage) << std::endl;
     }
@@ -728,6 +869,7 @@ private:
     ir::graph graph_;
     compile_options compile_options_;
     std::string input_layout_;
+    compile_stats stats_;
     std::variant<ptq_dataset_options, ptq_tensor_options> ptq_options_;
     std::variant<dump_range_dataset_options, dump_range_tensor_options> dump_range_options_;
     bool use_ptq_ = false;
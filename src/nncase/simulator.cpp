@@ -12,14 +12,22 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <iostream>
 #include <magic_enum.hpp>
+#include <mutex>
 #include <nncase/data/dataset.h>
 #include <nncase/io_utils.h>
 #include <nncase/ir/debug.h>
 #include <nncase/runtime/debug.h>
 #include <nncase/runtime/interpreter.h>
 #include <nncase/simulator.h>
+#include <optional>
+#include <queue>
+#include <thread>
 
 using namespace nncase;
 using namespace nncase::data;
@@ -27,13 +35,123 @@ using namespace nncase::runtime;
 
 namespace
 {
+template <class T>
+class bounded_queue
+{
+public:
+    explicit bounded_queue(size_t capacity)
+        : capacity_(std::max(capacity, size_t(1)))
+    {
+    }
+
+    // Blocks while the queue is full, returns false if the queue has been closed.
+    bool push(T value)
+    {
+        std::unique_lock lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || queue_.size() < capacity_; });
+        if (closed_)
+            return false;
+        queue_.emplace(std::move(value));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Blocks while the queue is empty, returns nullopt once it is closed and drained.
+    std::optional<T> pop()
+    {
+        std::unique_lock lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+        if (queue_.empty())
+            return std::nullopt;
+        auto value = std::move(queue_.front());
+        queue_.pop();
+        not_full_.notify_one();
+        return value;
+    }
+
+    void close()
+    {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    bool closed_ = false;
+    std::queue<T> queue_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+};
+
+struct input_sample
+{
+    std::filesystem::path filename;
+    std::vector<uint8_t> data;
+};
+
+struct eval_sample
+{
+    std::filesystem::path filename;
+    std::vector<std::vector<uint8_t>> tensors;
+};
+
+// Decodes one model input from its dataset, type-erasing the element type of the iterator.
+class input_reader
+{
+public:
+    input_reader(std::unique_ptr<dataset> ds, datatype_t type)
+        : dataset_(std::move(ds))
+    {
+        switch (type)
+        {
+        case dt_float32:
+            next_ = make_next<float>();
+            break;
+        case dt_uint8:
+            next_ = make_next<uint8_t>();
+            break;
+        case dt_int8:
+            next_ = make_next<int8_t>();
+            break;
+        default:
+            throw std::runtime_error("Unsupported input datatype: " + std::string(datatype_names(type)));
+        }
+    }
+
+    size_t total_size() const noexcept { return dataset_->total_size(); }
+    std::optional<input_sample> next() { return next_(); }
+
+private:
+    template <class T>
+    std::function<std::optional<input_sample>()> make_next()
+    {
+        return [it = dataset_->begin<T>(), end = dataset_->end<T>()]() mutable -> std::optional<input_sample> {
+            if (it == end)
+                return std::nullopt;
+
+            auto &tensor = it->tensor;
+            input_sample sample { it->filenames[0], std::vector<uint8_t>(tensor.size() * sizeof(T)) };
+            std::memcpy(sample.data.data(), tensor.data(), sample.data.size());
+            ++it;
+            return sample;
+        };
+    }
+
+private:
+    std::unique_ptr<dataset> dataset_;
+    std::function<std::optional<input_sample>()> next_;
+};
+
 class simulator_impl : public simulator
 {
 public:
     simulator_impl(std::vector<uint8_t> model, const simulate_options &options)
         : model_(std::move(model)), options_(options)
     {
-        interp_.load_model(gsl::as_bytes(gsl::make_span(model_))).unwrap_or_throw();
+        interpreters_.emplace_back(load_interpreter());
     }
 
     void run() override
@@ -41,80 +159,185 @@ public:
         if (!std::filesystem::exists(options_.output_path))
             std::filesystem::create_directories(options_.output_path);
 
-        if (interp_.inputs_size() != 1)
-            throw std::invalid_argument("Simulator only support models that have single 1 input");
+        auto readers = create_readers(*interpreters_[0]);
+        auto total_size = readers.empty() ? 0 : readers[0].total_size();
+        for (auto &reader : readers)
+        {
+            if (reader.total_size() != total_size)
+                throw std::invalid_argument("Datasets of all inputs should contain the same number of samples");
+        }
+
+        if (total_size == 0)
+            throw std::invalid_argument("Nothing to simulate, the model has no inputs or the dataset is empty");
+
+        size_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        size_t num_threads = options_.num_threads ? options_.num_threads : hardware_threads;
+        num_threads = std::clamp(num_threads, size_t(1), total_size);
+        while (interpreters_.size() < num_threads)
+            interpreters_.emplace_back(load_interpreter());
+
+        // Interpreters split the cores, so their kernels don't oversubscribe them
+        for (auto &interp : interpreters_)
+            interp->num_threads((uint32_t)std::max(hardware_threads / num_threads, size_t(1)));
 
-        auto &in_shape = interp_.input_shape(0);
+        bounded_queue<eval_sample> inputs(num_threads * 2);
+        bounded_queue<eval_sample> outputs(num_threads * 2);
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto guard = [&](auto &&func) {
+            try
+            {
+                func();
+            }
+            catch (...)
+            {
+                std::lock_guard lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                inputs.close();
+                outputs.close();
+            }
+        };
+
+        std::thread loader([&] { guard([&] { load(readers, inputs); }); });
+        std::thread writer([&] { guard([&] { write(outputs, total_size); }); });
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < num_threads; i++)
+            workers.emplace_back([&, i] { guard([&] { eval(*interpreters_[i], inputs, outputs, error_mutex); }); });
+
+        loader.join();
+        for (auto &worker : workers)
+            worker.join();
+        outputs.close();
+        writer.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    std::unique_ptr<interpreter> load_interpreter()
+    {
+        auto interp = std::make_unique<interpreter>();
+        interp->load_model(gsl::as_bytes(gsl::make_span(model_))).unwrap_or_throw();
+        return interp;
+    }
+
+    std::unique_ptr<dataset> create_dataset(const std::filesystem::path &path, const runtime_shape_t &in_shape)
+    {
         xt::dynamic_shape<size_t> dataset_in_shape(in_shape.begin(), in_shape.end());
-        std::unique_ptr<dataset> ds;
         if (options_.dataset_format == "image")
-            ds = std::make_unique<image_dataset>(options_.dataset, dataset_in_shape, options_.input_layout);
+            return std::make_unique<image_dataset>(path, dataset_in_shape, options_.input_layout);
         else if (options_.dataset_format == "raw")
-            ds = std::make_unique<raw_dataset>(options_.dataset, dataset_in_shape);
+            return std::make_unique<raw_dataset>(path, dataset_in_shape);
         else
             throw std::runtime_error("Invalid dataset format: " + options_.dataset_format);
+    }
 
-        auto in_type = interp_.input_desc(0).datatype;
-        switch (in_type)
+    // Single input models read the dataset directly, models with more inputs read
+    // one sub directory per input, named by the input index.
+    std::vector<input_reader> create_readers(interpreter &interp)
+    {
+        std::vector<input_reader> readers;
+        auto inputs_size = interp.inputs_size();
+        for (size_t i = 0; i < inputs_size; i++)
         {
-        case dt_float32:
-            eval<float>(*ds);
-            break;
-        case dt_uint8:
-            eval<uint8_t>(*ds);
-            break;
-        case dt_int8:
-            eval<int8_t>(*ds);
-            break;
-        default:
-            throw std::runtime_error("Unsupported input datatype: " + std::string(datatype_names(in_type)));
+            auto path = inputs_size == 1 ? options_.dataset : options_.dataset / std::to_string(i);
+            if (inputs_size != 1 && !std::filesystem::is_directory(path))
+                throw std::invalid_argument("Dataset of multi inputs model should contain a sub directory for each input: " + path.string());
+            readers.emplace_back(create_dataset(path, interp.input_shape(i)), interp.input_desc(i).datatype);
         }
+
+        return readers;
     }
 
-private:
-    template <class T>
-    void eval(dataset &dataset)
+    void load(std::vector<input_reader> &readers, bounded_queue<eval_sample> &inputs)
     {
-        size_t i = 0;
-        for (auto it = dataset.begin<T>(); it != dataset.end<T>(); ++it)
+        while (true)
         {
+            eval_sample sample;
+            for (size_t i = 0; i < readers.size(); i++)
             {
-                auto input_tensor = interp_.input_tensor(0).unwrap();
-                auto input_map = std::move(hrt::map(input_tensor, hrt::map_write).unwrap());
+                auto input = readers[i].next();
+                if (!input)
+                {
+                    inputs.close();
+                    return;
+                }
+
+                if (i == 0)
+                    sample.filename = input->filename.filename();
+                else if (input->filename.stem() != sample.filename.stem())
+                    throw std::invalid_argument("Mismatched input files: " + sample.filename.string() + " and " + input->filename.string());
+                sample.tensors.emplace_back(std::move(input->data));
+            }
+
+            if (!inputs.push(std::move(sample)))
+                return;
+        }
+    }
+
+    void eval(interpreter &interp, bounded_queue<eval_sample> &inputs, bounded_queue<eval_sample> &outputs, std::mutex &log_mutex)
+    {
+        while (auto sample = inputs.pop())
+        {
+            for (size_t i = 0; i < interp.inputs_size(); i++)
+            {
+                auto input_tensor = interp.input_tensor(i).unwrap_or_throw();
+                auto input_map = std::move(hrt::map(input_tensor, hrt::map_write).unwrap_or_throw());
                 auto input_buffer = input_map.buffer();
-                auto &tensor = it->tensor;
-                std::memcpy(input_buffer.data(), tensor.data(), input_buffer.size_bytes());
+                std::memcpy(input_buffer.data(), sample->tensors[i].data(), input_buffer.size_bytes());
             }
 
-            auto r = interp_.run();
+            eval_sample result { sample->filename, {} };
+            auto r = interp.run();
             if (r.is_ok())
             {
-                std::filesystem::path out_filename(options_.output_path / it->filenames[0].filename());
-                out_filename.replace_extension(".bin");
-
-                std::ofstream of(out_filename, std::ios::binary | std::ios::out);
-                for (size_t i = 0; i < interp_.outputs_size(); i++)
+                for (size_t i = 0; i < interp.outputs_size(); i++)
                 {
-                    auto output_tensor = interp_.output_tensor(i).unwrap();
-                    auto output_map = std::move(hrt::map(output_tensor, hrt::map_read).unwrap());
+                    auto output_tensor = interp.output_tensor(i).unwrap_or_throw();
+                    auto output_map = std::move(hrt::map(output_tensor, hrt::map_read).unwrap_or_throw());
                     auto output_buffer = output_map.buffer();
-                    of.write(reinterpret_cast<const char *>(output_buffer.data()), output_buffer.size());
+                    result.tensors.emplace_back(reinterpret_cast<const uint8_t *>(output_buffer.data()),
+                        reinterpret_cast<const uint8_t *>(output_buffer.data()) + output_buffer.size_bytes());
                 }
             }
             else
             {
-                std::cerr << "Eval " << it->filenames[0].filename() << " failed: " << r.unwrap_err().message() << std::endl;
+                std::lock_guard lock(log_mutex);
+                std::cerr << "Eval " << sample->filename << " failed: " << r.unwrap_err().message() << std::endl;
+            }
+
+            // Failed samples are still forwarded with no tensors so that progress stays accurate
+            if (!outputs.push(std::move(result)))
+                return;
+        }
+    }
+
+    void write(bounded_queue<eval_sample> &outputs, size_t total_size)
+    {
+        size_t count = 0;
+        while (auto result = outputs.pop())
+        {
+            if (!result->tensors.empty())
+            {
+                std::filesystem::path out_filename(options_.output_path / result->filename);
+                out_filename.replace_extension(".bin");
+
+                std::ofstream of(out_filename, std::ios::binary | std::ios::out);
+                for (auto &tensor : result->tensors)
+                    of.write(reinterpret_cast<const char *>(tensor.data()), tensor.size());
             }
 
             if (options_.progress)
-                options_.progress(i, dataset.total_size());
+                options_.progress(++count, total_size);
         }
     }
 
 private:
     std::vector<uint8_t> model_;
     simulate_options options_;
-    interpreter interp_;
+    std::vector<std::unique_ptr<interpreter>> interpreters_;
 };
 }
 
@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <nncase/runtime/dbg.h>
@@ -24,7 +25,7 @@ using namespace nncase;
 using namespace nncase::runtime;
 
 interpreter::interpreter() noexcept
-    : entry_function_(nullptr)
+    : shared_data_size_(0), entry_function_(nullptr), num_threads_(0)
 {
 }
 
@@ -61,6 +62,24 @@ result<void> interpreter::load_model(gsl::span<const gsl::byte> buffer) noexcept
         modules_[i] = std::move(rt_module);
     }
 
+    // 3. Allocate shared data
+    return initialize_shared_data();
+}
+
+result<void> interpreter::initialize_shared_data() noexcept
+{
+    size_t size = 0;
+    for (auto &mod : modules_)
+        size = std::max(size, (size_t)mod->shared_mempool(mem_shared_data).size);
+
+    if (size)
+    {
+        shared_data_.reset(new (std::nothrow) gsl::byte[size]);
+        if (!shared_data_)
+            return err(std::errc::not_enough_memory);
+    }
+
+    shared_data_size_ = size;
     return ok();
 }
 
@@ -119,6 +138,25 @@ result<void> interpreter::run() noexcept
     return entry_function_->invoke();
 }
 
+result<void> interpreter::run(gsl::span<const size_t> outputs) noexcept
+{
+    for (auto index : outputs)
+        CHECK_WITH_ERR(index < outputs_size(), std::errc::result_out_of_range);
+
+    // Masks cover 32 outputs, the compiler emits none for larger models, which run fully
+    if (outputs_size() > 32)
+        return run();
+
+    uint32_t mask = 0;
+    for (auto index : outputs)
+        mask |= uint32_t(1) << index;
+
+    entry_function_->output_mask(mask);
+    auto result = entry_function_->invoke();
+    entry_function_->output_mask(~uint32_t(0));
+    return result;
+}
+
 result<runtime_module *> interpreter::find_module_by_id(size_t index) noexcept
 {
     CHECK_WITH_ERR(index < modules_.size(), std::errc::result_out_of_range);
@@ -129,3 +167,8 @@ options_dict &interpreter::options() noexcept
 {
     return options_;
 }
+
+gsl::span<gsl::byte> interpreter::shared_data() const noexcept
+{
+    return { shared_data_.get(), shared_data_size_ };
+}
@@ -308,3 +308,24 @@ result<void> runtime_function::invoke() noexcept
 
     return ok();
 }
+
+result<void> runtime_function::invoke(gsl::span<const runtime_tensor> inputs, gsl::span<const runtime_tensor> outputs) noexcept
+{
+    CHECK_WITH_ERR(inputs.size() == input_tensors_.size(), std::errc::invalid_argument);
+    CHECK_WITH_ERR(outputs.size() == output_tensors_.size(), std::errc::invalid_argument);
+
+    // Only validate tensors that differ from the current bindings
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (input_tensors_[i].bind_tensor != inputs[i])
+            try_(input_tensor(i, inputs[i]));
+    }
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (output_tensors_[i].bind_tensor != outputs[i])
+            try_(output_tensor(i, outputs[i]));
+    }
+
+    return invoke();
+}
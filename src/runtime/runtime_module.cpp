@@ -15,6 +15,7 @@
 #include "section.h"
 #include <nncase/runtime/dbg.h>
 #include <nncase/runtime/error.h>
+#include <nncase/runtime/interpreter.h>
 #include <nncase/runtime/runtime_module.h>
 #include <nncase/runtime/span_reader.h>
 
@@ -102,6 +103,24 @@ mempool_desc runtime_module::mempool(memory_location_t location) const noexcept
     return desc;
 }
 
+mempool_desc runtime_module::shared_mempool(memory_location_t location) const noexcept
+{
+    for (auto &desc : shared_mempools_)
+    {
+        if (desc.location == location)
+            return desc;
+    }
+
+    mempool_desc desc {};
+    desc.location = location;
+    return desc;
+}
+
+gsl::span<gsl::byte> runtime_module::shared_data() const noexcept
+{
+    return interp().shared_data();
+}
+
 result<void> runtime_module::initialize(gsl::span<const gsl::byte> payload, interpreter &interp) noexcept
 {
     interp_ = &interp;
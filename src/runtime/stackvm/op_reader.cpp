@@ -82,6 +82,18 @@ result<void> op_visitor::next() noexcept
             return visit(op_reader<tensor_unary_op_t>()(reader_));
         case tensor_function_t::TRANSPOSE:
             return visit(op_reader<tensor_transpose_op_t>()(reader_));
+        case tensor_function_t::DETECTION_POSTPROCESS:
+            return visit(op_reader<tensor_detection_postprocess_op_t>()(reader_));
+        case tensor_function_t::TOPK:
+            return visit(op_reader<tensor_topk_op_t>()(reader_));
+        case tensor_function_t::LOOP:
+            return visit(op_reader<tensor_loop_op_t>()(reader_));
+        case tensor_function_t::IMAGE_PREPROCESS:
+            return visit(op_reader<tensor_image_preprocess_op_t>()(reader_));
+        case tensor_function_t::QUANTIZED_BINARY:
+            return visit(op_reader<tensor_quantized_binary_op_t>()(reader_));
+        case tensor_function_t::CONV2D_POOL:
+            return visit(op_reader<tensor_conv2d_pool_op_t>()(reader_));
         default:
             break;
         }
@@ -213,6 +213,11 @@ result<void> stackvm_runtime_function::visit(const lea_buffer_op_t &op) noexcept
         auto buffer = module().data().subspan(op.offset);
         return stack_.push((uintptr_t)buffer.data());
     }
+    else if (op.location == mem_shared_data)
+    {
+        auto buffer = module().shared_data().subspan(op.offset);
+        return stack_.push((uintptr_t)buffer.data());
+    }
     else
     {
         return err(std::errc::invalid_argument);
@@ -318,7 +323,8 @@ result<void> stackvm_runtime_function::visit(NNCASE_UNUSED const ldarg_op_t &op)
 
 result<void> stackvm_runtime_function::visit(NNCASE_UNUSED const ldarg_0_op_t &op) noexcept
 {
-    return err(std::errc::not_supported);
+    // Arg 0: requested output mask
+    return stack_.push((uint32_t)output_mask());
 }
 
 result<void> stackvm_runtime_function::visit(NNCASE_UNUSED const ldarg_1_op_t &op) noexcept
@@ -23,32 +23,48 @@ using namespace nncase::runtime::stackvm;
 
 result<void> stackvm_runtime_function::visit(const tensor_call_op_t &op) noexcept
 {
-    try_var(mod, module().interp().find_module_by_id(op.module_id));
-    try_var(func, mod->find_function_by_id(op.function_id));
+    // Buffer addresses of a call site are static except for the caller's
+    // inputs & outputs, so argument tensors are created once and reused.
+    auto args = (size_t)op.num_src + op.num_dst;
+    call_site *site;
+    try
+    {
+        site = &call_sites_[pc()];
+        if (site->tensors.size() != args)
+        {
+            site->addresses.assign(args, 0);
+            site->tensors.assign(args, runtime_tensor());
+        }
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    if (!site->callee)
+    {
+        try_var(mod, module().interp().find_module_by_id(op.module_id));
+        try_set(site->callee, mod->find_function_by_id(op.function_id));
+    }
 
-    auto create_tensor = [&]() -> result<runtime_tensor> {
+    for (size_t i = args; i-- > 0;)
+    {
         try_var(rstrides, stack_.pop());
-        try_var(strides, module().shape_reg(rstrides.as_u4()));
         try_var(rshape, stack_.pop());
-        try_var(shape, module().shape_reg(rshape.as_u4()));
         try_var(e_datatype, stack_.pop());
         try_var(addr, pop_addr());
 
-        auto datatype = (datatype_t)e_datatype.as_u1();
-        return this->create_tensor(addr, datatype, shape, strides);
-    };
-
-    for (uint8_t i = 0; i < op.num_dst; i++)
-    {
-        try_var(tensor, create_tensor());
-        try_(func->output_tensor((size_t)op.num_dst - i - 1, tensor));
-    }
-
-    for (uint8_t i = 0; i < op.num_src; i++)
-    {
-        try_var(tensor, create_tensor());
-        try_(func->input_tensor((size_t)op.num_src - i - 1, tensor));
+        auto &tensor = site->tensors[i];
+        if (tensor.empty() || site->addresses[i] != addr)
+        {
+            try_var(strides, module().shape_reg(rstrides.as_u4()));
+            try_var(shape, module().shape_reg(rshape.as_u4()));
+            auto datatype = (datatype_t)e_datatype.as_u1();
+            try_set(tensor, create_tensor(addr, datatype, shape, strides));
+            site->addresses[i] = addr;
+        }
     }
 
-    return func->invoke();
+    gsl::span<const runtime_tensor> tensors(site->tensors);
+    return site->callee->invoke(tensors.subspan(0, op.num_src), tensors.subspan(op.num_src));
 }
@@ -23,6 +23,13 @@ result<void> stackvm_runtime_function::visit(const tensor_conv2d_op_t &op) noexc
 {
     try_var(padding_w, pop_padding());
     try_var(padding_h, pop_padding());
+    auto fused_lut = activation_lut::none();
+    if (op.fused_lut)
+    {
+        try_var(table, pop_addr());
+        fused_lut = { reinterpret_cast<const float *>(table), { op.fused_lut_zero_point, op.fused_lut_scale } };
+    }
+
     try_var(output, pop_addr());
     try_var(bias, pop_addr());
     try_var(weights, pop_addr());
@@ -38,5 +45,5 @@ result<void> stackvm_runtime_function::visit(const tensor_conv2d_op_t &op) noexc
         return err(nncase_errc::datatype_mismatch);
     return kernels::conv2d(reinterpret_cast<const float *>(input), reinterpret_cast<const float *>(weights),
         reinterpret_cast<const float *>(bias), reinterpret_cast<float *>(output), in_shape, in_strides, w_shape, w_strides, bias_strides, out_strides,
-        padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+        padding_h, padding_w, op.groups, op.stride_h, op.stride_w, op.dilation_h, op.dilation_w, { op.fused_clamp_low, op.fused_clamp_high }, fused_lut, module().kernel_context());
 }
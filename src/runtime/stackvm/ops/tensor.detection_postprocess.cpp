@@ -0,0 +1,44 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <iostream>
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/debug.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_detection_postprocess_op_t &op) noexcept
+{
+    try_var(output, pop_addr());
+    try_var(scores, pop_addr());
+    try_var(boxes, pop_addr());
+    try_var(boxes_shape, module().shape_reg(op.rshape_boxes));
+    try_var(boxes_strides, module().shape_reg(op.rstride_boxes));
+    try_var(scores_shape, module().shape_reg(op.rshape_scores));
+    try_var(scores_strides, module().shape_reg(op.rstride_scores));
+
+    switch (op.datatype)
+    {
+    case dt_float32:
+        return kernels::detection_postprocess(reinterpret_cast<const float *>(boxes), boxes_shape, boxes_strides,
+            reinterpret_cast<const float *>(scores), scores_shape, scores_strides, reinterpret_cast<int64_t *>(output),
+            op.center_point_box, op.max_output_boxes_per_class, op.iou_threshold, op.score_threshold, module().kernel_context());
+    default:
+        std::cerr << "unsupported dtype for detection_postprocess: " + std::string(datatype_names(op.datatype));
+        return err(std::errc::invalid_argument);
+    }
+}
@@ -0,0 +1,53 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <iostream>
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/debug.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_image_preprocess_op_t &op) noexcept
+{
+    try_var(output, pop_addr());
+    try_var(stddev, pop_addr());
+    try_var(mean, pop_addr());
+    try_var(input, pop_addr());
+    try_var(in_shape, module().shape_reg(op.rshape_src));
+    try_var(in_strides, module().shape_reg(op.rstride_src));
+    try_var(out_shape, module().shape_reg(op.rshape_dest));
+    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    quant_param_t in_param { op.zero_point, op.scale };
+
+#define PREPROCESS_IMPL(type)                                                                                                                                \
+    return kernels::image_preprocess(reinterpret_cast<const type *>(input), reinterpret_cast<const float *>(mean), reinterpret_cast<const float *>(stddev), \
+        reinterpret_cast<float *>(output), in_shape, in_strides, out_shape, out_strides, in_param, op.input_nhwc, op.swap_rb, op.resize_h, op.resize_w,    \
+        op.pad_top, op.pad_left, op.pad_value, op.output_nhwc, module().kernel_context());
+
+    switch (op.datatype)
+    {
+    case dt_uint8:
+        PREPROCESS_IMPL(uint8_t);
+    case dt_int8:
+        PREPROCESS_IMPL(int8_t);
+    case dt_float32:
+        PREPROCESS_IMPL(float);
+    default:
+        std::cerr << "unsupported dtype for image_preprocess: " + std::string(datatype_names(op.datatype));
+        return err(std::errc::invalid_argument);
+    }
+}
@@ -0,0 +1,146 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/interpreter.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_loop_op_t &op) noexcept
+{
+    auto args = (size_t)op.num_src + op.num_dst;
+    auto num_states = (size_t)op.num_states;
+    auto num_scan_inputs = (size_t)op.num_scan_inputs;
+    auto num_invariants = (size_t)op.num_src - 2 * num_states - num_scan_inputs;
+    auto num_scan_outputs = (size_t)op.num_dst - num_states;
+    auto num_scans = num_scan_inputs + num_scan_outputs;
+    CHECK_WITH_ERR(op.num_src >= 2 * num_states + num_scan_inputs && op.num_dst >= num_states, std::errc::invalid_argument);
+
+    call_site *site;
+    try
+    {
+        site = &call_sites_[pc()];
+        if (site->tensors.size() != args)
+        {
+            site->addresses.assign(args, 0);
+            site->tensors.assign(args, runtime_tensor());
+            site->slices.assign(num_scans, scan_slice());
+        }
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    if (!site->callee)
+    {
+        try_var(mod, module().interp().find_module_by_id(op.module_id));
+        try_set(site->callee, mod->find_function_by_id(op.function_id));
+    }
+
+    auto is_scan = [&](size_t i) {
+        return (i >= num_states && i < num_states + num_scan_inputs) || i >= (size_t)op.num_src + num_states;
+    };
+    auto scan_index = [&](size_t i) {
+        return i < op.num_src ? i - num_states : num_scan_inputs + i - op.num_src - num_states;
+    };
+
+    for (size_t i = args; i-- > 0;)
+    {
+        try_var(rstrides, stack_.pop());
+        try_var(rshape, stack_.pop());
+        try_var(e_datatype, stack_.pop());
+        try_var(addr, pop_addr());
+
+        auto &tensor = site->tensors[i];
+        if (tensor.empty() || site->addresses[i] != addr)
+        {
+            try_var(strides, module().shape_reg(rstrides.as_u4()));
+            try_var(shape, module().shape_reg(rshape.as_u4()));
+            auto datatype = (datatype_t)e_datatype.as_u1();
+            try_set(tensor, create_tensor(addr, datatype, shape, strides));
+            site->addresses[i] = addr;
+
+            // Scans are fed to the body one axis 0 slice per iteration
+            if (is_scan(i))
+            {
+                auto &slice = site->slices[scan_index(i)];
+                try
+                {
+                    slice.shape.assign(shape.begin() + 1, shape.end());
+                    slice.strides.assign(strides.begin() + 1, strides.end());
+                }
+                catch (...)
+                {
+                    return err(std::errc::not_enough_memory);
+                }
+
+                slice.address = addr;
+                slice.bytes = strides[0] * get_bytes(datatype);
+                slice.datatype = datatype;
+            }
+        }
+    }
+
+    // States ping-pong between the final state output and its carry buffer, the
+    // initial state is placed so that the last iteration writes the final state.
+    auto &tensors = site->tensors;
+    auto state_buffer = [&](size_t i, size_t t) -> runtime_tensor & {
+        auto &final_state = tensors[op.num_src + i];
+        auto &carry = tensors[op.num_src - num_states + i];
+        return (t % 2) == (op.trip_count % 2) ? final_state : carry;
+    };
+
+    for (size_t i = 0; i < num_states; i++)
+        try_(tensors[i].copy_to(state_buffer(i, 0)));
+
+    std::vector<runtime_tensor> inputs;
+    std::vector<runtime_tensor> outputs;
+    try
+    {
+        inputs.resize(num_states + num_scan_inputs + num_invariants);
+        outputs.resize(op.num_dst);
+    }
+    catch (...)
+    {
+        return err(std::errc::not_enough_memory);
+    }
+
+    for (size_t i = 0; i < num_invariants; i++)
+        inputs[num_states + num_scan_inputs + i] = tensors[num_states + num_scan_inputs + i];
+
+    for (size_t t = 0; t < op.trip_count; t++)
+    {
+        for (size_t i = 0; i < num_states; i++)
+        {
+            inputs[i] = state_buffer(i, t);
+            outputs[i] = state_buffer(i, t + 1);
+        }
+
+        for (auto &slice : site->slices)
+            try_set(slice.tensor, create_tensor(slice.address + t * slice.bytes, slice.datatype, slice.shape, slice.strides));
+        for (size_t i = 0; i < num_scan_inputs; i++)
+            inputs[num_states + i] = site->slices[i].tensor;
+        for (size_t i = 0; i < num_scan_outputs; i++)
+            outputs[num_states + i] = site->slices[num_scan_inputs + i].tensor;
+
+        try_(site->callee->invoke(inputs, outputs));
+    }
+
+    return ok();
+}
@@ -0,0 +1,50 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <nncase/kernels/tensor_compute.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_quantized_binary_op_t &op) noexcept
+{
+    try_var(output, pop_addr());
+    try_var(input_b, pop_addr());
+    try_var(input_a, pop_addr());
+    try_var(in_a_shape, module().shape_reg(op.rshape_src1));
+    try_var(in_a_strides, module().shape_reg(op.rstride_src1));
+    try_var(in_b_shape, module().shape_reg(op.rshape_src2));
+    try_var(in_b_strides, module().shape_reg(op.rstride_src2));
+    try_var(out_strides, module().shape_reg(op.rstride_dest));
+    quant_param_t in_a_param { op.in_a_zero_point, op.in_a_scale };
+    quant_param_t in_b_param { op.in_b_zero_point, op.in_b_scale };
+    quant_param_t out_param { op.out_zero_point, op.out_scale };
+
+#define QUANTIZED_BINARY_IMPL(type)                                                                                                                 \
+    return kernels::quantized_binary(op.binary_op, reinterpret_cast<const type *>(input_a), reinterpret_cast<const type *>(input_b),              \
+        reinterpret_cast<type *>(output), in_a_shape, in_a_strides, in_b_shape, in_b_strides, out_strides, in_a_param, in_b_param, out_param, \
+        { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+
+    switch (op.datatype)
+    {
+    case dt_uint8:
+        QUANTIZED_BINARY_IMPL(uint8_t);
+    case dt_int8:
+        QUANTIZED_BINARY_IMPL(int8_t);
+    default:
+        return err(nncase_errc::datatype_mismatch);
+    }
+}
@@ -28,7 +28,7 @@ result<void> stackvm_runtime_function::visit(const tensor_random_normal_op_t &op
     switch (op.datatype_dest)
     {
     case dt_float32:
-        return kernels::random_normal(reinterpret_cast<float *>(output), out_shape, op.mean, op.std, op.seed);
+        return kernels::random_normal(reinterpret_cast<float *>(output), out_shape, op.mean, op.std, op.seed, module().kernel_context());
         break;
     default:
         std::cerr << "unsupported dtype for random_normal: " + std::string(datatype_names(op.datatype_dest));
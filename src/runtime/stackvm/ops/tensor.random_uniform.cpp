@@ -28,7 +28,7 @@ result<void> stackvm_runtime_function::visit(const tensor_random_uniform_op_t &o
     switch (op.datatype_dest)
     {
     case dt_float32:
-        return kernels::random_uniform(reinterpret_cast<float *>(output), out_shape, op.low, op.high, op.seed);
+        return kernels::random_uniform(reinterpret_cast<float *>(output), out_shape, op.low, op.high, op.seed, module().kernel_context());
         break;
     default:
         std::cerr << "unsupported dtype for random_uniform: " + std::string(datatype_names(op.datatype_dest));
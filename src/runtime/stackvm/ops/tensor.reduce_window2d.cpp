@@ -30,9 +30,20 @@ result<void> stackvm_runtime_function::visit(const tensor_reduce_window2d_op_t &
     try_var(in_strides, module().shape_reg(op.rstride_src));
     try_var(out_strides, module().shape_reg(op.rstride_dest));
 
-    if (op.datatype != dt_float32)
-        return err(nncase_errc::datatype_mismatch);
-    return kernels::reduce_window2d(op.reduce_op, reinterpret_cast<const float *>(input), init_value.as_r4(),
-        reinterpret_cast<float *>(output), in_shape, in_strides, out_strides, padding_h, padding_w, op.filter_h, op.filter_w,
+#define REDUCE_WINDOW2D_IMPL(type)                                                                                                    \
+    return kernels::reduce_window2d(op.reduce_op, reinterpret_cast<const type *>(input), init_value.as_r4(),                          \
+        reinterpret_cast<type *>(output), in_shape, in_strides, out_strides, padding_h, padding_w, op.filter_h, op.filter_w,          \
         op.stride_h, op.stride_w, op.dilation_h, op.dilation_w, { op.fused_clamp_low, op.fused_clamp_high }, module().kernel_context());
+
+    switch (op.datatype)
+    {
+    case dt_float32:
+        REDUCE_WINDOW2D_IMPL(float);
+    case dt_uint8:
+        REDUCE_WINDOW2D_IMPL(uint8_t);
+    case dt_int8:
+        REDUCE_WINDOW2D_IMPL(int8_t);
+    default:
+        return err(nncase_errc::datatype_mismatch);
+    }
 }
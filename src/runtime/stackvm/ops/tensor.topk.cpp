@@ -0,0 +1,43 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../runtime_function.h"
+#include <iostream>
+#include <nncase/kernels/tensor_compute.h>
+#include <nncase/runtime/debug.h>
+
+using namespace nncase;
+using namespace nncase::runtime;
+using namespace nncase::runtime::stackvm;
+
+result<void> stackvm_runtime_function::visit(const tensor_topk_op_t &op) noexcept
+{
+    try_var(indices, pop_addr());
+    try_var(values, pop_addr());
+    try_var(input, pop_addr());
+    try_var(in_shape, module().shape_reg(op.rshape_src));
+    try_var(in_strides, module().shape_reg(op.rstride_src));
+    try_var(values_strides, module().shape_reg(op.rstride_values));
+    try_var(indices_strides, module().shape_reg(op.rstride_indices));
+
+    switch (op.datatype)
+    {
+    case dt_float32:
+        return kernels::topk(reinterpret_cast<const float *>(input), reinterpret_cast<float *>(values), reinterpret_cast<int64_t *>(indices),
+            in_shape, in_strides, values_strides, indices_strides, op.k, op.axis, op.largest, op.sorted, module().kernel_context());
+    default:
+        std::cerr << "unsupported dtype for topk: " + std::string(datatype_names(op.datatype));
+        return err(std::errc::invalid_argument);
+    }
+}
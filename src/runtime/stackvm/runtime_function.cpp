@@ -148,6 +148,11 @@ result<runtime_tensor> stackvm_runtime_function::create_tensor(uintptr_t addr, d
     {
         pool = hrt::pool_cpu_only;
     }
+    else if (addr >= reinterpret_cast<uintptr_t>(module().shared_data().begin())
+        && addr < reinterpret_cast<uintptr_t>(module().shared_data().end()))
+    {
+        pool = hrt::pool_cpu_only;
+    }
     else if (addr >= reinterpret_cast<uintptr_t>(module().rdata().begin())
         && addr < reinterpret_cast<uintptr_t>(module().rdata().end()))
     {
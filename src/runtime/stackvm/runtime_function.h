@@ -18,11 +18,31 @@
 #include <nncase/kernels/kernel_context.h>
 #include <nncase/runtime/runtime_function.h>
 #include <nncase/runtime/stackvm/op_reader.h>
+#include <unordered_map>
 
 BEGIN_NS_NNCASE_RT_MODULE(stackvm)
 
 class stackvm_runtime_function : public runtime_function, private op_visitor
 {
+    // One axis 0 slice of a loop scan, moved to the current iteration before each invoke
+    struct scan_slice
+    {
+        uintptr_t address = 0;
+        size_t bytes = 0;
+        datatype_t datatype {};
+        runtime_shape_t shape;
+        runtime_shape_t strides;
+        runtime_tensor tensor;
+    };
+
+    struct call_site
+    {
+        runtime_function *callee = nullptr;
+        std::vector<uintptr_t> addresses;
+        std::vector<runtime_tensor> tensors;
+        std::vector<scan_slice> slices;
+    };
+
 public:
     using runtime_function::runtime_function;
 
@@ -164,6 +184,12 @@ protected:
     result<void> visit(const tensor_ternary_op_t &op) noexcept override;
     result<void> visit(const tensor_transpose_op_t &op) noexcept override;
     result<void> visit(const tensor_unary_op_t &op) noexcept override;
+    result<void> visit(const tensor_detection_postprocess_op_t &op) noexcept override;
+    result<void> visit(const tensor_topk_op_t &op) noexcept override;
+    result<void> visit(const tensor_loop_op_t &op) noexcept override;
+    result<void> visit(const tensor_image_preprocess_op_t &op) noexcept override;
+    result<void> visit(const tensor_quantized_binary_op_t &op) noexcept override;
+    result<void> visit(const tensor_conv2d_pool_op_t &op) noexcept override;
 
 private:
     uintptr_t pc() const noexcept;
@@ -186,6 +212,7 @@ private:
     gsl::span<const gsl::byte> text_;
     evaluate_stack stack_;
     size_t call_depth_;
+    std::unordered_map<uintptr_t, call_site> call_sites_;
 };
 
 END_NS_NNCASE_RT_MODULE
@@ -106,7 +106,10 @@ result<void> stackvm_runtime_module::paddings_reg(size_t id, runtime_paddings_t
 
 kernels::kernel_context &stackvm_runtime_module::kernel_context() noexcept
 {
-    return kernels::default_kernel_context();
+    kernel_context_ = kernels::default_kernel_context();
+    if (auto num_threads = interp().num_threads())
+        kernel_context_.num_threads = num_threads;
+    return kernel_context_;
 }
 
 result<std::unique_ptr<runtime_function>> stackvm_runtime_module::create_function() noexcept
@@ -68,33 +68,26 @@ void linear_buffer_allocator::finish()
 {
 }
 
-first_fit_allocator::first_fit_allocator(std::optional<size_t> fixed_size)
+best_fit_allocator::best_fit_allocator(std::optional<size_t> fixed_size)
     : list_(fixed_size)
 {
 }
 
-void first_fit_allocator::base_offset([[maybe_unused]] size_t value)
+void best_fit_allocator::base_offset([[maybe_unused]] size_t value)
 {
-    throw std::runtime_error("First fit allocator doesn't support base offset");
+    throw std::runtime_error("Best fit allocator doesn't support base offset");
 }
 
-void first_fit_allocator::mark(const physical_buffer &buffer)
+void best_fit_allocator::mark(const physical_buffer &buffer)
 {
     auto age = buffer.lifetime().birth;
 
     // 1. Free dead buffers
-    for (auto it = living_buffers_.begin(); it != living_buffers_.end();)
+    while (!living_buffers_.empty() && living_buffers_.top().first <= age)
     {
-        if ((*it)->lifetime().end() <= age)
-        {
-            auto &alloc = allocations_.at(*it);
-            list_.free({ alloc.start, alloc.size });
-            it = living_buffers_.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        auto &alloc = allocations_.at(living_buffers_.top().second);
+        list_.free({ alloc.start, alloc.size });
+        living_buffers_.pop();
     }
 
     // 2. Allocate new
@@ -102,10 +95,10 @@ void first_fit_allocator::mark(const physical_buffer &buffer)
     auto alloc_node = list_.allocate(alloc.size);
     alloc.start = alloc_node.start;
     allocations_.emplace(&buffer, alloc);
-    living_buffers_.emplace_back(&buffer);
+    living_buffers_.emplace(buffer.lifetime().end(), &buffer);
 }
 
-void first_fit_allocator::finish()
+void best_fit_allocator::finish()
 {
     max_usage_ = list_.max_usage();
 }
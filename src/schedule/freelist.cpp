@@ -12,8 +12,6 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <algorithm>
-#include <cassert>
 #include <nncase/schedule/freelist.h>
 #include <stdexcept>
 
@@ -25,18 +23,43 @@ freelist::freelist(std::optional<size_t> fixed_size)
 {
     if (fixed_size)
     {
-        free_nodes_.emplace(0, memory_span { 0, *fixed_size });
+        add_node(memory_span { 0, *fixed_size });
         heap_end_ = *fixed_size;
     }
 }
 
+bool freelist::can_allocate(size_t size)
+{
+    return !is_fixed_ || size_index_.lower_bound({ size, 0 }) != size_index_.end();
+}
+
 void freelist::free(const memory_span &node)
 {
     if (node.size)
     {
-        free_nodes_.emplace(node.start, node);
-        auto it = free_nodes_.find(node.start);
-        merge(it);
+        auto merged = node;
+
+        // Coalesce with the neighbours in address order
+        auto right = free_nodes_.lower_bound(node.start);
+        if (right != free_nodes_.end() && right->second.start == merged.end())
+        {
+            merged.size += right->second.size;
+            remove_node(right);
+        }
+
+        auto left = free_nodes_.lower_bound(node.start);
+        if (left != free_nodes_.begin())
+        {
+            --left;
+            if (left->second.end() == merged.start)
+            {
+                merged.start = left->second.start;
+                merged.size += left->second.size;
+                remove_node(left);
+            }
+        }
+
+        add_node(merged);
     }
 }
 
@@ -48,15 +71,12 @@ memory_span freelist::allocate(size_t size)
         throw std::runtime_error("Allocator has ran out of memory");
 
     auto node = free->second;
+    remove_node(free);
 
-    if (free->second.size == size)
-    {
-        free_nodes_.erase(free);
-    }
-    else
+    if (node.size != size)
     {
-        free->second.size -= size;
-        node.start = free->second.end();
+        add_node(memory_span { node.start, node.size - size });
+        node.start += node.size - size;
         node.size = size;
     }
 
@@ -65,58 +85,44 @@ memory_span freelist::allocate(size_t size)
 
 freelist::free_nodes_t::iterator freelist::reserve(size_t size)
 {
-    auto free = std::find_if(free_nodes_.begin(), free_nodes_.end(),
-        [=](const std::pair<size_t, memory_span> &node) {
-            return node.second.size >= size;
-        });
+    // Best fit, lowest address first among equally sized nodes
+    auto fit = size_index_.lower_bound({ size, 0 });
+    if (fit != size_index_.end())
+        return free_nodes_.find(fit->second);
 
     // Not enough free space
-    if (free == free_nodes_.end())
-    {
-        if (is_fixed_)
-            return free;
+    if (is_fixed_)
+        return free_nodes_.end();
 
-        // No free node
-        if (!free_nodes_.empty())
+    // Enlarge the node at the heap end if any
+    if (!free_nodes_.empty())
+    {
+        auto last = std::prev(free_nodes_.end());
+        if (last->second.end() == heap_end_)
         {
-            auto last = std::prev(free_nodes_.end());
-            if (last->second.end() == heap_end_)
-            {
-                auto enlarge = size - last->second.size;
-                last->second.size += enlarge;
-                heap_end_ += enlarge;
-                return last;
-            }
+            auto node = last->second;
+            remove_node(last);
+            heap_end_ += size - node.size;
+            node.size = size;
+            return add_node(node);
         }
-
-        auto it = free_nodes_.emplace(heap_end_, memory_span { heap_end_, size });
-        heap_end_ += size;
-        return it.first;
     }
 
-    return free;
+    auto it = add_node(memory_span { heap_end_, size });
+    heap_end_ += size;
+    return it;
 }
 
-void freelist::merge(freelist::free_nodes_t::iterator offset)
+freelist::free_nodes_t::iterator freelist::add_node(const memory_span &node)
 {
-    if (offset != free_nodes_.begin())
-    {
-        auto left = std::prev(offset);
-        if (left != std::end(free_nodes_) && left->second.end() == offset->second.start)
-        {
-            left->second.size += offset->second.size;
-            free_nodes_.erase(offset);
-            return merge(left);
-        }
-    }
+    size_index_.emplace(node.size, node.start);
+    return free_nodes_.emplace(node.start, node).first;
+}
 
-    auto right = std::next(offset);
-    if (right != std::end(free_nodes_) && right->second.start == offset->second.end())
-    {
-        offset->second.size += right->second.size;
-        free_nodes_.erase(right);
-        return merge(offset);
-    }
+void freelist::remove_node(free_nodes_t::iterator it)
+{
+    size_index_.erase({ it->second.size, it->second.start });
+    free_nodes_.erase(it);
 }
 
 std::vector<memory_span> freelist::free_nodes() const
@@ -18,6 +18,7 @@
 #include <nncase/ir/ops/call.h>
 #include <nncase/ir/ops/concat.h>
 #include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/loop.h>
 #include <nncase/ir/ops/slice.h>
 #include <nncase/ir/visitor.h>
 #include <nncase/schedule/schedule_context.h>
@@ -31,7 +32,7 @@ using namespace nncase::ir::transforms;
 
 namespace
 {
-memory_location_t decide_memory_location(ir::output_connector &conn, [[maybe_unused]] bool skip_buffer_alias) noexcept
+memory_location_t decide_memory_location(ir::output_connector &conn, [[maybe_unused]] bool skip_buffer_alias, bool share_data) noexcept
 {
     auto &opcode = conn.owner().runtime_opcode();
     if (opcode == op_input_node)
@@ -43,11 +44,9 @@ memory_location_t decide_memory_location(ir::output_connector &conn, [[maybe_unu
     if (std::any_of(inputs.begin(), inputs.end(), [](input_connector *conn) { return conn->owner().runtime_opcode() == op_output_node; }))
         return mem_output;
 
-    //if (opcode == op_call && conn.memory_location() == mem_data)
-    //    return mem_shared_data;
-    //if (conn.memory_location() == mem_data
-    //    && std::any_of(inputs.begin(), inputs.end(), [](input_connector *conn) { return conn->owner().runtime_opcode() == op_call; }))
-    //    return mem_shared_data;
+    // Scratch buffers of all functions and modules live in one model-wide pool
+    if (share_data && conn.memory_location() == mem_data)
+        return mem_shared_data;
 
     return conn.memory_location();
 }
@@ -80,6 +79,13 @@ function_schedule_context::function_schedule_context(ir::graph &graph, module_sc
     create_allocators();
 }
 
+buffer_allocator &function_schedule_context::allocator(const logical_buffer &buffer)
+{
+    if (buffer.memory_location() == mem_shared_data)
+        return mod_sched_.shared_allocator(buffer.shared_module());
+    return *allocators_.at(buffer.memory_location());
+}
+
 void function_schedule_context::create_allocators()
 {
     mod_sched_.model_sched().target().register_allocators(module_type(), allocators_, allocator_holder_);
@@ -102,6 +108,7 @@ void function_schedule_context::visit_function(caller_context &caller_ctx)
     update_offset();
     fix_lifetime();
     generate_compute_sequence();
+    analyze_output_masks();
     make_physical_buffers();
 
     allocate_physical_buffers();
@@ -138,10 +145,11 @@ void function_schedule_context::generate_compute_sequence()
 
     alloc_visitor.visit(outputs_);
 
+    // Subgraphs keep all inputs in order, callers bind arguments by position
     size_t i = 0;
     for (auto in : graph->inputs())
     {
-        if (used_inputs.contains(in))
+        if (graph->is_subgraph() || used_inputs.contains(in))
         {
             compute_sequence.insert(compute_sequence.begin() + i, in);
             i++;
@@ -149,18 +157,67 @@ void function_schedule_context::generate_compute_sequence()
     }
 }
 
+void function_schedule_context::analyze_output_masks()
+{
+    // Only the entry function is run for a subset of outputs, which are passed as a 32 bits mask.
+    // Without masks every op runs unconditionally, so larger models always compute all outputs.
+    if (graph != mod_sched_.model_sched().entry_function() || outputs_.size() > 32)
+        return;
+
+    std::vector<node *> nodes;
+    auto visitor = make_relay_ir_visitor([&](node &node) { nodes.emplace_back(&node); });
+    visitor.visit(outputs_);
+
+    for (size_t i = 0; i < outputs_.size(); i++)
+        output_masks[outputs_[i]] = uint32_t(1) << i;
+
+    // Consumers are visited after their producers, so walk backwards
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+    {
+        auto n = *it;
+        if (n->runtime_opcode() == op_output_node)
+            continue;
+
+        uint32_t mask = 0;
+        for (auto out : n->outputs())
+        {
+            for (auto in : out->connections())
+            {
+                auto mask_it = output_masks.find(&in->owner());
+                if (mask_it != output_masks.end())
+                    mask |= mask_it->second;
+            }
+        }
+
+        output_masks[n] = mask;
+    }
+}
+
 void function_schedule_context::make_logical_buffers(caller_context &caller_ctx)
 {
     auto skip_buffer_alias = mod_sched_.model_sched().skip_buffer_alias();
+    auto share_data = mod_sched_.is_data_shared();
     lifetime_recorder lr(logical_buffers_, logical_buffer_map_);
 
     // 1. Adjust base age to caller's age
     lr.current_age(caller_ctx.lifetime.current_age());
 
     // 2. Estimate buffer lifetime
+    // Unused subgraph inputs are not reached by the visitor, but callers still bind them by position
+    for (auto in : graph->inputs())
+    {
+        if (graph->is_subgraph() && in->output().connections().empty())
+            lr.allocate(in->output(), decide_memory_location(in->output(), skip_buffer_alias, share_data));
+    }
+
     auto alloc_visitor = make_relay_ir_visitor([&](node &node) {
         for (auto out : node.outputs())
-            lr.allocate(*out, decide_memory_location(*out, skip_buffer_alias));
+        {
+            auto location = decide_memory_location(*out, skip_buffer_alias, share_data);
+            lr.allocate(*out, location);
+            if (location == mem_shared_data)
+                logical_buffer_map_.at(out)->shared_module(module_type());
+        }
 
         lr.grow_age();
 
@@ -169,6 +226,11 @@ void function_schedule_context::make_logical_buffers(caller_context &caller_ctx)
             caller_context new_caller_ctx { lr };
             mod_sched_.model_sched().visit_function(c->target(), new_caller_ctx);
         }
+        else if (auto l = node_cast<loop>(node))
+        {
+            caller_context new_caller_ctx { lr };
+            mod_sched_.model_sched().visit_function(l->body(), new_caller_ctx);
+        }
 
         for (auto in : node.inputs())
         {
@@ -178,6 +240,7 @@ void function_schedule_context::make_logical_buffers(caller_context &caller_ctx)
         }
     });
     alloc_visitor.visit(outputs_);
+    lr.finish();
 
     // 3. Adjust caller's age to now
     caller_ctx.lifetime.current_age(lr.current_age());
@@ -267,38 +330,46 @@ void function_schedule_context::allocate_physical_buffers()
         if (location != mem_shared_data)
             allocators_.at(location)->mark(*b);
         else
-            mod_sched_.shared_allocator(b->owner().shared_module()).mark(*b);
+            mod_sched_.model_sched().mark_shared(*b);
     }
 }
 
 void function_schedule_context::assign_allocations()
 {
     for (auto &b : physical_buffers_)
-        b.allocation() = memory_span { allocators_.at(b.owner().memory_location())->allocations().at(&b) };
+        b.allocation() = memory_span { allocator(b.owner()).allocations().at(&b) };
+
+    auto assign = [&](output_connector *out) {
+        auto &lbuf = *logical_buffer_map_.at(out);
+        auto &owner = lbuf.physical()->owner();
+        auto &memory = lbuf.physical()->allocation();
+
+        // TODO: take account of subbuffer
+        buffer_allocation alloc {};
+        alloc.memory_location = owner.memory_location();
+        alloc.type = lbuf.type();
+        alloc.size = allocator(owner).get_size_in_bytes(lbuf);
+        alloc.shape = lbuf.shape();
+        assert(lbuf.strides_shape().size());
+        alloc.strides_shape = lbuf.strides_shape();
+        alloc.strides = to_strides(alloc.strides_shape);
+        alloc.start = memory.start;
+        alloc.start += *lbuf.absolute_offset();
+
+        module->allocations.emplace(out, alloc);
+    };
 
     auto alloc_visitor = make_relay_ir_visitor([&](node &node) {
         for (auto out : node.outputs())
-        {
-            auto &lbuf = *logical_buffer_map_.at(out);
-            auto &owner = lbuf.physical()->owner();
-            auto &memory = lbuf.physical()->allocation();
-
-            // TODO: take account of subbuffer
-            buffer_allocation alloc {};
-            alloc.memory_location = owner.memory_location();
-            alloc.type = lbuf.type();
-            alloc.size = allocators_.at(alloc.memory_location)->get_size_in_bytes(lbuf);
-            alloc.shape = lbuf.shape();
-            assert(lbuf.strides_shape().size());
-            alloc.strides_shape = lbuf.strides_shape();
-            alloc.strides = to_strides(alloc.strides_shape);
-            alloc.start = memory.start;
-            alloc.start += *lbuf.absolute_offset();
-
-            module->allocations.emplace(out, alloc);
-        }
+            assign(out);
     });
     alloc_visitor.visit(outputs_);
+
+    for (auto in : graph->inputs())
+    {
+        if (graph->is_subgraph() && in->output().connections().empty())
+            assign(&in->output());
+    }
 }
 
 void function_schedule_context::dump(const std::filesystem::path &dump_dir)
@@ -32,7 +32,10 @@ void lifetime_recorder::allocate(ir::output_connector &conn, memory_location_t l
         buffer.lifetime().birth = cnt_age_;
         buffer.lifetime().used_count = conn.connections().size();
         buffer.strides_shape() = buffer.shape();
-        buffer_map_.emplace(&conn, &buffers_.emplace_back(buffer));
+        auto &new_buffer = buffers_.emplace_back(buffer);
+        buffer_map_.emplace(&conn, &new_buffer);
+        if (new_buffer.lifetime().is_alive())
+            alive_buffers_.emplace(&new_buffer);
     }
 }
 
@@ -44,8 +47,8 @@ void lifetime_recorder::release(ir::output_connector &conn)
         auto &lifetime = node->second->lifetime();
         if (!lifetime.is_alive())
             throw std::runtime_error("Trying to free a released buffer");
-        else
-            lifetime.used_count--;
+        else if (--lifetime.used_count == 0)
+            kill(*node->second);
     }
 }
 
@@ -59,12 +62,17 @@ void lifetime_recorder::current_age(size_t age)
     if (age < cnt_age_)
         throw std::invalid_argument("Cannot set back age");
 
-    auto increase = age - cnt_age_;
     cnt_age_ = age;
-    for (auto &b : buffers_)
-    {
-        auto &lifetime = b.lifetime();
-        if (lifetime.is_alive())
-            lifetime.age += increase;
-    }
+}
+
+void lifetime_recorder::finish()
+{
+    for (auto b : alive_buffers_)
+        b->lifetime().age = cnt_age_ - b->lifetime().birth;
+}
+
+void lifetime_recorder::kill(logical_buffer &buffer)
+{
+    buffer.lifetime().age = cnt_age_ - buffer.lifetime().birth;
+    alive_buffers_.erase(&buffer);
 }
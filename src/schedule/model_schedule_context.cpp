@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include <nncase/schedule/schedule_context.h>
+#include <algorithm>
 #include <nncase/targets/target.h>
 #include <unordered_set>
 
@@ -74,8 +75,26 @@ void model_schedule_context::visit_function(ir::graph &graph, caller_context &ca
         entry_module_ = &it->second;
 }
 
+void model_schedule_context::mark_shared(const physical_buffer &buffer)
+{
+    shared_buffers_.emplace_back(&buffer);
+}
+
+void model_schedule_context::allocate_shared_buffers()
+{
+    // Callees are visited before their callers finish, so shared buffers are
+    // collected out of age order. Sort them so the whole model can be packed
+    // into one time-multiplexed pool.
+    std::stable_sort(shared_buffers_.begin(), shared_buffers_.end(), [](const physical_buffer *lhs, const physical_buffer *rhs) { return lhs->lifetime().birth < rhs->lifetime().birth; });
+
+    for (auto b : shared_buffers_)
+        shared_allocator_.mark(*b);
+    shared_allocator_.finish();
+}
+
 void model_schedule_context::end_schedule()
 {
+    allocate_shared_buffers();
     for (auto &module_p : module_contexts_)
         module_p.second.end_schedule();
     result_.entry_function = entry_module_->module_result().functions_map.at(entry_function_);
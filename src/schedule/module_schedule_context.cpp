@@ -26,6 +26,8 @@ module_schedule_context::module_schedule_context(module_schedule_result &result,
 {
     result_.type = type;
     model_sched.target().register_allocators(type_, allocators_, allocator_holder_);
+    if (model_sched.target().supports_shared_data(type_))
+        shared_allocators_.emplace(type_, &model_sched.shared_allocator());
 }
 
 buffer_allocator &module_schedule_context::shared_allocator(const module_type_t &type)
@@ -50,6 +52,9 @@ void module_schedule_context::end_schedule()
             module_result().max_usages.emplace(allocator.first, allocator.second->max_usage());
     }
 
+    for (auto &allocator : shared_allocators_)
+        module_result().shared_max_usages.emplace(allocator.first, allocator.second->max_usage());
+
     result_.functions.resize(functions_.size());
     for (size_t i = 0; i < functions_.size(); i++)
     {
@@ -19,6 +19,7 @@
 #include <nncase/transforms/neutral/add_quant_checkpoints.h>
 #include <nncase/transforms/neutral/binary_motion.h>
 #include <nncase/transforms/neutral/bitcast_motion.h>
+#include <nncase/transforms/neutral/depth_first_tiling.h>
 #include <nncase/transforms/neutral/dequantize_motion.h>
 #include <nncase/transforms/neutral/fold_bitcast.h>
 #include <nncase/transforms/neutral/fold_constant.h>
@@ -26,17 +27,22 @@
 #include <nncase/transforms/neutral/fold_convert.h>
 #include <nncase/transforms/neutral/fold_dilated_conv2d.h>
 #include <nncase/transforms/neutral/fold_pad.h>
+#include <nncase/transforms/neutral/fold_qdq.h>
 #include <nncase/transforms/neutral/fold_quantize.h>
 #include <nncase/transforms/neutral/fold_slice.h>
 #include <nncase/transforms/neutral/fold_transpose.h>
 #include <nncase/transforms/neutral/fuse_clamp.h>
+#include <nncase/transforms/neutral/fuse_conv2d_lut.h>
+#include <nncase/transforms/neutral/fuse_conv2d_pool.h>
 #include <nncase/transforms/neutral/fuse_pad.h>
 #include <nncase/transforms/neutral/fuse_unary.h>
 #include <nncase/transforms/neutral/fused_unary_to_lookup1d.h>
 #include <nncase/transforms/neutral/global_reduce_window_to_reduce.h>
+#include <nncase/transforms/neutral/layout_assignment.h>
 #include <nncase/transforms/neutral/lstm_transform.h>
 #include <nncase/transforms/neutral/matmul_to_conv2d.h>
 #include <nncase/transforms/neutral/quantize_motion.h>
+#include <nncase/transforms/neutral/quantized_ops.h>
 #include <nncase/transforms/neutral/remove_binary.h>
 #include <nncase/transforms/neutral/simplify_reduce.h>
 #include <nncase/transforms/neutral/space_to_batch_transform.h>
@@ -67,7 +73,7 @@ void neutral_target::register_allocators(const module_type_t &type, allocator_ma
         allocators.emplace(mem_input, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
         allocators.emplace(mem_output, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
         allocators.emplace(mem_rdata, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
-        allocators.emplace(mem_data, allocator_holders.emplace_back(std::make_shared<first_fit_allocator>()).get());
+        allocators.emplace(mem_data, allocator_holders.emplace_back(std::make_shared<best_fit_allocator>()).get());
     }
     else
     {
@@ -75,6 +81,11 @@ void neutral_target::register_allocators(const module_type_t &type, allocator_ma
     }
 }
 
+bool neutral_target::supports_shared_data(const module_type_t &type)
+{
+    return type == runtime::stackvm::stackvm_module_type;
+}
+
 void neutral_target::register_evaluator_ops()
 {
     using namespace nncase::ir;
@@ -182,6 +193,12 @@ void neutral_target::register_target_independent_passes(const module_type_t &typ
 
     if (type == runtime::stackvm::stackvm_module_type)
     {
+        //fold_qdq
+        {
+            transform_pass p("fold_qdq");
+            p.emplace<fold_qdq_transform>();
+            pass_mgr.add_pass(std::move(p));
+        }
         //lstm_transform
         {
             transform_pass p("lstm_transform");
@@ -216,6 +233,14 @@ void neutral_target::register_target_independent_passes(const module_type_t &typ
             pass_mgr.add_pass(std::move(p));
         }
 
+        //layout_assignment
+        {
+            pass_mgr.add_pass<layout_assignment_pass>("layout_assignment");
+            transform_pass p("fold_layout_transpose");
+            add_default_transforms(p, true);
+            pass_mgr.add_pass(std::move(p));
+        }
+
         // pad to slice
         {
             transform_pass p("pad_to_slice");
@@ -243,7 +268,7 @@ void neutral_target::register_quantize_annotation_passes([[maybe_unused]] const
 
     {
         transform_pass p("annotate_neutral_quantize");
-        p.emplace<add_quant_checkpoints_transform>(std::in_place, ir::op_fused_unary);
+        p.emplace<add_quant_checkpoints_transform>(std::in_place, ir::op_fused_unary, ir::op_binary, ir::op_reduce_window2d, ir::op_resize_image, ir::op_concat);
         pass_mgr.add_pass(std::move(p));
     }
 }
@@ -255,12 +280,44 @@ void neutral_target::register_quantize_passes([[maybe_unused]] const module_type
         p.emplace<fused_unary_to_lookup1d_transform>();
         pass_mgr.add_pass(std::move(p));
     }
+    {
+        transform_pass p("lower_quantized_ops");
+        p.emplace<quantized_binary_transform>(quant_type);
+        p.emplace<quantized_reduce_window2d_transform>(quant_type);
+        p.emplace<quantized_resize_image_transform>(quant_type);
+        p.emplace<quantized_concat_transform>(quant_type);
+        pass_mgr.add_pass(std::move(p));
+    }
     {
         transform_pass p("fold_quantize");
         add_default_transforms(p);
         p.emplace<fold_quantize_transform>();
+        p.emplace<fold_requantize_transform>();
+        pass_mgr.add_pass(std::move(p));
+    }
+}
+
+void neutral_target::register_target_dependent_after_quantization_passes(const module_type_t &type, ir::transforms::pass_manager &pass_mgr)
+{
+    {
+        transform_pass p("fuse_conv2d_lut");
+        p.emplace<fuse_conv2d_lut_transform>();
         pass_mgr.add_pass(std::move(p));
     }
+
+    if (type == runtime::stackvm::stackvm_module_type)
+    {
+        {
+            transform_pass p("depth_first_tiling");
+            p.emplace<depth_first_tiling_transform>();
+            pass_mgr.add_pass(std::move(p));
+        }
+        {
+            transform_pass p("fuse_conv2d_pool");
+            p.emplace<fuse_conv2d_pool_transform>();
+            pass_mgr.add_pass(std::move(p));
+        }
+    }
 }
 
 void neutral_target::register_allocation_passes([[maybe_unused]] const module_type_t &type, [[maybe_unused]] ir::transforms::pass_manager &pass_mgr)
@@ -32,6 +32,11 @@ void target::config_attributes([[maybe_unused]] target_attributes &attrs)
 {
 }
 
+bool target::supports_shared_data([[maybe_unused]] const module_type_t &type)
+{
+    return false;
+}
+
 void target::register_quantize_annotation_passes([[maybe_unused]] const module_type_t &type, [[maybe_unused]] ir::transforms::pass_manager &pass_mgr)
 {
 }
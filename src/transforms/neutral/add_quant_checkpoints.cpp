@@ -29,6 +29,11 @@ bool add_quant_checkpoints_transform::on_try_match(node &node, transform_context
 {
     if (opcodes_.find(node.runtime_opcode()) != opcodes_.end())
     {
+        // Only float tensors carry a quantization range
+        if (std::any_of(node.inputs().begin(), node.inputs().end(), [](input_connector *in) { return in->type() != dt_float32; })
+            || std::any_of(node.outputs().begin(), node.outputs().end(), [](output_connector *out) { return out->type() != dt_float32; }))
+            return false;
+
         bool not_processed = false;
         if (!node.inputs().empty()
             && std::any_of(node.inputs().begin(), node.inputs().end(), [](input_connector *in) { return (in->connection()->attributes() & cnctr_attr_need_quantize) != cnctr_attr_need_quantize; }))
@@ -0,0 +1,302 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/ops/slice.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/depth_first_tiling.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+// Recomputed halo rows may at most double the rows computed by the first op
+constexpr int32_t max_recompute_ratio = 2;
+
+// Rows of an op input read by a tile, and the padding the tile applies on them
+struct tile_rows
+{
+    int32_t begin;
+    int32_t end;
+    padding pad;
+};
+
+// Index of the input fed by the previous op in the chain, -1 if the op can't be tiled by rows
+int32_t get_chain_input(node &node)
+{
+    auto is_4d = [](output_connector &output) { return output.shape().size() == 4; };
+
+    if (auto conv = node_cast<conv2d>(node))
+        return is_4d(conv->output()) ? 0 : -1;
+    if (auto rw = node_cast<reduce_window2d>(node))
+    {
+        auto pad_after = rw->padding_h_w_after();
+        return is_4d(rw->output()) && !rw->ceil_mode() && !rw->strict_inside_input()
+                && std::all_of(pad_after.begin(), pad_after.end(), [](int32_t pad) { return pad == 0; })
+            ? 0
+            : -1;
+    }
+    if (node.runtime_opcode() == op_unary || node.runtime_opcode() == op_quantize || node.runtime_opcode() == op_dequantize)
+        return is_4d(node.output_at(0)) ? 0 : -1;
+    if (auto b = node_cast<binary>(node))
+    {
+        // The other operand must be a constant that doesn't vary along rows
+        auto row_invariant = [&](input_connector &in) {
+            auto &shape = in.shape();
+            return in.connection()->owner().runtime_opcode() == op_constant
+                && (shape.size() < 2 || shape[shape.size() - 2] == 1);
+        };
+
+        if (!is_4d(b->output()))
+            return -1;
+        if (row_invariant(b->input_b()) && b->input_a().shape() == b->output().shape())
+            return 0;
+        if (row_invariant(b->input_a()) && b->input_b().shape() == b->output().shape())
+            return 1;
+    }
+
+    return -1;
+}
+
+// Window along rows, elementwise ops read the row they write
+void get_row_window(node &node, int32_t &extent, int32_t &stride, padding &pad)
+{
+    extent = 1;
+    stride = 1;
+    pad = padding::zero();
+    if (auto conv = node_cast<conv2d>(node))
+    {
+        extent = (conv->filter_h() - 1) * conv->dilation_h() + 1;
+        stride = conv->stride_h();
+        pad = conv->padding_h();
+    }
+    else if (auto rw = node_cast<reduce_window2d>(node))
+    {
+        extent = (rw->filter_h() - 1) * rw->dilation_h() + 1;
+        stride = rw->stride_h();
+        pad = rw->padding_h();
+    }
+}
+
+// Input rows of every op needed to produce output rows [begin, end) of the last op
+std::vector<tile_rows> get_tile_rows(std::span<node *const> chain, int32_t begin, int32_t end)
+{
+    std::vector<tile_rows> result(chain.size());
+    for (size_t i = chain.size(); i-- > 0;)
+    {
+        auto &op = *chain[i];
+        auto in_h = (int32_t)op.input_at(get_chain_input(op)).shape()[2];
+        int32_t extent, stride;
+        padding pad;
+        get_row_window(op, extent, stride, pad);
+
+        auto in_begin = begin * stride - pad.before;
+        auto in_end = (end - 1) * stride - pad.before + extent;
+        auto &rows = result[i];
+        rows.begin = std::max(in_begin, 0);
+        rows.end = std::min(in_end, in_h);
+        rows.pad = { rows.begin - in_begin, in_end - rows.end };
+        begin = rows.begin;
+        end = rows.end;
+    }
+
+    return result;
+}
+
+size_t get_row_bytes(output_connector &output)
+{
+    auto &shape = output.shape();
+    return get_bytes(output.type(), shape) / shape[2];
+}
+
+// Split the output rows into the fewest tiles whose intermediates fit in the cache
+std::vector<std::vector<tile_rows>> get_tiles(std::span<node *const> chain, size_t cache_size)
+{
+    auto &head_input = chain.front()->input_at(get_chain_input(*chain.front()));
+    auto out_h = (int32_t)chain.back()->output_at(0).shape()[2];
+    auto head_out_h = (int32_t)chain.front()->output_at(0).shape()[2];
+
+    for (int32_t tiles = 2; tiles <= out_h; tiles++)
+    {
+        std::vector<std::vector<tile_rows>> result;
+        size_t max_bytes = 0;
+        int32_t head_rows = 0;
+        for (int32_t i = 0; i < tiles; i++)
+        {
+            auto begin = out_h * i / tiles;
+            auto end = out_h * (i + 1) / tiles;
+            auto &rows = result.emplace_back(get_tile_rows(chain, begin, end));
+
+            size_t bytes = (rows[0].end - rows[0].begin) * get_row_bytes(head_input);
+            for (size_t j = 0; j < chain.size(); j++)
+            {
+                auto out_rows = j + 1 < chain.size() ? rows[j + 1].end - rows[j + 1].begin : end - begin;
+                bytes += out_rows * get_row_bytes(chain[j]->output_at(0));
+            }
+            max_bytes = std::max(max_bytes, bytes);
+            head_rows += chain.size() > 1 ? rows[1].end - rows[1].begin : end - begin;
+        }
+
+        if (head_rows > head_out_h * max_recompute_ratio)
+            break;
+        if (max_bytes <= cache_size)
+            return result;
+    }
+
+    return {};
+}
+
+output_connector &build_tile_op(graph &graph, node &op, output_connector &input, padding pad_h, const std::string &suffix)
+{
+    auto chain_input = get_chain_input(op);
+    node *new_op = nullptr;
+    if (auto conv = node_cast<conv2d>(op))
+    {
+        auto &weights = *conv->weights().connection();
+        conv2d *c;
+        if (conv->has_activation_table())
+            c = graph.emplace<conv2d>(input.shape(), weights.shape(), conv->groups(), pad_h, conv->padding_w(), conv->stride_h(), conv->stride_w(),
+                conv->dilation_h(), conv->dilation_w(), conv->fused_activation(), conv->activation_param());
+        else
+            c = graph.emplace<conv2d>(input.shape(), weights.shape(), conv->groups(), pad_h, conv->padding_w(), conv->stride_h(), conv->stride_w(),
+                conv->dilation_h(), conv->dilation_w(), conv->fused_activation());
+        for (size_t i = 1; i < conv->inputs().size(); i++)
+            c->input_at(i).connect(*conv->input_at(i).connection());
+        new_op = c;
+    }
+    else if (auto rw = node_cast<reduce_window2d>(op))
+    {
+        new_op = graph.emplace<reduce_window2d>(input.type(), rw->reduce_op(), input.shape(), rw->init_value(), rw->filter_h(), rw->filter_w(), pad_h, rw->padding_w(),
+            rw->stride_h(), rw->stride_w(), rw->dilation_h(), rw->dilation_w(), rw->fused_activation(), false, rw->count_include_pad());
+    }
+    else if (auto u = node_cast<unary>(op))
+    {
+        new_op = graph.emplace<unary>(u->unary_op(), input.shape());
+    }
+    else if (auto q = node_cast<quantize>(op))
+    {
+        new_op = graph.emplace<quantize>(input.type(), input.shape(), q->output().type(), q->quant_param());
+    }
+    else if (auto deq = node_cast<dequantize>(op))
+    {
+        new_op = graph.emplace<dequantize>(input.type(), input.shape(), deq->output().type(), deq->quant_param());
+    }
+    else if (auto b = node_cast<binary>(op))
+    {
+        auto &other = *b->input_at(1 - chain_input).connection();
+        auto &a_shape = chain_input == 0 ? input.shape() : other.shape();
+        auto &b_shape = chain_input == 0 ? other.shape() : input.shape();
+        new_op = graph.emplace<binary>(b->binary_op(), a_shape, b_shape, b->fused_activation());
+        new_op->input_at(1 - chain_input).connect(other);
+    }
+
+    new_op->name(op.name() + suffix);
+    new_op->input_at(chain_input).connect(input);
+    return new_op->output_at(0);
+}
+}
+
+bool depth_first_tiling_transform::on_try_match(node &node, transform_context &context)
+{
+    // Start from the head of a chain
+    auto head_input = get_chain_input(node);
+    if (head_input == -1)
+        return false;
+    auto &head_producer = *node.input_at(head_input).connection();
+    if (head_producer.connections().size() == 1 && get_chain_input(head_producer.owner()) != -1)
+        return false;
+
+    std::vector<ir::node *> chain { &node };
+    while (true)
+    {
+        auto consumers = chain.back()->output_at(0).connections();
+        if (consumers.size() != 1)
+            break;
+        auto &next = consumers[0]->owner();
+        auto next_input = get_chain_input(next);
+        if (next_input == -1 || &next.input_at(next_input) != consumers[0])
+            break;
+        chain.emplace_back(&next);
+    }
+
+    // Drop ops from the tail until the chain can be tiled, tiling only pays off while
+    // an intermediate feature map spills out of the cache
+    for (; chain.size() >= 2; chain.pop_back())
+    {
+        auto spills = std::any_of(chain.begin(), chain.end() - 1, [&](ir::node *op) {
+            auto &output = op->output_at(0);
+            return get_bytes(output.type(), output.shape()) > cache_size_;
+        });
+        if (!spills)
+            continue;
+
+        if (!get_tiles(chain, cache_size_).empty())
+        {
+            context.inputs.emplace_back(&node.input_at(head_input));
+            context.outputs.emplace_back(&chain.back()->output_at(0));
+            context.matched_nodes.assign(chain.begin(), chain.end());
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void depth_first_tiling_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto inputs = context.outputs[0]->connections();
+    auto chain = std::span<ir::node *const>(context.matched_nodes);
+    auto &last = *chain.back();
+
+    auto &in_shape = output.shape();
+    auto tiles = get_tiles(chain, cache_size_);
+    std::vector<output_connector *> tile_outputs;
+    std::vector<shape_t> tile_shapes;
+
+    for (size_t i = 0; i < tiles.size(); i++)
+    {
+        auto &rows = tiles[i];
+        auto suffix = "/tile_" + std::to_string(i);
+        auto in_slc = context.graph.emplace<slice>(output.type(), in_shape, axis_t { 0, 0, rows[0].begin, 0 },
+            axis_t { (int32_t)in_shape[0], (int32_t)in_shape[1], rows[0].end, (int32_t)in_shape[3] });
+        in_slc->name(chain.front()->name() + suffix + "/slice");
+        in_slc->input().connect(output);
+
+        auto *tile_output = &in_slc->output();
+        for (size_t j = 0; j < chain.size(); j++)
+            tile_output = &build_tile_op(context.graph, *chain[j], *tile_output, rows[j].pad, suffix);
+        tile_outputs.emplace_back(tile_output);
+        tile_shapes.emplace_back(tile_output->shape());
+    }
+
+    auto c = context.graph.emplace<concat>(last.output_at(0).type(), tile_shapes, 2);
+    c->name(last.name());
+    for (size_t i = 0; i < tile_outputs.size(); i++)
+        c->input_at(i).connect(*tile_outputs[i]);
+
+    for (auto &in : dup(inputs))
+        in->connect(c->output());
+}
@@ -0,0 +1,68 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/fold_qdq.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+bool fold_qdq_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto q = node_cast<quantize>(node))
+    {
+        if (q->input().type() != dt_float32
+            || (q->output().type() != dt_uint8 && q->output().type() != dt_int8))
+            return false;
+
+        for (auto &&conn : q->output().connections())
+        {
+            if (auto deq = node_cast<dequantize>(conn->owner()))
+            {
+                if (deq->output().type() == dt_float32 && almost_equal(q->quant_param(), deq->quant_param()))
+                {
+                    context.outputs.emplace_back(&deq->output());
+                    context.matched_nodes.emplace_back(deq);
+                }
+            }
+        }
+
+        if (!context.outputs.empty())
+        {
+            context.inputs.emplace_back(&q->input());
+            context.matched_nodes.emplace_back(q);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void fold_qdq_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &q = static_cast<quantize &>(*context.matched_nodes.back());
+    auto param = q.quant_param();
+    output.quant_range(q.output().type() == dt_int8 ? param.range<int8_t>() : param.range<uint8_t>());
+
+    for (auto deq_out : context.outputs)
+    {
+        auto inputs = deq_out->connections();
+        for (auto &in : dup(inputs))
+            in->connect(output);
+    }
+}
@@ -13,18 +13,34 @@
  * limitations under the License.
  */
 #include <nncase/ir/ops/batch_to_space.h>
+#include <nncase/ir/ops/constant.h>
 #include <nncase/ir/ops/conv2d.h>
 #include <nncase/ir/ops/dequantize.h>
 #include <nncase/ir/ops/quantize.h>
 #include <nncase/ir/ops/reduce_window2d.h>
 #include <nncase/ir/ops/space_to_batch.h>
+#include <nncase/ir/ops/table_lookup.h>
 #include <nncase/ir/visitor.h>
+#include <nncase/kernels/kernel_utils.h>
 #include <nncase/transforms/neutral/fold_quantize.h>
 
 using namespace nncase;
 using namespace nncase::ir;
 using namespace nncase::ir::transforms;
 
+namespace
+{
+template <class T>
+std::vector<T> generate_requantize_lut(const quant_param_t &in_param, const quant_param_t &out_param)
+{
+    std::vector<T> lut;
+    lut.reserve(256);
+    for (int32_t i = std::numeric_limits<T>::lowest(); i <= std::numeric_limits<T>::max(); i++)
+        lut.emplace_back(kernels::detail::quantize<T>(kernels::detail::dequantize<T>((T)i, in_param), out_param));
+    return lut;
+}
+}
+
 bool fold_quantize_transform::on_try_match(node &node, transform_context &context)
 {
     if (node.runtime_opcode() == op_quantize)
@@ -89,3 +105,57 @@ void fold_quantize_transform::process(transform_context &context)
     for (auto &in : dup(inputs))
         in->connect(output);
 }
+
+bool fold_requantize_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto deq = node_cast<dequantize>(node))
+    {
+        auto type = deq->input().type();
+        if (type != dt_uint8 && type != dt_int8)
+            return false;
+
+        for (auto &&conn : deq->output().connections())
+        {
+            if (auto q = node_cast<quantize>(conn->owner()))
+            {
+                if (q->output().type() == type && !almost_equal(q->quant_param(), deq->quant_param()))
+                {
+                    context.inputs.emplace_back(&deq->input());
+                    context.outputs.emplace_back(&q->output());
+
+                    context.matched_nodes.emplace_back(deq);
+                    context.matched_nodes.emplace_back(q);
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ *         dequantize(p1)
+ *         |                    -->     table_lookup1d(p1 -> p2)
+ *         quantize(p2)
+ **/
+void fold_requantize_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto inputs = context.outputs[0]->connections();
+    auto &old_deq = static_cast<dequantize &>(*context.matched_nodes[0]);
+    auto &old_q = static_cast<quantize &>(*context.matched_nodes[1]);
+
+    auto type = output.type();
+    auto table = type == dt_uint8
+        ? context.graph.emplace<constant>(dt_uint8, shape_t { 256 }, generate_requantize_lut<uint8_t>(old_deq.quant_param(), old_q.quant_param()))
+        : context.graph.emplace<constant>(dt_int8, shape_t { 256 }, generate_requantize_lut<int8_t>(old_deq.quant_param(), old_q.quant_param()));
+    table->name(old_q.name() + "/requantize_table");
+    auto lut = context.graph.emplace<table_lookup1d>(type, output.shape(), 256);
+    lut->name(old_q.name() + "/requantize");
+    lut->input().connect(output);
+    lut->table().connect(table->output());
+
+    for (auto &in : dup(inputs))
+        in->connect(lut->output());
+}
@@ -0,0 +1,101 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/ops/table_lookup.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/transforms/neutral/fuse_conv2d_lut.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+bool fuse_conv2d_lut_transform::on_try_match(node &node, transform_context &context)
+{
+    conv2d *conv;
+    quantize *q;
+    table_lookup1d *lut;
+    constant *table;
+    dequantize *deq;
+
+    if ((conv = node_cast<conv2d>(node)) && !conv->has_activation_table()
+        && conv->output().connections().size() == 1
+        && (q = try_get_direct_child<quantize>(*conv)) && q->output().type() == dt_uint8
+        && q->output().connections().size() == 1
+        && (lut = try_get_direct_child<table_lookup1d>(*q))
+        && (table = node_cast<constant>(lut->table().connection()->owner()))
+        && lut->output().connections().size() == 1
+        && (deq = try_get_direct_child<dequantize>(*lut)) && deq->output().type() == dt_float32)
+    {
+        context.inputs.emplace_back(&conv->input());
+        context.inputs.emplace_back(&conv->weights());
+        context.inputs.emplace_back(&conv->bias());
+        context.outputs.emplace_back(&deq->output());
+
+        context.matched_nodes.emplace_back(conv);
+        context.matched_nodes.emplace_back(q);
+        context.matched_nodes.emplace_back(lut);
+        context.matched_nodes.emplace_back(table);
+        context.matched_nodes.emplace_back(deq);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ *         conv2d
+ *         |
+ *         quantize
+ *         |                    -->     conv2d(activation_table)
+ *         table_lookup1d
+ *         |
+ *         dequantize
+ **/
+void fuse_conv2d_lut_transform::process(transform_context &context)
+{
+    auto &input = *context.inputs[0]->connection();
+    auto &weights = *context.inputs[1]->connection();
+    auto &bias = *context.inputs[2]->connection();
+    auto inputs = context.outputs[0]->connections();
+    auto &old_conv = static_cast<conv2d &>(*context.matched_nodes[0]);
+    auto &old_q = static_cast<quantize &>(*context.matched_nodes[1]);
+    auto &old_table = static_cast<constant &>(*context.matched_nodes[3]);
+    auto &old_deq = static_cast<dequantize &>(*context.matched_nodes[4]);
+
+    // Dequantize the table entries so the conv epilogue yields the final float directly
+    auto table_data = old_table.data();
+    std::vector<float> float_table(256);
+    for (size_t i = 0; i < float_table.size(); i++)
+        float_table[i] = kernels::detail::dequantize((uint8_t)table_data[i], old_deq.quant_param());
+
+    auto table = context.graph.emplace<constant>(dt_float32, shape_t { 256 }, float_table);
+    table->name(old_conv.name() + "/activation_table");
+    auto conv = context.graph.emplace<conv2d>(old_conv.input().shape(), old_conv.weights().shape(), old_conv.groups(), old_conv.padding_h(),
+        old_conv.padding_w(), old_conv.stride_h(), old_conv.stride_w(), old_conv.dilation_h(), old_conv.dilation_w(),
+        old_conv.fused_activation(), old_q.quant_param());
+    conv->name(old_conv.name());
+    conv->input().connect(input);
+    conv->weights().connect(weights);
+    conv->bias().connect(bias);
+    conv->activation_table().connect(table->output());
+
+    link(old_deq.output(), conv->output(), context.quantizer);
+    for (auto &in : dup(inputs))
+        in->connect(conv->output());
+}
@@ -0,0 +1,91 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/conv2d_pool.h>
+#include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/fuse_conv2d_pool.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+bool fuse_conv2d_pool_transform::on_try_match(node &node, transform_context &context)
+{
+    conv2d *conv;
+    reduce_window2d *pool;
+
+    // The fused kernel pools with dilation 1, floor rounding and averages over the in-bounds elements only
+    if ((conv = node_cast<conv2d>(node))
+        && conv->output().connections().size() == 1
+        && (pool = try_get_direct_child<reduce_window2d>(*conv)) && pool->input().type() == dt_float32
+        && pool->dilation_h() == 1 && pool->dilation_w() == 1 && !pool->ceil_mode() && !pool->strict_inside_input()
+        && pool->padding_h_w_after() == std::vector<int32_t> { 0, 0 }
+        && (pool->reduce_op() != reduce_mean || !pool->count_include_pad() || (pool->padding_h().sum() == 0 && pool->padding_w().sum() == 0)))
+    {
+        context.inputs.emplace_back(&conv->input());
+        context.inputs.emplace_back(&conv->weights());
+        context.inputs.emplace_back(&conv->bias());
+        if (conv->has_activation_table())
+            context.inputs.emplace_back(&conv->activation_table());
+        context.outputs.emplace_back(&pool->output());
+
+        context.matched_nodes.emplace_back(conv);
+        context.matched_nodes.emplace_back(pool);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ *         conv2d
+ *         |                    -->     conv2d_pool
+ *         reduce_window2d
+ **/
+void fuse_conv2d_pool_transform::process(transform_context &context)
+{
+    auto &input = *context.inputs[0]->connection();
+    auto &weights = *context.inputs[1]->connection();
+    auto &bias = *context.inputs[2]->connection();
+    auto inputs = context.outputs[0]->connections();
+    auto &old_conv = static_cast<conv2d &>(*context.matched_nodes[0]);
+    auto &old_pool = static_cast<reduce_window2d &>(*context.matched_nodes[1]);
+
+    conv2d_pool *conv;
+    if (old_conv.has_activation_table())
+    {
+        conv = context.graph.emplace<conv2d_pool>(old_conv.input().shape(), old_conv.weights().shape(), old_conv.groups(), old_conv.padding_h(),
+            old_conv.padding_w(), old_conv.stride_h(), old_conv.stride_w(), old_conv.dilation_h(), old_conv.dilation_w(), old_conv.fused_activation(),
+            old_conv.activation_param(), old_pool.reduce_op(), old_pool.init_value(), old_pool.filter_h(), old_pool.filter_w(), old_pool.padding_h(),
+            old_pool.padding_w(), old_pool.stride_h(), old_pool.stride_w(), old_pool.fused_activation());
+        conv->activation_table().connect(*context.inputs[3]->connection());
+    }
+    else
+    {
+        conv = context.graph.emplace<conv2d_pool>(old_conv.input().shape(), old_conv.weights().shape(), old_conv.groups(), old_conv.padding_h(),
+            old_conv.padding_w(), old_conv.stride_h(), old_conv.stride_w(), old_conv.dilation_h(), old_conv.dilation_w(), old_conv.fused_activation(),
+            old_pool.reduce_op(), old_pool.init_value(), old_pool.filter_h(), old_pool.filter_w(), old_pool.padding_h(),
+            old_pool.padding_w(), old_pool.stride_h(), old_pool.stride_w(), old_pool.fused_activation());
+    }
+
+    conv->name(old_pool.name());
+    conv->input().connect(input);
+    conv->weights().connect(weights);
+    conv->bias().connect(bias);
+
+    for (auto &in : dup(inputs))
+        in->connect(conv->output());
+}
@@ -0,0 +1,389 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/bitcast.h>
+#include <nncase/ir/ops/clamp.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/convert.h>
+#include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/pad.h>
+#include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/ops/reduce.h>
+#include <nncase/ir/ops/transpose.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/layout_assignment.h>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+// A region is a connected set of ops that compute the same result under any
+// permutation of their axes. Running a region in layout `perm` means every
+// tensor y inside it is stored as transpose(y, perm), so transposes are only
+// needed where values enter or leave the region, and those fold away when
+// they meet an opposite transpose already in the graph.
+
+namespace
+{
+struct layout_region
+{
+    size_t rank;
+    std::vector<node *> nodes;
+    std::unordered_set<node *> members;
+};
+
+axis_t identity_perm(size_t rank)
+{
+    axis_t perm(rank);
+    for (size_t i = 0; i < rank; i++)
+        perm[i] = (int32_t)i;
+    return perm;
+}
+
+bool is_identity(const axis_t &perm)
+{
+    for (size_t i = 0; i < perm.size(); i++)
+    {
+        if ((size_t)perm[i] != i)
+            return false;
+    }
+
+    return true;
+}
+
+axis_t inverse_perm(const axis_t &perm)
+{
+    axis_t inv(perm.size());
+    for (size_t i = 0; i < perm.size(); i++)
+        inv[perm[i]] = (int32_t)i;
+    return inv;
+}
+
+// transpose(transpose(x, first), second) == transpose(x, compose(first, second))
+axis_t compose_perm(const axis_t &first, const axis_t &second)
+{
+    axis_t perm(first.size());
+    for (size_t i = 0; i < perm.size(); i++)
+        perm[i] = first[second[i]];
+    return perm;
+}
+
+shape_t expand_rank(const shape_t &shape, size_t rank)
+{
+    shape_t new_shape(rank - shape.size(), 1);
+    new_shape.insert(new_shape.end(), shape.begin(), shape.end());
+    return new_shape;
+}
+
+bool is_layout_agnostic(node &node)
+{
+    static const std::unordered_set<node_opcode> opcodes {
+        op_unary, op_binary, op_clamp, op_quantize, op_dequantize, op_convert, op_concat, op_pad, op_reduce
+    };
+
+    if (!opcodes.contains(node.runtime_opcode()) || node.outputs().size() != 1)
+        return false;
+    if (auto r = node_cast<reduce>(node); r && !r->keep_dims())
+        return false;
+
+    auto rank = node.output_at(0).shape().size();
+    auto inputs = node.inputs();
+    return rank >= 2 && std::all_of(inputs.begin(), inputs.end(), [&](input_connector *in) { return in->shape().size() <= rank; });
+}
+
+std::vector<layout_region> find_regions(graph &graph)
+{
+    std::vector<node *> order;
+    auto visitor = make_relay_ir_visitor([&](node &node) { order.emplace_back(&node); });
+    visitor.visit(graph);
+
+    std::unordered_map<node *, size_t> topo_index;
+    for (size_t i = 0; i < order.size(); i++)
+        topo_index.emplace(order[i], i);
+
+    std::vector<layout_region> regions;
+    std::unordered_set<node *> visited;
+    for (auto seed : order)
+    {
+        if (visited.contains(seed) || !is_layout_agnostic(*seed))
+            continue;
+
+        auto &region = regions.emplace_back();
+        region.rank = seed->output_at(0).shape().size();
+        std::queue<node *> pending;
+        pending.push(seed);
+        visited.emplace(seed);
+
+        auto try_add = [&](node &n) {
+            if (!visited.contains(&n) && topo_index.contains(&n) && is_layout_agnostic(n)
+                && n.output_at(0).shape().size() == region.rank)
+            {
+                visited.emplace(&n);
+                pending.push(&n);
+            }
+        };
+
+        while (!pending.empty())
+        {
+            auto n = pending.front();
+            pending.pop();
+            region.members.emplace(n);
+
+            for (auto in : n->inputs())
+                try_add(in->connection()->owner());
+            for (auto in : n->output_at(0).connections())
+                try_add(in->owner());
+        }
+
+        region.nodes.assign(region.members.begin(), region.members.end());
+        std::sort(region.nodes.begin(), region.nodes.end(), [&](node *lhs, node *rhs) { return topo_index.at(lhs) < topo_index.at(rhs); });
+    }
+
+    return regions;
+}
+
+// Optimized kernels reduce along contiguous trailing axes and concat whole blocks fastest
+size_t kernel_cost(node &node, const axis_t &perm, const axis_t &inv_perm)
+{
+    if (auto r = node_cast<reduce>(node))
+    {
+        auto &axes = r->axis();
+        for (auto axis : axes)
+        {
+            if ((size_t)inv_perm[axis] < perm.size() - axes.size())
+                return xt::compute_size(r->input().shape());
+        }
+    }
+    else if (auto c = node_cast<concat>(node))
+    {
+        auto &shape = c->output().shape();
+        for (size_t i = 0; i < (size_t)inv_perm[c->axis()]; i++)
+        {
+            if (shape[perm[i]] != 1)
+                return xt::compute_size(shape);
+        }
+    }
+
+    return 0;
+}
+
+size_t region_cost(const layout_region &region, const axis_t &perm)
+{
+    auto inv_perm = inverse_perm(perm);
+    auto keep_layout = is_identity(perm);
+    size_t cost = 0;
+
+    std::unordered_set<output_connector *> entries;
+    for (auto n : region.nodes)
+    {
+        cost += kernel_cost(*n, perm, inv_perm);
+
+        for (auto in : n->inputs())
+        {
+            auto &conn = *in->connection();
+            if (region.members.contains(&conn.owner()) || !entries.emplace(&conn).second
+                || conn.owner().runtime_opcode() == op_constant)
+                continue;
+
+            auto tp = node_cast<transpose>(conn.owner());
+            if (tp && conn.shape().size() == region.rank)
+                cost += is_identity(compose_perm(tp->perm(), perm)) ? 0 : xt::compute_size(conn.shape());
+            else if (!keep_layout)
+                cost += xt::compute_size(conn.shape());
+        }
+
+        auto &out = n->output_at(0);
+        bool has_plain_consumer = false;
+        for (auto in : out.connections())
+        {
+            auto &consumer = in->owner();
+            if (region.members.contains(&consumer))
+                continue;
+
+            if (auto tp = node_cast<transpose>(consumer))
+                cost += is_identity(compose_perm(inv_perm, tp->perm())) ? 0 : xt::compute_size(out.shape());
+            else
+                has_plain_consumer = true;
+        }
+
+        if (has_plain_consumer && !keep_layout)
+            cost += xt::compute_size(out.shape());
+    }
+
+    return cost;
+}
+
+std::vector<axis_t> candidate_layouts(const layout_region &region)
+{
+    std::vector<axis_t> candidates { identity_perm(region.rank) };
+    auto add_candidate = [&](axis_t perm) {
+        if (std::find(candidates.begin(), candidates.end(), perm) == candidates.end())
+            candidates.emplace_back(std::move(perm));
+    };
+
+    for (auto n : region.nodes)
+    {
+        for (auto in : n->inputs())
+        {
+            auto tp = node_cast<transpose>(in->connection()->owner());
+            if (tp && tp->perm().size() == region.rank)
+                add_candidate(inverse_perm(tp->perm()));
+        }
+
+        for (auto in : n->output_at(0).connections())
+        {
+            auto tp = node_cast<transpose>(in->owner());
+            if (tp && tp->perm().size() == region.rank)
+                add_candidate(tp->perm());
+        }
+    }
+
+    return candidates;
+}
+
+node *permute_node(graph &graph, node &old, std::span<output_connector *const> inputs, const axis_t &perm, const axis_t &inv_perm)
+{
+    if (auto u = node_cast<unary>(old))
+        return graph.emplace<unary>(u->unary_op(), inputs[0]->shape());
+    if (auto b = node_cast<binary>(old))
+        return graph.emplace<binary>(b->binary_op(), inputs[0]->shape(), inputs[1]->shape(), b->fused_activation());
+    if (node_cast<clamp>(old))
+        return graph.emplace<clamp>(inputs[0]->shape(), inputs[1]->shape(), inputs[2]->shape());
+    if (auto q = node_cast<quantize>(old))
+        return graph.emplace<quantize>(q->input().type(), inputs[0]->shape(), q->output().type(), q->quant_param());
+    if (auto dq = node_cast<dequantize>(old))
+        return graph.emplace<dequantize>(dq->input().type(), inputs[0]->shape(), dq->output().type(), dq->quant_param());
+    if (auto c = node_cast<convert>(old))
+        return graph.emplace<convert>(c->input().type(), inputs[0]->shape(), c->output().type());
+    if (auto c = node_cast<concat>(old))
+    {
+        std::vector<shape_t> shapes;
+        for (auto in : inputs)
+            shapes.emplace_back(in->shape());
+        return graph.emplace<concat>(c->output().type(), shapes, inv_perm[c->axis()]);
+    }
+    if (auto p = node_cast<pad>(old))
+    {
+        xt::svector<padding> paddings(perm.size(), padding::zero());
+        for (size_t i = 0; i < perm.size(); i++)
+            paddings[i] = p->paddings()[perm[i]];
+        return graph.emplace<pad>(p->output().type(), inputs[0]->shape(), std::move(paddings), p->pad_mode(), p->pad_value());
+    }
+    if (auto r = node_cast<reduce>(old))
+    {
+        axis_t axes(r->axis().size());
+        for (size_t i = 0; i < axes.size(); i++)
+            axes[i] = inv_perm[r->axis()[i]];
+        std::sort(axes.begin(), axes.end());
+        return graph.emplace<reduce>(r->reduce_op(), inputs[0]->shape(), std::move(axes), r->init_value(), r->keep_dims());
+    }
+
+    throw std::runtime_error("Layout assignment doesn't support " + std::string(old.runtime_opcode().name));
+}
+
+void assign_layout(graph &graph, const layout_region &region, const axis_t &perm)
+{
+    auto inv_perm = inverse_perm(perm);
+    std::unordered_map<output_connector *, output_connector *> permuted;
+
+    auto get_permuted = [&](output_connector &conn) -> output_connector & {
+        if (auto it = permuted.find(&conn); it != permuted.end())
+            return *it->second;
+
+        auto src = &conn;
+        if (conn.shape().size() < region.rank)
+        {
+            auto bc = graph.emplace<bitcast>(conn.type(), conn.shape(), expand_rank(conn.shape(), region.rank));
+            bc->name(conn.owner().name() + "/expand_rank");
+            bc->input().connect(conn);
+            src = &bc->output();
+        }
+
+        auto tp = graph.emplace<transpose>(src->type(), src->shape(), perm);
+        tp->name(conn.owner().name() + "/to_layout");
+        tp->input().connect(*src);
+        permuted.emplace(&conn, &tp->output());
+        return tp->output();
+    };
+
+    for (auto old : region.nodes)
+    {
+        std::vector<output_connector *> inputs;
+        for (auto in : old->inputs())
+            inputs.emplace_back(&get_permuted(*in->connection()));
+
+        auto new_node = permute_node(graph, *old, inputs, perm, inv_perm);
+        new_node->name(old->name());
+        for (size_t i = 0; i < inputs.size(); i++)
+            new_node->input_at(i).connect(*inputs[i]);
+        permuted.emplace(&old->output_at(0), &new_node->output_at(0));
+    }
+
+    for (auto old : region.nodes)
+    {
+        auto &old_out = old->output_at(0);
+        std::vector<input_connector *> outside;
+        for (auto in : old_out.connections())
+        {
+            if (!region.members.contains(&in->owner()))
+                outside.emplace_back(in);
+        }
+
+        if (!outside.empty())
+        {
+            auto &new_out = *permuted.at(&old_out);
+            auto tp = graph.emplace<transpose>(new_out.type(), new_out.shape(), inv_perm);
+            tp->name(old->name() + "/from_layout");
+            tp->input().connect(new_out);
+            for (auto in : outside)
+                in->connect(tp->output());
+        }
+    }
+}
+}
+
+void layout_assignment_pass::run_core(graph &graph, [[maybe_unused]] nncase::target &target, [[maybe_unused]] const run_pass_options &options)
+{
+    bool changed = false;
+    for (auto &region : find_regions(graph))
+    {
+        auto candidates = candidate_layouts(region);
+        auto best = &candidates[0];
+        auto best_cost = region_cost(region, *best);
+        for (size_t i = 1; i < candidates.size(); i++)
+        {
+            auto cost = region_cost(region, candidates[i]);
+            if (cost < best_cost)
+            {
+                best = &candidates[i];
+                best_cost = cost;
+            }
+        }
+
+        if (!is_identity(*best))
+        {
+            assign_layout(graph, region, *best);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        graph.dce();
+}
@@ -15,14 +15,15 @@
 #include <nncase/ir/ir_types.h>
 #include <nncase/ir/ops/binary.h>
 #include <nncase/ir/ops/bitcast.h>
-#include <nncase/ir/ops/concat.h>
 #include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/loop.h>
 #include <nncase/ir/ops/lstm.h>
 #include <nncase/ir/ops/matmul.h>
 #include <nncase/ir/ops/pad.h>
 #include <nncase/ir/ops/slice.h>
 #include <nncase/ir/ops/transpose.h>
 #include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
 #include <nncase/ir/visitor.h>
 #include <nncase/transforms/neutral/lstm_transform.h>
 
@@ -30,15 +31,15 @@ using namespace nncase;
 using namespace nncase::ir;
 using namespace nncase::ir::transforms;
 
-output_connector *local_sigmoid(output_connector *x, transform_context &context, std::string i)
+output_connector *local_sigmoid(output_connector *x, graph &graph, std::string i)
 {
     std::vector<float> one_data(xt::compute_size(x->shape()), 1.f);
 
-    auto one = context.graph.emplace<constant>(dt_float32, x->shape(), one_data);
-    auto neg_ = context.graph.emplace<unary>(unary_neg, x->shape());
-    auto exp_ = context.graph.emplace<unary>(unary_exp, neg_->output().shape());
-    auto add_ = context.graph.emplace<binary>(binary_add, exp_->output().shape(), one->output().shape(), value_range<float>::full());
-    auto div_ = context.graph.emplace<binary>(binary_div, one->output().shape(), add_->output().shape(), value_range<float>::full());
+    auto one = graph.emplace<constant>(dt_float32, x->shape(), one_data);
+    auto neg_ = graph.emplace<unary>(unary_neg, x->shape());
+    auto exp_ = graph.emplace<unary>(unary_exp, neg_->output().shape());
+    auto add_ = graph.emplace<binary>(binary_add, exp_->output().shape(), one->output().shape(), value_range<float>::full());
+    auto div_ = graph.emplace<binary>(binary_div, one->output().shape(), add_->output().shape(), value_range<float>::full());
 
     one->name(x->owner().name() + "/sig_one" + i);
     neg_->name(x->owner().name() + "/sig_neg_" + i);
@@ -56,21 +57,21 @@ output_connector *local_sigmoid(output_connector *x, transform_context &context,
     return &div_->output();
 }
 
-output_connector *local_tanh(output_connector *x, transform_context &context, std::string i)
+output_connector *local_tanh(output_connector *x, graph &graph, std::string i)
 {
     std::vector<float> one_data(xt::compute_size(x->shape()), 1.f);
     std::vector<float> two_data(xt::compute_size(x->shape()), 2.f);
 
-    auto two_ = context.graph.emplace<constant>(dt_float32, x->shape(), two_data);
-    auto one_ = context.graph.emplace<constant>(dt_float32, x->shape(), one_data);
-    auto mul_1 = context.graph.emplace<binary>(binary_mul, x->shape(), two_->output().shape(), value_range<float>::full());
+    auto two_ = graph.emplace<constant>(dt_float32, x->shape(), two_data);
+    auto one_ = graph.emplace<constant>(dt_float32, x->shape(), one_data);
+    auto mul_1 = graph.emplace<binary>(binary_mul, x->shape(), two_->output().shape(), value_range<float>::full());
     one_->name(x->owner().name() + "/tanh_one_" + i);
     two_->name(x->owner().name() + "/tanh_two_" + i);
     mul_1->name(x->owner().name() + "/tanh_mul_" + i + "_1");
 
-    auto sigm = local_sigmoid(&mul_1->output(), context, "_tanh_" + i + "_");
-    auto mul_2 = context.graph.emplace<binary>(binary_mul, sigm->shape(), two_->output().shape(), value_range<float>::full());
-    auto sub_ = context.graph.emplace<binary>(binary_sub, mul_2->output().shape(), one_->output().shape(), value_range<float>::full());
+    auto sigm = local_sigmoid(&mul_1->output(), graph, "_tanh_" + i + "_");
+    auto mul_2 = graph.emplace<binary>(binary_mul, sigm->shape(), two_->output().shape(), value_range<float>::full());
+    auto sub_ = graph.emplace<binary>(binary_sub, mul_2->output().shape(), one_->output().shape(), value_range<float>::full());
     mul_2->name(x->owner().name() + "/tanh_mul_" + i + "_2");
     sub_->name(x->owner().name() + "/tanh_sub_" + i);
 
@@ -153,13 +154,11 @@ void lstm_transform::process(transform_context &context)
     auto matmul_wxc = context.graph.emplace<matmul>(bitcast_wxc_pre->output().shape(), tp_wxc->output().shape(), value_range<float>::full());
     auto bitcast_wxc_post = context.graph.emplace<bitcast>(dt_float32, matmul_wxc->output().shape(),
         shape_t { old_lstm.input().shape()[0], old_lstm.input().shape()[1], matmul_wxc->output().shape()[1] });
-    // auto matmul_bxc = context.graph.emplace<binary>(binary_add, matmul_wxc->output().shape(), b_xc.output().shape(), value_range<float>::full());
     bitc_wxc->name(old_lstm.name() + "/bitc_wxc");
     tp_wxc->name(old_lstm.name() + "/tp_wxc");
     bitcast_wxc_pre->name(old_lstm.name() + "/bitcast_wxc_pre");
     matmul_wxc->name(old_lstm.name() + "/matmul_wxc");
     bitcast_wxc_post->name(old_lstm.name() + "/bitcast_wxc_post");
-    // matmul_bxc->name(old_lstm.name() + "/matmul_bxc");
     bitc_wxc->input().connect(w_xc.output());
     tp_wxc->input().connect(bitc_wxc->output());
     bitcast_wxc_pre->input().connect(output);
@@ -167,8 +166,6 @@ void lstm_transform::process(transform_context &context)
     matmul_wxc->input_b().connect(tp_wxc->output());
     matmul_wxc->bias().connect(b_xc.output());
     bitcast_wxc_post->input().connect(matmul_wxc->output());
-    // matmul_bxc->input_a().connect(matmul_wxc->output());
-    // matmul_bxc->input_b().connect(b_xc.output());
 
     //weights bitcast去掉directions
     auto bitc_wrc = context.graph.emplace<bitcast>(dt_float32, w_rc.output().shape(), shape_t { w_rc.output().shape()[1], w_rc.output().shape()[2] });
@@ -179,225 +176,150 @@ void lstm_transform::process(transform_context &context)
     bitc_wrc->input().connect(w_rc.output());
     tp_wrc->input().connect(bitc_wrc->output());
 
-    // if model doesn't has init h&c , init it with zero
-    std::vector<float> constant_data((int)bitcast_wxc_post->output().shape()[1] * (int)bitcast_wxc_post->output().shape()[2] / 4, 0.f);
+    auto seq_len = bitcast_wxc_post->output().shape()[0];
+    auto batch = bitcast_wxc_post->output().shape()[1];
+    auto gates = bitcast_wxc_post->output().shape()[2];
+    auto hidden = gates / 4;
+    shape_t state_shape { 1, batch, hidden };
 
     auto init_h = &static_cast<constant &>(*context.matched_nodes[5]);
     auto init_c = &static_cast<constant &>(*context.matched_nodes[6]);
 
-    auto c_0 = context.graph.emplace<bitcast>(dt_float32, init_c->output().shape(), shape_t { 1, bitcast_wxc_post->output().shape()[1], bitcast_wxc_post->output().shape()[2] / 4 });
-    auto h_0 = context.graph.emplace<bitcast>(dt_float32, init_h->output().shape(), shape_t { 1, bitcast_wxc_post->output().shape()[1], bitcast_wxc_post->output().shape()[2] / 4 });
+    auto c_0 = context.graph.emplace<bitcast>(dt_float32, init_c->output().shape(), state_shape);
+    auto h_0 = context.graph.emplace<bitcast>(dt_float32, init_h->output().shape(), state_shape);
     c_0->name(old_lstm.name() + "_c_0");
     h_0->name(old_lstm.name() + "_h_0");
     c_0->input().connect(init_c->output());
     h_0->input().connect(init_h->output());
-    auto c_ = &c_0->output();
-    auto h_ = &h_0->output();
 
-    std::vector<shape_t> lstm_h_s;
-    for (size_t i = 0; i < (size_t)output.shape()[0]; i++)
+    // x projections of all timesteps are computed at once and scanned by the loop
+    auto x_scan = context.graph.emplace<bitcast>(dt_float32, bitcast_wxc_post->output().shape(), shape_t { seq_len, 1, batch, gates });
+    x_scan->name(old_lstm.name() + "/x_scan");
+    x_scan->input().connect(bitcast_wxc_post->output());
+
+    // caffe resets the states at the first timestep
+    std::vector<float> cont_data(seq_len, 1.f);
+    if (old_lstm.framework() == "caffe")
+        cont_data[0] = 0.f;
+    auto cont_scan = context.graph.emplace<constant>(dt_float32, shape_t { seq_len, 1, 1 }, cont_data);
+    cont_scan->name(old_lstm.name() + "/cont");
+
+    // One timestep body
+    // inputs: h_, c_, w_xc_x, cont_, w_rc^T, b_rc
+    // outputs: h_t, c_t, h_t (scanned)
+    auto &body = context.graph.add_subgraph(std::make_unique<graph>(context.graph.module_type()));
+    body.name(old_lstm.name() + "_step");
+    auto h_ = body.emplace<input_node>(dt_float32, state_shape);
+    auto c_ = body.emplace<input_node>(dt_float32, state_shape);
+    auto w_xc_x = body.emplace<input_node>(dt_float32, shape_t { 1, batch, gates });
+    auto cont_ = body.emplace<input_node>(dt_float32, shape_t { 1, 1 });
+    auto w_rc_t = body.emplace<input_node>(dt_float32, tp_wrc->output().shape());
+    auto b_rc_ = body.emplace<input_node>(dt_float32, b_rc.output().shape());
+    h_->name(old_lstm.name() + "/h_");
+    c_->name(old_lstm.name() + "/c_");
+    w_xc_x->name(old_lstm.name() + "/w_xc_x");
+    cont_->name(old_lstm.name() + "/cont_");
+    w_rc_t->name(old_lstm.name() + "/w_rc_t");
+    b_rc_->name(old_lstm.name() + "/b_rc");
+
+    auto scale_ = body.emplace<binary>(binary_mul, state_shape, cont_->output().shape(), value_range<float>::full());
+    scale_->name(old_lstm.name() + "/scale_");
+    scale_->input_a().connect(h_->output());
+    scale_->input_b().connect(cont_->output());
+
+    //w_rc_h
+    auto bitcast_wrc_pre = body.emplace<bitcast>(dt_float32, scale_->output().shape(), shape_t { batch, hidden });
+    auto w_rc_h = body.emplace<matmul>(bitcast_wrc_pre->output().shape(), w_rc_t->output().shape(), value_range<float>::full());
+    auto bitcast_wrc_post = body.emplace<bitcast>(dt_float32, w_rc_h->output().shape(), shape_t { 1, batch, w_rc_h->output().shape()[1] });
+    bitcast_wrc_pre->name(old_lstm.name() + "/bitcast_wrc_pre");
+    w_rc_h->name(old_lstm.name() + "/w_rc_h");
+    bitcast_wrc_post->name(old_lstm.name() + "/bitcast_wrc_post");
+    bitcast_wrc_pre->input().connect(scale_->output());
+    w_rc_h->input_a().connect(bitcast_wrc_pre->output());
+    w_rc_h->input_b().connect(w_rc_t->output());
+    w_rc_h->bias().connect(b_rc_->output());
+    bitcast_wrc_post->input().connect(w_rc_h->output());
+
+    auto gate_input = body.emplace<binary>(binary_add, w_xc_x->output().shape(), bitcast_wrc_post->output().shape(), value_range<float>::full());
+    gate_input->name(old_lstm.name() + "/gate_input");
+    gate_input->input_a().connect(w_xc_x->output());
+    gate_input->input_b().connect(bitcast_wrc_post->output());
+
+    // lstm_uint: need [c_, gate_input:[in_sigmoid:[i_t,o_t,f_t,g_t], in_tanh[g_t]]] onnx(default)
+    //            need [c_, gate_input:[in_sigmoid:[i_t,f_t,o_t,g_t], in_tanh[g_t]]] caffe
+    auto in_sigmoid = local_sigmoid(&gate_input->output(), body, "");
+    auto in_tanh = local_tanh(&gate_input->output(), body, "");
+    int32_t o_index = old_lstm.framework() == "caffe" ? 2 : 1;
+    int32_t f_index = old_lstm.framework() == "caffe" ? 1 : 2;
+    auto gate = [&](output_connector *src, int32_t index, const std::string &name) {
+        auto s = body.emplace<slice>(src->type(), src->shape(),
+            axis_t { 0, 0, index * (int32_t)hidden }, axis_t { 1, (int32_t)batch, (index + 1) * (int32_t)hidden });
+        s->name(old_lstm.name() + "/" + name);
+        s->input().connect(*src);
+        return s;
+    };
+    auto i_t = gate(in_sigmoid, 0, "i_t");
+    auto o_t = gate(in_sigmoid, o_index, "o_t");
+    auto f_t = gate(in_sigmoid, f_index, "f_t");
+    auto g_t = gate(in_tanh, 3, "g_t");
+
+    //c_t = cont_ * (f * c_) + (i * g)
+    auto f_c_mul = body.emplace<binary>(binary_mul, state_shape, f_t->output().shape(), value_range<float>::full());
+    f_c_mul->name(old_lstm.name() + "/f_c_mul");
+    f_c_mul->input_a().connect(c_->output());
+    f_c_mul->input_b().connect(f_t->output());
+
+    auto c_f_c_mul = body.emplace<binary>(binary_mul, cont_->output().shape(), f_c_mul->output().shape(), value_range<float>::full());
+    c_f_c_mul->name(old_lstm.name() + "/c_f_c_mul");
+    c_f_c_mul->input_a().connect(cont_->output());
+    c_f_c_mul->input_b().connect(f_c_mul->output());
+
+    auto i_g_mul = body.emplace<binary>(binary_mul, i_t->output().shape(), g_t->output().shape(), value_range<float>::full());
+    i_g_mul->name(old_lstm.name() + "/i_g_mul");
+    i_g_mul->input_a().connect(i_t->output());
+    i_g_mul->input_b().connect(g_t->output());
+
+    auto c_t = body.emplace<binary>(binary_add, c_f_c_mul->output().shape(), i_g_mul->output().shape(), value_range<float>::full());
+    c_t->name(old_lstm.name() + "/c_t");
+    c_t->input_a().connect(c_f_c_mul->output());
+    c_t->input_b().connect(i_g_mul->output());
+
+    //h_t = o_t * tanh(c_t)
+    auto tanh_c_t = local_tanh(&c_t->output(), body, "");
+    auto h_t = body.emplace<binary>(binary_mul, o_t->output().shape(), tanh_c_t->shape(), value_range<float>::full());
+    h_t->name(old_lstm.name() + "/h_t");
+    h_t->input_a().connect(o_t->output());
+    h_t->input_b().connect(*tanh_c_t);
+
+    auto h_out = body.emplace<output_node>(dt_float32, state_shape);
+    auto c_out = body.emplace<output_node>(dt_float32, state_shape);
+    auto h_scan_out = body.emplace<output_node>(dt_float32, state_shape);
+    h_out->name(old_lstm.name() + "/h_t_out");
+    c_out->name(old_lstm.name() + "/c_t_out");
+    h_scan_out->name(old_lstm.name() + "/h_t_scan");
+    h_out->input().connect(h_t->output());
+    c_out->input().connect(c_t->output());
+    h_scan_out->input().connect(h_t->output());
+
+    auto lp = context.graph.emplace<loop>(body, 2, 2, seq_len);
+    lp->name(old_lstm.name() + "/loop");
+    lp->initial_state(0).connect(h_0->output());
+    lp->initial_state(1).connect(c_0->output());
+    lp->scan_input(0).connect(x_scan->output());
+    lp->scan_input(1).connect(cont_scan->output());
+    lp->invariant(0).connect(tp_wrc->output());
+    lp->invariant(1).connect(b_rc.output());
+    for (size_t i = 0; i < 2; i++)
     {
-        lstm_h_s.push_back(h_0->output().shape());
+        auto carry = context.graph.emplace<uninitialized>(dt_float32, state_shape);
+        carry->name(old_lstm.name() + "/carry_" + std::to_string(i));
+        lp->carry(i).connect(carry->output());
     }
+
     //h_concat
-    auto h_concat = context.graph.emplace<concat>(dt_float32, lstm_h_s, 0);
+    auto h_concat = context.graph.emplace<bitcast>(dt_float32, lp->scan_output(0).shape(), shape_t { seq_len, batch, hidden });
     h_concat->name(old_lstm.name() + "/h_concat");
-
-    // 0 constant for matmul
-    // std::vector<float> zero(tp_wrc->output().shape()[1], 0.f);
-    // auto zero_constant = context.graph.emplace<constant>(dt_float32, shape_t { tp_wrc->output().shape()[1] }, zero);
-
-    for (size_t i = 0; i < (size_t)(bitcast_wxc_post->output().shape()[0]); i++)
-    {
-        std::vector<float> cont_data((int)bitcast_wxc_post->output().shape()[1], (i == 0) ? (old_lstm.framework() == "caffe" ? 0.f : 1.f) : 1.f);
-        auto cont_ = context.graph.emplace<constant>(dt_float32, shape_t { 1, 1 }, cont_data);
-        cont_->name(old_lstm.name() + "/cont_" + std::to_string(i));
-
-        //slice
-        auto scale_ = context.graph.emplace<binary>(binary_mul, h_->shape(), cont_->output().shape(), value_range<float>::full());
-        scale_->name(old_lstm.name() + "/scale_" + std::to_string(i));
-        scale_->input_a().connect(*h_);
-        scale_->input_b().connect(cont_->output());
-
-        //w_rc_h
-        auto bitcast_wrc_pre = context.graph.emplace<bitcast>(dt_float32, scale_->output().shape(),
-            shape_t { scale_->output().shape()[0] * scale_->output().shape()[1], scale_->output().shape()[2] });
-        auto w_rc_h = context.graph.emplace<matmul>(bitcast_wrc_pre->output().shape(), tp_wrc->output().shape(), value_range<float>::full());
-        auto bitcast_wrc_post = context.graph.emplace<bitcast>(dt_float32, w_rc_h->output().shape(),
-            shape_t { scale_->output().shape()[0], scale_->output().shape()[1], w_rc_h->output().shape()[1] });
-
-        bitcast_wrc_pre->name(old_lstm.name() + "/bitcast_wrc_pre" + std::to_string(i));
-        w_rc_h->name(old_lstm.name() + "/w_rc_h_" + std::to_string(i));
-        bitcast_wrc_post->name(old_lstm.name() + "/bitcast_wrc_post" + std::to_string(i));
-
-        bitcast_wrc_pre->input().connect(scale_->output());
-        w_rc_h->input_a().connect(bitcast_wrc_pre->output());
-        w_rc_h->input_b().connect(tp_wrc->output());
-        w_rc_h->bias().connect(b_rc.output());
-        bitcast_wrc_post->input().connect(w_rc_h->output());
-
-        //slice w_xc_x
-        auto w_xc_x = context.graph.emplace<slice>(bitcast_wxc_post->output().type(), bitcast_wxc_post->output().shape(),
-            axis_t { (int32_t)i, 0, 0 }, axis_t { (int32_t)i + 1, (int32_t)bitcast_wxc_post->output().shape()[1], (int32_t)bitcast_wxc_post->output().shape()[2] });
-        w_xc_x->name(old_lstm.name() + "/w_xc_x_" + std::to_string(i));
-        w_xc_x->input().connect(bitcast_wxc_post->output());
-
-        auto gate_input = context.graph.emplace<binary>(binary_add, w_xc_x->output().shape(), bitcast_wrc_post->output().shape(), value_range<float>::full());
-        gate_input->name(old_lstm.name() + "/gate_input_" + std::to_string(i));
-        gate_input->input_a().connect(w_xc_x->output());
-        gate_input->input_b().connect(bitcast_wrc_post->output());
-
-        // lstm_uint: need [c_, gate_input:[in_sigmoid:[i_t,o_t,f_t,g_t], in_tanh[g_t]]] onnx(default)
-        //            need [c_, gate_input:[in_sigmoid:[i_t,f_t,o_t,g_t], in_tanh[g_t]]] caffe
-        // transpose the source of gate data
-        auto gate_output_ptr = &gate_input->output();
-        if (old_lstm.framework() == "caffe")
-        {
-            // std::vector<shape_t> suit_for_framework;
-            // std::vector<int32_t> caffe_sequence { 0, 2, 1, 3 };
-            // for (size_t index = 0; index < 4; index++)
-            // {
-            //     suit_for_framework.push_back(shape_t { (size_t)gate_input->output().shape()[0], (size_t)gate_input->output().shape()[1], (size_t)c_->shape()[2] });
-            // }
-            // auto framework_concat = context.graph.emplace<concat>(dt_float32, suit_for_framework, 2);
-            // framework_concat->name(old_lstm.name() + "/fit_framework_concat");
-            // for (auto index : caffe_sequence)
-            // {
-            //     auto slice_gate_output = context.graph.emplace<slice>(dt_float32, gate_input->output().shape(),
-            //         axis_t { 0, 0, index * (int32_t)c_->shape()[2] },
-            //         axis_t { (int32_t)gate_input->output().shape()[0], (int32_t)gate_input->output().shape()[1], (index + 1) * (int32_t)c_->shape()[2] });
-            //     slice_gate_output->name(old_lstm.name() + "/slice_gate");
-            //     slice_gate_output->input().connect(*gate_output_ptr);
-            //     framework_concat->input_at(index).connect(slice_gate_output->output());
-            // }
-            // gate_output_ptr = &framework_concat->output();
-            // get gate_output
-            auto in_sigmoid = local_sigmoid(gate_output_ptr, context, std::to_string(i));
-            auto in_tanh = local_tanh(gate_output_ptr, context, std::to_string(i));
-
-            // slice the in_sidmoid into i_t, f_t, o_t, g_t
-            // i_t
-            auto i_t = context.graph.emplace<slice>(in_sigmoid->type(), in_sigmoid->shape(),
-                axis_t { 0, 0, 0 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], (int32_t)c_->shape()[2] });
-            i_t->name(old_lstm.name() + "/i_t_" + std::to_string(i));
-            i_t->input().connect(*in_sigmoid);
-
-            // o_t
-            auto o_t = context.graph.emplace<slice>(in_sigmoid->type(), in_sigmoid->shape(),
-                axis_t { 0, 0, 2 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], 3 * (int32_t)c_->shape()[2] });
-            o_t->name(old_lstm.name() + "/o_t_" + std::to_string(i));
-            o_t->input().connect(*in_sigmoid);
-
-            // f_t
-            auto f_t = context.graph.emplace<slice>(in_sigmoid->type(), in_sigmoid->shape(),
-                axis_t { 0, 0, 1 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], 2 * (int32_t)c_->shape()[2] });
-            f_t->name(old_lstm.name() + "/f_t_" + std::to_string(i));
-            f_t->input().connect(*in_sigmoid);
-
-            // g_t
-            auto g_t = context.graph.emplace<slice>(in_tanh->type(), in_tanh->shape(),
-                axis_t { 0, 0, 3 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], 4 * (int32_t)c_->shape()[2] });
-            g_t->name(old_lstm.name() + "/g_t_" + std::to_string(i));
-            g_t->input().connect(*in_tanh);
-
-            //c_t = cont_ * (f * c_) + (i * g)
-            auto f_c_mul = context.graph.emplace<binary>(binary_mul, c_->shape(), f_t->output().shape(), value_range<float>::full());
-            f_c_mul->name(old_lstm.name() + "/f_c_mul_" + std::to_string(i));
-            f_c_mul->input_a().connect(*c_);
-            f_c_mul->input_b().connect(f_t->output());
-
-            auto c_f_c_mul = context.graph.emplace<binary>(binary_mul, cont_->output().shape(), f_c_mul->output().shape(), value_range<float>::full());
-            c_f_c_mul->name(old_lstm.name() + "/c_f_c_mul_" + std::to_string(i));
-            c_f_c_mul->input_a().connect(cont_->output());
-            c_f_c_mul->input_b().connect(f_c_mul->output());
-
-            auto i_g_mul = context.graph.emplace<binary>(binary_mul, i_t->output().shape(), g_t->output().shape(), value_range<float>::full());
-            i_g_mul->name(old_lstm.name() + "/i_g_mul_" + std::to_string(i));
-            i_g_mul->input_a().connect(i_t->output());
-            i_g_mul->input_b().connect(g_t->output());
-
-            auto c_t = context.graph.emplace<binary>(binary_add, c_f_c_mul->output().shape(), i_g_mul->output().shape(), value_range<float>::full());
-            c_t->name(old_lstm.name() + "/c_t_" + std::to_string(i));
-            c_t->input_a().connect(c_f_c_mul->output());
-            c_t->input_b().connect(i_g_mul->output());
-
-            //h_t = o_t * tanh(c_t)
-            auto tanh_c_t = local_tanh(&c_t->output(), context, std::to_string(i));
-            auto h_t = context.graph.emplace<binary>(binary_mul, o_t->output().shape(), tanh_c_t->shape(), value_range<float>::full());
-            h_t->name(old_lstm.name() + "/h_t_" + std::to_string(i));
-            h_t->input_a().connect(o_t->output());
-            h_t->input_b().connect(*tanh_c_t);
-
-            h_concat->input_at(i).connect(h_t->output());
-            // update c_, h_
-            c_ = &c_t->output();
-            h_ = &h_t->output();
-        }
-        else
-        {
-            // get gate_output
-            auto in_sigmoid = local_sigmoid(gate_output_ptr, context, std::to_string(i));
-            auto in_tanh = local_tanh(gate_output_ptr, context, std::to_string(i));
-
-            // slice the in_sidmoid into i_t, o_t, f_t, g_t
-            // i_t
-            auto i_t = context.graph.emplace<slice>(in_sigmoid->type(), in_sigmoid->shape(),
-                axis_t { 0, 0, 0 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], (int32_t)c_->shape()[2] });
-            i_t->name(old_lstm.name() + "/i_t_" + std::to_string(i));
-            i_t->input().connect(*in_sigmoid);
-
-            // o_t
-            auto o_t = context.graph.emplace<slice>(in_sigmoid->type(), in_sigmoid->shape(),
-                axis_t { 0, 0, 1 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], 2 * (int32_t)c_->shape()[2] });
-            o_t->name(old_lstm.name() + "/o_t_" + std::to_string(i));
-            o_t->input().connect(*in_sigmoid);
-
-            // f_t
-            auto f_t = context.graph.emplace<slice>(in_sigmoid->type(), in_sigmoid->shape(),
-                axis_t { 0, 0, 2 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], 3 * (int32_t)c_->shape()[2] });
-            f_t->name(old_lstm.name() + "/f_t_" + std::to_string(i));
-            f_t->input().connect(*in_sigmoid);
-
-            // g_t
-            auto g_t = context.graph.emplace<slice>(in_tanh->type(), in_tanh->shape(),
-                axis_t { 0, 0, 3 * (int32_t)c_->shape()[2] }, axis_t { (int32_t)in_sigmoid->shape()[0], (int32_t)in_sigmoid->shape()[1], 4 * (int32_t)c_->shape()[2] });
-            g_t->name(old_lstm.name() + "/g_t_" + std::to_string(i));
-            g_t->input().connect(*in_tanh);
-
-            //c_t = cont_ * (f * c_) + (i * g)
-            auto f_c_mul = context.graph.emplace<binary>(binary_mul, c_->shape(), f_t->output().shape(), value_range<float>::full());
-            f_c_mul->name(old_lstm.name() + "/f_c_mul_" + std::to_string(i));
-            f_c_mul->input_a().connect(*c_);
-            f_c_mul->input_b().connect(f_t->output());
-
-            auto c_f_c_mul = context.graph.emplace<binary>(binary_mul, cont_->output().shape(), f_c_mul->output().shape(), value_range<float>::full());
-            c_f_c_mul->name(old_lstm.name() + "/c_f_c_mul_" + std::to_string(i));
-            c_f_c_mul->input_a().connect(cont_->output());
-            c_f_c_mul->input_b().connect(f_c_mul->output());
-
-            auto i_g_mul = context.graph.emplace<binary>(binary_mul, i_t->output().shape(), g_t->output().shape(), value_range<float>::full());
-            i_g_mul->name(old_lstm.name() + "/i_g_mul_" + std::to_string(i));
-            i_g_mul->input_a().connect(i_t->output());
-            i_g_mul->input_b().connect(g_t->output());
-
-            auto c_t = context.graph.emplace<binary>(binary_add, c_f_c_mul->output().shape(), i_g_mul->output().shape(), value_range<float>::full());
-            c_t->name(old_lstm.name() + "/c_t_" + std::to_string(i));
-            c_t->input_a().connect(c_f_c_mul->output());
-            c_t->input_b().connect(i_g_mul->output());
-
-            //h_t = o_t * tanh(c_t)
-            auto tanh_c_t = local_tanh(&c_t->output(), context, std::to_string(i));
-            auto h_t = context.graph.emplace<binary>(binary_mul, o_t->output().shape(), tanh_c_t->shape(), value_range<float>::full());
-            h_t->name(old_lstm.name() + "/h_t_" + std::to_string(i));
-            h_t->input_a().connect(o_t->output());
-            h_t->input_b().connect(*tanh_c_t);
-
-            h_concat->input_at(i).connect(h_t->output());
-            // update c_, h_
-            c_ = &c_t->output();
-            h_ = &h_t->output();
-        }
-    }
+    h_concat->input().connect(lp->scan_output(0));
 
     for (auto &in : dup(inputs))
         in->connect(h_concat->output());
@@ -18,14 +18,44 @@
 #include <nncase/ir/ops/copy.h>
 #include <nncase/ir/ops/slice.h>
 #include <nncase/ir/visitor.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
 #include <nncase/schedule/scheduler.h>
 #include <nncase/transforms/neutral/optimize_allocation.h>
+#include <unordered_set>
 
 using namespace nncase;
 using namespace nncase::ir;
 using namespace nncase::ir::transforms;
 using namespace nncase::schedule;
 
+namespace
+{
+// Stackvm kernels of these ops take separate input and output strides
+bool accepts_strided_view(node &node)
+{
+    static const std::unordered_set<node_opcode> opcodes {
+        op_batch_to_space, op_binary, op_broadcast, op_conv2d, op_conv2d_pool, op_convert, op_copy, op_dequantize, op_gather, op_gather_nd,
+        op_pad, op_quantize, op_reduce, op_reduce_arg, op_reduce_prod, op_reduce_window2d, op_resize_image, op_slice,
+        op_table_lookup1d, op_ternary, op_transpose, op_unary
+    };
+
+    return node.module_type() == runtime::stackvm::stackvm_module_type
+        && (node.attributes() & node_attr_action)
+        && opcodes.contains(node.runtime_opcode());
+}
+
+bool accepts_strided_output(output_connector &output, node &exclude)
+{
+    if ((output.attributes() & cnctr_attr_no_layout_strides) || !accepts_strided_view(output.owner()))
+        return false;
+
+    auto consumers = output.connections();
+    return std::all_of(consumers.begin(), consumers.end(), [&](input_connector *in) {
+        return &in->owner() == &exclude || accepts_strided_view(in->owner());
+    });
+}
+}
+
 void make_concat_no_action_pass::run_core(graph &graph, [[maybe_unused]] nncase::target &target, [[maybe_unused]] const run_pass_options &options)
 {
     auto alias_visitor = make_relay_ir_visitor([&](node &node) {
@@ -119,6 +149,37 @@ void add_copy_to_slice_pass::run_core(graph &graph, [[maybe_unused]] nncase::tar
     alias_visitor.visit(graph);
 }
 
+void make_slice_view_pass::run_core(graph &graph, [[maybe_unused]] nncase::target &target, [[maybe_unused]] const run_pass_options &options)
+{
+    auto alias_visitor = make_relay_ir_visitor([&](node &node) {
+        slice *s;
+        if ((s = node_cast<slice>(node))
+            && (s->attributes() & node_attr_action)
+            && s->module_type() == runtime::stackvm::stackvm_module_type
+            && !s->begin_mask() && !s->end_mask() && !s->ellipsis_mask() && !s->new_axis_mask()
+            && std::all_of(s->begin().begin(), s->begin().end(), [](int32_t begin) { return begin >= 0; })
+            && std::all_of(s->strides().begin(), s->strides().end(), [](int32_t stride) { return stride == 1; }))
+        {
+            auto &input = *s->input().connection();
+            auto &output = s->output();
+            auto siblings = input.connections();
+            auto consumers = output.connections();
+
+            // The view borrows the input's strides, so the input must keep its own layout
+            if ((input.attributes() & cnctr_attr_buffer_slice)
+                || std::any_of(siblings.begin(), siblings.end(), [](input_connector *in) { return in->owner().runtime_opcode() == op_concat; })
+                || consumers.empty()
+                || !std::all_of(consumers.begin(), consumers.end(), [](input_connector *in) { return accepts_strided_view(in->owner()); }))
+                return;
+
+            input.attributes(input.attributes() | cnctr_attr_no_buffer_fusion);
+            output.attributes(output.attributes() | cnctr_attr_buffer_slice | cnctr_attr_no_buffer_fusion);
+            s->attributes(s->attributes() & ~node_attr_action);
+        }
+    });
+    alias_visitor.visit(graph);
+}
+
 void add_copy_to_output_pass::run_core(graph &graph, [[maybe_unused]] nncase::target &target, [[maybe_unused]] const run_pass_options &options)
 {
     auto alias_visitor = make_relay_ir_visitor([&](node &node) {
@@ -197,9 +258,10 @@ bool remove_exclusive_copy_to_concat_transform::on_try_match(node &node, transfo
 
         auto c_inputs = c->inputs();
         auto is_simple_concat = (c->axis() == 0 || std::all_of(c_inputs[0]->shape().begin(), c_inputs[0]->shape().begin() + c->axis(), [](size_t dim) { return dim == 1; }));
+        // Non-simple concats need the producer to write through a strided view
         if (input->memory_location() == mem_data
             && ((input->attributes() & (cnctr_attr_no_buffer_fusion | cnctr_attr_buffer_slice)) == 0)
-            && is_simple_concat)
+            && (is_simple_concat || accepts_strided_output(*input, *cp)))
         {
             context.inputs.emplace_back(&cp->input());
             context.outputs.emplace_back(&cp->output());
@@ -285,7 +347,7 @@ void alias_bitcast_buffer_pass::run_core(graph &graph, [[maybe_unused]] nncase::
                 }
                 else
                 {
-                    assert(in_buf.memory_location() == mem_data);
+                    assert(in_buf.memory_location() == mem_data || in_buf.memory_location() == mem_shared_data);
 
                     // owner transfered to output
                     in_buf.parent() = { &out_buf, offset, b->output().shape() };
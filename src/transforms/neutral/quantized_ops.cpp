@@ -0,0 +1,241 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/ops/quantized_binary.h>
+#include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/ops/resize_image.h>
+#include <nncase/ir/quantizer.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/transforms/neutral/quantized_ops.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+bool is_quantizable(node &node)
+{
+    for (auto in : node.inputs())
+    {
+        if (in->type() != dt_float32 || !(in->connection()->attributes() & cnctr_attr_need_quantize))
+            return false;
+    }
+
+    for (auto out : node.outputs())
+    {
+        if (out->type() != dt_float32 || !(out->attributes() & cnctr_attr_need_quantize))
+            return false;
+    }
+
+    return !node.inputs().empty();
+}
+
+void match_node(node &node, transform_context &context)
+{
+    for (auto in : node.inputs())
+        context.inputs.emplace_back(in);
+    context.outputs.emplace_back(&node.output_at(0));
+    context.matched_nodes.emplace_back(&node);
+}
+
+quant_param_t get_quant_param(quantizer &quantizer, output_connector &conn, datatype_t quant_type)
+{
+    auto mode = quant_type == dt_int8 ? quantizer::quant_mode::signed_asymmetric_mode : quantizer::quant_mode::unsigned_mode;
+    return quantizer.get_quant_param(quantizer.get(conn), 8, mode);
+}
+
+quantize *quantize_input(transform_context &context, output_connector &output, datatype_t quant_type, const quant_param_t &param)
+{
+    auto q = context.graph.emplace<quantize>(output.type(), output.shape(), quant_type, param);
+    q->name(output.owner().name() + "/quantize");
+    q->input().connect(output);
+    return q;
+}
+
+// Replace the float output of old_node with a dequantize of new_output
+void dequantize_output(transform_context &context, node &old_node, output_connector &new_output, const quant_param_t &param)
+{
+    auto inputs = context.outputs[0]->connections();
+    auto &old_output = old_node.output_at(0);
+
+    auto deq = context.graph.emplace<dequantize>(new_output.type(), new_output.shape(), old_output.type(), param);
+    deq->record_output_connectors_quant_map(deq->output_at(0), old_output);
+    deq->record_node_name_before_quant(old_node.name());
+    deq->name(old_node.name() + "/dequantize");
+    link(old_output, deq->output(), context.quantizer);
+    deq->input().connect(new_output);
+
+    for (auto &in : dup(inputs))
+        in->connect(deq->output());
+}
+
+value_range<float> quantize_activation(value_range<float> activation, const quant_param_t &param)
+{
+    return { activation.min / param.scale + param.zero_point, activation.max / param.scale + param.zero_point };
+}
+}
+
+bool quantized_binary_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto b = node_cast<binary>(node))
+    {
+        switch (b->binary_op())
+        {
+        case binary_add:
+        case binary_sub:
+        case binary_mul:
+        case binary_min:
+        case binary_max:
+            if (is_quantizable(*b))
+            {
+                match_node(*b, context);
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+void quantized_binary_transform::process(transform_context &context)
+{
+    auto &output_a = *context.inputs[0]->connection();
+    auto &output_b = *context.inputs[1]->connection();
+    auto &old_b = static_cast<binary &>(*context.matched_nodes[0]);
+
+    auto &quantizer = *context.quantizer;
+    auto a_p = get_quant_param(quantizer, output_a, quant_type_);
+    auto b_p = get_quant_param(quantizer, output_b, quant_type_);
+    auto o_p = get_quant_param(quantizer, old_b.output(), quant_type_);
+
+    auto q_a = quantize_input(context, output_a, quant_type_, a_p);
+    auto q_b = quantize_input(context, output_b, quant_type_, b_p);
+    auto qb = context.graph.emplace<quantized_binary>(old_b.binary_op(), quant_type_, output_a.shape(), output_b.shape(),
+        a_p, b_p, o_p, old_b.fused_activation());
+    qb->name(old_b.name());
+    qb->input_a().connect(q_a->output());
+    qb->input_b().connect(q_b->output());
+
+    dequantize_output(context, old_b, qb->output(), o_p);
+}
+
+bool quantized_reduce_window2d_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto r = node_cast<reduce_window2d>(node))
+    {
+        // Sum isn't invariant to the zero point, so it stays in float
+        if ((r->reduce_op() == reduce_mean || r->reduce_op() == reduce_min || r->reduce_op() == reduce_max)
+            && is_quantizable(*r))
+        {
+            match_node(*r, context);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void quantized_reduce_window2d_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &old_r = static_cast<reduce_window2d &>(*context.matched_nodes[0]);
+
+    // reduce_window2d broadcasts its input range, so both sides share one param
+    auto p = get_quant_param(*context.quantizer, output, quant_type_);
+    auto q = quantize_input(context, output, quant_type_, p);
+    auto r = context.graph.emplace<reduce_window2d>(quant_type_, old_r.reduce_op(), output.shape(), old_r.init_value(),
+        old_r.filter_h(), old_r.filter_w(), old_r.padding_h(), old_r.padding_w(), old_r.stride_h(), old_r.stride_w(),
+        old_r.dilation_h(), old_r.dilation_w(), quantize_activation(old_r.fused_activation(), p), old_r.ceil_mode(),
+        old_r.count_include_pad(), old_r.padding_h_w_after(), old_r.strict_inside_input());
+    r->name(old_r.name());
+    r->input().connect(q->output());
+
+    dequantize_output(context, old_r, r->output(), p);
+}
+
+bool quantized_resize_image_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto r = node_cast<resize_image>(node))
+    {
+        if (is_quantizable(*r))
+        {
+            match_node(*r, context);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void quantized_resize_image_transform::process(transform_context &context)
+{
+    auto &output = *context.inputs[0]->connection();
+    auto &old_r = static_cast<resize_image &>(*context.matched_nodes[0]);
+
+    // Interpolation is affine, so the input param carries over to the output
+    auto p = get_quant_param(*context.quantizer, output, quant_type_);
+    auto q = quantize_input(context, output, quant_type_, p);
+    auto r = context.graph.emplace<resize_image>(quant_type_, old_r.mode(), output.shape(), old_r.new_size(),
+        old_r.align_corners(), old_r.half_pixel_centers());
+    r->name(old_r.name());
+    r->input().connect(q->output());
+
+    dequantize_output(context, old_r, r->output(), p);
+}
+
+bool quantized_concat_transform::on_try_match(node &node, transform_context &context)
+{
+    if (auto c = node_cast<concat>(node))
+    {
+        if (is_quantizable(*c))
+        {
+            match_node(*c, context);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void quantized_concat_transform::process(transform_context &context)
+{
+    auto &old_c = static_cast<concat &>(*context.matched_nodes[0]);
+
+    // Every input is quantized with the output param; inputs whose own range differs
+    // end up as dequantize -> quantize pairs that fold_requantize turns into a lut.
+    auto p = get_quant_param(*context.quantizer, old_c.output(), quant_type_);
+    std::vector<shape_t> input_shapes;
+    std::vector<quantize *> quantizes;
+    for (size_t i = 0; i < old_c.inputs().size(); i++)
+    {
+        auto &output = *context.inputs[i]->connection();
+        input_shapes.emplace_back(output.shape());
+        quantizes.emplace_back(quantize_input(context, output, quant_type_, p));
+    }
+
+    auto c = context.graph.emplace<concat>(quant_type_, input_shapes, old_c.axis());
+    c->name(old_c.name());
+    for (size_t i = 0; i < quantizes.size(); i++)
+        c->input_at(i).connect(quantizes[i]->output());
+
+    dequantize_output(context, old_c, c->output(), p);
+}
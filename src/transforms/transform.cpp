@@ -73,6 +73,8 @@ bool transform::skip_self_contained_check() const noexcept
 void nncase::ir::transforms::link(ir::output_connector &old_c, ir::output_connector &new_c, [[maybe_unused]] ir::quantizer *quantizer)
 {
     new_c.attributes(old_c.attributes());
+    if (!new_c.quant_range())
+        new_c.quant_range(old_c.quant_range());
 
     if (old_c.attributes() & ir::cnctr_attr_need_quantize && quantizer)
         quantizer->set(new_c, quantizer->get(old_c));
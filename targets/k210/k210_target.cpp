@@ -25,6 +25,7 @@
 #include <nncase/transforms/k210/fuse_kpu_download.h>
 #include <nncase/transforms/k210/fused_unary_motion.h>
 #include <nncase/transforms/k210/kpu_conv2d.h>
+#include <nncase/transforms/k210/kpu_conv2d_tiling.h>
 #include <nncase/transforms/k210/strided_slice_motion.h>
 #include <nncase/transforms/neutral/add_quant_checkpoints.h>
 #include <nncase/transforms/neutral/add_to_conv2d.h>
@@ -73,7 +74,7 @@ void k210_target::register_allocators(const module_type_t &type, allocator_map_t
         allocators.emplace(mem_input, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
         allocators.emplace(mem_output, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
         allocators.emplace(mem_rdata, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
-        allocators.emplace(mem_data, allocator_holders.emplace_back(std::make_shared<linear_buffer_allocator>()).get());
+        allocators.emplace(mem_data, allocator_holders.emplace_back(std::make_shared<best_fit_allocator>()).get());
         allocators.emplace(runtime::k210::mem_kpu, allocator_holders.emplace_back(std::make_shared<kpu_buffer_allocator>()).get());
     }
     else
@@ -82,6 +83,11 @@ void k210_target::register_allocators(const module_type_t &type, allocator_map_t
     }
 }
 
+bool k210_target::supports_shared_data(const module_type_t &type)
+{
+    return type == runtime::k210::k210_module_type || neutral_target::supports_shared_data(type);
+}
+
 void k210_target::register_evaluator_ops()
 {
     neutral_target::register_evaluator_ops();
@@ -116,6 +122,12 @@ void k210_target::register_quantize_annotation_passes(const module_type_t &type,
         pass_mgr.add_pass(std::move(p));
     }
 
+    {
+        transform_pass p("tile_kpu_conv2d");
+        p.emplace<kpu_conv2d_tiling_transform>();
+        pass_mgr.add_pass(std::move(p));
+    }
+
     neutral_target::register_quantize_annotation_passes(type, pass_mgr);
 
     {
@@ -0,0 +1,96 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import onnx
+from onnx import helper
+from onnx import TensorProto
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_shape, trip_count, with_cond):
+    # body: state_out = state_in * 0.5 + x, scan_out = tanh(state_out), iter_num is unused
+    iter_num = helper.make_tensor_value_info('iter_num', TensorProto.INT64, [])
+    cond_in = helper.make_tensor_value_info('cond_in', TensorProto.BOOL, [])
+    state_in = helper.make_tensor_value_info('state_in', TensorProto.FLOAT, in_shape)
+    cond_out = helper.make_tensor_value_info('cond_out', TensorProto.BOOL, [])
+    state_out = helper.make_tensor_value_info('state_out', TensorProto.FLOAT, in_shape)
+    scan_out = helper.make_tensor_value_info('scan_out', TensorProto.FLOAT, in_shape)
+    half = helper.make_tensor('half', TensorProto.FLOAT, dims=[1], vals=[0.5])
+    body_nodes = [
+        helper.make_node('Identity', ['cond_in'], ['cond_out']),
+        helper.make_node('Mul', ['state_in', 'half'], ['decay']),
+        helper.make_node('Add', ['decay', 'x'], ['state_out']),
+        helper.make_node('Tanh', ['state_out'], ['scan_out']),
+    ]
+    body = helper.make_graph(body_nodes, 'loop_body', [iter_num, cond_in, state_in],
+                             [cond_out, state_out, scan_out], initializer=[half])
+
+    initial = helper.make_tensor_value_info('initial', TensorProto.FLOAT, in_shape)
+    x = helper.make_tensor_value_info('x', TensorProto.FLOAT, in_shape)
+    final = helper.make_tensor_value_info('final', TensorProto.FLOAT, in_shape)
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, [trip_count] + in_shape)
+    initializers = [helper.make_tensor('trip_count', TensorProto.INT64, dims=[], vals=[trip_count])]
+    if with_cond:
+        initializers.append(helper.make_tensor('cond', TensorProto.BOOL, dims=[], vals=[True]))
+
+    node = onnx.helper.make_node(
+        'Loop',
+        inputs=['trip_count', 'cond' if with_cond else '', 'initial'],
+        outputs=['final', 'output'],
+        body=body
+    )
+
+    graph_def = helper.make_graph(
+        [node],
+        'test-model',
+        [initial, x],
+        [final, output],
+        initializer=initializers)
+
+    model_def = helper.make_model(graph_def, producer_name='kendryte')
+
+    return model_def
+
+
+in_shapes = [
+    [1, 3, 4],
+    [16, 32]
+]
+
+trip_counts = [
+    1,
+    5
+]
+
+with_conds = [
+    False,
+    True
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('trip_count', trip_counts)
+@pytest.mark.parametrize('with_cond', with_conds)
+def test_loop(in_shape, trip_count, with_cond, request):
+    model_def = _make_module(in_shape, trip_count, with_cond)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_onnx_helper(model_def)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_loop.py'])
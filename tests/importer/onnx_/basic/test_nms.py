@@ -0,0 +1,114 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import onnx
+import numpy as np
+from onnx import helper
+from onnx import TensorProto, numpy_helper
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_boxes(batch, center_point_box):
+    # A 4x4 grid of boxes, each with a shifted twin it overlaps with IoU ~0.8. Every class keeps
+    # at least 16 boxes, so selected_indices has no padding rows and matches onnx's dynamic shape.
+    boxes = []
+    for y in range(4):
+        for x in range(4):
+            for shift in [0., 0.5]:
+                x1, y1 = x * 10. + shift, y * 10. + shift
+                if center_point_box:
+                    boxes.append([x1 + 4., y1 + 4., 8., 8.])
+                else:
+                    boxes.append([y1, x1, y1 + 8., x1 + 8.])
+    return np.tile(np.array(boxes, dtype=np.float32), (batch, 1, 1))
+
+
+def _make_module(batch, classes, max_output_boxes_per_class, center_point_box, score_threshold):
+    boxes = _make_boxes(batch, center_point_box)
+    spatial = boxes.shape[1]
+    initializers = [
+        numpy_helper.from_array(boxes, 'boxes'),
+        helper.make_tensor('max_output_boxes_per_class', TensorProto.INT64, dims=[1], vals=[max_output_boxes_per_class]),
+        helper.make_tensor('iou_threshold', TensorProto.FLOAT, dims=[1], vals=[0.5])
+    ]
+    inputs = ['boxes', 'scores', 'max_output_boxes_per_class', 'iou_threshold']
+    if score_threshold is not None:
+        initializers.append(helper.make_tensor('score_threshold', TensorProto.FLOAT, dims=[1], vals=[score_threshold]))
+        inputs.append('score_threshold')
+
+    scores = helper.make_tensor_value_info('scores', TensorProto.FLOAT, [batch, classes, spatial])
+    output = helper.make_tensor_value_info('output', TensorProto.INT64, [batch * classes * max_output_boxes_per_class, 3])
+
+    node = onnx.helper.make_node(
+        'NonMaxSuppression',
+        inputs=inputs,
+        outputs=['output'],
+        center_point_box=int(center_point_box)
+    )
+
+    graph_def = helper.make_graph(
+        [node],
+        'test-model',
+        [scores],
+        [output],
+        initializer=initializers)
+
+    model_def = helper.make_model(graph_def, producer_name='kendryte')
+
+    return model_def
+
+
+batches = [
+    1,
+    2
+]
+
+classes = [
+    1,
+    3
+]
+
+max_output_boxes_per_classes = [
+    3,
+    16
+]
+
+center_point_boxes = [
+    False,
+    True
+]
+
+score_thresholds = [
+    None,
+    0.
+]
+
+
+@pytest.mark.parametrize('batch', batches)
+@pytest.mark.parametrize('classes', classes)
+@pytest.mark.parametrize('max_output_boxes_per_class', max_output_boxes_per_classes)
+@pytest.mark.parametrize('center_point_box', center_point_boxes)
+@pytest.mark.parametrize('score_threshold', score_thresholds)
+def test_nms(batch, classes, max_output_boxes_per_class, center_point_box, score_threshold, request):
+    model_def = _make_module(batch, classes, max_output_boxes_per_class, center_point_box, score_threshold)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_onnx_helper(model_def)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_nms.py'])
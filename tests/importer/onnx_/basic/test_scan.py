@@ -0,0 +1,81 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import copy
+import pytest
+import onnx
+from onnx import helper
+from onnx import AttributeProto, TensorProto, GraphProto, numpy_helper
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_shape):
+    state_shape = in_shape[1:]
+
+    # body: sum_out = sum_in * 0.5 + x, scan_out = tanh(sum_out)
+    sum_in = helper.make_tensor_value_info('sum_in', TensorProto.FLOAT, state_shape)
+    x = helper.make_tensor_value_info('x', TensorProto.FLOAT, state_shape)
+    sum_out = helper.make_tensor_value_info('sum_out', TensorProto.FLOAT, state_shape)
+    scan_out = helper.make_tensor_value_info('scan_out', TensorProto.FLOAT, state_shape)
+    half = helper.make_tensor('half', TensorProto.FLOAT, dims=[1], vals=[0.5])
+    body_nodes = [
+        helper.make_node('Mul', ['sum_in', 'half'], ['decay']),
+        helper.make_node('Add', ['decay', 'x'], ['sum_out']),
+        helper.make_node('Tanh', ['sum_out'], ['scan_out']),
+    ]
+    body = helper.make_graph(body_nodes, 'scan_body', [sum_in, x], [sum_out, scan_out], initializer=[half])
+
+    initial = helper.make_tensor_value_info('initial', TensorProto.FLOAT, state_shape)
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    final = helper.make_tensor_value_info('final', TensorProto.FLOAT, state_shape)
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, in_shape)
+
+    node = onnx.helper.make_node(
+        'Scan',
+        inputs=['initial', 'input'],
+        outputs=['final', 'output'],
+        num_scan_inputs=1,
+        body=body
+    )
+
+    graph_def = helper.make_graph(
+        [node],
+        'test-model',
+        [initial, input],
+        [final, output])
+
+    model_def = helper.make_model(graph_def, producer_name='kendryte')
+
+    return model_def
+
+
+in_shapes = [
+    [1, 3, 4],
+    [5, 3, 4],
+    [16, 1, 32]
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+def test_scan(in_shape, request):
+    model_def = _make_module(in_shape)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_onnx_helper(model_def)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_scan.py'])
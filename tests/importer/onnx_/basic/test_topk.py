@@ -0,0 +1,114 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import copy
+import pytest
+import onnx
+from onnx import helper
+from onnx import AttributeProto, TensorProto, GraphProto, numpy_helper
+from onnx_test_runner import OnnxTestRunner
+
+
+
+def _make_module(in_shape, k, axis, largest):
+    inputs = []
+    initializers = []
+    attributes_dict = {}
+
+    # input
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    inputs.append('input')
+
+    # k
+    k_tensor = helper.make_tensor(
+        'k',
+        TensorProto.INT64,
+        dims=[1],
+        vals=[k]
+    )
+    inputs.append('k')
+    initializers.append(k_tensor)
+
+    # output
+    out_shape = copy.deepcopy(in_shape)
+    out_shape[axis] = k
+    values = helper.make_tensor_value_info('values', TensorProto.FLOAT, out_shape)
+    indices = helper.make_tensor_value_info('indices', TensorProto.INT64, out_shape)
+
+    # axis
+    if axis is not None:
+        attributes_dict['axis'] = axis
+
+    # largest
+    if largest is not None:
+        attributes_dict['largest'] = largest
+
+    node = onnx.helper.make_node(
+        'TopK',
+        inputs=inputs,
+        outputs=['values', 'indices'],
+        **attributes_dict
+    )
+
+    nodes = []
+    nodes.append(node)
+
+    graph_def = helper.make_graph(
+        nodes,
+        'test-model',
+        [input],
+        [values, indices],
+        initializer=initializers)
+
+    model_def = helper.make_model(graph_def, producer_name='kendryte')
+
+    return model_def
+
+
+in_shapes = [
+    [1, 3, 16, 16],
+    [1, 1000]
+]
+
+ks = [
+    1,
+    3
+]
+
+axes = [
+    1,
+    -1
+]
+
+largests = [
+    None,
+    0
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('k', ks)
+@pytest.mark.parametrize('axis', axes)
+@pytest.mark.parametrize('largest', largests)
+def test_topk(in_shape, k, axis, largest, request):
+    model_def = _make_module(in_shape, k, axis, largest)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_onnx_helper(model_def)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_topk.py'])
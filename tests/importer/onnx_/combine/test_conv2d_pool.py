@@ -0,0 +1,72 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+import pytest
+import torch
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_channels, kernel_size, pool, pool_size, pool_stride, pool_padding):
+
+    class ConvPoolModule(torch.nn.Module):
+        def __init__(self):
+            super(ConvPoolModule, self).__init__()
+            self.conv = torch.nn.Conv2d(in_channels, 16, kernel_size, padding=kernel_size // 2)
+            if pool == 'max':
+                self.pool = torch.nn.MaxPool2d(pool_size, pool_stride, pool_padding)
+            else:
+                self.pool = torch.nn.AvgPool2d(pool_size, pool_stride, pool_padding,
+                                               count_include_pad=False)
+
+        def forward(self, x):
+            return self.pool(torch.relu(self.conv(x)))
+
+    return ConvPoolModule()
+
+
+in_shapes = [
+    [1, 3, 56, 56],
+    [1, 8, 33, 31]
+]
+
+kernel_sizes = [
+    1,
+    3
+]
+
+pools = [
+    'max',
+    'avg'
+]
+
+pool_args = [
+    (2, 2, 0),
+    (3, 2, 1)
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('kernel_size', kernel_sizes)
+@pytest.mark.parametrize('pool', pools)
+@pytest.mark.parametrize('pool_arg', pool_args)
+def test_conv2d_pool(in_shape, kernel_size, pool, pool_arg, request):
+    module = _make_module(in_shape[1], kernel_size, pool, *pool_arg)
+
+    runner = OnnxTestRunner(request.node.name, ['cpu'])
+    model_file = runner.from_torch(module, in_shape)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_conv2d_pool.py'])
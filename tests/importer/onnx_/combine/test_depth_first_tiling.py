@@ -0,0 +1,84 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+import pytest
+import torch
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_channels, kernel_size, stride, pool, conv_tail):
+
+    class ConvChainModule(torch.nn.Module):
+        def __init__(self):
+            super(ConvChainModule, self).__init__()
+            self.conv1 = torch.nn.Conv2d(in_channels, 32, kernel_size,
+                                         stride=stride, padding=kernel_size // 2)
+            self.conv2 = torch.nn.Conv2d(32, 32, kernel_size, padding=kernel_size // 2)
+            self.pool = torch.nn.MaxPool2d(2) if pool else None
+            self.conv3 = torch.nn.Conv2d(32, 16, 1)
+
+        def forward(self, x):
+            x = torch.relu(self.conv1(x))
+            x = torch.relu(self.conv2(x))
+            if self.pool is not None:
+                x = self.pool(x)
+            x = self.conv3(x)
+            # a conv tail writes its tiles straight into the concat
+            return x if conv_tail else x + 1
+
+    return ConvChainModule()
+
+
+# intermediates of these chains don't fit in cache and are computed in row tiles
+in_shapes = [
+    [1, 3, 224, 224],
+    [1, 16, 127, 129]
+]
+
+kernel_sizes = [
+    1,
+    3
+]
+
+strides = [
+    1,
+    2
+]
+
+pools = [
+    False,
+    True
+]
+
+conv_tails = [
+    False,
+    True
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('kernel_size', kernel_sizes)
+@pytest.mark.parametrize('stride', strides)
+@pytest.mark.parametrize('pool', pools)
+@pytest.mark.parametrize('conv_tail', conv_tails)
+def test_depth_first_tiling(in_shape, kernel_size, stride, pool, conv_tail, request):
+    module = _make_module(in_shape[1], kernel_size, stride, pool, conv_tail)
+
+    runner = OnnxTestRunner(request.node.name, ['cpu'])
+    model_file = runner.from_torch(module, in_shape)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_depth_first_tiling.py'])
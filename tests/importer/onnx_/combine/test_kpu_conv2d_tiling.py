@@ -0,0 +1,66 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+import pytest
+import torch
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_channels, out_channels, kernel_size, pool):
+
+    class ConvModule(torch.nn.Module):
+        def __init__(self):
+            super(ConvModule, self).__init__()
+            self.conv = torch.nn.Conv2d(in_channels, out_channels, kernel_size, padding=kernel_size // 2)
+            self.pool = torch.nn.MaxPool2d(2) if pool else None
+
+        def forward(self, x):
+            x = torch.relu(self.conv(x))
+            if self.pool is not None:
+                x = self.pool(x)
+            return x
+
+    return ConvModule()
+
+
+# activations of these convs exceed the 2MB KPU RAM and have to be tiled
+in_shapes = [
+    [1, 32, 224, 320],
+    [1, 64, 255, 257]
+]
+
+kernel_sizes = [
+    1,
+    3
+]
+
+pools = [
+    False,
+    True
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('kernel_size', kernel_sizes)
+@pytest.mark.parametrize('pool', pools)
+def test_kpu_conv2d_tiling(in_shape, kernel_size, pool, request):
+    module = _make_module(in_shape[1], 32, kernel_size, pool)
+
+    runner = OnnxTestRunner(request.node.name, ['k210'])
+    model_file = runner.from_torch(module, in_shape)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_kpu_conv2d_tiling.py'])
@@ -0,0 +1,53 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import torch
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_shape):
+
+    class LayoutAssignmentModule(torch.nn.Module):
+        def __init__(self):
+            super(LayoutAssignmentModule, self).__init__()
+
+        def forward(self, x):
+            n, c, h, w = in_shape
+            nhwc = x.permute(0, 2, 3, 1)
+            y = torch.sigmoid(nhwc + x.reshape(n, h, w, c))
+            y = torch.cat((y, torch.relu(nhwc)), 3)
+            return y.permute(0, 3, 1, 2)
+
+    return LayoutAssignmentModule()
+
+
+in_shapes = [
+    [1, 4, 8, 8],
+    [1, 16, 14, 10]
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+def test_layout_assignment(in_shape, request):
+    module = _make_module(in_shape)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_torch(module, in_shape)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_layout_assignment.py'])
@@ -0,0 +1,80 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import onnx
+import numpy as np
+from onnx import helper
+from onnx import TensorProto, numpy_helper
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_shape, out_channel, q_type):
+    zp = 0 if q_type == TensorProto.INT8 else 128
+    np_type = np.int8 if q_type == TensorProto.INT8 else np.uint8
+    initializers = []
+    nodes = []
+
+    def qdq(name, scale):
+        initializers.append(helper.make_tensor(name + '_scale', TensorProto.FLOAT, [], [scale]))
+        initializers.append(numpy_helper.from_array(np.array(zp, dtype=np_type), name + '_zp'))
+        nodes.append(helper.make_node('QuantizeLinear', [name, name + '_scale', name + '_zp'], [name + '_q']))
+        nodes.append(helper.make_node('DequantizeLinear', [
+                     name + '_q', name + '_scale', name + '_zp'], [name + '_dq']))
+        return name + '_dq'
+
+    input = helper.make_tensor_value_info('input', TensorProto.FLOAT, in_shape)
+    x = qdq('input', 1 / 64)
+
+    w = np.random.rand(out_channel, in_shape[1], 3, 3).astype(np.float32) - 0.5
+    initializers.append(numpy_helper.from_array(w, 'weight'))
+    nodes.append(helper.make_node('Conv', [x, 'weight'], ['conv'], kernel_shape=[3, 3], pads=[1, 1, 1, 1]))
+    y = qdq('conv', 1 / 8)
+
+    out_shape = [in_shape[0], out_channel, in_shape[2], in_shape[3]]
+    nodes.append(helper.make_node('Identity', [y], ['output']))
+    output = helper.make_tensor_value_info('output', TensorProto.FLOAT, out_shape)
+
+    graph_def = helper.make_graph(nodes, 'test-model', [input], [output], initializer=initializers)
+    return helper.make_model(graph_def, producer_name='onnx')
+
+
+in_shapes = [
+    [1, 3, 16, 16]
+]
+
+out_channels = [
+    8
+]
+
+q_types = [
+    TensorProto.UINT8,
+    TensorProto.INT8
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('out_channel', out_channels)
+@pytest.mark.parametrize('q_type', q_types)
+def test_qdq_conv2d(in_shape, out_channel, q_type, request):
+    model_def = _make_module(in_shape, out_channel, q_type)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_onnx_helper(model_def)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_qdq_conv2d.py'])
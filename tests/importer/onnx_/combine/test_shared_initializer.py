@@ -0,0 +1,81 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import onnx
+import numpy as np
+from onnx import helper
+from onnx import TensorProto, numpy_helper
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(in_shape, raw_data):
+    # Every initializer feeds two nodes. Each must be imported once and keep its data
+    # after the first consumer takes it.
+    w = np.random.rand(in_shape[-1], in_shape[-1]).astype(np.float32) - 0.5
+    b = np.random.rand(in_shape[-1]).astype(np.float32) - 0.5
+    new_shape = np.array([-1, in_shape[-1]], dtype=np.int64)
+    if raw_data:
+        initializers = [
+            numpy_helper.from_array(w, 'w'),
+            numpy_helper.from_array(b, 'b'),
+            numpy_helper.from_array(new_shape, 'new_shape')
+        ]
+    else:
+        initializers = [
+            helper.make_tensor('w', TensorProto.FLOAT, dims=w.shape, vals=w.flatten().tolist()),
+            helper.make_tensor('b', TensorProto.FLOAT, dims=b.shape, vals=b.tolist()),
+            helper.make_tensor('new_shape', TensorProto.INT64, dims=new_shape.shape, vals=new_shape.tolist())
+        ]
+
+    nodes = [
+        helper.make_node('MatMul', ['x', 'w'], ['mm0']),
+        helper.make_node('Add', ['mm0', 'b'], ['add0']),
+        helper.make_node('Reshape', ['add0', 'new_shape'], ['r0']),
+        helper.make_node('MatMul', ['r0', 'w'], ['mm1']),
+        helper.make_node('Add', ['mm1', 'b'], ['add1']),
+        helper.make_node('Reshape', ['add1', 'new_shape'], ['y'])
+    ]
+
+    rows = int(np.prod(in_shape[:-1]))
+    x = helper.make_tensor_value_info('x', TensorProto.FLOAT, in_shape)
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [rows, in_shape[-1]])
+    graph_def = helper.make_graph(nodes, 'test-model', [x], [y], initializer=initializers)
+    return helper.make_model(graph_def, producer_name='kendryte')
+
+
+in_shapes = [
+    [4, 4],
+    [2, 3, 8]
+]
+
+raw_datas = [
+    True,
+    False
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('raw_data', raw_datas)
+def test_shared_initializer(in_shape, raw_data, request):
+    model_def = _make_module(in_shape, raw_data)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_onnx_helper(model_def)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_shared_initializer.py'])
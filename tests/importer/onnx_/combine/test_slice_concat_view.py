@@ -0,0 +1,96 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import torch
+from onnx_test_runner import OnnxTestRunner
+
+
+def _make_module(axis):
+
+    class SliceConcatViewModule(torch.nn.Module):
+        def __init__(self):
+            super(SliceConcatViewModule, self).__init__()
+
+        def forward(self, x):
+            y = x[:, 1:3, 1:-1, 2:] * 2.0
+            return torch.cat((torch.relu(y), torch.sigmoid(y)), axis)
+
+    return SliceConcatViewModule()
+
+
+def _make_conv_module(in_channels, axis, kernel_size, stride):
+
+    class SliceConvConcatViewModule(torch.nn.Module):
+        def __init__(self):
+            super(SliceConvConcatViewModule, self).__init__()
+            self.conv1 = torch.nn.Conv2d(in_channels, 8, kernel_size, stride, padding=kernel_size // 2)
+            self.conv2 = torch.nn.Conv2d(in_channels, 8, 3, stride, padding=1, groups=in_channels // 2)
+
+        def forward(self, x):
+            # Both convs read a W and H sliced view and write their halves of the concat in place
+            y = x[:, :, 1:-1, 2:]
+            return torch.cat((self.conv1(y), self.conv2(y)), axis)
+
+    return SliceConvConcatViewModule()
+
+
+in_shapes = [
+    [1, 4, 8, 8],
+    [1, 8, 16, 24]
+]
+
+axes = [
+    1,
+    2,
+    3
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('axis', axes)
+def test_slice_concat_view(in_shape, axis, request):
+    module = _make_module(axis)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_torch(module, in_shape)
+    runner.run(model_file)
+
+
+kernel_sizes = [
+    1,
+    3
+]
+
+strides = [
+    1,
+    2
+]
+
+
+@pytest.mark.parametrize('in_shape', in_shapes)
+@pytest.mark.parametrize('axis', axes)
+@pytest.mark.parametrize('kernel_size', kernel_sizes)
+@pytest.mark.parametrize('stride', strides)
+def test_slice_conv_concat_view(in_shape, axis, kernel_size, stride, request):
+    module = _make_conv_module(in_shape[1], axis, kernel_size, stride)
+
+    runner = OnnxTestRunner(request.node.name)
+    model_file = runner.from_torch(module, in_shape)
+    runner.run(model_file)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_slice_concat_view.py'])
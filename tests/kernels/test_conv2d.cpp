@@ -0,0 +1,156 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+class Conv2DTest : public ::testing::TestWithParam<
+                       std::tuple<
+                           runtime_shape_t, // input shape
+                           runtime_shape_t, // weights shape
+                           int32_t, // groups
+                           int32_t, // stride
+                           bool>> // fused lut
+{
+public:
+    void SetUp() override
+    {
+        auto &&[in_shape, w_shape, groups, stride, use_lut] = GetParam();
+
+        input = create_float_tensor(in_shape, 1);
+        weights = create_float_tensor(w_shape, 2);
+        bias = create_float_tensor({ w_shape[0] }, 3);
+
+        auto out_h = kernels::detail::get_windowed_output_size(in_shape[2], (int32_t)w_shape[2], stride, 1, padding::zero());
+        auto out_w = kernels::detail::get_windowed_output_size(in_shape[3], (int32_t)w_shape[3], stride, 1, padding::zero());
+        runtime_shape_t out_shape { in_shape[0], w_shape[0], out_h, out_w };
+        output_ref = host_runtime_tensor::create(dt_float32, out_shape).unwrap_or_throw();
+        output_opt = host_runtime_tensor::create(dt_float32, out_shape).unwrap_or_throw();
+
+        // A sigmoid sampled over the quantized output range
+        table.resize(256);
+        for (size_t i = 0; i < table.size(); i++)
+            table[i] = 1.f / (1.f + std::exp(-kernels::detail::dequantize((uint8_t)i, table_param)));
+
+        this->groups = groups;
+        this->stride = stride;
+        this->use_lut = use_lut;
+    }
+
+    static runtime_tensor create_float_tensor(const runtime_shape_t &shape, uint32_t seed)
+    {
+        auto tensor = host_runtime_tensor::create(dt_float32, shape).unwrap_or_throw();
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dis(-1.f, 1.f);
+        auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+        for (auto &v : map.buffer().as_span<float>())
+            v = dis(gen);
+        return tensor;
+    }
+
+    runtime_tensor input, weights, bias, output_ref, output_opt;
+    std::vector<float> table;
+    quant_param_t table_param { 128, 0.05f };
+    int32_t groups;
+    int32_t stride;
+    bool use_lut;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Conv2D,
+    Conv2DTest,
+    testing::Values(
+        std::make_tuple(runtime_shape_t { 1, 8, 16, 16 }, runtime_shape_t { 16, 8, 1, 1 }, 1, 1, false),
+        std::make_tuple(runtime_shape_t { 1, 8, 16, 16 }, runtime_shape_t { 16, 8, 1, 1 }, 1, 1, true),
+        std::make_tuple(runtime_shape_t { 1, 8, 16, 16 }, runtime_shape_t { 16, 8, 1, 1 }, 1, 2, true),
+        std::make_tuple(runtime_shape_t { 1, 4, 17, 15 }, runtime_shape_t { 8, 4, 3, 3 }, 1, 1, false),
+        std::make_tuple(runtime_shape_t { 1, 4, 17, 15 }, runtime_shape_t { 8, 4, 3, 3 }, 1, 1, true),
+        std::make_tuple(runtime_shape_t { 1, 4, 17, 15 }, runtime_shape_t { 8, 4, 3, 3 }, 1, 2, true),
+        std::make_tuple(runtime_shape_t { 2, 6, 12, 12 }, runtime_shape_t { 6, 1, 3, 3 }, 6, 1, true),
+        std::make_tuple(runtime_shape_t { 2, 6, 12, 12 }, runtime_shape_t { 6, 1, 5, 5 }, 6, 2, true)));
+
+TEST_P(Conv2DTest, normal)
+{
+    auto fused_lut = use_lut ? activation_lut { table.data(), table_param } : activation_lut::none();
+    auto in_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(input));
+    auto w_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(weights));
+    auto b_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(bias));
+    auto ref = cpu::reference::conv2d(in_ptr, w_ptr, b_ptr, reinterpret_cast<float *>(get_tensor_begin(output_ref)),
+        input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), output_ref.strides(),
+        padding::zero(), padding::zero(), groups, stride, stride, 1, 1, value_range<float>::full(), fused_lut, default_kernel_context());
+    auto opt = cpu::optimized::conv2d(in_ptr, w_ptr, b_ptr, reinterpret_cast<float *>(get_tensor_begin(output_opt)),
+        input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), output_opt.strides(),
+        padding::zero(), padding::zero(), groups, stride, stride, 1, 1, value_range<float>::full(), fused_lut, default_kernel_context());
+    ASSERT_TRUE(ref.is_ok());
+    ASSERT_TRUE(opt.is_ok());
+
+    // Accumulation order differs, so a value near a quantization boundary may pick the neighbouring table entry
+    auto ref_map = std::move(hrt::map(output_ref, hrt::map_read).unwrap_or_throw());
+    auto opt_map = std::move(hrt::map(output_opt, hrt::map_read).unwrap_or_throw());
+    auto r = ref_map.buffer().as_span<float>();
+    auto o = opt_map.buffer().as_span<float>();
+    const auto tolerance = use_lut ? table_param.scale : 1e-4f;
+    for (size_t i = 0; i < r.size(); i++)
+        ASSERT_NEAR(r[i], o[i], tolerance) << "at " << i;
+}
+
+TEST(Conv2DStridedTest, views)
+{
+    // Input is a H/W slice of a larger tensor and the output is one half of a W concat
+    const size_t channels = 8, in_h = 13, in_w = 11, full_h = in_h + 3, full_w = in_w + 5;
+    auto full_input = Conv2DTest::create_float_tensor({ 1, channels, full_h, full_w }, 1);
+    auto in_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(full_input)) + 2 * full_w + 3;
+    runtime_shape_t in_shape { 1, channels, in_h, in_w };
+    auto &in_strides = full_input.strides();
+
+    for (int32_t groups : { 1, (int32_t)channels })
+    {
+        for (size_t filter : { 1, 3 })
+        {
+            for (int32_t stride : { 1, 2 })
+            {
+                const size_t out_channels = groups == 1 ? 16 : channels;
+                auto weights = Conv2DTest::create_float_tensor({ out_channels, channels / groups, filter, filter }, 2);
+                auto bias = Conv2DTest::create_float_tensor({ out_channels }, 3);
+                auto w_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(weights));
+                auto b_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(bias));
+
+                auto out_h = kernels::detail::get_windowed_output_size(in_h, (int32_t)filter, stride, 1, padding::zero());
+                auto out_w = kernels::detail::get_windowed_output_size(in_w, (int32_t)filter, stride, 1, padding::zero());
+                runtime_shape_t out_shape { 1, out_channels, out_h, out_w };
+                runtime_shape_t out_strides { out_channels * out_h * out_w * 2, out_h * out_w * 2, out_w * 2, 1 };
+                std::vector<float> ref(out_channels * out_h * out_w * 2, -1.f), opt(ref.size(), -1.f);
+
+                ASSERT_TRUE(cpu::reference::conv2d(in_ptr, w_ptr, b_ptr, ref.data(), in_shape, in_strides, weights.shape(), weights.strides(),
+                    bias.strides(), out_strides, padding::zero(), padding::zero(), groups, stride, stride, 1, 1, value_range<float>::full(),
+                    activation_lut::none(), default_kernel_context())
+                                .is_ok());
+                auto r = cpu::optimized::conv2d(in_ptr, w_ptr, b_ptr, opt.data(), in_shape, in_strides, weights.shape(), weights.strides(),
+                    bias.strides(), out_strides, padding::zero(), padding::zero(), groups, stride, stride, 1, 1, value_range<float>::full(),
+                    activation_lut::none(), default_kernel_context());
+                if (r.is_err())
+                    continue;
+
+                // The other half of each output row must be left untouched
+                for (size_t i = 0; i < ref.size(); i++)
+                    ASSERT_NEAR(ref[i], opt[i], 1e-4f) << "at " << i << ", groups " << groups << ", filter " << filter << ", stride " << stride;
+            }
+        }
+    }
+}
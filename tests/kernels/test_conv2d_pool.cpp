@@ -0,0 +1,171 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/convolution.h>
+#include <nncase/kernels/cpu/reference/convolution.h>
+#include <nncase/kernels/cpu/reference/reduce_window.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+class Conv2DPoolTest : public ::testing::TestWithParam<
+                           std::tuple<
+                               runtime_shape_t, // input shape
+                               runtime_shape_t, // weights shape
+                               int32_t, // conv stride
+                               padding, // conv padding
+                               reduce_op_t, // pool op
+                               int32_t, // pool filter
+                               int32_t, // pool stride
+                               padding>> // pool padding
+{
+public:
+    void SetUp() override
+    {
+        auto &&[in_shape, w_shape, stride, conv_pad, pool_op, pool_filter, pool_stride, pool_pad] = GetParam();
+
+        input = create_float_tensor(in_shape, 1);
+        weights = create_float_tensor(w_shape, 2);
+        bias = create_float_tensor({ w_shape[0] }, 3);
+
+        auto conv_h = kernels::detail::get_windowed_output_size(in_shape[2], (int32_t)w_shape[2], stride, 1, conv_pad);
+        auto conv_w = kernels::detail::get_windowed_output_size(in_shape[3], (int32_t)w_shape[3], stride, 1, conv_pad);
+        auto out_h = kernels::detail::get_windowed_output_size(conv_h, pool_filter, pool_stride, 1, pool_pad);
+        auto out_w = kernels::detail::get_windowed_output_size(conv_w, pool_filter, pool_stride, 1, pool_pad);
+        conv_output = host_runtime_tensor::create(dt_float32, { in_shape[0], w_shape[0], conv_h, conv_w }).unwrap_or_throw();
+        output_ref = host_runtime_tensor::create(dt_float32, { in_shape[0], w_shape[0], out_h, out_w }).unwrap_or_throw();
+        output_fused = host_runtime_tensor::create(dt_float32, output_ref.shape()).unwrap_or_throw();
+
+        this->stride = stride;
+        this->conv_pad = conv_pad;
+        this->pool_op = pool_op;
+        this->pool_filter = pool_filter;
+        this->pool_stride = pool_stride;
+        this->pool_pad = pool_pad;
+    }
+
+    static runtime_tensor create_float_tensor(const runtime_shape_t &shape, uint32_t seed)
+    {
+        auto tensor = host_runtime_tensor::create(dt_float32, shape).unwrap_or_throw();
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dis(-1.f, 1.f);
+        auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+        for (auto &v : map.buffer().as_span<float>())
+            v = dis(gen);
+        return tensor;
+    }
+
+    runtime_tensor input, weights, bias, conv_output, output_ref, output_fused;
+    int32_t stride;
+    padding conv_pad;
+    reduce_op_t pool_op;
+    int32_t pool_filter;
+    int32_t pool_stride;
+    padding pool_pad;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Conv2DPool,
+    Conv2DPoolTest,
+    testing::Values(
+        std::make_tuple(runtime_shape_t { 1, 8, 16, 16 }, runtime_shape_t { 16, 8, 3, 3 }, 1, padding { 1, 1 }, reduce_max, 2, 2, padding::zero()),
+        std::make_tuple(runtime_shape_t { 1, 8, 16, 16 }, runtime_shape_t { 16, 8, 3, 3 }, 1, padding { 1, 1 }, reduce_mean, 2, 2, padding::zero()),
+        std::make_tuple(runtime_shape_t { 2, 4, 17, 15 }, runtime_shape_t { 8, 4, 3, 3 }, 2, padding { 1, 1 }, reduce_max, 3, 2, padding { 1, 1 }),
+        std::make_tuple(runtime_shape_t { 2, 4, 17, 15 }, runtime_shape_t { 8, 4, 1, 1 }, 1, padding::zero(), reduce_mean, 3, 1, padding { 1, 1 }),
+        // Large enough to be computed in several bands
+        std::make_tuple(runtime_shape_t { 1, 8, 96, 96 }, runtime_shape_t { 64, 8, 3, 3 }, 1, padding { 1, 1 }, reduce_max, 2, 2, padding::zero()),
+        std::make_tuple(runtime_shape_t { 1, 8, 97, 95 }, runtime_shape_t { 64, 8, 5, 5 }, 1, padding { 2, 2 }, reduce_mean, 3, 2, padding { 1, 1 })));
+
+TEST_P(Conv2DPoolTest, normal)
+{
+    auto in_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(input));
+    auto w_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(weights));
+    auto b_ptr = reinterpret_cast<const float *>(get_tensor_cbegin(bias));
+    auto conv_activation = value_range<float> { 0.f, std::numeric_limits<float>::infinity() };
+    auto init_value = pool_op == reduce_max ? std::numeric_limits<float>::lowest() : 0.f;
+
+    auto ref_conv = cpu::reference::conv2d(in_ptr, w_ptr, b_ptr, reinterpret_cast<float *>(get_tensor_begin(conv_output)),
+        input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), conv_output.strides(),
+        conv_pad, conv_pad, 1, stride, stride, 1, 1, conv_activation, activation_lut::none(), default_kernel_context());
+    ASSERT_TRUE(ref_conv.is_ok());
+    auto ref_pool = cpu::reference::reduce_window2d(pool_op, reinterpret_cast<const float *>(get_tensor_cbegin(conv_output)), init_value,
+        reinterpret_cast<float *>(get_tensor_begin(output_ref)), conv_output.shape(), conv_output.strides(), output_ref.strides(),
+        pool_pad, pool_pad, pool_filter, pool_filter, pool_stride, pool_stride, 1, 1, value_range<float>::full(), default_kernel_context());
+    ASSERT_TRUE(ref_pool.is_ok());
+
+    auto fused = kernels::conv2d_pool(in_ptr, w_ptr, b_ptr, reinterpret_cast<float *>(get_tensor_begin(output_fused)),
+        input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), output_fused.strides(),
+        conv_pad, conv_pad, 1, stride, stride, 1, 1, conv_activation, activation_lut::none(), pool_op, init_value,
+        pool_filter, pool_filter, pool_pad, pool_pad, pool_stride, pool_stride, value_range<float>::full());
+    ASSERT_TRUE(fused.is_ok());
+
+    auto ref_map = std::move(hrt::map(output_ref, hrt::map_read).unwrap_or_throw());
+    auto fused_map = std::move(hrt::map(output_fused, hrt::map_read).unwrap_or_throw());
+    auto r = ref_map.buffer().as_span<float>();
+    auto f = fused_map.buffer().as_span<float>();
+    for (size_t i = 0; i < r.size(); i++)
+        ASSERT_NEAR(r[i], f[i], 1e-4f) << "at " << i;
+}
+
+TEST_P(Conv2DPoolTest, views)
+{
+    // Input is an H/W slice of a larger tensor, output is the first half of a W concat
+    auto &in_shape = input.shape();
+    runtime_shape_t full_shape { in_shape[0], in_shape[1], in_shape[2] + 3, in_shape[3] + 5 };
+    auto full_strides = get_default_strides(full_shape);
+    std::vector<float> full_input(runtime::compute_size(full_shape), 0.f);
+    auto in_view = full_input.data() + 2 * full_strides[2] + 3;
+    auto in_map = std::move(hrt::map(input, hrt::map_read).unwrap_or_throw());
+    auto in_data = in_map.buffer().as_span<float>();
+    for (size_t n = 0; n < in_shape[0]; n++)
+        for (size_t c = 0; c < in_shape[1]; c++)
+            for (size_t h = 0; h < in_shape[2]; h++)
+                std::copy_n(in_data.data() + ((n * in_shape[1] + c) * in_shape[2] + h) * in_shape[3], in_shape[3],
+                    in_view + n * full_strides[0] + c * full_strides[1] + h * full_strides[2]);
+
+    auto &out_shape = output_ref.shape();
+    runtime_shape_t out_strides { out_shape[1] * out_shape[2] * out_shape[3] * 2, out_shape[2] * out_shape[3] * 2, out_shape[3] * 2, 1 };
+    std::vector<float> concat_output(out_shape[0] * out_strides[0], -1.f);
+
+    auto conv_activation = value_range<float> { 0.f, std::numeric_limits<float>::infinity() };
+    auto init_value = pool_op == reduce_max ? std::numeric_limits<float>::lowest() : 0.f;
+    auto ref_conv = cpu::reference::conv2d(reinterpret_cast<const float *>(get_tensor_cbegin(input)), reinterpret_cast<const float *>(get_tensor_cbegin(weights)),
+        reinterpret_cast<const float *>(get_tensor_cbegin(bias)), reinterpret_cast<float *>(get_tensor_begin(conv_output)),
+        input.shape(), input.strides(), weights.shape(), weights.strides(), bias.strides(), conv_output.strides(),
+        conv_pad, conv_pad, 1, stride, stride, 1, 1, conv_activation, activation_lut::none(), default_kernel_context());
+    ASSERT_TRUE(ref_conv.is_ok());
+    auto ref_pool = cpu::reference::reduce_window2d(pool_op, reinterpret_cast<const float *>(get_tensor_cbegin(conv_output)), init_value,
+        reinterpret_cast<float *>(get_tensor_begin(output_ref)), conv_output.shape(), conv_output.strides(), output_ref.strides(),
+        pool_pad, pool_pad, pool_filter, pool_filter, pool_stride, pool_stride, 1, 1, value_range<float>::full(), default_kernel_context());
+    ASSERT_TRUE(ref_pool.is_ok());
+
+    auto fused = kernels::conv2d_pool(in_view, reinterpret_cast<const float *>(get_tensor_cbegin(weights)), reinterpret_cast<const float *>(get_tensor_cbegin(bias)),
+        concat_output.data(), in_shape, full_strides, weights.shape(), weights.strides(), bias.strides(), out_strides,
+        conv_pad, conv_pad, 1, stride, stride, 1, 1, conv_activation, activation_lut::none(), pool_op, init_value,
+        pool_filter, pool_filter, pool_pad, pool_pad, pool_stride, pool_stride, value_range<float>::full());
+    ASSERT_TRUE(fused.is_ok());
+
+    auto ref_map = std::move(hrt::map(output_ref, hrt::map_read).unwrap_or_throw());
+    auto r = ref_map.buffer().as_span<float>();
+    for (size_t i = 0; i < concat_output.size(); i++)
+    {
+        auto w = i % out_strides[2];
+        auto row = i / out_strides[2];
+        if (w < out_shape[3])
+            ASSERT_NEAR(r[row * out_shape[3] + w], concat_output[i], 1e-4f) << "at " << i;
+        else
+            ASSERT_EQ(-1.f, concat_output[i]) << "at " << i;
+    }
+}
@@ -0,0 +1,133 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <functional>
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+#include <random>
+
+namespace
+{
+using nms_func_t = std::function<result<void>(const float *, const runtime_shape_t &, const runtime_shape_t &, const float *,
+    const runtime_shape_t &, const runtime_shape_t &, int64_t *, bool, int32_t, float, float)>;
+
+std::vector<std::pair<const char *, nms_func_t>> nms_impls()
+{
+    return {
+        { "reference", [](auto... args) { return cpu::reference::detection_postprocess<float>(args...); } },
+        { "optimized", [](auto... args) { return cpu::optimized::detection_postprocess<float>(args...); } },
+        { "optimized_4_threads", [](auto... args) {
+             kernel_context context { 4 };
+             return cpu::optimized::detection_postprocess<float>(args..., context);
+         } }
+    };
+}
+}
+
+TEST(DetectionPostprocessTest, hand_computed)
+{
+    // Boxes 0/1 and 2/3 overlap with IoU 90 / 110, box 4 is apart from all
+    const float corners[5][4] = { { 0, 0, 10, 10 }, { 0, 1, 10, 11 }, { 0, 20, 10, 30 }, { 0, 21, 10, 31 }, { 50, 50, 60, 60 } };
+    const float scores[2][5] = {
+        { 0.9f, 0.8f, 0.3f, 0.95f, 0.1f }, // 3, 0 kept, 1 and 2 suppressed, 4 below the score threshold
+        { 0.5f, 0.6f, 0.7f, 0.4f, 0.9f } // 4, 2, 1 kept, stops at max_output_boxes_per_class
+    };
+    const int64_t expected[6][3] = { { 0, 0, 3 }, { 0, 0, 0 }, { 0, 1, 4 }, { 0, 1, 2 }, { 0, 1, 1 }, { -1, -1, -1 } };
+
+    runtime_shape_t boxes_shape { 1, 5, 4 }, scores_shape { 1, 2, 5 };
+    for (bool center_point_box : { false, true })
+    {
+        float boxes[5][4];
+        for (size_t i = 0; i < 5; i++)
+        {
+            auto [y1, x1, y2, x2] = corners[i];
+            if (center_point_box)
+            {
+                boxes[i][0] = (x1 + x2) / 2;
+                boxes[i][1] = (y1 + y2) / 2;
+                boxes[i][2] = x2 - x1;
+                boxes[i][3] = y2 - y1;
+            }
+            else
+            {
+                // Any diagonal pair of corners is accepted
+                boxes[i][0] = i % 2 ? y2 : y1;
+                boxes[i][1] = i % 2 ? x2 : x1;
+                boxes[i][2] = i % 2 ? y1 : y2;
+                boxes[i][3] = i % 2 ? x1 : x2;
+            }
+        }
+
+        for (auto &[name, nms] : nms_impls())
+        {
+            int64_t output[6][3];
+            ASSERT_TRUE(nms(&boxes[0][0], boxes_shape, get_default_strides(boxes_shape), &scores[0][0], scores_shape, get_default_strides(scores_shape),
+                &output[0][0], center_point_box, 3, 0.5f, 0.2f)
+                            .is_ok());
+            for (size_t i = 0; i < 6; i++)
+            {
+                for (size_t j = 0; j < 3; j++)
+                    EXPECT_EQ(expected[i][j], output[i][j]) << name << ", center_point_box " << center_point_box << ", row " << i;
+            }
+        }
+    }
+}
+
+TEST(DetectionPostprocessTest, random)
+{
+    // Many overlapping boxes, scores are strided views of a transposed tensor
+    const size_t batches = 2, classes = 4, spatial = 300;
+    const int32_t max_per_class = 20;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> pos(0.f, 100.f), size(5.f, 30.f), score(0.f, 1.f);
+    std::vector<float> boxes(batches * spatial * 4);
+    for (size_t i = 0; i < batches * spatial; i++)
+    {
+        auto y = pos(gen), x = pos(gen);
+        boxes[i * 4 + 0] = y;
+        boxes[i * 4 + 1] = x;
+        boxes[i * 4 + 2] = y + size(gen);
+        boxes[i * 4 + 3] = x + size(gen);
+    }
+
+    // [batch, spatial, classes] storage read as [batch, classes, spatial]
+    std::vector<float> scores(batches * spatial * classes);
+    for (auto &s : scores)
+        s = score(gen);
+    // Few boxes of the last class pass the score threshold, so its rows are padded
+    for (size_t i = 0; i < batches * spatial; i++)
+        scores[i * classes + classes - 1] *= 0.32f;
+    runtime_shape_t boxes_shape { batches, spatial, 4 }, scores_shape { batches, classes, spatial };
+    runtime_shape_t scores_strides { spatial * classes, 1, classes };
+
+    const auto rows = batches * classes * max_per_class * 3;
+    std::vector<int64_t> expected(rows);
+    ASSERT_TRUE(cpu::reference::detection_postprocess(boxes.data(), boxes_shape, get_default_strides(boxes_shape), scores.data(), scores_shape,
+        scores_strides, expected.data(), false, max_per_class, 0.4f, 0.3f)
+                    .is_ok());
+    EXPECT_NE(expected.end(), std::find(expected.begin(), expected.end(), -1));
+
+    for (auto &[name, nms] : nms_impls())
+    {
+        std::vector<int64_t> output(rows, 7);
+        ASSERT_TRUE(nms(boxes.data(), boxes_shape, get_default_strides(boxes_shape), scores.data(), scores_shape, scores_strides,
+            output.data(), false, max_per_class, 0.4f, 0.3f)
+                        .is_ok());
+        EXPECT_EQ(expected, output) << name;
+    }
+}
@@ -0,0 +1,212 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <nncase/functional/ops.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+
+namespace
+{
+template <class T>
+runtime_tensor make_tensor(datatype_t type, const runtime_shape_t &shape, const std::vector<T> &values)
+{
+    auto tensor = hrt::create(type, shape).unwrap_or_throw();
+    auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+    std::copy(values.begin(), values.end(), map.buffer().as_span<T>().begin());
+    return tensor;
+}
+
+template <class T>
+std::vector<T> read_tensor(runtime_tensor &tensor)
+{
+    auto map = std::move(hrt::map(tensor, hrt::map_read).unwrap_or_throw());
+    auto data = map.buffer().as_span<T>();
+    return { data.begin(), data.end() };
+}
+
+std::vector<float> arange(size_t count, float start, float step)
+{
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; i++)
+        values[i] = start + step * i;
+    return values;
+}
+}
+
+TEST(FunctionalTest, unary)
+{
+    using F_unary = result<runtime_tensor> (*)(runtime_tensor &, datatype_t) noexcept;
+    const std::vector<std::tuple<const char *, F_unary, float (*)(float)>> ops {
+        { "abs", F::abs, [](float v) { return std::fabs(v); } },
+        { "ceil", F::ceil, [](float v) { return std::ceil(v); } },
+        { "cos", F::cos, [](float v) { return std::cos(v); } },
+        { "exp", F::exp, [](float v) { return std::exp(v); } },
+        { "floor", F::floor, [](float v) { return std::floor(v); } },
+        { "log", F::log, [](float v) { return std::log(std::fabs(v) + 1.f); } },
+        { "neg", F::neg, [](float v) { return -v; } },
+        { "round", F::round, [](float v) { return std::round(v); } },
+        { "sin", F::sin, [](float v) { return std::sin(v); } },
+        { "sqrt", F::sqrt, [](float v) { return std::sqrt(std::fabs(v) + 1.f); } },
+        { "square", F::square, [](float v) { return v * v; } },
+    };
+
+    runtime_shape_t shape { 1, 3, 4, 5 };
+    auto values = arange(60, -3.1f, 0.13f);
+    for (auto &[name, op, expected] : ops)
+    {
+        // log and sqrt only take positive inputs
+        auto positive = std::string_view(name) == "log" || std::string_view(name) == "sqrt";
+        auto in_values = values;
+        if (positive)
+            std::transform(values.begin(), values.end(), in_values.begin(), [](float v) { return std::fabs(v) + 1.f; });
+
+        auto input = make_tensor(dt_float32, shape, in_values);
+        auto output = op(input, dt_float32).unwrap_or_throw();
+        EXPECT_EQ(shape, output.shape()) << name;
+        auto actual = read_tensor<float>(output);
+        for (size_t i = 0; i < values.size(); i++)
+            ASSERT_NEAR(expected(values[i]), actual[i], 1e-4f) << name << " at " << i;
+    }
+
+    // Only float is implemented
+    auto u8 = make_tensor<uint8_t>(dt_uint8, shape, std::vector<uint8_t>(60));
+    EXPECT_TRUE(F::neg(u8, dt_uint8).is_err());
+}
+
+TEST(FunctionalTest, binary)
+{
+    using F_binary = result<runtime_tensor> (*)(runtime_tensor &, runtime_tensor &, datatype_t) noexcept;
+    const std::vector<std::tuple<const char *, F_binary, float (*)(float, float)>> ops {
+        { "add", F::add, [](float a, float b) { return a + b; } },
+        { "sub", F::sub, [](float a, float b) { return a - b; } },
+        { "mul", F::mul, [](float a, float b) { return a * b; } },
+        { "div", F::div, [](float a, float b) { return a / b; } },
+        { "min", F::min, [](float a, float b) { return std::min(a, b); } },
+        { "max", F::max, [](float a, float b) { return std::max(a, b); } },
+    };
+
+    // b is broadcast along the rows of a
+    auto a_values = arange(12, -2.f, 0.5f);
+    auto b_values = std::vector<float> { 0.5f, -1.f, 3.f };
+    auto a = make_tensor(dt_float32, { 4, 3 }, a_values);
+    auto b = make_tensor(dt_float32, { 3 }, b_values);
+    for (auto &[name, op, expected] : ops)
+    {
+        auto output = op(a, b, dt_float32).unwrap_or_throw();
+        EXPECT_EQ((runtime_shape_t { 4, 3 }), output.shape()) << name;
+        auto actual = read_tensor<float>(output);
+        for (size_t i = 0; i < a_values.size(); i++)
+            ASSERT_NEAR(expected(a_values[i], b_values[i % 3]), actual[i], 1e-5f) << name << " at " << i;
+    }
+}
+
+TEST(FunctionalTest, quantize_dequantize)
+{
+    const quant_param_t param { 10, 0.25f };
+    // Multiples of the scale survive the round trip exactly
+    std::vector<float> values;
+    for (int32_t q = 0; q < 256; q += 3)
+        values.emplace_back((q - param.zero_point) * param.scale);
+
+    runtime_shape_t shape { values.size() };
+    auto input = make_tensor(dt_float32, shape, values);
+    input.quant_param(param);
+    auto quantized = F::quantize(input, dt_uint8).unwrap_or_throw();
+    EXPECT_EQ(dt_uint8, quantized.datatype());
+    EXPECT_EQ(param, quantized.quant_param());
+    auto q = read_tensor<uint8_t>(quantized);
+    for (size_t i = 0; i < q.size(); i++)
+        ASSERT_EQ(i * 3, q[i]) << "at " << i;
+
+    auto dequantized = F::dequantize(quantized, dt_float32).unwrap_or_throw();
+    EXPECT_EQ(dt_float32, dequantized.datatype());
+    EXPECT_EQ(values, read_tensor<float>(dequantized));
+
+    EXPECT_TRUE(F::quantize(input, dt_float32).is_err());
+    EXPECT_TRUE(F::dequantize(input, dt_float32).is_err());
+}
+
+TEST(FunctionalTest, resize)
+{
+    runtime_shape_t in_shape { 2, 3, 6, 7 };
+    auto input = make_tensor(dt_float32, in_shape, arange(runtime::compute_size(in_shape), 0.f, 0.5f));
+    for (auto mode : { image_resize_bilinear, image_resize_nearest_neighbor })
+    {
+        auto output = F::resize(input, 11, 5, mode, false, true).unwrap_or_throw();
+        runtime_shape_t out_shape { 2, 3, 11, 5 };
+        EXPECT_EQ(out_shape, output.shape());
+
+        auto expected = hrt::create(dt_float32, out_shape).unwrap_or_throw();
+        auto kernel = mode == image_resize_bilinear ? cpu::reference::resize_bilinear : cpu::reference::resize_nearest_neighbor;
+        ASSERT_TRUE(kernel(dt_float32, get_tensor_cbegin(input), get_tensor_begin(expected), in_shape, input.strides(), expected.strides(),
+            11, 5, false, true, default_kernel_context())
+                        .is_ok());
+        auto e = read_tensor<float>(expected);
+        auto a = read_tensor<float>(output);
+        for (size_t i = 0; i < e.size(); i++)
+            ASSERT_NEAR(e[i], a[i], 1e-4f) << "mode " << mode << " at " << i;
+    }
+}
+
+TEST(FunctionalTest, crop)
+{
+    // in[n][c][y][x] = n * 1000 + c * 100 + y * 10 + x
+    runtime_shape_t in_shape { 2, 2, 8, 8 };
+    std::vector<float> values;
+    for (size_t i = 0; i < runtime::compute_size(in_shape); i++)
+        values.emplace_back((float)(i / 128 * 1000 + i / 64 % 2 * 100 + i / 8 % 8 * 10 + i % 8));
+    auto input = make_tensor(dt_float32, in_shape, values);
+
+    // [y0, x0, y1, x1), both rois 4x4 so nearest neighbor copies them as is
+    auto bbox = make_tensor(dt_float32, { 1, 1, 2, 4 }, std::vector<float> { 0.f, 0.f, 4.f, 4.f, 2.f, 3.f, 6.f, 7.f });
+    const size_t origins[][2] { { 0, 0 }, { 2, 3 } };
+    auto output = F::crop(input, bbox, 4, 4, image_resize_nearest_neighbor, false, false).unwrap_or_throw();
+    EXPECT_EQ((runtime_shape_t { 4, 2, 4, 4 }), output.shape());
+
+    auto actual = read_tensor<float>(output);
+    for (size_t n = 0; n < 2; n++)
+        for (size_t r = 0; r < 2; r++)
+            for (size_t c = 0; c < 2; c++)
+                for (size_t y = 0; y < 4; y++)
+                    for (size_t x = 0; x < 4; x++)
+                    {
+                        auto expected = (float)(n * 1000 + c * 100 + (origins[r][0] + y) * 10 + origins[r][1] + x);
+                        ASSERT_EQ(expected, actual[offset(output.strides(), runtime_shape_t { n * 2 + r, c, y, x })])
+                            << "n " << n << " roi " << r << " c " << c << " y " << y << " x " << x;
+                    }
+
+    auto empty_bbox = make_tensor(dt_float32, { 1, 1, 1, 4 }, std::vector<float> { 2.f, 2.f, 2.f, 5.f });
+    EXPECT_TRUE(F::crop(input, empty_bbox, 4, 4, image_resize_bilinear, false, false).is_err());
+}
+
+TEST(FunctionalTest, pad)
+{
+    runtime_shape_t in_shape { 1, 1, 2, 3 };
+    auto input = make_tensor(dt_float32, in_shape, arange(6, 1.f, 1.f));
+
+    // Paddings start from the last dim
+    runtime_paddings_t paddings { { 1, 2 }, { 0, 1 } };
+    auto output = F::pad(input, paddings, pad_constant, 9.f).unwrap_or_throw();
+    EXPECT_EQ((runtime_shape_t { 1, 1, 3, 6 }), output.shape());
+    EXPECT_EQ((std::vector<float> {
+                  9, 1, 2, 3, 9, 9,
+                  9, 4, 5, 6, 9, 9,
+                  9, 9, 9, 9, 9, 9 }),
+        read_tensor<float>(output));
+
+    runtime_paddings_t too_many(5, padding::zero());
+    EXPECT_TRUE(F::pad(input, too_many, pad_constant, 0.f).is_err());
+}
@@ -0,0 +1,108 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+class ImagePreprocessTest : public ::testing::TestWithParam<
+                                std::tuple<
+                                    runtime_shape_t, // input shape (NHWC)
+                                    std::array<int32_t, 2>, // model input size
+                                    bool, // swapRB
+                                    bool>> // output NHWC
+{
+public:
+    void SetUp() override
+    {
+        auto &&[in_shape, model_size, swap_rb, output_nhwc] = GetParam();
+
+        input = host_runtime_tensor::create(dt_uint8, in_shape).unwrap_or_throw();
+        {
+            std::mt19937 gen(42);
+            std::uniform_int_distribution<int32_t> dis(0, 255);
+            auto map = std::move(hrt::map(input, hrt::map_write).unwrap_or_throw());
+            for (auto &v : map.buffer().as_span<uint8_t>())
+                v = (uint8_t)dis(gen);
+        }
+
+        // letterbox
+        auto ratio = std::min(model_size[0] / float(in_shape[1]), model_size[1] / float(in_shape[2]));
+        resize_h = (int32_t)std::round(in_shape[1] * ratio);
+        resize_w = (int32_t)std::round(in_shape[2] * ratio);
+        pad_top = (model_size[0] - resize_h) / 2;
+        pad_left = (model_size[1] - resize_w) / 2;
+
+        auto channels = in_shape[3];
+        out_shape = output_nhwc ? runtime_shape_t { in_shape[0], (size_t)model_size[0], (size_t)model_size[1], channels }
+                                : runtime_shape_t { in_shape[0], channels, (size_t)model_size[0], (size_t)model_size[1] };
+        output_ref = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 0));
+        output_opt = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 0));
+
+        mean.assign(channels, 0.f);
+        stddev.assign(channels, 1.f);
+        for (size_t c = 0; c < channels; c++)
+        {
+            mean[c] = 0.4f + 0.05f * c;
+            stddev[c] = 0.2f + 0.02f * c;
+        }
+
+        this->swap_rb = swap_rb;
+        this->output_nhwc = output_nhwc;
+    }
+
+    runtime_tensor input, output_ref, output_opt;
+    runtime_shape_t out_shape;
+    std::vector<float> mean, stddev;
+    int32_t resize_h, resize_w, pad_top, pad_left;
+    bool swap_rb;
+    bool output_nhwc;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ImagePreprocess,
+    ImagePreprocessTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 1, 24, 32, 3 }, // input shape
+            runtime_shape_t { 2, 17, 9, 3 }),
+        testing::Values(
+            std::array<int32_t, 2> { 20, 20 }, // model input size
+            std::array<int32_t, 2> { 48, 40 }),
+        testing::Bool(),
+        testing::Bool()));
+
+TEST_P(ImagePreprocessTest, normal)
+{
+    quant_param_t in_param { 0, 1.f / 255 };
+    auto in_shape = input.shape();
+    auto input_ptr = reinterpret_cast<const uint8_t *>(get_tensor_cbegin(input));
+    NNCASE_UNUSED auto ref = cpu::reference::image_preprocess(input_ptr, mean.data(), stddev.data(),
+        reinterpret_cast<float *>(get_tensor_begin(output_ref)), in_shape, input.strides(), out_shape, output_ref.strides(),
+        in_param, true, swap_rb, resize_h, resize_w, pad_top, pad_left, 0.5f, output_nhwc);
+    NNCASE_UNUSED auto opt = cpu::optimized::image_preprocess(input_ptr, mean.data(), stddev.data(),
+        reinterpret_cast<float *>(get_tensor_begin(output_opt)), in_shape, out_shape,
+        in_param, true, swap_rb, resize_h, resize_w, pad_top, pad_left, 0.5f, output_nhwc);
+
+    // The optimized kernel multiplies by the reciprocal of stddev
+    auto ref_map = std::move(hrt::map(output_ref, hrt::map_read).unwrap_or_throw());
+    auto opt_map = std::move(hrt::map(output_opt, hrt::map_read).unwrap_or_throw());
+    auto r = ref_map.buffer().as_span<float>();
+    auto o = opt_map.buffer().as_span<float>();
+    for (size_t i = 0; i < r.size(); i++)
+        ASSERT_NEAR(r[i], o[i], 1e-4f) << "at " << i;
+}
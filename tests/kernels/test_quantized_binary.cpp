@@ -0,0 +1,96 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+class QuantizedBinaryTest : public ::testing::TestWithParam<
+                                std::tuple<
+                                    binary_op_t,
+                                    runtime_shape_t, // input a shape
+                                    runtime_shape_t, // input b shape
+                                    value_range<float>>> // fused activation
+{
+public:
+    void SetUp() override
+    {
+        auto &&[op, in_a_shape, in_b_shape, fused_activation] = GetParam();
+
+        input_a = create_input(in_a_shape, 1);
+        input_b = create_input(in_b_shape, 2);
+        auto out_shape = kernels::detail::get_binary_output_shape(in_a_shape, in_b_shape);
+        output_ref = host_runtime_tensor::create(dt_uint8, out_shape).unwrap_or_throw();
+        output_opt = host_runtime_tensor::create(dt_uint8, out_shape).unwrap_or_throw();
+
+        this->op = op;
+        this->fused_activation = fused_activation;
+    }
+
+    static runtime_tensor create_input(const runtime_shape_t &shape, uint32_t seed)
+    {
+        auto tensor = host_runtime_tensor::create(dt_uint8, shape).unwrap_or_throw();
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int32_t> dis(0, 255);
+        auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+        for (auto &v : map.buffer().as_span<uint8_t>())
+            v = (uint8_t)dis(gen);
+        return tensor;
+    }
+
+    runtime_tensor input_a, input_b, output_ref, output_opt;
+    binary_op_t op;
+    value_range<float> fused_activation;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    QuantizedBinary,
+    QuantizedBinaryTest,
+    testing::Combine(
+        testing::Values(binary_add, binary_sub, binary_mul),
+        testing::Values(
+            runtime_shape_t { 1, 3, 16, 16 }, // input a shape
+            runtime_shape_t { 1 }),
+        testing::Values(
+            runtime_shape_t { 1, 3, 16, 16 }, // input b shape
+            runtime_shape_t { 1, 1, 1, 1 }),
+        testing::Values(
+            value_range<float>::full(), // fused activation
+            value_range<float> { 0.f, 6.f })));
+
+TEST_P(QuantizedBinaryTest, normal)
+{
+    quant_param_t a_param { 120, 0.02f };
+    quant_param_t b_param { 30, 0.05f };
+    quant_param_t out_param { 100, 0.07f };
+
+    auto a_ptr = reinterpret_cast<const uint8_t *>(get_tensor_cbegin(input_a));
+    auto b_ptr = reinterpret_cast<const uint8_t *>(get_tensor_cbegin(input_b));
+    NNCASE_UNUSED auto ref = cpu::reference::quantized_binary(op, a_ptr, b_ptr, reinterpret_cast<uint8_t *>(get_tensor_begin(output_ref)),
+        input_a.shape(), input_a.strides(), input_b.shape(), input_b.strides(), output_ref.strides(),
+        a_param, b_param, out_param, fused_activation, default_kernel_context());
+    NNCASE_UNUSED auto opt = cpu::optimized::quantized_binary(op, a_ptr, b_ptr, reinterpret_cast<uint8_t *>(get_tensor_begin(output_opt)),
+        input_a.shape(), input_b.shape(), a_param, b_param, out_param, fused_activation, default_kernel_context());
+
+    // The optimized kernel folds requantization into one affine expression, so rounding may differ by one step
+    auto ref_map = std::move(hrt::map(output_ref, hrt::map_read).unwrap_or_throw());
+    auto opt_map = std::move(hrt::map(output_opt, hrt::map_read).unwrap_or_throw());
+    auto r = ref_map.buffer().as_span<uint8_t>();
+    auto o = opt_map.buffer().as_span<uint8_t>();
+    for (size_t i = 0; i < r.size(); i++)
+        ASSERT_LE(std::abs((int32_t)r[i] - (int32_t)o[i]), 1) << "at " << i;
+}
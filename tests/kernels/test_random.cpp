@@ -0,0 +1,102 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+TEST(PhiloxTest, known_answer)
+{
+    // Random123 kat_vectors for philox4x32-10
+    using kernels::detail::philox4x32;
+    EXPECT_EQ(philox4x32(kernels::detail::philox_block { 0, 0, 0, 0 }, { 0, 0 }),
+        (kernels::detail::philox_block { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+    EXPECT_EQ(philox4x32(kernels::detail::philox_block { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }),
+        (kernels::detail::philox_block { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }));
+    EXPECT_EQ(philox4x32(kernels::detail::philox_block { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }),
+        (kernels::detail::philox_block { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }));
+}
+
+class RandomTest : public ::testing::TestWithParam<
+                       std::tuple<
+                           runtime_shape_t, // output shape
+                           float>> // seed
+{
+public:
+    void SetUp() override
+    {
+        auto &&[out_shape, seed] = GetParam();
+        this->out_shape = out_shape;
+        this->seed = seed;
+        size = compute_size(out_shape);
+    }
+
+    runtime_shape_t out_shape;
+    float seed;
+    size_t size;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Random,
+    RandomTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 1, 3, 64, 64 }, // output shape
+            runtime_shape_t { 7, 13 },
+            runtime_shape_t { 3 }),
+        testing::Values(0.f, 42.f)));
+
+TEST_P(RandomTest, uniform)
+{
+    std::vector<float> ref(size), opt(size), opt_mt(size);
+    kernel_context single { 1 }, multi { 4 };
+    ASSERT_TRUE(cpu::reference::random_uniform(ref.data(), out_shape, -2.f, 3.f, seed).is_ok());
+    ASSERT_TRUE(cpu::optimized::random_uniform(opt.data(), out_shape, -2.f, 3.f, seed, single).is_ok());
+    ASSERT_TRUE(cpu::optimized::random_uniform(opt_mt.data(), out_shape, -2.f, 3.f, seed, multi).is_ok());
+
+    for (size_t i = 0; i < size; i++)
+    {
+        ASSERT_GE(ref[i], -2.f) << "at " << i;
+        ASSERT_LT(ref[i], 3.f) << "at " << i;
+        ASSERT_FLOAT_EQ(ref[i], opt[i]) << "at " << i;
+        ASSERT_EQ(opt[i], opt_mt[i]) << "at " << i;
+    }
+}
+
+TEST_P(RandomTest, normal)
+{
+    std::vector<float> ref(size), opt(size), opt_mt(size);
+    kernel_context single { 1 }, multi { 4 };
+    ASSERT_TRUE(cpu::reference::random_normal(ref.data(), out_shape, 1.f, 0.5f, seed).is_ok());
+    ASSERT_TRUE(cpu::optimized::random_normal(opt.data(), out_shape, 1.f, 0.5f, seed, single).is_ok());
+    ASSERT_TRUE(cpu::optimized::random_normal(opt_mt.data(), out_shape, 1.f, 0.5f, seed, multi).is_ok());
+
+    for (size_t i = 0; i < size; i++)
+    {
+        ASSERT_TRUE(std::isfinite(ref[i])) << "at " << i;
+        ASSERT_FLOAT_EQ(ref[i], opt[i]) << "at " << i;
+        ASSERT_EQ(opt[i], opt_mt[i]) << "at " << i;
+    }
+
+    if (size >= 4096)
+    {
+        auto mean = std::accumulate(ref.begin(), ref.end(), 0.) / size;
+        auto var = std::accumulate(ref.begin(), ref.end(), 0., [&](double acc, float v) { return acc + (v - mean) * (v - mean); }) / size;
+        EXPECT_NEAR(mean, 1., 0.05);
+        EXPECT_NEAR(std::sqrt(var), 0.5, 0.05);
+    }
+}
@@ -0,0 +1,88 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/reduce_window.h>
+#include <nncase/runtime/debug.h>
+
+class ReduceWindow2DQuantizedTest : public ::testing::TestWithParam<
+                                        std::tuple<
+                                            datatype_t,
+                                            reduce_op_t,
+                                            padding, // padding h & w
+                                            value_range<float>>> // fused activation
+{
+public:
+    // Quantized windows are reduced on the raw integers, which must match
+    // reducing the dequantized values in float and quantizing the result
+    template <class T>
+    void run(const quant_param_t &param)
+    {
+        auto &&[type, op, pad, fused_activation] = GetParam();
+        runtime_shape_t in_shape { 1, 3, 17, 15 };
+        const int32_t filter = 3, stride = 2, dilation = 1;
+        auto out_h = kernels::detail::get_windowed_output_size(in_shape[2], filter, stride, dilation, pad);
+        auto out_w = kernels::detail::get_windowed_output_size(in_shape[3], filter, stride, dilation, pad);
+        runtime_shape_t out_shape { in_shape[0], in_shape[1], out_h, out_w };
+        auto in_strides = get_default_strides(in_shape);
+        auto out_strides = get_default_strides(out_shape);
+
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<int32_t> dis(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+        std::vector<T> input(runtime::compute_size(in_shape));
+        std::vector<float> input_float(input.size());
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = (T)dis(gen);
+            input_float[i] = kernels::detail::dequantize(input[i], param);
+        }
+
+        auto init_value = op == reduce_min ? std::numeric_limits<float>::max() : op == reduce_max ? std::numeric_limits<float>::lowest() : 0.f;
+        value_range<float> q_activation { fused_activation.min / param.scale + param.zero_point, fused_activation.max / param.scale + param.zero_point };
+        std::vector<T> output(runtime::compute_size(out_shape));
+        std::vector<float> expected(output.size());
+        ASSERT_TRUE(kernels::reduce_window2d(op, input.data(), init_value, output.data(), in_shape, in_strides, out_strides,
+            pad, pad, filter, filter, stride, stride, dilation, dilation, q_activation)
+                        .is_ok());
+        ASSERT_TRUE(kernels::reduce_window2d(op, input_float.data(), init_value, expected.data(), in_shape, in_strides, out_strides,
+            pad, pad, filter, filter, stride, stride, dilation, dilation, fused_activation)
+                        .is_ok());
+
+        for (size_t i = 0; i < output.size(); i++)
+        {
+            auto expected_q = (int32_t)kernels::detail::quantize<T>(expected[i], param);
+            EXPECT_LE(std::abs((int32_t)output[i] - expected_q), op == reduce_mean ? 1 : 0) << "type " << datatype_names(type) << ", at " << i;
+        }
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ReduceWindow2DQuantized,
+    ReduceWindow2DQuantizedTest,
+    testing::Combine(
+        testing::Values(dt_uint8, dt_int8),
+        testing::Values(reduce_mean, reduce_min, reduce_max),
+        testing::Values(padding::zero(), padding { 1, 1 }),
+        testing::Values(
+            value_range<float>::full(), // fused activation
+            value_range<float> { 0.f, 6.f })));
+
+TEST_P(ReduceWindow2DQuantizedTest, normal)
+{
+    if (std::get<0>(GetParam()) == dt_uint8)
+        run<uint8_t>({ 100, 0.05f });
+    else
+        run<int8_t>({ -10, 0.05f });
+}
@@ -0,0 +1,130 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/tensor_compute.h>
+
+class ResizeTest : public ::testing::TestWithParam<
+                       std::tuple<
+                           datatype_t,
+                           image_resize_mode_t,
+                           runtime_shape_t, // input strides bias
+                           std::array<int32_t, 2>, // out h, w
+                           std::array<bool, 2>>> // align corners, half pixel centers
+{
+public:
+    void SetUp() override
+    {
+        auto &&[type, mode, in_strides_bias, out_size, flags] = GetParam();
+        this->type = type;
+        this->mode = mode;
+        out_h = out_size[0];
+        out_w = out_size[1];
+        align_corners = flags[0];
+        half_pixel_centers = flags[1];
+
+        // Biased strides make the input a view, with rows still dense
+        runtime_shape_t in_shape { 2, 3, 9, 11 };
+        input = host_runtime_tensor::create(type, in_shape, get_strides(in_shape, in_strides_bias)).unwrap_or_throw();
+        {
+            std::mt19937 gen(42);
+            std::uniform_int_distribution<int32_t> dis(0, 255);
+            auto map = std::move(hrt::map(input, hrt::map_write).unwrap_or_throw());
+            auto data = map.buffer();
+            NNCASE_UNUSED auto res = cpu::reference::apply(in_shape, [&](const runtime_shape_t &index) -> result<void> {
+                auto off = offset(input.strides(), index);
+                if (type == dt_float32)
+                    data.as_span<float>()[off] = dis(gen) / 16.f;
+                else
+                    data.as_span<uint8_t>()[off] = (uint8_t)dis(gen);
+                return ok();
+            });
+        }
+
+        runtime_shape_t out_shape { in_shape[0], in_shape[1], (size_t)out_h, (size_t)out_w };
+        output_ref = host_runtime_tensor::create(type, out_shape).unwrap_or_throw();
+        output_opt = host_runtime_tensor::create(type, out_shape).unwrap_or_throw();
+        output_dispatch = host_runtime_tensor::create(type, out_shape).unwrap_or_throw();
+    }
+
+    result<void> resize(result<void> (*bilinear)(datatype_t, const gsl::byte *, gsl::byte *, const runtime_shape_t &, const runtime_shape_t &, const runtime_shape_t &, int32_t, int32_t, bool, bool, kernel_context &),
+        result<void> (*nearest)(datatype_t, const gsl::byte *, gsl::byte *, const runtime_shape_t &, const runtime_shape_t &, const runtime_shape_t &, int32_t, int32_t, bool, bool, kernel_context &),
+        runtime_tensor &output)
+    {
+        auto kernel = mode == image_resize_bilinear ? bilinear : nearest;
+        return kernel(type, get_tensor_cbegin(input), get_tensor_begin(output), input.shape(), input.strides(), output.strides(),
+            out_h, out_w, align_corners, half_pixel_centers, default_kernel_context());
+    }
+
+    void check(runtime_tensor &expected, runtime_tensor &actual)
+    {
+        auto e_map = std::move(hrt::map(expected, hrt::map_read).unwrap_or_throw());
+        auto a_map = std::move(hrt::map(actual, hrt::map_read).unwrap_or_throw());
+        if (type == dt_float32)
+        {
+            auto e = e_map.buffer().as_span<float>();
+            auto a = a_map.buffer().as_span<float>();
+            for (size_t i = 0; i < e.size(); i++)
+                ASSERT_NEAR(e[i], a[i], 1e-4f) << "at " << i;
+        }
+        else
+        {
+            auto e = e_map.buffer().as_span<uint8_t>();
+            auto a = a_map.buffer().as_span<uint8_t>();
+            for (size_t i = 0; i < e.size(); i++)
+                ASSERT_NEAR(e[i], a[i], 1) << "at " << i;
+        }
+    }
+
+    datatype_t type;
+    image_resize_mode_t mode;
+    int32_t out_h, out_w;
+    bool align_corners, half_pixel_centers;
+    runtime_tensor input, output_ref, output_opt, output_dispatch;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Resize,
+    ResizeTest,
+    testing::Combine(
+        testing::Values(dt_float32, dt_uint8),
+        testing::Values(image_resize_bilinear, image_resize_nearest_neighbor),
+        testing::Values(
+            runtime_shape_t { 0, 0, 0, 0 }, // input strides bias
+            runtime_shape_t { 0, 0, 0, 5 },
+            runtime_shape_t { 0, 0, 2, 0 },
+            runtime_shape_t { 0, 1, 0, 0 },
+            runtime_shape_t { 3, 3, 3, 3 }),
+        testing::Values(
+            std::array<int32_t, 2> { 18, 22 }, // out h, w
+            std::array<int32_t, 2> { 4, 5 },
+            std::array<int32_t, 2> { 9, 1 }),
+        testing::Values(
+            std::array<bool, 2> { false, false },
+            std::array<bool, 2> { true, false },
+            std::array<bool, 2> { false, true })));
+
+TEST_P(ResizeTest, strided_input)
+{
+    ASSERT_TRUE(resize(cpu::reference::resize_bilinear, cpu::reference::resize_nearest_neighbor, output_ref).is_ok());
+    ASSERT_TRUE(resize(cpu::optimized::resize_bilinear, cpu::optimized::resize_nearest_neighbor, output_opt).is_ok());
+    // Dense rows dispatch to the optimized kernel whatever the outer strides are
+    ASSERT_TRUE(resize(kernels::resize_bilinear, kernels::resize_nearest_neighbor, output_dispatch).is_ok());
+
+    check(output_ref, output_opt);
+    check(output_ref, output_dispatch);
+}
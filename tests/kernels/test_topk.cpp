@@ -0,0 +1,105 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_util.h"
+#include <gtest/gtest.h>
+#include <nncase/kernels/cpu/optimized/tensor_compute.h>
+#include <nncase/kernels/cpu/reference/tensor_compute.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/runtime/runtime_op_utility.h>
+
+class TopKTest : public ::testing::TestWithParam<
+                     std::tuple<
+                         runtime_shape_t, // input shape
+                         size_t, // axis
+                         int64_t, // k
+                         bool, // largest
+                         bool>> // sorted
+{
+public:
+    void SetUp() override
+    {
+        auto &&[data_shape, axis, k, largest, sorted] = GetParam();
+
+        input = create_input_tensor(data_shape, runtime_shape_t(data_shape.size(), 0));
+
+        auto out_shape = data_shape;
+        out_shape[axis] = (size_t)k;
+        values_ref = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 0));
+        values_opt = create_tensor(out_shape, runtime_shape_t(out_shape.size(), 0));
+        indices_ref = host_runtime_tensor::create(dt_int64, out_shape).unwrap();
+        indices_opt = host_runtime_tensor::create(dt_int64, out_shape).unwrap();
+
+        this->axis = (int32_t)axis;
+        this->k = k;
+        this->largest = largest;
+        this->sorted = sorted;
+    }
+
+    runtime_tensor input, values_ref, values_opt, indices_ref, indices_opt;
+    int32_t axis;
+    int64_t k;
+    bool largest;
+    bool sorted;
+};
+
+bool is_same_indices(runtime_tensor &lhs, runtime_tensor &rhs)
+{
+    auto lhs_map = std::move(hrt::map(lhs, hrt::map_read).unwrap_or_throw());
+    auto rhs_map = std::move(hrt::map(rhs, hrt::map_read).unwrap_or_throw());
+    auto l = lhs_map.buffer().as_span<int64_t>();
+    auto r = rhs_map.buffer().as_span<int64_t>();
+    return std::equal(l.begin(), l.end(), r.begin(), r.end());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TopKTestLastAxis,
+    TopKTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 3, 1000 }, // input shape
+            runtime_shape_t { 6, 67 }),
+        testing::Values(1), // axis
+        testing::Values(1, 5, 40),
+        testing::Bool(),
+        testing::Bool()));
+
+INSTANTIATE_TEST_SUITE_P(
+    TopKTestInnerAxis,
+    TopKTest,
+    testing::Combine(
+        testing::Values(
+            runtime_shape_t { 4, 300, 3 }), // input shape
+        testing::Values(1), // axis
+        testing::Values(1, 7, 300),
+        testing::Bool(),
+        testing::Bool()));
+
+TEST_P(TopKTest, normal)
+{
+    auto in_shape = input.shape();
+    NNCASE_UNUSED auto ref = cpu::reference::topk(reinterpret_cast<const float *>(get_tensor_cbegin(input)),
+        reinterpret_cast<float *>(get_tensor_begin(values_ref)), reinterpret_cast<int64_t *>(get_tensor_begin(indices_ref)),
+        in_shape, input.strides(), values_ref.strides(), indices_ref.strides(), k, axis, largest, sorted);
+    NNCASE_UNUSED auto opt = cpu::optimized::topk(reinterpret_cast<const float *>(get_tensor_cbegin(input)),
+        reinterpret_cast<float *>(get_tensor_begin(values_opt)), reinterpret_cast<int64_t *>(get_tensor_begin(indices_opt)),
+        in_shape, k, axis, largest, sorted);
+
+    auto is_ok = is_same_tensor(values_ref, values_opt) && is_same_indices(indices_ref, indices_opt);
+    if (!is_ok)
+    {
+        output_all_data(input, values_ref, values_opt);
+        ASSERT_EQ(values_ref, values_opt);
+    }
+}
@@ -0,0 +1,182 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <gtest/gtest.h>
+#include <nncase/compiler.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/call.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/runtime/host_runtime_tensor.h>
+#include <nncase/runtime/interpreter.h>
+#include <nncase/runtime/runtime_function.h>
+#include <nncase/runtime/runtime_module.h>
+#include <sstream>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::runtime;
+
+namespace
+{
+const shape_t shape { 1, 16 };
+
+// in -> neg -> abs -> out, with neg and abs moved into a called function if requested
+std::vector<uint8_t> compile_model(bool with_call)
+{
+    compile_options options {};
+    options.target = "cpu";
+    auto compiler = compiler::create(options);
+    auto &graph = compiler->graph(0);
+    auto in = graph.emplace<input_node>(dt_float32, shape);
+    auto neg = graph.emplace<unary>(unary_neg, shape);
+    auto abs = graph.emplace<unary>(unary_abs, shape);
+    auto out = graph.emplace<output_node>(dt_float32, shape);
+    neg->input().connect(in->output());
+    abs->input().connect(neg->output());
+    out->input().connect(abs->output());
+
+    if (with_call)
+    {
+        std::vector<node *> nodes { neg, abs };
+        auto split = graph.split_subgraph(nodes);
+        auto &callee = graph.add_subgraph(std::move(split.subgraph));
+        auto c = graph.emplace<call>(callee);
+        for (auto &inp : split.inputs)
+            c->outer_connector(*inp.first).connect(*inp.second);
+        for (auto &outp : split.outputs)
+        {
+            auto &outer_out = c->outer_connector(*outp.first);
+            for (auto in : outp.second)
+                in->connect(outer_out);
+        }
+    }
+
+    compiler->compile();
+    std::stringstream kmodel;
+    compiler->gencode(kmodel);
+    auto str = kmodel.str();
+    return { str.begin(), str.end() };
+}
+
+runtime_tensor make_tensor(float first, const runtime_shape_t &tensor_shape = { 1, 16 })
+{
+    auto tensor = hrt::create(dt_float32, tensor_shape).unwrap_or_throw();
+    auto map = std::move(hrt::map(tensor, hrt::map_write).unwrap_or_throw());
+    auto data = map.buffer().as_span<float>();
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = first + (float)i;
+    return tensor;
+}
+
+// Whether output holds |-x| of the input, or else is untouched
+void check_output(runtime_tensor &input, runtime_tensor &output, bool computed, float untouched_first)
+{
+    auto in_map = std::move(hrt::map(input, hrt::map_read).unwrap_or_throw());
+    auto out_map = std::move(hrt::map(output, hrt::map_read).unwrap_or_throw());
+    auto in_data = in_map.buffer().as_span<float>();
+    auto out_data = out_map.buffer().as_span<float>();
+    for (size_t i = 0; i < out_data.size(); i++)
+        ASSERT_EQ(computed ? std::fabs(in_data[i]) : untouched_first + (float)i, out_data[i]) << "at " << i;
+}
+
+class CallTest : public ::testing::TestWithParam<bool>
+{
+public:
+    void SetUp() override
+    {
+        model = compile_model(GetParam());
+        interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+    }
+
+    std::vector<uint8_t> model;
+    interpreter interp;
+};
+}
+
+INSTANTIATE_TEST_SUITE_P(Call, CallTest, testing::Bool());
+
+TEST_P(CallTest, rebound_tensors)
+{
+    // Fresh tensors move the caller's inputs and outputs, which a call site has to follow
+    for (size_t round = 0; round < 3; round++)
+    {
+        auto input = make_tensor(-8.f * (round + 1));
+        auto output = make_tensor(1000.f);
+        ASSERT_TRUE(interp.input_tensor(0, input).is_ok());
+        ASSERT_TRUE(interp.output_tensor(0, output).is_ok());
+        ASSERT_TRUE(interp.run().is_ok());
+        check_output(input, output, true, 0.f);
+
+        // Same tensors with new data, the cached argument tensors see it
+        {
+            auto map = std::move(hrt::map(input, hrt::map_write).unwrap_or_throw());
+            for (auto &value : map.buffer().as_span<float>())
+                value = -value * 2.f;
+        }
+        ASSERT_TRUE(interp.run().is_ok());
+        check_output(input, output, true, 0.f);
+    }
+}
+
+TEST_P(CallTest, invoke_with_tensors)
+{
+    auto mod = interp.find_module_by_id(0).unwrap_or_throw();
+    auto func = mod->find_function_by_id(0).unwrap_or_throw();
+    ASSERT_EQ(1, func->inputs_size());
+    ASSERT_EQ(1, func->outputs_size());
+
+    auto in1 = make_tensor(-8.f);
+    auto out1 = make_tensor(1000.f);
+    runtime_tensor inputs1[] = { in1 };
+    runtime_tensor outputs1[] = { out1 };
+    ASSERT_TRUE(func->invoke(inputs1, outputs1).is_ok());
+    check_output(in1, out1, true, 0.f);
+
+    // Different tensors are bound, the previous output stays untouched
+    auto stale = make_tensor(2000.f);
+    ASSERT_TRUE(stale.copy_to(out1).is_ok());
+    auto in2 = make_tensor(3.f);
+    auto out2 = make_tensor(1000.f);
+    runtime_tensor inputs2[] = { in2 };
+    runtime_tensor outputs2[] = { out2 };
+    ASSERT_TRUE(func->invoke(inputs2, outputs2).is_ok());
+    check_output(in2, out2, true, 0.f);
+    check_output(in1, out1, false, 2000.f);
+    EXPECT_EQ(out2, func->output_tensor(0).unwrap_or_throw());
+
+    // Invoking again with the bound tensors
+    ASSERT_TRUE(func->invoke(inputs2, outputs2).is_ok());
+    check_output(in2, out2, true, 0.f);
+}
+
+TEST_P(CallTest, invoke_invalid_tensors)
+{
+    auto mod = interp.find_module_by_id(0).unwrap_or_throw();
+    auto func = mod->find_function_by_id(0).unwrap_or_throw();
+    ASSERT_EQ(1, func->inputs_size());
+    ASSERT_EQ(1, func->outputs_size());
+
+    auto input = make_tensor(0.f);
+    auto output = make_tensor(0.f);
+    runtime_tensor inputs[] = { input };
+    runtime_tensor outputs[] = { output };
+    runtime_tensor two_outputs[] = { output, output };
+    EXPECT_TRUE(func->invoke({}, outputs).is_err());
+    EXPECT_TRUE(func->invoke(inputs, two_outputs).is_err());
+
+    runtime_tensor bad_shape[] = { make_tensor(0.f, { 1, 8 }) };
+    EXPECT_TRUE(func->invoke(bad_shape, outputs).is_err());
+}
@@ -0,0 +1,178 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <gtest/gtest.h>
+#include <nncase/compiler.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/runtime/interpreter.h>
+#include <sstream>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::runtime;
+
+namespace
+{
+const shape_t shape { 1, 16 };
+const unary_op_t output_ops[] = { unary_neg, unary_abs, unary_square };
+
+float apply(unary_op_t op, float value)
+{
+    switch (op)
+    {
+    case unary_neg:
+        return -value;
+    case unary_abs:
+        return std::fabs(value);
+    default:
+        return value * value;
+    }
+}
+
+// One unary op of the input per output
+std::vector<uint8_t> compile_model(size_t outputs)
+{
+    compile_options options {};
+    options.target = "cpu";
+    auto compiler = compiler::create(options);
+    auto &graph = compiler->graph(0);
+    auto in = graph.emplace<input_node>(dt_float32, shape);
+    for (size_t i = 0; i < outputs; i++)
+    {
+        auto u = graph.emplace<unary>(output_ops[i % std::size(output_ops)], shape);
+        auto out = graph.emplace<output_node>(dt_float32, shape);
+        u->input().connect(in->output());
+        out->input().connect(u->output());
+    }
+
+    compiler->compile();
+    std::stringstream kmodel;
+    compiler->gencode(kmodel);
+    auto str = kmodel.str();
+    return { str.begin(), str.end() };
+}
+
+class InterpreterTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        model = compile_model(std::size(output_ops));
+        interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+
+        auto input = interp.input_tensor(0).unwrap_or_throw();
+        auto map = std::move(hrt::map(input, hrt::map_write).unwrap_or_throw());
+        auto data = map.buffer().as_span<float>();
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = (float)i - 7.5f;
+        input_data.assign(data.begin(), data.end());
+    }
+
+    void fill_outputs(float value)
+    {
+        for (size_t i = 0; i < interp.outputs_size(); i++)
+        {
+            auto output = interp.output_tensor(i).unwrap_or_throw();
+            auto map = std::move(hrt::map(output, hrt::map_write).unwrap_or_throw());
+            auto data = map.buffer().as_span<float>();
+            std::fill(data.begin(), data.end(), value);
+        }
+    }
+
+    // Whether output i holds its op applied to the input, or else is untouched
+    void check_output(size_t index, bool computed, float untouched)
+    {
+        auto output = interp.output_tensor(index).unwrap_or_throw();
+        auto map = std::move(hrt::map(output, hrt::map_read).unwrap_or_throw());
+        auto data = map.buffer().as_span<float>();
+        for (size_t i = 0; i < data.size(); i++)
+            ASSERT_EQ(computed ? apply(output_ops[index], input_data[i]) : untouched, data[i]) << "output " << index << " at " << i;
+    }
+
+    std::vector<uint8_t> model;
+    interpreter interp;
+    std::vector<float> input_data;
+};
+}
+
+TEST_F(InterpreterTest, run_all_outputs)
+{
+    ASSERT_EQ(std::size(output_ops), interp.outputs_size());
+    fill_outputs(1234.f);
+    ASSERT_TRUE(interp.run().is_ok());
+    for (size_t i = 0; i < interp.outputs_size(); i++)
+        check_output(i, true, 0.f);
+}
+
+TEST_F(InterpreterTest, run_requested_outputs)
+{
+    // Skipping the op computed last branches to the ret that ends the function
+    const std::vector<std::vector<size_t>> requests { { 0 }, { 1 }, { 2 }, { 0, 2 }, { 2, 1, 0 } };
+    for (auto &request : requests)
+    {
+        fill_outputs(1234.f);
+        ASSERT_TRUE(interp.run(request).is_ok());
+        for (size_t i = 0; i < interp.outputs_size(); i++)
+            check_output(i, std::find(request.begin(), request.end(), i) != request.end(), 1234.f);
+    }
+
+    // A full run afterwards computes everything again
+    fill_outputs(1234.f);
+    ASSERT_TRUE(interp.run().is_ok());
+    for (size_t i = 0; i < interp.outputs_size(); i++)
+        check_output(i, true, 0.f);
+}
+
+TEST_F(InterpreterTest, run_invalid_output)
+{
+    const size_t request[] = { 0, 3 };
+    EXPECT_TRUE(interp.run(request).is_err());
+}
+
+TEST(InterpreterOutputsTest, too_many_outputs)
+{
+    // Masks don't cover more than 32 outputs, a partial run computes all of them
+    constexpr size_t outputs = 33;
+    auto model = compile_model(outputs);
+    interpreter interp;
+    interp.load_model({ reinterpret_cast<const gsl::byte *>(model.data()), model.size() }).unwrap_or_throw();
+    ASSERT_EQ(outputs, interp.outputs_size());
+
+    std::vector<float> input_data;
+    {
+        auto input = interp.input_tensor(0).unwrap_or_throw();
+        auto map = std::move(hrt::map(input, hrt::map_write).unwrap_or_throw());
+        auto data = map.buffer().as_span<float>();
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = (float)i - 7.5f;
+        input_data.assign(data.begin(), data.end());
+    }
+
+    const size_t request[] = { 0, 32 };
+    ASSERT_TRUE(interp.run(request).is_ok());
+    for (size_t i = 0; i < outputs; i++)
+    {
+        auto output = interp.output_tensor(i).unwrap_or_throw();
+        auto map = std::move(hrt::map(output, hrt::map_read).unwrap_or_throw());
+        auto data = map.buffer().as_span<float>();
+        for (size_t j = 0; j < data.size(); j++)
+            ASSERT_EQ(apply(output_ops[i % std::size(output_ops)], input_data[j]), data[j]) << "output " << i << " at " << j;
+    }
+
+    const size_t invalid[] = { outputs };
+    EXPECT_TRUE(interp.run(invalid).is_err());
+}
@@ -0,0 +1,80 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nncase/compiler.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <sstream>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+namespace
+{
+const shape_t shape { 1, 3, 16, 16 };
+
+// A few outputs sharing constants, so the model has rdata and several text symbols
+std::string build_model(size_t codegen_threads, bool dump_asm, const std::filesystem::path &dump_dir)
+{
+    compile_options options {};
+    options.target = "cpu";
+    options.dump_asm = dump_asm;
+    options.dump_dir = dump_dir;
+    options.codegen_threads = codegen_threads;
+    auto compiler = compiler::create(options);
+    auto &graph = compiler->graph(0);
+    auto in = graph.emplace<input_node>(dt_float32, shape);
+    for (size_t i = 0; i < 4; i++)
+    {
+        std::vector<float> bias(shape[1], (float)i);
+        auto b = graph.emplace<constant>(dt_float32, shape_t { shape[1], 1, 1 }, std::span<const float>(bias));
+        auto add = graph.emplace<binary>(binary_add, shape, b->output().shape(), value_range<float>::full());
+        auto u = graph.emplace<unary>(i % 2 ? unary_abs : unary_neg, shape);
+        auto out = graph.emplace<output_node>(dt_float32, shape);
+        add->input_a().connect(in->output());
+        add->input_b().connect(b->output());
+        u->input().connect(add->output());
+        out->input().connect(u->output());
+    }
+
+    compiler->compile();
+    std::stringstream kmodel;
+    compiler->gencode(kmodel);
+    return kmodel.str();
+}
+}
+
+TEST(ModelBuilderTest, parallel_build_matches_serial)
+{
+    auto dump_dir = std::filesystem::temp_directory_path() / "nncase_model_builder_test";
+    for (bool dump_asm : { false, true })
+    {
+        std::filesystem::remove_all(dump_dir);
+        auto serial = build_model(1, dump_asm, dump_dir / "serial");
+        ASSERT_FALSE(serial.empty());
+        for (size_t threads : { 2, 0 })
+        {
+            // Repeat to give a scheduling dependent result a chance to show up
+            for (size_t i = 0; i < 3; i++)
+                EXPECT_EQ(serial, build_model(threads, dump_asm, dump_dir / "parallel")) << "threads " << threads << ", dump_asm " << dump_asm;
+        }
+    }
+
+    std::filesystem::remove_all(dump_dir);
+}
@@ -0,0 +1,122 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <nncase/compiler.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/simulator.h>
+#include <sstream>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+namespace
+{
+const shape_t in_shape { 1, 3, 4, 4 };
+
+// output = -input
+std::vector<uint8_t> compile_neg_model()
+{
+    compile_options options {};
+    options.target = "cpu";
+    auto compiler = compiler::create(options);
+    auto &graph = compiler->graph(0);
+    auto in = graph.emplace<input_node>(dt_float32, in_shape);
+    auto neg = graph.emplace<unary>(unary_neg, in_shape);
+    auto out = graph.emplace<output_node>(dt_float32, in_shape);
+    neg->input().connect(in->output());
+    out->input().connect(neg->output());
+
+    compiler->compile();
+    std::stringstream kmodel;
+    compiler->gencode(kmodel);
+    auto str = kmodel.str();
+    return { str.begin(), str.end() };
+}
+
+class SimulatorTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        auto name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        root = std::filesystem::temp_directory_path() / "nncase_simulator_test" / name;
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root / "dataset");
+        options.output_path = root / "output";
+        options.dataset = root / "dataset";
+        options.dataset_format = "raw";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(root);
+    }
+
+    std::vector<float> write_sample(size_t index)
+    {
+        std::vector<float> data(xt::compute_size(in_shape));
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = (float)(index * 100 + i);
+        std::ofstream(options.dataset / ("sample" + std::to_string(index) + ".raw"), std::ios::binary)
+            .write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(float));
+        return data;
+    }
+
+    std::filesystem::path root;
+    simulate_options options;
+};
+}
+
+TEST_F(SimulatorTest, empty_dataset)
+{
+    auto sim = simulator::create(compile_neg_model(), options);
+    EXPECT_THROW(sim->run(), std::invalid_argument);
+}
+
+TEST_F(SimulatorTest, parallel)
+{
+    const size_t samples = 7;
+    std::vector<std::vector<float>> inputs;
+    for (size_t i = 0; i < samples; i++)
+        inputs.emplace_back(write_sample(i));
+
+    auto model = compile_neg_model();
+    // More interpreters than samples, and fewer, and the hardware default
+    for (size_t num_threads : { 16, 3, 0 })
+    {
+        std::filesystem::remove_all(options.output_path);
+        options.num_threads = num_threads;
+        size_t progress = 0;
+        options.progress = [&](size_t cnt, size_t total) {
+            EXPECT_EQ(samples, total);
+            progress = cnt;
+        };
+
+        simulator::create(model, options)->run();
+        EXPECT_EQ(samples, progress) << "num_threads " << num_threads;
+        for (size_t i = 0; i < samples; i++)
+        {
+            auto filename = options.output_path / ("sample" + std::to_string(i) + ".bin");
+            std::vector<float> output(inputs[i].size());
+            std::ifstream(filename, std::ios::binary).read(reinterpret_cast<char *>(output.data()), output.size() * sizeof(float));
+            for (size_t j = 0; j < output.size(); j++)
+                ASSERT_EQ(-inputs[i][j], output[j]) << filename << " at " << j;
+        }
+    }
+}
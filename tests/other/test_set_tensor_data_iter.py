@@ -0,0 +1,88 @@
+# Copyright 2019-2021 Canaan Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""System test: set_tensor_data_iter"""
+# pylint: disable=invalid-name, unused-argument, import-outside-toplevel
+
+import pytest
+import numpy as np
+import onnx
+from onnx import helper
+from onnx import TensorProto
+import nncase
+
+in_shape = [1, 3, 8, 8]
+samples_count = 4
+
+
+def _make_model():
+    w = helper.make_tensor('w', TensorProto.FLOAT, [4, 3, 3, 3],
+                           np.random.rand(4, 3, 3, 3).astype(np.float32).flatten().tolist())
+    node = helper.make_node('Conv', ['x', 'w'], ['y'], pads=[1, 1, 1, 1])
+    graph = helper.make_graph([node], 'test_set_tensor_data_iter',
+                              [helper.make_tensor_value_info('x', TensorProto.FLOAT, in_shape)],
+                              [helper.make_tensor_value_info('y', TensorProto.FLOAT, [1, 4, 8, 8])],
+                              initializer=[w])
+    return helper.make_model(graph, producer_name='onnx').SerializeToString()
+
+
+class CalibData:
+    def __init__(self):
+        self.passes = 0
+
+    def __iter__(self):
+        self.passes += 1
+        for _ in range(samples_count):
+            yield np.random.rand(*in_shape).astype(np.float32)
+
+
+def _compile(tmp_path, samples, calibrate_method, prefetch):
+    compile_options = nncase.CompileOptions()
+    compile_options.target = 'cpu'
+    compile_options.dump_dir = str(tmp_path)
+    compiler = nncase.Compiler(compile_options)
+    compiler.import_onnx(_make_model(), nncase.ImportOptions())
+
+    ptq_options = nncase.PTQTensorOptions()
+    ptq_options.calibrate_method = calibrate_method
+    ptq_options.samples_count = samples_count
+    ptq_options.set_tensor_data_iter(samples, prefetch)
+    compiler.use_ptq(ptq_options)
+    compiler.compile()
+    return compiler.gencode_tobytes()
+
+
+@pytest.mark.parametrize('prefetch', [0, 2])
+@pytest.mark.parametrize('calibrate_method', ['no_clip', 'kld_m0'])
+def test_reiterable(tmp_path, calibrate_method, prefetch):
+    data = CalibData()
+    kmodel = _compile(tmp_path, data, calibrate_method, prefetch)
+    assert len(kmodel) > 0
+    assert data.passes == (1 if calibrate_method == 'no_clip' else 2)
+
+
+@pytest.mark.parametrize('prefetch', [0, 2])
+def test_generator_single_pass(tmp_path, prefetch):
+    samples = (np.random.rand(*in_shape).astype(np.float32) for _ in range(samples_count))
+    assert len(_compile(tmp_path, samples, 'no_clip', prefetch)) > 0
+
+
+@pytest.mark.parametrize('prefetch', [0, 2])
+def test_generator_two_passes(tmp_path, prefetch):
+    samples = (np.random.rand(*in_shape).astype(np.float32) for _ in range(samples_count))
+    with pytest.raises(RuntimeError, match='re-iterable'):
+        _compile(tmp_path, samples, 'kld_m0', prefetch)
+
+
+if __name__ == "__main__":
+    pytest.main(['-vv', 'test_set_tensor_data_iter.py'])
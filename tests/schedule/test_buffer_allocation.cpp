@@ -0,0 +1,150 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <list>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/schedule/buffer_allocator.h>
+#include <nncase/schedule/freelist.h>
+#include <nncase/schedule/liveness_analysis.h>
+#include <random>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::schedule;
+
+namespace
+{
+// An unrolled recurrent cell: every step reads the previous state and a skip connection
+// from a few steps back, which keeps a handful of buffers alive across many ages.
+void build_unrolled_graph(graph &g, size_t steps, size_t skip)
+{
+    shape_t shape { 1, 64 };
+    auto in = g.emplace<input_node>(dt_float32, shape);
+    std::vector<output_connector *> states { &in->output() };
+    for (size_t i = 0; i < steps; i++)
+    {
+        auto &prev = *states.back();
+        auto &skipped = *states[states.size() > skip ? states.size() - skip : 0];
+        auto u = g.emplace<unary>(unary_tanh, shape);
+        auto b = g.emplace<binary>(binary_add, shape, shape, value_range<float>::full());
+        u->input().connect(prev);
+        b->input_a().connect(u->output());
+        b->input_b().connect(skipped);
+        states.emplace_back(&b->output());
+    }
+
+    auto out = g.emplace<output_node>(dt_float32, shape);
+    out->input().connect(*states.back());
+}
+
+bool overlaps(const memory_span &lhs, const memory_span &rhs)
+{
+    return lhs.start < rhs.end() && rhs.start < lhs.end();
+}
+}
+
+TEST(BufferAllocationTest, FreelistAllocateFree)
+{
+    constexpr size_t allocations = 100000;
+    constexpr size_t max_living = 5000;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> size_dist(1, 4096);
+    freelist list(std::nullopt);
+    std::vector<memory_span> living;
+
+    for (size_t i = 0; i < allocations; i++)
+    {
+        if (living.size() >= max_living)
+        {
+            auto idx = std::uniform_int_distribution<size_t>(0, living.size() - 1)(rng);
+            list.free(living[idx]);
+            living[idx] = living.back();
+            living.pop_back();
+        }
+
+        living.emplace_back(list.allocate(size_dist(rng) * 8));
+    }
+
+    std::sort(living.begin(), living.end(), [](const memory_span &lhs, const memory_span &rhs) { return lhs.start < rhs.start; });
+    for (size_t i = 1; i < living.size(); i++)
+        EXPECT_LE(living[i - 1].end(), living[i].start);
+
+    // Every free node must be disjoint from the living spans and coalesced with its neighbours
+    auto free_nodes = list.free_nodes();
+    for (size_t i = 1; i < free_nodes.size(); i++)
+        EXPECT_LT(free_nodes[i - 1].end(), free_nodes[i].start);
+    for (auto &node : free_nodes)
+    {
+        auto it = std::lower_bound(living.begin(), living.end(), node.start, [](const memory_span &span, size_t start) { return span.end() <= start; });
+        if (it != living.end())
+            EXPECT_FALSE(overlaps(*it, node));
+    }
+}
+
+TEST(BufferAllocationTest, UnrolledGraphLiveness)
+{
+    constexpr size_t steps = 10000;
+    constexpr size_t skip = 8;
+
+    graph g;
+    build_unrolled_graph(g, steps, skip);
+    ASSERT_GT(g.nodes().size(), 2 * steps);
+
+    std::list<logical_buffer> buffers;
+    std::unordered_map<const output_connector *, logical_buffer *> buffer_map;
+    lifetime_recorder lr(buffers, buffer_map);
+    auto alloc_visitor = make_relay_ir_visitor([&](node &node) {
+        for (auto out : node.outputs())
+            lr.allocate(*out, mem_data);
+        lr.grow_age();
+        for (auto in : node.inputs())
+            lr.release(*in->connection());
+    });
+    alloc_visitor.visit(g.outputs());
+    lr.finish();
+
+    std::list<physical_buffer> physical_buffers;
+    std::vector<physical_buffer *> orders;
+    for (auto &b : buffers)
+        orders.emplace_back(&physical_buffers.emplace_back(orders.size(), b));
+    std::sort(orders.begin(), orders.end(), [](const physical_buffer *lhs, const physical_buffer *rhs) { return lhs->lifetime().birth < rhs->lifetime().birth; });
+
+    best_fit_allocator allocator;
+    for (auto b : orders)
+        allocator.mark(*b);
+    allocator.finish();
+
+    // Each step holds at most the skip window plus the step temporaries
+    auto buffer_size = allocator.allocations().at(orders.front()).size;
+    EXPECT_LE(allocator.max_usage(), (skip + 4) * buffer_size);
+
+    // Buffers with overlapping lifetimes must not share memory
+    std::vector<const physical_buffer *> living;
+    for (auto b : orders)
+    {
+        auto birth = b->lifetime().birth;
+        living.erase(std::remove_if(living.begin(), living.end(), [=](const physical_buffer *l) { return l->lifetime().end() <= birth; }), living.end());
+        auto &alloc = allocator.allocations().at(b);
+        for (auto l : living)
+            EXPECT_FALSE(overlaps(alloc, allocator.allocations().at(l)));
+        living.emplace_back(b);
+    }
+}
@@ -0,0 +1,175 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/call.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
+#include <nncase/schedule/schedule_context.h>
+#include <nncase/schedule/scheduler.h>
+#include <nncase/targets/neutral_target.h>
+#include <type_traits>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::schedule;
+
+// Module contexts point into the model context, which therefore must stay in place
+static_assert(!std::is_move_constructible_v<model_schedule_context>);
+static_assert(!std::is_move_assignable_v<model_schedule_context>);
+
+namespace
+{
+const shape_t shape { 1, 64 };
+
+unary *add_unary(graph &g, output_connector &input)
+{
+    auto u = g.emplace<unary>(unary_neg, shape);
+    u->input().connect(input);
+    return u;
+}
+
+// Move nodes into a new function of the same module, called where they were
+graph &move_to_call(graph &g, std::vector<node *> nodes)
+{
+    auto split = g.split_subgraph(nodes);
+    auto &callee = g.add_subgraph(std::move(split.subgraph));
+    auto c = g.emplace<call>(callee);
+    for (auto &inp : split.inputs)
+        c->outer_connector(*inp.first).connect(*inp.second);
+    for (auto &outp : split.outputs)
+    {
+        auto &outer_out = c->outer_connector(*outp.first);
+        for (auto in : outp.second)
+            in->connect(outer_out);
+    }
+
+    return callee;
+}
+
+// in -> u -> call(u -> u) -> u x tail -> out
+struct call_model
+{
+    graph main;
+    graph *callee;
+    output_connector *callee_output;
+    std::vector<unary *> tail;
+
+    call_model(size_t tail_length)
+    {
+        auto in = main.emplace<input_node>(dt_float32, shape);
+        auto head = add_unary(main, in->output());
+        auto c1 = add_unary(main, head->output());
+        auto c2 = add_unary(main, c1->output());
+        callee_output = &c1->output();
+
+        auto *last = c2;
+        for (size_t i = 0; i < tail_length; i++)
+            last = tail.emplace_back(add_unary(main, last->output()));
+        auto out = main.emplace<output_node>(dt_float32, shape);
+        out->input().connect(last->output());
+
+        callee = &move_to_call(main, { c1, c2 });
+    }
+};
+}
+
+TEST(SharedPoolTest, functions_share_one_pool)
+{
+    constexpr size_t tail_length = 8;
+    call_model model(tail_length);
+    targets::neutral_target target;
+    scheduler sch(target, model.main, model.main.outputs());
+    auto result = sch.schedule();
+
+    ASSERT_EQ(1, result.modules.size());
+    auto &mod = result.modules[0];
+    EXPECT_EQ(2, mod.functions.size());
+    ASSERT_TRUE(mod.shared_max_usages.contains(runtime::stackvm::stackvm_module_type));
+    auto pool_size = mod.shared_max_usages.at(runtime::stackvm::stackvm_module_type);
+
+    // Scratch buffers of both functions are placed in the shared pool
+    EXPECT_EQ(mem_shared_data, mod.allocations.at(model.callee_output).memory_location);
+    for (auto u : model.tail)
+    {
+        if (u->output().connections()[0]->owner().runtime_opcode() != op_output_node)
+            EXPECT_EQ(mem_shared_data, mod.allocations.at(&u->output()).memory_location) << u->name();
+    }
+
+    size_t shared_bytes = 0;
+    for (auto &alloc : mod.allocations)
+    {
+        EXPECT_NE(mem_data, alloc.second.memory_location) << alloc.first->owner().name();
+        if (alloc.second.memory_location == mem_shared_data)
+        {
+            EXPECT_LE(alloc.second.linear_end(), pool_size) << alloc.first->owner().name();
+            shared_bytes += alloc.second.size;
+        }
+    }
+
+    // A chain only keeps a couple of buffers alive, so the pool reuses their memory
+    EXPECT_GT(pool_size, 0);
+    EXPECT_LT(pool_size, shared_bytes);
+
+    // An op reads its input while writing its output, they can't share memory
+    for (size_t i = 1; i + 1 < model.tail.size(); i++)
+    {
+        auto &prev = mod.allocations.at(&model.tail[i - 1]->output());
+        auto &cur = mod.allocations.at(&model.tail[i]->output());
+        EXPECT_FALSE(prev.overlap(cur)) << model.tail[i]->name();
+    }
+}
+
+TEST(SharedPoolTest, nested_functions)
+{
+    // Each function runs one op and calls the next, so every function context is
+    // created while all of its callers are still being visited
+    constexpr size_t depth = 40;
+    graph main;
+    auto in = main.emplace<input_node>(dt_float32, shape);
+    std::vector<unary *> chain;
+    auto *last = &in->output();
+    for (size_t i = 0; i <= depth; i++)
+        last = &chain.emplace_back(add_unary(main, *last))->output();
+    auto out = main.emplace<output_node>(dt_float32, shape);
+    out->input().connect(*last);
+
+    auto *caller = &main;
+    for (size_t i = 1; i <= depth; i++)
+        caller = &move_to_call(*caller, std::vector<node *>(chain.begin() + i, chain.end()));
+
+    targets::neutral_target target;
+    scheduler sch(target, main, main.outputs());
+    auto result = sch.schedule();
+
+    ASSERT_EQ(1, result.modules.size());
+    auto &mod = result.modules[0];
+    EXPECT_EQ(depth + 1, mod.functions.size());
+    for (auto &func : mod.functions)
+        EXPECT_EQ(&func, mod.functions_map.at(func.graph));
+    auto pool_size = mod.shared_max_usages.at(runtime::stackvm::stackvm_module_type);
+
+    // A caller's buffer stays alive while its callee runs
+    for (size_t i = 0; i + 1 < chain.size(); i++)
+    {
+        auto &caller_alloc = mod.allocations.at(&chain[i]->output());
+        auto &callee_alloc = mod.allocations.at(&chain[i + 1]->output());
+        ASSERT_EQ(mem_shared_data, caller_alloc.memory_location) << chain[i]->name();
+        EXPECT_LE(caller_alloc.linear_end(), pool_size) << chain[i]->name();
+        if (callee_alloc.memory_location == mem_shared_data)
+            EXPECT_FALSE(caller_alloc.overlap(callee_alloc)) << chain[i]->name();
+    }
+}
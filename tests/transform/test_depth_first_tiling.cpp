@@ -0,0 +1,125 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/conv2d.h>
+#include <nncase/ir/ops/slice.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/targets/neutral_target.h>
+#include <nncase/transforms/neutral/depth_first_tiling.h>
+#include <nncase/transforms/pass.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+conv2d *add_conv(graph &g, output_connector &input, size_t out_channels, int32_t kernel_size, int32_t stride)
+{
+    auto &in_shape = input.shape();
+    shape_t w_shape { out_channels, in_shape[1], (size_t)kernel_size, (size_t)kernel_size };
+    std::vector<float> weights(xt::compute_size(w_shape), 0.1f);
+    std::vector<float> bias(out_channels, 0.f);
+    auto w = g.emplace<constant>(dt_float32, w_shape, std::span<const float>(weights));
+    auto b = g.emplace<constant>(dt_float32, shape_t { out_channels }, std::span<const float>(bias));
+    padding pad { kernel_size / 2, kernel_size / 2 };
+    auto conv = g.emplace<conv2d>(in_shape, w_shape, 1, pad, pad, stride, stride, 1, 1, value_range<float>::full());
+    conv->input().connect(input);
+    conv->weights().connect(w->output());
+    conv->bias().connect(b->output());
+    return conv;
+}
+
+size_t count_nodes(graph &g, std::string_view prefix)
+{
+    size_t count = 0;
+    for (auto &n : g.nodes())
+    {
+        auto &name = n->name();
+        if (name.compare(0, prefix.size(), prefix) == 0 && name.find("/tile_") != std::string::npos)
+            count++;
+    }
+
+    return count;
+}
+
+void run_tiling(graph &g)
+{
+    targets::neutral_target target;
+    transform_pass pass("depth_first_tiling");
+    pass.emplace<depth_first_tiling_transform>();
+    pass.run(g, target, {});
+    g.dce();
+}
+}
+
+TEST(DepthFirstTilingTest, conv_chain)
+{
+    for (int32_t stride : { 1, 2 })
+    {
+        graph g;
+        auto in = g.emplace<input_node>(dt_float32, shape_t { 1, 32, 160, 160 });
+        auto conv1 = add_conv(g, in->output(), 32, 3, stride);
+        conv1->name("conv1");
+        auto conv2 = add_conv(g, conv1->output(), 16, 3, 1);
+        conv2->name("conv2");
+        auto out_shape = conv2->output().shape();
+        auto out = g.emplace<output_node>(dt_float32, out_shape);
+        out->input().connect(conv2->output());
+
+        // Chain ends in a conv, which then writes straight into the concat view
+        run_tiling(g);
+
+        auto c = node_cast<concat>(out->input().connection()->owner());
+        ASSERT_NE(nullptr, c) << "stride " << stride;
+        EXPECT_EQ("conv2", c->name());
+        EXPECT_EQ(2, c->axis());
+        EXPECT_GE(c->inputs().size(), 2);
+
+        size_t rows = 0;
+        for (auto in : c->inputs())
+        {
+            auto &producer = in->connection()->owner();
+            EXPECT_NE(nullptr, node_cast<conv2d>(producer));
+            EXPECT_NE(std::string::npos, producer.name().find("conv2/tile_"));
+            rows += in->shape()[2];
+        }
+        EXPECT_EQ(out_shape[2], rows);
+
+        // Every tile slices its input rows and runs both convs
+        EXPECT_EQ(c->inputs().size() * 2, count_nodes(g, "conv1/tile_"));
+        EXPECT_EQ(c->inputs().size(), count_nodes(g, "conv2/tile_"));
+    }
+}
+
+TEST(DepthFirstTilingTest, small_chain)
+{
+    // Intermediates fit in the cache, tiling would only add recomputed rows
+    graph g;
+    auto in = g.emplace<input_node>(dt_float32, shape_t { 1, 8, 32, 32 });
+    auto conv1 = add_conv(g, in->output(), 8, 3, 1);
+    auto conv2 = add_conv(g, conv1->output(), 8, 3, 1);
+    auto out = g.emplace<output_node>(dt_float32, conv2->output().shape());
+    out->input().connect(conv2->output());
+
+    run_tiling(g);
+
+    EXPECT_EQ(conv2, &out->input().connection()->owner());
+    EXPECT_EQ(0, count_nodes(g, ""));
+}
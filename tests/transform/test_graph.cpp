@@ -0,0 +1,119 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <unordered_set>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+namespace
+{
+const shape_t shape { 1, 3, 8, 8 };
+
+unary *add_unary(graph &g, output_connector &input)
+{
+    auto u = g.emplace<unary>(unary_neg, shape);
+    u->input().connect(input);
+    return u;
+}
+}
+
+TEST(GraphTest, names_live_in_graph_arena)
+{
+    auto g1 = std::make_unique<graph>();
+    graph g2;
+    auto a = g1->emplace<input_node>(dt_float32, shape);
+    auto b = g2.emplace<input_node>(dt_float32, shape);
+    a->name("input");
+    b->name("input");
+
+    // Each graph pools its own names, renames included
+    EXPECT_EQ(a->name(), b->name());
+    EXPECT_NE(&a->name(), &b->name());
+    EXPECT_NE(&a->output().name(), &b->output().name());
+
+    a->name("renamed");
+    auto c = g1->emplace<input_node>(dt_float32, shape);
+    c->name("renamed");
+    EXPECT_EQ(&a->name(), &c->name());
+
+    g1.reset();
+    EXPECT_EQ("input", b->name());
+}
+
+TEST(GraphTest, dce_reuses_node_storage)
+{
+    graph g;
+    auto in = g.emplace<input_node>(dt_float32, shape);
+    auto out = g.emplace<output_node>(dt_float32, shape);
+    out->input().connect(add_unary(g, in->output())->output());
+
+    // A dead chain hanging off the input
+    std::unordered_set<void *> dead;
+    auto *tail = &in->output();
+    for (size_t i = 0; i < 64; i++)
+    {
+        auto u = add_unary(g, *tail);
+        dead.emplace(u);
+        dead.emplace(&u->input());
+        dead.emplace(&u->output());
+        tail = &u->output();
+    }
+
+    g.dce();
+    EXPECT_EQ(3, g.nodes().size());
+
+    // New nodes and connectors are built in the storage of the removed ones
+    tail = &in->output();
+    for (size_t i = 0; i < 64; i++)
+    {
+        auto u = add_unary(g, *tail);
+        EXPECT_TRUE(dead.contains(u)) << "node " << i;
+        EXPECT_TRUE(dead.contains(&u->input())) << "node " << i;
+        EXPECT_TRUE(dead.contains(&u->output())) << "node " << i;
+        tail = &u->output();
+    }
+}
+
+TEST(GraphTest, split_subgraph_keeps_ids_unique)
+{
+    graph g;
+    auto in = g.emplace<input_node>(dt_float32, shape);
+    auto u1 = add_unary(g, in->output());
+    auto u2 = add_unary(g, u1->output());
+    auto out = g.emplace<output_node>(dt_float32, shape);
+    out->input().connect(u2->output());
+
+    std::vector<node *> nodes { u1 };
+    auto split = g.split_subgraph(nodes);
+    auto &subgraph = *split.subgraph;
+
+    // Both graphs keep growing after the split
+    add_unary(g, in->output());
+    add_unary(subgraph, u1->output());
+
+    std::unordered_set<size_t> ids;
+    for (auto *owner : { &g, &subgraph })
+    {
+        for (auto &node : owner->nodes())
+        {
+            EXPECT_TRUE(ids.emplace(node->id()).second) << "duplicate id " << node->id() << " of " << node->name();
+            EXPECT_LT(node->id(), owner->node_id_bound());
+        }
+    }
+}
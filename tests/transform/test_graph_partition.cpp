@@ -0,0 +1,324 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <list>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/ops/binary.h>
+#include <nncase/ir/ops/unary.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/ir/visitor.h>
+#include <nncase/runtime/stackvm/runtime_module.h>
+#include <set>
+#include <unordered_set>
+
+using namespace nncase;
+using namespace nncase::ir;
+
+namespace
+{
+using partition_t = std::set<std::set<std::string>>;
+
+const shape_t shape { 1, 4 };
+constexpr module_type_t test_module_type = to_module_type("test");
+constexpr module_type_t stackvm_module_type = runtime::stackvm::stackvm_module_type;
+
+// The merger before it used a worklist, kept as the reference for the partitions it chose
+class legacy_merger
+{
+    struct region
+    {
+        bool is_all_noaction = true;
+        module_type_t module_type;
+        std::vector<node *> nodes;
+        std::unordered_set<input_connector *> region_inputs;
+        std::unordered_set<output_connector *> outputs;
+
+        region(module_type_t module_type)
+            : module_type(module_type)
+        {
+        }
+
+        void add_node(node &n)
+        {
+            nodes.emplace_back(&n);
+            for (auto in : n.inputs())
+                region_inputs.emplace(in);
+            for (auto out : n.outputs())
+                outputs.emplace(out);
+            for (auto it = region_inputs.begin(); it != region_inputs.end();)
+            {
+                if (outputs.contains((*it)->connection()))
+                    it = region_inputs.erase(it);
+                else
+                    ++it;
+            }
+
+            if (n.attributes() & node_attr_action)
+                is_all_noaction = false;
+        }
+
+        void merge(region &other)
+        {
+            for (auto node : other.nodes)
+                add_node(*node);
+        }
+    };
+
+    using rule_t = bool (*)(region &a, region &b);
+
+public:
+    partition_t merge(graph &g)
+    {
+        auto creator = make_relay_ir_visitor([this](node &node) {
+            if (node.runtime_opcode() == op_input_node || node.runtime_opcode() == op_output_node)
+                return;
+
+            region *last_region = nullptr;
+            for (auto in : node.inputs())
+            {
+                auto it = node_to_region_.find(&in->connection()->owner());
+                if (it != node_to_region_.end())
+                {
+                    if (!last_region)
+                    {
+                        last_region = it->second;
+                    }
+                    else if (last_region != it->second)
+                    {
+                        last_region = nullptr;
+                        break;
+                    }
+                }
+            }
+
+            auto r = last_region;
+            if (!r || r->module_type != node.module_type())
+                r = &regions_.emplace_back(node.module_type());
+            r->add_node(node);
+            node_to_region_.emplace(&node, r);
+        });
+        creator.visit(g);
+
+        bool changed;
+        do
+        {
+            changed = false;
+            changed |= merge_by(child_rule);
+            changed |= merge_by(parent_rule);
+            changed |= merge_by(same_input_rule);
+        } while (changed);
+
+        partition_t result;
+        for (auto &r : regions_)
+        {
+            if (r.module_type == stackvm_module_type)
+                continue;
+            std::set<std::string> names;
+            for (auto n : r.nodes)
+                names.emplace(n->name());
+            result.emplace(std::move(names));
+        }
+
+        return result;
+    }
+
+private:
+    // b's inputs all connect to a's outputs
+    static bool child_rule(region &a, region &b)
+    {
+        return (a.module_type == b.module_type || b.is_all_noaction)
+            && std::all_of(b.region_inputs.begin(), b.region_inputs.end(), [&](input_connector *in) { return a.outputs.contains(in->connection()); });
+    }
+
+    // b's outputs all connect to a's inputs
+    static bool parent_rule(region &a, region &b)
+    {
+        return b.is_all_noaction
+            && std::all_of(b.outputs.begin(), b.outputs.end(), [&](output_connector *out) {
+                   auto conns = out->connections();
+                   return std::all_of(conns.begin(), conns.end(), [&](input_connector *in) { return a.region_inputs.contains(in); });
+               });
+    }
+
+    // b reads the same outputs as a
+    static bool same_input_rule(region &a, region &b)
+    {
+        std::set<output_connector *> outputs_a, outputs_b;
+        for (auto in : a.region_inputs)
+            outputs_a.emplace(in->connection());
+        for (auto in : b.region_inputs)
+            outputs_b.emplace(in->connection());
+        return a.module_type == b.module_type && outputs_a == outputs_b;
+    }
+
+    bool merge_by(rule_t rule)
+    {
+        bool ever_changed = false;
+        bool changed;
+        do
+        {
+            changed = false;
+            for (auto ita = regions_.begin(); ita != regions_.end() && !changed; ++ita)
+            {
+                std::vector<std::list<region>::iterator> to_be_merge;
+                for (auto itb = regions_.begin(); itb != regions_.end(); ++itb)
+                {
+                    if (ita == itb || (ita->module_type == stackvm_module_type && itb->module_type == stackvm_module_type))
+                        continue;
+                    if (rule(*ita, *itb))
+                        to_be_merge.emplace_back(itb);
+                }
+
+                for (auto r : to_be_merge)
+                {
+                    for (auto n : r->nodes)
+                        node_to_region_[n] = &*ita;
+                    ita->merge(*r);
+                    regions_.erase(r);
+                    changed = ever_changed = true;
+                }
+            }
+        } while (changed);
+        return ever_changed;
+    }
+
+    std::list<region> regions_;
+    std::unordered_map<node *, region *> node_to_region_;
+};
+
+partition_t merge_module_regions(graph &g)
+{
+    g.merge_module_regions();
+    partition_t result;
+    for (auto &subgraph : g.subgraphs())
+    {
+        std::set<std::string> names;
+        for (auto &n : subgraph->nodes())
+        {
+            if (n->runtime_opcode() != op_input_node && n->runtime_opcode() != op_output_node)
+                names.emplace(n->name());
+        }
+        result.emplace(std::move(names));
+    }
+
+    return result;
+}
+
+node *add_unary(graph &g, const char *name, output_connector &input, const module_type_t &module_type, bool action = true)
+{
+    auto u = g.emplace<unary>(unary_neg, shape);
+    u->name(name);
+    u->module_type(module_type);
+    if (!action)
+        u->attributes(node_attr_none);
+    u->input().connect(input);
+    return u;
+}
+
+node *add_binary(graph &g, const char *name, output_connector &a, output_connector &b, const module_type_t &module_type)
+{
+    auto bin = g.emplace<binary>(binary_add, shape, shape, value_range<float>::full());
+    bin->name(name);
+    bin->module_type(module_type);
+    bin->input_a().connect(a);
+    bin->input_b().connect(b);
+    return bin;
+}
+
+void add_output(graph &g, node &n)
+{
+    g.emplace<output_node>(dt_float32, shape)->input().connect(n.output_at(0));
+}
+
+// Partitions both a copy of the graph with the legacy merger and the graph itself
+void check_partition(void (*build)(graph &g), const partition_t &expected)
+{
+    graph legacy_g, g;
+    build(legacy_g);
+    build(g);
+
+    auto legacy = legacy_merger().merge(legacy_g);
+    EXPECT_EQ(expected, legacy);
+    EXPECT_EQ(legacy, merge_module_regions(g));
+}
+}
+
+TEST(GraphPartitionTest, noaction_child)
+{
+    check_partition([](graph &g) {
+        auto in = g.emplace<input_node>(dt_float32, shape);
+        auto a = add_unary(g, "a", in->output(), test_module_type);
+        auto b = add_unary(g, "b", a->output_at(0), stackvm_module_type, false);
+        auto c = add_unary(g, "c", b->output_at(0), test_module_type);
+        add_output(g, *c);
+    },
+        { { "a", "b", "c" } });
+}
+
+TEST(GraphPartitionTest, noaction_parent)
+{
+    check_partition([](graph &g) {
+        auto in = g.emplace<input_node>(dt_float32, shape);
+        auto a = add_unary(g, "a", in->output(), stackvm_module_type, false);
+        auto b = add_unary(g, "b", a->output_at(0), test_module_type);
+        add_output(g, *b);
+    },
+        { { "a", "b" } });
+}
+
+TEST(GraphPartitionTest, diamond)
+{
+    // Merging d into {a, c} would make that region read back its own output through b
+    check_partition([](graph &g) {
+        auto in = g.emplace<input_node>(dt_float32, shape);
+        auto a = add_unary(g, "a", in->output(), test_module_type);
+        auto b = add_unary(g, "b", a->output_at(0), stackvm_module_type);
+        auto c = add_unary(g, "c", a->output_at(0), test_module_type);
+        auto d = add_binary(g, "d", b->output_at(0), c->output_at(0), test_module_type);
+        add_output(g, *d);
+    },
+        { { "a", "c" }, { "d" } });
+}
+
+TEST(GraphPartitionTest, same_input)
+{
+    check_partition([](graph &g) {
+        auto in = g.emplace<input_node>(dt_float32, shape);
+        auto s = add_unary(g, "s", in->output(), stackvm_module_type);
+        auto x = add_unary(g, "x", s->output_at(0), test_module_type);
+        auto y = add_unary(g, "y", s->output_at(0), test_module_type);
+        auto z = add_binary(g, "z", x->output_at(0), y->output_at(0), stackvm_module_type);
+        add_output(g, *z);
+    },
+        { { "x", "y" } });
+}
+
+TEST(GraphPartitionTest, chained_rules)
+{
+    // Same-input regions merge, then pull in their no-action consumer as a child
+    check_partition([](graph &g) {
+        auto in = g.emplace<input_node>(dt_float32, shape);
+        auto s = add_unary(g, "s", in->output(), stackvm_module_type);
+        auto x = add_unary(g, "x", s->output_at(0), test_module_type);
+        auto y = add_unary(g, "y", s->output_at(0), test_module_type);
+        auto n = add_binary(g, "n", x->output_at(0), y->output_at(0), stackvm_module_type);
+        n->attributes(node_attr_none);
+        auto t = add_unary(g, "t", n->output_at(0), test_module_type);
+        auto u = add_unary(g, "u", s->output_at(0), stackvm_module_type);
+        auto v = add_binary(g, "v", t->output_at(0), u->output_at(0), stackvm_module_type);
+        add_output(g, *v);
+    },
+        { { "x", "y", "n", "t" } });
+}
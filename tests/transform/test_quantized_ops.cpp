@@ -0,0 +1,219 @@
+/* Copyright 2019-2021 Canaan Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <nncase/ir/graph.h>
+#include <nncase/ir/op_utils.h>
+#include <nncase/ir/ops/concat.h>
+#include <nncase/ir/ops/constant.h>
+#include <nncase/ir/ops/dequantize.h>
+#include <nncase/ir/ops/quantize.h>
+#include <nncase/ir/ops/reduce_window2d.h>
+#include <nncase/ir/ops/resize_image.h>
+#include <nncase/ir/ops/table_lookup.h>
+#include <nncase/ir/placeholders.h>
+#include <nncase/ir/quantizer.h>
+#include <nncase/kernels/kernel_utils.h>
+#include <nncase/targets/neutral_target.h>
+#include <nncase/transforms/neutral/fold_quantize.h>
+#include <nncase/transforms/neutral/quantized_ops.h>
+#include <nncase/transforms/pass.h>
+
+using namespace nncase;
+using namespace nncase::ir;
+using namespace nncase::ir::transforms;
+
+namespace
+{
+const value_range<float> in_range { 0.f, 1.f };
+const value_range<float> concat_range { -2.f, 4.f };
+
+template <class T>
+T *find_node(graph &g, std::string_view name)
+{
+    for (auto &n : g.nodes())
+    {
+        if (n->name() == name)
+        {
+            if (auto t = node_cast<T>(*n))
+                return t;
+        }
+    }
+
+    return nullptr;
+}
+
+template <class T>
+T &producer(input_connector &input)
+{
+    auto p = node_cast<T>(input.connection()->owner());
+    if (!p)
+        throw std::runtime_error("Unexpected producer " + input.connection()->owner().name() + " of " + input.owner().name());
+    return *p;
+}
+
+// Entry i of the table requantizes the i-th smallest value of T
+template <class T>
+void check_table(constant &table, const quant_param_t &in_param, const quant_param_t &out_param)
+{
+    auto data = table.data();
+    ASSERT_EQ(256, data.size());
+    auto values = reinterpret_cast<const T *>(data.data());
+    for (int32_t i = std::numeric_limits<T>::lowest(); i <= std::numeric_limits<T>::max(); i++)
+    {
+        auto expected = kernels::detail::quantize<T>(kernels::detail::dequantize<T>((T)i, in_param), out_param);
+        EXPECT_EQ((int32_t)expected, (int32_t)values[i - std::numeric_limits<T>::lowest()]) << "at " << i;
+    }
+}
+
+void annotate(quantizer &quantizer, output_connector &output, value_range<float> range)
+{
+    output.attributes(output.attributes() | cnctr_attr_need_quantize);
+    quantizer.set(output, range);
+}
+
+// in -> resize -> concat(in2) -> max pool -> out, and in2 -> sum pool -> out2
+class QuantizedOpsTest : public ::testing::TestWithParam<datatype_t>
+{
+public:
+    void SetUp() override
+    {
+        quant_type = GetParam();
+        auto mode = quant_type == dt_int8 ? quantizer::quant_mode::signed_asymmetric_mode : quantizer::quant_mode::unsigned_mode;
+        in_param = quantizer::get_quant_param(in_range, 8, mode);
+        concat_param = quantizer::get_quant_param(concat_range, 8, mode);
+
+        auto in = graph.emplace<input_node>(dt_float32, shape_t { 1, 3, 8, 8 });
+        auto in2 = graph.emplace<input_node>(dt_float32, shape_t { 1, 3, 16, 16 });
+        auto resize = graph.emplace<resize_image>(dt_float32, image_resize_bilinear, in->output().shape(), std::array<int32_t, 2> { 16, 16 }, false, false);
+        resize->name("resize");
+        std::vector<shape_t> concat_shapes { resize->output().shape(), in2->output().shape() };
+        auto c = graph.emplace<concat>(dt_float32, concat_shapes, 1);
+        c->name("concat");
+        auto max_pool = graph.emplace<reduce_window2d>(reduce_max, c->output().shape(), std::numeric_limits<float>::lowest(), 2, 2,
+            padding::zero(), padding::zero(), 2, 2, 1, 1, value_range<float>::full());
+        max_pool->name("max_pool");
+        auto sum_pool = graph.emplace<reduce_window2d>(reduce_sum, in2->output().shape(), 0.f, 2, 2,
+            padding::zero(), padding::zero(), 2, 2, 1, 1, value_range<float>::full());
+        sum_pool->name("sum_pool");
+        out = graph.emplace<output_node>(dt_float32, max_pool->output().shape());
+        out2 = graph.emplace<output_node>(dt_float32, sum_pool->output().shape());
+
+        resize->input().connect(in->output());
+        c->input_at(0).connect(resize->output());
+        c->input_at(1).connect(in2->output());
+        max_pool->input().connect(c->output());
+        sum_pool->input().connect(in2->output());
+        out->input().connect(max_pool->output());
+        out2->input().connect(sum_pool->output());
+
+        annotate(quant, in->output(), in_range);
+        annotate(quant, resize->output(), in_range);
+        annotate(quant, in2->output(), concat_range);
+        annotate(quant, c->output(), concat_range);
+        annotate(quant, max_pool->output(), concat_range);
+        annotate(quant, sum_pool->output(), { -8.f, 16.f });
+    }
+
+    // Same passes and order as neutral_target::register_quantize_passes
+    void lower()
+    {
+        run_pass_options options { &quant, nullptr, std::nullopt };
+        {
+            transform_pass p("lower_quantized_ops");
+            p.emplace<quantized_reduce_window2d_transform>(quant_type);
+            p.emplace<quantized_resize_image_transform>(quant_type);
+            p.emplace<quantized_concat_transform>(quant_type);
+            p.run(graph, target, options);
+        }
+        {
+            transform_pass p("fold_quantize");
+            p.emplace<fold_quantize_transform>();
+            p.emplace<fold_requantize_transform>();
+            p.run(graph, target, options);
+        }
+        graph.dce();
+    }
+
+    ir::graph graph;
+    quantizer quant { calibrate_method::no_clip, 2048 };
+    targets::neutral_target target;
+    datatype_t quant_type;
+    quant_param_t in_param, concat_param;
+    output_node *out;
+    output_node *out2;
+};
+}
+
+INSTANTIATE_TEST_SUITE_P(QuantizedOps, QuantizedOpsTest, testing::Values(dt_uint8, dt_int8));
+
+TEST_P(QuantizedOpsTest, lowering)
+{
+    lower();
+
+    // Resize keeps the input param, its range is the same on both sides
+    auto resize = find_node<resize_image>(graph, "resize");
+    ASSERT_NE(nullptr, resize);
+    EXPECT_EQ(quant_type, resize->output().type());
+    auto &resize_q = producer<quantize>(resize->input());
+    EXPECT_EQ(in_param.zero_point, resize_q.quant_param().zero_point);
+    EXPECT_EQ(in_param.scale, resize_q.quant_param().scale);
+
+    // Concat runs on integers with its output param
+    auto c = find_node<concat>(graph, "concat");
+    ASSERT_NE(nullptr, c);
+    EXPECT_EQ(quant_type, c->output().type());
+    auto &in2_q = producer<quantize>(c->input_at(1));
+    EXPECT_EQ(concat_param.zero_point, in2_q.quant_param().zero_point);
+    EXPECT_EQ(concat_param.scale, in2_q.quant_param().scale);
+
+    // Max pool stays quantized, sum pool depends on the zero point and stays in float
+    auto max_pool = find_node<reduce_window2d>(graph, "max_pool");
+    ASSERT_NE(nullptr, max_pool);
+    EXPECT_EQ(quant_type, max_pool->output().type());
+    auto &deq = producer<dequantize>(out->input());
+    EXPECT_EQ(max_pool, &deq.input().connection()->owner());
+
+    auto sum_pool = find_node<reduce_window2d>(graph, "sum_pool");
+    ASSERT_NE(nullptr, sum_pool);
+    EXPECT_EQ(dt_float32, sum_pool->output().type());
+    EXPECT_EQ(sum_pool, &out2->input().connection()->owner());
+}
+
+TEST_P(QuantizedOpsTest, requantize_folding)
+{
+    lower();
+
+    // The resize output is dequantized with its own param and quantized again with the
+    // concat param, that pair becomes one table lookup on the integers
+    auto c = find_node<concat>(graph, "concat");
+    ASSERT_NE(nullptr, c);
+    auto &lut = producer<table_lookup1d>(c->input_at(0));
+    EXPECT_EQ(quant_type, lut.output().type());
+    EXPECT_NE(nullptr, node_cast<resize_image>(lut.input().connection()->owner()));
+
+    auto &table = producer<constant>(lut.table());
+    EXPECT_EQ(quant_type, table.output().type());
+    if (quant_type == dt_uint8)
+        check_table<uint8_t>(table, in_param, concat_param);
+    else
+        check_table<int8_t>(table, in_param, concat_param);
+
+    // No float round trip is left between resize and concat
+    for (auto &n : graph.nodes())
+    {
+        if (auto q = node_cast<quantize>(*n))
+            EXPECT_EQ(op_input_node, q->input().connection()->owner().runtime_opcode()) << q->name();
+    }
+}
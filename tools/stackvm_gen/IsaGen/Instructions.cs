@@ -178,6 +178,12 @@ namespace IsaGen
         TERNARY,
         TRANSPOSE,
         UNARY,
+        DETECTION_POSTPROCESS,
+        TOPK,
+        LOOP,
+        IMAGE_PREPROCESS,
+        QUANTIZED_BINARY,
+        CONV2D_POOL,
     }
 
     [BitLength(8)]
@@ -1264,6 +1270,18 @@ namespace IsaGen
             [DisplayName("fused_clamp_high")]
             [Description("FusedClampHigh")]
             public float FusedClampHigh { get; set; }
+
+            [DisplayName("fused_lut")]
+            [Description("Whether a 256-entry activation table address is on the stack")]
+            public bool FusedLut { get; set; }
+
+            [DisplayName("fused_lut_zero_point")]
+            [Description("FusedLutZeroPoint")]
+            public int FusedLutZeroPoint { get; set; }
+
+            [DisplayName("fused_lut_scale")]
+            [Description("FusedLutScale")]
+            public float FusedLutScale { get; set; }
         }
 
         [DisplayName("TENSOR.COPY")]
@@ -1981,5 +1999,373 @@ namespace IsaGen
             [Description("Perm shape register")]
             public byte RshapePerm { get; set; }
         }
+
+        [DisplayName("TENSOR.DETECTION_POSTPROCESS")]
+        [Category("Tensor Instructions")]
+        [Description("Box decode, score threshold, top-k preselection and NMS")]
+        public class DetectionPostprocessInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.DETECTION_POSTPROCESS;
+
+            [DisplayName("datatype")]
+            [Description("Boxes/Scores datatype")]
+            public DataType DataType { get; set; }
+
+            [DisplayName("rshape_boxes")]
+            [Description("Boxes shape register")]
+            public byte RshapeBoxes { get; set; }
+
+            [DisplayName("rstride_boxes")]
+            [Description("Boxes stride register")]
+            public byte RstrideBoxes { get; set; }
+
+            [DisplayName("rshape_scores")]
+            [Description("Scores shape register")]
+            public byte RshapeScores { get; set; }
+
+            [DisplayName("rstride_scores")]
+            [Description("Scores stride register")]
+            public byte RstrideScores { get; set; }
+
+            [DisplayName("center_point_box")]
+            [Description("Boxes are encoded as [x_center, y_center, width, height]")]
+            public bool CenterPointBox { get; set; }
+
+            [DisplayName("max_output_boxes_per_class")]
+            [Description("Max selected boxes per batch and class")]
+            public int MaxOutputBoxesPerClass { get; set; }
+
+            [DisplayName("iou_threshold")]
+            [Description("IoU threshold")]
+            public float IouThreshold { get; set; }
+
+            [DisplayName("score_threshold")]
+            [Description("Score threshold")]
+            public float ScoreThreshold { get; set; }
+        }
+
+        [DisplayName("TENSOR.TOPK")]
+        [Category("Tensor Instructions")]
+        [Description("TopK")]
+        public class TopKInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.TOPK;
+
+            [DisplayName("datatype")]
+            [Description("Datatype")]
+            public DataType DataType { get; set; }
+
+            [DisplayName("rshape_src")]
+            [Description("Source shape register")]
+            public byte RshapeSrc { get; set; }
+
+            [DisplayName("rstride_src")]
+            [Description("Source stride register")]
+            public byte RstrideSrc { get; set; }
+
+            [DisplayName("rstride_values")]
+            [Description("Values stride register")]
+            public byte RstrideValues { get; set; }
+
+            [DisplayName("rstride_indices")]
+            [Description("Indices stride register")]
+            public byte RstrideIndices { get; set; }
+
+            [DisplayName("axis")]
+            [Description("Axis")]
+            public int Axis { get; set; }
+
+            [DisplayName("k")]
+            [Description("K")]
+            public int K { get; set; }
+
+            [DisplayName("largest")]
+            [Description("Select the largest elements")]
+            public bool Largest { get; set; }
+
+            [DisplayName("sorted")]
+            [Description("Sort the selected elements")]
+            public bool Sorted { get; set; }
+        }
+
+        [DisplayName("TENSOR.LOOP")]
+        [Category("Tensor Instructions")]
+        [Description("Loop")]
+        public class LoopInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.LOOP;
+
+            [DisplayName("function_id")]
+            [Description("Body function Id")]
+            public uint FunctionId { get; set; }
+
+            [DisplayName("module_id")]
+            [Description("Body module Id")]
+            public ushort ModuleId { get; set; }
+
+            [DisplayName("num_src")]
+            [Description("Source count")]
+            public byte SrcCount { get; set; }
+
+            [DisplayName("num_dst")]
+            [Description("Dest count")]
+            public byte DstCount { get; set; }
+
+            [DisplayName("num_states")]
+            [Description("Loop carried states count")]
+            public byte StatesCount { get; set; }
+
+            [DisplayName("num_scan_inputs")]
+            [Description("Scan inputs count")]
+            public byte ScanInputsCount { get; set; }
+
+            [DisplayName("trip_count")]
+            [Description("Trip count")]
+            public uint TripCount { get; set; }
+        }
+
+        [DisplayName("TENSOR.IMAGE_PREPROCESS")]
+        [Category("Tensor Instructions")]
+        [Description("ImagePreprocess")]
+        public class ImagePreprocessInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.IMAGE_PREPROCESS;
+
+            [DisplayName("datatype")]
+            [Description("Input datatype")]
+            public DataType DataType { get; set; }
+
+            [DisplayName("rshape_src")]
+            [Description("Source shape register")]
+            public byte RshapeSrc { get; set; }
+
+            [DisplayName("rstride_src")]
+            [Description("Source stride register")]
+            public byte RstrideSrc { get; set; }
+
+            [DisplayName("rshape_dest")]
+            [Description("Dest shape register")]
+            public byte RshapeDest { get; set; }
+
+            [DisplayName("rstride_dest")]
+            [Description("Dest stride register")]
+            public byte RstrideDest { get; set; }
+
+            [DisplayName("zero_point")]
+            [Description("Input zero point")]
+            public int ZeroPoint { get; set; }
+
+            [DisplayName("scale")]
+            [Description("Input scale")]
+            public float Scale { get; set; }
+
+            [DisplayName("input_nhwc")]
+            [Description("Input is NHWC")]
+            public bool InputNHWC { get; set; }
+
+            [DisplayName("swap_rb")]
+            [Description("Swap R and B channels")]
+            public bool SwapRB { get; set; }
+
+            [DisplayName("resize_h")]
+            [Description("Resized height")]
+            public int ResizeH { get; set; }
+
+            [DisplayName("resize_w")]
+            [Description("Resized width")]
+            public int ResizeW { get; set; }
+
+            [DisplayName("pad_top")]
+            [Description("Letterbox top padding")]
+            public int PadTop { get; set; }
+
+            [DisplayName("pad_left")]
+            [Description("Letterbox left padding")]
+            public int PadLeft { get; set; }
+
+            [DisplayName("pad_value")]
+            [Description("Letterbox padding value")]
+            public float PadValue { get; set; }
+
+            [DisplayName("output_nhwc")]
+            [Description("Output is NHWC")]
+            public bool OutputNHWC { get; set; }
+        }
+
+        [DisplayName("TENSOR.QUANTIZED_BINARY")]
+        [Category("Tensor Instructions")]
+        [Description("QuantizedBinary")]
+        public class QuantizedBinaryInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.QUANTIZED_BINARY;
+
+            [DisplayName("datatype")]
+            [Description("Datatype")]
+            public DataType DataType { get; set; }
+
+            [DisplayName("binary_op")]
+            [Description("Binary operator")]
+            public BinaryOp BinaryOp { get; set; }
+
+            [DisplayName("rshape_src1")]
+            [Description("Source1 shape register")]
+            public byte RshapeSrc1 { get; set; }
+
+            [DisplayName("rstride_src1")]
+            [Description("Source1 stride register")]
+            public byte RstrideSrc1 { get; set; }
+
+            [DisplayName("rshape_src2")]
+            [Description("Source2 shape register")]
+            public byte RshapeSrc2 { get; set; }
+
+            [DisplayName("rstride_src2")]
+            [Description("Source2 stride register")]
+            public byte RstrideSrc2 { get; set; }
+
+            [DisplayName("rstride_dest")]
+            [Description("Dest stride register")]
+            public byte RstrideDest { get; set; }
+
+            [DisplayName("in_a_zero_point")]
+            [Description("Source1 zero point")]
+            public int InAZeroPoint { get; set; }
+
+            [DisplayName("in_a_scale")]
+            [Description("Source1 scale")]
+            public float InAScale { get; set; }
+
+            [DisplayName("in_b_zero_point")]
+            [Description("Source2 zero point")]
+            public int InBZeroPoint { get; set; }
+
+            [DisplayName("in_b_scale")]
+            [Description("Source2 scale")]
+            public float InBScale { get; set; }
+
+            [DisplayName("out_zero_point")]
+            [Description("Dest zero point")]
+            public int OutZeroPoint { get; set; }
+
+            [DisplayName("out_scale")]
+            [Description("Dest scale")]
+            public float OutScale { get; set; }
+
+            [DisplayName("fused_clamp_low")]
+            [Description("FusedClampLow")]
+            public float FusedClampLow { get; set; }
+
+            [DisplayName("fused_clamp_high")]
+            [Description("FusedClampHigh")]
+            public float FusedClampHigh { get; set; }
+        }
+
+        [DisplayName("TENSOR.CONV2D_POOL")]
+        [Category("Tensor Instructions")]
+        [Description("Conv2D followed by a fused 2D pooling")]
+        public class Conv2DPoolInstruction : TensorInstruction
+        {
+            public override TensorFunction Function => TensorFunction.CONV2D_POOL;
+
+            [DisplayName("datatype")]
+            [Description("Datatype")]
+            public DataType DataType { get; set; }
+
+            [DisplayName("rshape_src")]
+            [Description("Source shape register")]
+            public byte RshapeSrc { get; set; }
+
+            [DisplayName("rstride_src")]
+            [Description("Source stride register")]
+            public byte RstrideSrc { get; set; }
+
+            [DisplayName("rshape_kernel")]
+            [Description("Kernel shape register")]
+            public byte RshapeKernel { get; set; }
+
+            [DisplayName("rstride_kernel")]
+            [Description("Kernel stride register")]
+            public byte RstrideKernel { get; set; }
+
+            [DisplayName("rstride_bias")]
+            [Description("Bias stride register")]
+            public byte RstrideBias { get; set; }
+
+            [DisplayName("rstride_dest")]
+            [Description("Dest stride register")]
+            public byte RstrideDest { get; set; }
+
+            [DisplayName("groups")]
+            [Description("Groups")]
+            public ushort Groups { get; set; }
+
+            [DisplayName("stride_h")]
+            [Description("StrideH")]
+            public ushort StrideH { get; set; }
+
+            [DisplayName("stride_w")]
+            [Description("StrideW")]
+            public ushort StrideW { get; set; }
+
+            [DisplayName("dilation_h")]
+            [Description("DilationH")]
+            public ushort DilationH { get; set; }
+
+            [DisplayName("dilation_w")]
+            [Description("DilationW")]
+            public ushort DilationW { get; set; }
+
+            [DisplayName("fused_clamp_low")]
+            [Description("FusedClampLow")]
+            public float FusedClampLow { get; set; }
+
+            [DisplayName("fused_clamp_high")]
+            [Description("FusedClampHigh")]
+            public float FusedClampHigh { get; set; }
+
+            [DisplayName("fused_lut")]
+            [Description("Whether a 256-entry activation table address is on the stack")]
+            public bool FusedLut { get; set; }
+
+            [DisplayName("fused_lut_zero_point")]
+            [Description("FusedLutZeroPoint")]
+            public int FusedLutZeroPoint { get; set; }
+
+            [DisplayName("fused_lut_scale")]
+            [Description("FusedLutScale")]
+            public float FusedLutScale { get; set; }
+
+            [DisplayName("pool_op")]
+            [Description("Pooling reduce operator")]
+            public ReduceOp PoolOp { get; set; }
+
+            [DisplayName("pool_init_value")]
+            [Description("Pooling init value")]
+            public float PoolInitValue { get; set; }
+
+            [DisplayName("pool_filter_h")]
+            [Description("PoolFilterH")]
+            public ushort PoolFilterH { get; set; }
+
+            [DisplayName("pool_filter_w")]
+            [Description("PoolFilterW")]
+            public ushort PoolFilterW { get; set; }
+
+            [DisplayName("pool_stride_h")]
+            [Description("PoolStrideH")]
+            public ushort PoolStrideH { get; set; }
+
+            [DisplayName("pool_stride_w")]
+            [Description("PoolStrideW")]
+            public ushort PoolStrideW { get; set; }
+
+            [DisplayName("pool_clamp_low")]
+            [Description("PoolClampLow")]
+            public float PoolClampLow { get; set; }
+
+            [DisplayName("pool_clamp_high")]
+            [Description("PoolClampHigh")]
+            public float PoolClampHigh { get; set; }
+        }
     }
 }